@@ -320,6 +320,9 @@ class GPCatalog():
         # pg_database: datfrozenxid and datminmxid are vacuum related
         self._tables['pg_database']._setKnownDifferences("datfrozenxid datminmxid")
 
+        # pg_appendonly: analyzemodcount and analyzestatsig are analyze related, only kept on the coordinator
+        self._tables['pg_appendonly']._setKnownDifferences("analyzemodcount analyzestatsig")
+
         # -------------
         # Issues still present in the product
         # -------------
@@ -0,0 +1,82 @@
+/* gpcontrib/gp_toolkit/gp_toolkit--1.5--1.6.sql */
+
+-- complain if script is sourced in psql, rather than via ALTER EXTENSION
+\echo Use "ALTER EXTENSION gp_toolkit UPDATE TO '1.6" to load this file. \quit
+
+--------------------------------------------------------------------------------
+-- @function:
+--        gp_toolkit.__gp_ao_modcount(regclass)
+--
+-- @in:
+--        regclass - append-optimized table
+--
+-- @out:
+--        bigint - total modcount of the segment files over all the segments,
+--                 or NULL if the segment files cannot be read
+--
+-- @doc:
+--        Sum up the modcounts of the segment files of an append-optimized
+--        table, the way ANALYZE does to find out whether the table has been
+--        modified since it was last analyzed.  A column-oriented table has
+--        one row per column for each segment file, with the same modcount,
+--        so only its first column is counted.
+--
+--------------------------------------------------------------------------------
+CREATE FUNCTION gp_toolkit.__gp_ao_modcount(regclass)
+RETURNS bigint AS $$
+DECLARE
+    modcount bigint;
+BEGIN
+    IF EXISTS (SELECT 1
+               FROM pg_catalog.pg_class c
+               JOIN pg_catalog.pg_am am ON c.relam = am.oid
+               WHERE c.oid = $1 AND am.amname = 'ao_column') THEN
+        SELECT sum(seg.modcount)::bigint INTO modcount
+        FROM gp_toolkit.__gp_aocsseg($1) seg
+        WHERE seg.column_num = 0;
+    ELSE
+        SELECT sum(seg.modcount)::bigint INTO modcount
+        FROM gp_toolkit.__gp_aoseg($1) seg;
+    END IF;
+    RETURN coalesce(modcount, 0);
+EXCEPTION
+    -- If failed to read the aoseg table (e.g. the table itself is missing), skip it
+    WHEN OTHERS THEN
+    RAISE WARNING 'Failed to get aoseg info for %: %', $1, SQLERRM;
+    RETURN NULL;
+END;
+$$
+LANGUAGE plpgsql READS SQL DATA;
+
+GRANT EXECUTE ON FUNCTION gp_toolkit.__gp_ao_modcount(regclass) TO public;
+
+--------------------------------------------------------------------------------
+-- @view:
+--        gp_toolkit.gp_stats_stale_ao
+--
+-- @doc:
+--        List the append-optimized tables readable by the current user whose
+--        statistics may be stale: those that have been modified since
+--        ANALYZE last recorded their modcount, and those it never recorded
+--        it for. Every ANALYZE of all the columns of a table records its
+--        modcount. ANALYZE never skips the listed tables, even when
+--        gp_analyze_skip_unmodified_ao is on.
+--
+--------------------------------------------------------------------------------
+CREATE VIEW gp_toolkit.gp_stats_stale_ao
+AS
+    SELECT
+        aut.autnspname AS ssaschema,
+        aut.autrelname AS ssatable,
+        CASE WHEN ao.analyzemodcount < 0 THEN NULL
+             ELSE ao.analyzemodcount END AS ssaanalyzedmodcount,
+        mc.modcount AS ssamodcount
+    FROM
+        gp_toolkit.__gp_user_data_tables_readable aut
+        JOIN pg_catalog.pg_appendonly ao ON aut.autoid = ao.relid,
+        LATERAL (SELECT gp_toolkit.__gp_ao_modcount(aut.autoid) AS modcount) mc
+    WHERE aut.autrelkind = 'r'
+    AND mc.modcount IS NOT NULL
+    AND mc.modcount <> ao.analyzemodcount;
+
+GRANT SELECT ON TABLE gp_toolkit.gp_stats_stale_ao TO public;
@@ -128,6 +128,23 @@ analyze deep_part;
 -- should return no partitions, since they've all been analyzed
 select * from gp_toolkit.gp_stats_missing where smitable LIKE 'deep_part%';
 
+-- GP Stale Stats of append-optimized tables
+-- A table is returned until ANALYZE records its modcount, and again once it
+-- has been modified since. Every ANALYZE records it, also with
+-- gp_analyze_skip_unmodified_ao off, which is the default.
+create table toolkit_stale_ao (a int, b int) with (appendonly=true, autovacuum_enabled=false) distributed by (a);
+insert into toolkit_stale_ao select i, i from generate_series(1,10) i;
+select ssatable, ssaanalyzedmodcount is null as never_analyzed from gp_toolkit.gp_stats_stale_ao where ssatable='toolkit_stale_ao';
+analyze toolkit_stale_ao;
+select * from gp_toolkit.gp_stats_stale_ao where ssatable='toolkit_stale_ao';
+insert into toolkit_stale_ao values (1, 1);
+select ssatable, ssamodcount > ssaanalyzedmodcount as modified from gp_toolkit.gp_stats_stale_ao where ssatable='toolkit_stale_ao';
+-- tables the user cannot read are not listed
+set session authorization toolkit_user1;
+select * from gp_toolkit.gp_stats_stale_ao where ssatable='toolkit_stale_ao';
+reset session authorization;
+drop table toolkit_stale_ao;
+
 -- Test the gp_skew_idle_fractions view
 create table toolkit_skew (a int);
 insert into toolkit_skew select i from generate_series(1,50000) i;
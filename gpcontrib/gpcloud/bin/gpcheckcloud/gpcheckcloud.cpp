@@ -148,6 +148,7 @@ static void printTemplate() {
         "version = 1\n"
         "proxy = \"\"\n"
         "autocompress = true\n"
+        "compress_threadnum = 1\n"
         "verifycert = true\n"
         "server_side_encryption = \"\"\n"
         "# gpcheckcloud config\n"
@@ -1,6 +1,9 @@
 #ifndef INCLUDE_COMPRESS_WRITER_H_
 #define INCLUDE_COMPRESS_WRITER_H_
 
+#include <chrono>
+#include <deque>
+
 #include "s3common_headers.h"
 #include "s3exception.h"
 #include "s3macros.h"
@@ -9,6 +12,17 @@
 // 2MB by default
 extern uint64_t S3_ZIP_COMPRESS_CHUNKSIZE;
 
+struct CompressJob;
+
+// CompressWriter gzips data before passing it to the underlying writer.
+//
+// With one compression thread the output is a single gzip stream, deflated on
+// the calling thread. With more, input is cut into S3_ZIP_COMPRESS_CHUNKSIZE
+// blocks, each compressed into an independent gzip member by one of
+// numOfThreads worker threads started in open(), and members are passed
+// downstream in input order. The concatenation is still a valid gzip file. At
+// most numOfThreads blocks are in flight at a time.
+
 class CompressWriter : public Writer {
    public:
     CompressWriter();
@@ -26,12 +40,44 @@ class CompressWriter : public Writer {
 
     void setWriter(Writer *writer);
 
+    uint64_t getNumOfWorkers() const {
+        return workers.size();
+    }
+
    private:
+    static void *CompressWorkerFunc(void *p);
+    static void compressBlock(CompressJob *job);
+
     void flush();
     uint64_t writeOneChunk(const char *buf, uint64_t count);
 
+    void startWorkers();
+    void stopWorkers();
+
+    void submitBlock();
+    void drainOneJob();
+    void abandonJobs();
+
     Writer *writer;
 
+    uint64_t numOfThreads;
+
+    // For parallel compression, input not yet handed to a worker, the blocks
+    // in flight, oldest first, and those of them no worker has taken yet.
+    vector<char> block;
+    std::deque<CompressJob *> jobs;
+    std::deque<CompressJob *> queue;
+
+    vector<pthread_t> workers;
+    pthread_mutex_t queueMutex;
+    pthread_cond_t queueCond;  // a block is queued, or workers are to stop
+    pthread_cond_t doneCond;   // a block is compressed
+    bool stopping;
+
+    uint64_t totalIn;
+    uint64_t totalOut;
+    std::chrono::steady_clock::time_point startTime;
+
     // zlib related variables.
     z_stream zstream;
     char *out;  // Output buffer for compression.
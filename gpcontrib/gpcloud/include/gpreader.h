@@ -48,7 +48,7 @@ class GPReader : public Reader {
 };
 
 // Following 3 functions are invoked by s3_import(), need to be exception safe
-GPReader *reader_init(const char *url_with_options);
+GPReader *reader_init(const char *url_with_options, const S3ScanDesc &scanDesc = S3ScanDesc());
 bool reader_transfer_data(GPReader *reader, char *data_buf, int &data_len);
 bool reader_cleanup(GPReader **reader);
 
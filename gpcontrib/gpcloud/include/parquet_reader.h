@@ -0,0 +1,216 @@
+#ifndef INCLUDE_PARQUET_READER_H_
+#define INCLUDE_PARQUET_READER_H_
+
+#include "reader.h"
+#include "s3common_headers.h"
+#include "s3exception.h"
+#include "s3interface.h"
+#include "s3macros.h"
+#include "s3params.h"
+
+// Physical types, page types, codecs and encodings, numbered as in parquet.thrift.
+enum ParquetType {
+    PARQUET_BOOLEAN = 0,
+    PARQUET_INT32 = 1,
+    PARQUET_INT64 = 2,
+    PARQUET_INT96 = 3,
+    PARQUET_FLOAT = 4,
+    PARQUET_DOUBLE = 5,
+    PARQUET_BYTE_ARRAY = 6,
+    PARQUET_FIXED_LEN_BYTE_ARRAY = 7
+};
+
+enum ParquetPageType {
+    PARQUET_DATA_PAGE = 0,
+    PARQUET_INDEX_PAGE = 1,
+    PARQUET_DICTIONARY_PAGE = 2,
+    PARQUET_DATA_PAGE_V2 = 3
+};
+
+enum ParquetCodec { PARQUET_UNCOMPRESSED = 0, PARQUET_SNAPPY = 1, PARQUET_GZIP = 2 };
+
+enum ParquetEncoding {
+    PARQUET_PLAIN = 0,
+    PARQUET_PLAIN_DICTIONARY = 2,
+    PARQUET_RLE = 3,
+    PARQUET_RLE_DICTIONARY = 8
+};
+
+// How the values of a column are rendered as text, derived from its logical
+// (or legacy converted) type.
+enum ParquetValueKind {
+    PARQUET_KIND_DEFAULT,
+    PARQUET_KIND_STRING,
+    PARQUET_KIND_UNSIGNED,
+    PARQUET_KIND_DECIMAL,
+    PARQUET_KIND_DATE,
+    PARQUET_KIND_TIME,
+    PARQUET_KIND_TIMESTAMP
+};
+
+struct ParquetColumn {
+    ParquetColumn()
+        : type(-1),
+          typeLength(0),
+          optional(false),
+          kind(PARQUET_KIND_DEFAULT),
+          scale(0),
+          unitsPerSecond(1000),
+          adjustedToUTC(false) {
+    }
+
+    string name;
+    int32_t type;
+    int32_t typeLength;  // for FIXED_LEN_BYTE_ARRAY
+    bool optional;
+    ParquetValueKind kind;
+    int32_t scale;           // for DECIMAL
+    int64_t unitsPerSecond;  // for TIME and TIMESTAMP
+    bool adjustedToUTC;      // for TIME and TIMESTAMP
+};
+
+struct ParquetColumnChunk {
+    ParquetColumnChunk()
+        : codec(PARQUET_UNCOMPRESSED),
+          numValues(0),
+          offset(0),
+          length(0),
+          nullCount(-1),
+          hasMinMax(false) {
+    }
+
+    int32_t codec;
+    int64_t numValues;
+    uint64_t offset;  // offset of the first page, the dictionary page if there is one
+    uint64_t length;  // total compressed size of all pages
+
+    // Statistics of the chunk, in the PLAIN encoding of its physical type.
+    int64_t nullCount;  // -1 if unknown
+    bool hasMinMax;
+    string minValue;
+    string maxValue;
+};
+
+struct ParquetRowGroup {
+    int64_t numRows;
+    vector<ParquetColumnChunk> columns;
+};
+
+// Text of one column of the current row group, already quoted for CSV. A NULL
+// value is an empty cell; ends[i] is the end of the i-th cell in text.
+struct ParquetCells {
+    void clear() {
+        text.clear();
+        ends.clear();
+    }
+
+    string text;
+    vector<uint64_t> ends;
+};
+
+// Read position in a column chunk of the current row group. The chunk is
+// fetched in windows and decoded one data page at a time; cells holds the
+// values of rows firstRow onwards.
+struct ParquetChunkCursor {
+    ParquetChunkCursor() : rawOffset(0), pos(0), firstRow(0), valuesRead(0) {
+    }
+
+    void reset(const ParquetColumnChunk& chunk) {
+        this->chunk = chunk;
+        this->raw.clear();
+        this->rawOffset = 0;
+        this->pos = 0;
+        this->dictionary.clear();
+        this->cells.clear();
+        this->firstRow = 0;
+        this->valuesRead = 0;
+    }
+
+    ParquetColumnChunk chunk;
+    vector<uint8_t> raw;  // fetched bytes of the chunk
+    uint64_t rawOffset;   // offset of raw in the chunk
+    uint64_t pos;         // offset of the next page in the chunk
+
+    ParquetCells dictionary;
+    ParquetCells cells;  // values of the current data page
+    int64_t firstRow;    // row of the first value in cells
+    int64_t valuesRead;  // values of the chunk decoded so far
+
+    vector<uint8_t> pageBuf;  // uncompressed page
+    vector<uint8_t> defLevels;
+};
+
+struct ParquetPageHeader;
+
+// ParquetReader turns a Parquet file into CSV rows for the external table
+// protocol. It fetches the footer first, then for each row group only the
+// chunks of the columns the scan needs, in ranged GETs of at most chunksize
+// bytes. The other columns are left empty, i.e. NULL. Row groups whose
+// statistics show that no row passes the filters of the scan are skipped.
+//
+// Columns of the external table are matched to Parquet columns by name, or by
+// position if the names don't all match.
+//
+// Only flat schemas are supported. Pages may be PLAIN or dictionary encoded,
+// and uncompressed, SNAPPY or GZIP compressed.
+class ParquetReader : public Reader {
+   public:
+    ParquetReader()
+        : s3InterfaceService(NULL),
+          rowGroupIndex(0),
+          rowIndex(0),
+          rowsInGroup(0),
+          outOffset(0) {
+    }
+
+    virtual ~ParquetReader() {
+        this->close();
+    }
+
+    virtual void open(const S3Params& params);
+
+    // read() attempts to read up to count bytes into the buffer.
+    // Return 0 if EOF. Throw exception if encounters errors.
+    virtual uint64_t read(char* buf, uint64_t count);
+
+    // This should be reentrant, has no side effects when called multiple times.
+    virtual void close();
+
+    void setS3InterfaceService(S3Interface* s3InterfaceService) {
+        this->s3InterfaceService = s3InterfaceService;
+    }
+
+   protected:
+    void fetchRange(uint64_t offset, uint64_t len, vector<uint8_t>& out);
+    void readFileMetaData();
+    void parseFileMetaData(const uint8_t* data, uint64_t len);
+    void setProjection(const S3ScanDesc& scanDesc);
+    bool canSkipRowGroup(const ParquetRowGroup& rowGroup) const;
+
+    bool loadNextRowGroup();
+    const uint8_t* fetchChunkBytes(ParquetChunkCursor& cursor, uint64_t len);
+    void readPageHeader(ParquetChunkCursor& cursor, ParquetPageHeader& header);
+    void decodeNextPage(const ParquetColumn& column, ParquetChunkCursor& cursor);
+    void formatRows(uint64_t count);
+
+    S3Interface* s3InterfaceService;
+    S3Params params;
+
+    vector<ParquetColumn> schema;  // leaf columns, in file order
+    vector<ParquetRowGroup> rowGroups;
+    vector<size_t> readColumns;  // indexes into schema of the columns to read
+    vector<int> projection;      // per output column, index into readColumns or -1 if empty
+
+    // filters of the scan, with the column an index into schema
+    vector<S3ScanFilter> filters;
+
+    size_t rowGroupIndex;  // next row group to load
+    vector<ParquetChunkCursor> chunks;  // one per column in readColumns
+    int64_t rowIndex;
+    int64_t rowsInGroup;
+
+    string out;  // formatted rows not yet returned by read()
+    uint64_t outOffset;
+};
+
+#endif /* INCLUDE_PARQUET_READER_H_ */
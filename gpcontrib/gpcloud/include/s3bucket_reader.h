@@ -6,6 +6,99 @@
 #include "s3exception.h"
 #include "s3interface.h"
 
+// A key fetched ahead of its reader.
+struct PrefetchedKey {
+    PrefetchedKey() : ready(false), compressionType(S3_COMPRESSION_PLAIN) {
+    }
+
+    void clear() {
+        this->url.clear();
+        this->ready = false;
+        this->data.clear();
+        this->data.shrink_to_fit();
+    }
+
+    string url;
+    bool ready;
+    S3CompressionType compressionType;
+    vector<uint8_t> data;
+};
+
+// S3KeyPrefetcher downloads the next small key (one no larger than a chunk) in
+// the background while the current one is read, so that per-key request
+// latency overlaps with reading. Readers of a key use it as their S3Interface,
+// it answers from memory what it has prefetched and passes on the rest.
+class S3KeyPrefetcher : public S3Interface {
+   public:
+    S3KeyPrefetcher() : s3Interface(NULL), thread(0) {
+    }
+    virtual ~S3KeyPrefetcher() {
+        this->close();
+    }
+
+    void setS3InterfaceService(S3Interface *s3) {
+        this->s3Interface = s3;
+    }
+
+    // Start fetching the key of readerParams.
+    void prefetch(const S3Params &readerParams);
+
+    // Make the key of s3Url, if it is the one prefetched, the one to serve.
+    void serve(const S3Url &s3Url);
+
+    void close();
+
+    bool isServing(const S3Url &s3Url) const {
+        return this->served.ready && this->served.url == s3Url.getFullUrlForCurl();
+    }
+
+    // Runs in the prefetching thread.
+    void fetchPending();
+
+    ListBucketResult listBucket(S3Url &s3Url) {
+        return this->s3Interface->listBucket(s3Url);
+    }
+
+    uint64_t fetchData(uint64_t offset, S3VectorUInt8 &data, uint64_t len, const S3Url &s3Url);
+
+    S3CompressionType checkCompressionType(const S3Url &s3Url);
+
+    bool checkKeyExistence(const S3Url &s3Url) {
+        return this->s3Interface->checkKeyExistence(s3Url);
+    }
+
+    string getUploadId(const S3Url &s3Url) {
+        return this->s3Interface->getUploadId(s3Url);
+    }
+
+    string uploadPartOfData(S3VectorUInt8 &data, const S3Url &s3Url, uint64_t partNumber,
+                            const string &uploadId) {
+        return this->s3Interface->uploadPartOfData(data, s3Url, partNumber, uploadId);
+    }
+
+    bool completeMultiPart(const S3Url &s3Url, const string &uploadId,
+                           const vector<string> &etagArray) {
+        return this->s3Interface->completeMultiPart(s3Url, uploadId, etagArray);
+    }
+
+    bool abortUpload(const S3Url &s3Url, const string &uploadId) {
+        return this->s3Interface->abortUpload(s3Url, uploadId);
+    }
+
+   private:
+    S3Interface *s3Interface;
+
+    // pending is written by the prefetching thread only, and handed over to
+    // served after joining it. served is read by the downloading threads of
+    // the current key only.
+    pthread_t thread;
+    S3Params pendingParams;
+    PrefetchedKey pending;
+    PrefetchedKey served;
+
+    void join();
+};
+
 // S3BucketReader read multiple files in a bucket.
 class S3BucketReader : public Reader {
    public:
@@ -18,6 +111,17 @@ class S3BucketReader : public Reader {
 
     void setS3InterfaceService(S3Interface *s3) {
         this->s3Interface = s3;
+        this->keyPrefetcher.setS3InterfaceService(s3);
+    }
+
+    // The upstream reader must use getKeyPrefetcher() as its S3Interface for
+    // prefetched keys to be read from memory.
+    void setPrefetchNextKey(bool prefetchNextKey) {
+        this->prefetchNextKey = prefetchNextKey;
+    }
+
+    S3KeyPrefetcher *getKeyPrefetcher() {
+        return &this->keyPrefetcher;
     }
 
     void setUpstreamReader(Reader *reader) {
@@ -37,6 +141,9 @@ class S3BucketReader : public Reader {
     Reader *upstreamReader;
     bool needNewReader;
 
+    S3KeyPrefetcher keyPrefetcher;
+    bool prefetchNextKey;
+
     // when load multiple files on one segment and each of them has a header line,
     // we should read header line only for the 1st file and ignore remainings.
     bool isFirstFile;
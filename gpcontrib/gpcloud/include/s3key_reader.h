@@ -1,6 +1,8 @@
 #ifndef INCLUDE_S3KEY_READER_H_
 #define INCLUDE_S3KEY_READER_H_
 
+#include <chrono>
+
 #include "reader.h"
 #include "s3common_headers.h"
 #include "s3exception.h"
@@ -11,9 +13,24 @@ struct Range {
     uint64_t length;
 };
 
+// Chunks start at this size and grow while that makes requests faster.
+#define S3_INITIAL_CHUNK_SIZE (1024 * 1024)
+
+// How much faster (in bytes per second) a larger chunk or one more thread must
+// make the download to keep growing.
+#define S3_THROUGHPUT_MIN_GAIN 1.1
+
 class OffsetMgr {
    public:
-    OffsetMgr() : keySize(0), chunkSize(0), curPos(0) {
+    OffsetMgr()
+        : keySize(0),
+          chunkSize(0),
+          curPos(0),
+          maxChunkSize(0),
+          adaptive(false),
+          learnedChunkSize(0),
+          lastThroughput(0),
+          chunkSizeSettled(false) {
         pthread_mutex_init(&this->offsetLock, NULL);
     }
     ~OffsetMgr() {
@@ -26,10 +43,16 @@ class OffsetMgr {
         return chunkSize;
     }
 
+    // A fixed chunk size, and the upper bound of an adaptive one.
     void setChunkSize(uint64_t chunkSize) {
         this->chunkSize = chunkSize;
+        this->maxChunkSize = chunkSize;
+        this->adaptive = false;
     }
 
+    void setAdaptiveChunkSize(uint64_t initialChunkSize);
+    void reportFetch(uint64_t length, double seconds);
+
     uint64_t getKeySize() const {
         return keySize;
     }
@@ -42,7 +65,11 @@ class OffsetMgr {
         this->curPos = curPos;
     }
 
+    // What the adaptive chunk size has learned is kept for the next key.
     void reset() {
+        if (this->adaptive) {
+            this->learnedChunkSize = this->chunkSize;
+        }
         this->setCurPos(0);
         this->setChunkSize(0);
         this->setKeySize(0);
@@ -57,6 +84,12 @@ class OffsetMgr {
     uint64_t keySize;  // size of S3 key(file)
     uint64_t chunkSize;
     uint64_t curPos;
+
+    uint64_t maxChunkSize;
+    bool adaptive;
+    uint64_t learnedChunkSize;  // chunk size the previous key ended with
+    double lastThroughput;      // of a request of half the current chunk size
+    bool chunkSizeSettled;
 };
 
 enum ChunkStatus {
@@ -71,7 +104,13 @@ class S3KeyReader : public Reader {
     S3KeyReader()
         : sharedError(false),
           numOfChunks(0),
+          maxNumOfChunks(0),
+          learnedNumOfChunks(0),
           curReadingChunk(0),
+          curBuffer(0),
+          roundBytes(0),
+          lastRoundThroughput(0),
+          concurrencySettled(false),
           transferredKeyLen(0),
           s3Interface(NULL),
           hasEol(false),
@@ -149,8 +188,22 @@ class S3KeyReader : public Reader {
     // and share across threads.
     std::exception_ptr sharedException;
 
+    // Downloading threads, one per chunk buffer. A key starts with as many
+    // threads as the previous one ended with, or one, and gets another one
+    // after each round over the buffers that was faster than the one before,
+    // up to maxNumOfChunks.
     uint64_t numOfChunks;
+    uint64_t maxNumOfChunks;
+    uint64_t learnedNumOfChunks;
+
     uint64_t curReadingChunk;
+    uint64_t curBuffer;  // index of the buffer being read
+
+    std::chrono::steady_clock::time_point roundStart;
+    uint64_t roundBytes;
+    double lastRoundThroughput;
+    bool concurrencySettled;
+
     uint64_t transferredKeyLen;
     string region;
     OffsetMgr offsetMgr;
@@ -159,7 +212,10 @@ class S3KeyReader : public Reader {
     vector<pthread_t> threads;
 
     S3Interface* s3Interface;
+    S3Params params;
 
+    void addChunkBuffer();
+    void adjustConcurrency();
     void reset();
 
     bool hasEol;
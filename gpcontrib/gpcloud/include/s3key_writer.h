@@ -1,6 +1,8 @@
 #ifndef INCLUDE_S3KEY_WRITER_H_
 #define INCLUDE_S3KEY_WRITER_H_
 
+#include <chrono>
+
 #include "s3common_headers.h"
 #include "s3exception.h"
 #include "s3interface.h"
@@ -10,7 +12,8 @@ class WriterBuffer : public vector<uint8_t> {};
 
 class S3KeyWriter : public Writer {
    public:
-    S3KeyWriter() : sharedError(false), s3Interface(NULL), partNumber(0), activeThreads(0) {
+    S3KeyWriter()
+        : sharedError(false), s3Interface(NULL), partNumber(0), activeThreads(0), totalBytes(0) {
         pthread_mutex_init(&this->mutex, NULL);
         pthread_cond_init(&this->cv, NULL);
         pthread_mutex_init(&this->exceptionMutex, NULL);
@@ -61,6 +64,9 @@ class S3KeyWriter : public Writer {
     uint64_t partNumber;
     uint64_t activeThreads;
 
+    uint64_t totalBytes;  // bytes handed to upload threads, for throughput logging
+    std::chrono::steady_clock::time_point startTime;
+
     S3Params params;
 };
 
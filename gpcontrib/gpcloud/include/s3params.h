@@ -7,6 +7,33 @@
 
 enum S3SSEType { SSE_NONE, SSE_S3 };
 
+// A comparison of a column of the external table with a constant, taken from
+// the quals of the scan. Readers may skip data whose statistics show that no
+// row passes it.
+enum S3ScanFilterOp { S3_FILTER_LT, S3_FILTER_LE, S3_FILTER_EQ, S3_FILTER_GE, S3_FILTER_GT };
+
+enum S3ScanFilterType {
+    S3_FILTER_NUMBER,  // integer or floating point column
+    S3_FILTER_DATE     // date column, value is in days since 1970-01-01
+};
+
+struct S3ScanFilter {
+    size_t column;  // index into S3ScanDesc::columns
+    S3ScanFilterOp op;
+    S3ScanFilterType type;
+    bool isInteger;  // whether the value is intValue, or else floatValue
+    int64_t intValue;
+    double floatValue;
+};
+
+// What a scan of the external table needs. Readers of formats that can skip
+// data, like Parquet, use it; the others produce all columns of every row.
+struct S3ScanDesc {
+    vector<string> columns;  // names of the columns of the external table
+    vector<bool> needed;     // which of them the scan uses, empty if all
+    vector<S3ScanFilter> filters;
+};
+
 class S3Params {
    public:
     S3Params(const string& sourceUrl = "", bool useHttps = true, const string& version = "",
@@ -15,6 +42,7 @@ class S3Params {
           keySize(0),
           chunkSize(0),
           numOfChunks(0),
+          numOfCompressThreads(1),
           lowSpeedLimit(0),
           lowSpeedTime(0),
           proxy(""),
@@ -64,6 +92,14 @@ class S3Params {
         this->numOfChunks = numOfChunks;
     }
 
+    uint64_t getNumOfCompressThreads() const {
+        return numOfCompressThreads;
+    }
+
+    void setNumOfCompressThreads(uint64_t numOfCompressThreads) {
+        this->numOfCompressThreads = numOfCompressThreads;
+    }
+
     uint64_t getKeySize() const {
         return keySize;
     }
@@ -147,6 +183,14 @@ class S3Params {
         this->gpcheckcloud_newline = gpcheckcloud_newline;
     }
 
+    const S3ScanDesc& getScanDesc() const {
+        return scanDesc;
+    }
+
+    void setScanDesc(const S3ScanDesc& scanDesc) {
+        this->scanDesc = scanDesc;
+    }
+
    private:
     S3Url s3Url;  // original url to read/write.
 
@@ -157,6 +201,8 @@ class S3Params {
     uint64_t chunkSize;    // chunk size
     uint64_t numOfChunks;  // number of chunks(threads).
 
+    uint64_t numOfCompressThreads;  // number of threads compressing uploads
+
     uint64_t lowSpeedLimit;  // low speed limit
     uint64_t lowSpeedTime;   // low speed timeout
 
@@ -172,6 +218,8 @@ class S3Params {
     S3MemoryContext memoryContext;
 
     string gpcheckcloud_newline;  // newline LF, CRLF, CR
+
+    S3ScanDesc scanDesc;  // columns and quals of the scan, set by s3_import()
 };
 
 inline void PrepareS3MemContext(const S3Params& params) {
@@ -10,6 +10,25 @@
 #include "s3macros.h"
 #include "s3params.h"
 
+// Idle cURL easy handles. A handle keeps its connections open after a request,
+// so handing it to the next request, from whatever thread, saves the TCP and
+// TLS handshakes for every chunk and every small key.
+class CURLHandlePool {
+   public:
+    CURLHandlePool() {
+        pthread_mutex_init(&this->mutex, NULL);
+    }
+    ~CURLHandlePool();
+
+    CURL* acquire();
+    void release(CURL* curl);
+    void clear();
+
+   private:
+    pthread_mutex_t mutex;
+    vector<CURL*> idleHandles;
+};
+
 class S3RESTfulService : public RESTfulService {
    public:
     S3RESTfulService();
@@ -39,7 +58,11 @@ class S3RESTfulService : public RESTfulService {
     uint64_t chunkBufferSize;
     S3MemoryContext s3MemContext;
 
+    CURLHandlePool handlePool;
+
     void performCurl(CURL* curl, Response& response);
+
+    friend struct CURLWrapper;
 };
 
 class S3MessageParser {
@@ -2,8 +2,23 @@
 
 uint64_t S3_ZIP_COMPRESS_CHUNKSIZE = S3_ZIP_DEFAULT_CHUNKSIZE;
 
-CompressWriter::CompressWriter() : writer(NULL), isClosed(true) {
+struct CompressJob {
+    CompressJob() : done(false), status(Z_OK) {
+    }
+
+    bool done;  // guarded by queueMutex
+    vector<char> input;
+    vector<char> output;  // one complete gzip member
+    int status;
+};
+
+CompressWriter::CompressWriter()
+    : writer(NULL), numOfThreads(1), stopping(false), totalIn(0), totalOut(0), isClosed(true) {
     this->out = new char[S3_ZIP_COMPRESS_CHUNKSIZE];
+
+    pthread_mutex_init(&this->queueMutex, NULL);
+    pthread_cond_init(&this->queueCond, NULL);
+    pthread_cond_init(&this->doneCond, NULL);
 }
 
 CompressWriter::~CompressWriter() {
@@ -11,10 +26,26 @@ CompressWriter::~CompressWriter() {
         this->close();
     } catch (...) {
     }
+    this->abandonJobs();
+    this->stopWorkers();
     delete this->out;
+
+    pthread_mutex_destroy(&this->queueMutex);
+    pthread_cond_destroy(&this->queueCond);
+    pthread_cond_destroy(&this->doneCond);
 }
 
 void CompressWriter::open(const S3Params& params) {
+    this->numOfThreads = std::max(params.getNumOfCompressThreads(), (uint64_t)1);
+    this->totalIn = 0;
+    this->totalOut = 0;
+    this->startTime = std::chrono::steady_clock::now();
+
+    if (this->numOfThreads > 1) {
+        this->block.reserve(S3_ZIP_COMPRESS_CHUNKSIZE);
+        this->startWorkers();
+    }
+
     this->zstream.zalloc = Z_NULL;
     this->zstream.zfree = Z_NULL;
     this->zstream.opaque = Z_NULL;
@@ -74,6 +105,25 @@ uint64_t CompressWriter::write(const char* buf, uint64_t count) {
         return 0;
     }
 
+    this->totalIn += count;
+
+    if (this->numOfThreads > 1) {
+        uint64_t offset = 0;
+        while (offset < count) {
+            uint64_t room = S3_ZIP_COMPRESS_CHUNKSIZE - this->block.size();
+            uint64_t len = std::min(room, count - offset);
+
+            this->block.insert(this->block.end(), buf + offset, buf + offset + len);
+            offset += len;
+
+            if (this->block.size() == S3_ZIP_COMPRESS_CHUNKSIZE) {
+                this->submitBlock();
+            }
+        }
+
+        return count;
+    }
+
     uint64_t writtenLen = 0;
 
     for (uint64_t i = 0; i < (count / S3_ZIP_COMPRESS_CHUNKSIZE); i++) {
@@ -92,22 +142,46 @@ void CompressWriter::close() {
         return;
     }
 
-    int status;
-    do {
-        status = deflate(&this->zstream, Z_FINISH);
-        this->flush();
-    } while (status == Z_OK);
+    if (this->numOfThreads > 1) {
+        // zstream is unused, its output would be an extra empty member.
+        deflateEnd(&this->zstream);
 
-    deflateEnd(&this->zstream);
+        // An empty input still makes an (empty) gzip file.
+        if (!this->block.empty() || this->totalIn == 0) {
+            this->submitBlock();
+        }
 
-    if (status != Z_STREAM_END) {
-        S3_CHECK_OR_DIE(false, S3RuntimeError,
-                        string("Failed to compress data: ") +
-                            std::to_string((unsigned long long)status) + ", " + this->zstream.msg);
+        while (!this->jobs.empty()) {
+            this->drainOneJob();
+        }
+
+        this->stopWorkers();
+    } else {
+        int status;
+        do {
+            status = deflate(&this->zstream, Z_FINISH);
+            this->flush();
+        } while (status == Z_OK);
+
+        deflateEnd(&this->zstream);
+
+        if (status != Z_STREAM_END) {
+            S3_CHECK_OR_DIE(false, S3RuntimeError,
+                            string("Failed to compress data: ") +
+                                std::to_string((unsigned long long)status) + ", " +
+                                this->zstream.msg);
+        }
     }
 
     S3DEBUG("Compression finished: Z_STREAM_END.");
 
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - this->startTime).count();
+    S3DEBUG("Compressed %" PRIu64 " bytes into %" PRIu64 " bytes with %" PRIu64
+            " threads in %.3f seconds (%.2f MB/s)",
+            this->totalIn, this->totalOut, this->numOfThreads, seconds,
+            seconds > 0 ? this->totalIn / seconds / (1024 * 1024) : 0.0);
+
     this->writer->close();
     this->isClosed = true;
 }
@@ -118,8 +192,164 @@ void CompressWriter::setWriter(Writer* writer) {
 
 void CompressWriter::flush() {
     if (this->zstream.avail_out < S3_ZIP_COMPRESS_CHUNKSIZE) {
+        this->totalOut += S3_ZIP_COMPRESS_CHUNKSIZE - this->zstream.avail_out;
         this->writer->write(this->out, S3_ZIP_COMPRESS_CHUNKSIZE - this->zstream.avail_out);
         this->zstream.next_out = (Byte*)this->out;
         this->zstream.avail_out = S3_ZIP_COMPRESS_CHUNKSIZE;
     }
 }
+
+// Compress job->input into a complete gzip member in job->output.
+void CompressWriter::compressBlock(CompressJob* job) {
+    z_stream zs;
+    zs.zalloc = Z_NULL;
+    zs.zfree = Z_NULL;
+    zs.opaque = Z_NULL;
+
+    job->status = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, S3_DEFLATE_WINDOWSBITS, 8,
+                               Z_DEFAULT_STRATEGY);
+    if (job->status != Z_OK) {
+        return;
+    }
+
+    // deflateBound() is large enough for Z_FINISH to complete in a single call.
+    job->output.resize(deflateBound(&zs, job->input.size()));
+
+    zs.next_in = (Byte*)job->input.data();
+    zs.avail_in = job->input.size();
+    zs.next_out = (Byte*)job->output.data();
+    zs.avail_out = job->output.size();
+
+    job->status = deflate(&zs, Z_FINISH);
+    job->output.resize(zs.total_out);
+
+    deflateEnd(&zs);
+}
+
+// Take queued blocks and compress them until told to stop.
+void* CompressWriter::CompressWorkerFunc(void* p) {
+    MaskThreadSignals();
+
+    CompressWriter* compressWriter = (CompressWriter*)p;
+
+    while (true) {
+        CompressJob* job;
+        {
+            UniqueLock lock(&compressWriter->queueMutex);
+            while (compressWriter->queue.empty() && !compressWriter->stopping) {
+                pthread_cond_wait(&compressWriter->queueCond, &compressWriter->queueMutex);
+            }
+
+            if (compressWriter->queue.empty()) {
+                return NULL;
+            }
+
+            job = compressWriter->queue.front();
+            compressWriter->queue.pop_front();
+        }
+
+        compressBlock(job);
+
+        UniqueLock lock(&compressWriter->queueMutex);
+        job->done = true;
+        pthread_cond_broadcast(&compressWriter->doneCond);
+    }
+}
+
+void CompressWriter::startWorkers() {
+    this->stopping = false;
+
+    for (uint64_t i = 0; i < this->numOfThreads; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, CompressWorkerFunc, this) != 0) {
+            break;
+        }
+        this->workers.push_back(thread);
+    }
+
+    if (this->workers.size() < this->numOfThreads) {
+        S3DEBUG("Started %zu of %" PRIu64 " compression threads", this->workers.size(),
+                this->numOfThreads);
+    }
+}
+
+void CompressWriter::stopWorkers() {
+    {
+        UniqueLock lock(&this->queueMutex);
+        this->stopping = true;
+        pthread_cond_broadcast(&this->queueCond);
+    }
+
+    for (size_t i = 0; i < this->workers.size(); i++) {
+        pthread_join(this->workers[i], NULL);
+    }
+    this->workers.clear();
+}
+
+// Queue the current block for the workers, first waiting for the oldest one if
+// numOfThreads blocks are already in flight.
+void CompressWriter::submitBlock() {
+    if (this->jobs.size() >= this->numOfThreads) {
+        this->drainOneJob();
+    }
+
+    CompressJob* job = new CompressJob();
+    job->input.swap(this->block);
+    this->jobs.push_back(job);
+
+    if (this->workers.empty()) {
+        // Couldn't start any thread, do it here instead.
+        compressBlock(job);
+        job->done = true;
+    } else {
+        UniqueLock lock(&this->queueMutex);
+        this->queue.push_back(job);
+        pthread_cond_signal(&this->queueCond);
+    }
+
+    this->block.reserve(S3_ZIP_COMPRESS_CHUNKSIZE);
+}
+
+// Wait for the oldest block and pass its gzip member to the underlying writer.
+void CompressWriter::drainOneJob() {
+    std::unique_ptr<CompressJob> job(this->jobs.front());
+    this->jobs.pop_front();
+
+    {
+        UniqueLock lock(&this->queueMutex);
+        while (!job->done) {
+            pthread_cond_wait(&this->doneCond, &this->queueMutex);
+        }
+    }
+
+    if (job->status != Z_STREAM_END) {
+        this->abandonJobs();
+        S3_CHECK_OR_DIE(false, S3RuntimeError,
+                        string("Failed to compress data: ") +
+                            std::to_string((unsigned long long)job->status));
+    }
+
+    this->totalOut += job->output.size();
+    this->writer->write(job->output.data(), job->output.size());
+}
+
+// Drop all blocks in flight, waiting for those being compressed, used when
+// giving up on the output.
+void CompressWriter::abandonJobs() {
+    UniqueLock lock(&this->queueMutex);
+    for (size_t i = 0; i < this->queue.size(); i++) {
+        this->queue[i]->done = true;
+    }
+    this->queue.clear();
+
+    while (!this->jobs.empty()) {
+        CompressJob* job = this->jobs.front();
+        this->jobs.pop_front();
+
+        while (!job->done && !this->workers.empty()) {
+            pthread_cond_wait(&this->doneCond, &this->queueMutex);
+        }
+        delete job;
+    }
+    this->block.clear();
+}
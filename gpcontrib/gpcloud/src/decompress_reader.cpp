@@ -71,56 +71,65 @@ uint64_t DecompressReader::read(char *buf, uint64_t bufSize) {
 
 // Read compressed data from underlying reader and decompress to this->out buffer.
 // If no more data to consume, this->zstream.avail_out == S3_ZIP_DECOMPRESS_CHUNKSIZE;
+//
+// The input may be several gzip members one after another (CompressWriter writes
+// one per block when compressing in parallel). Crossing a member boundary can
+// produce no output, so go on until there is some or the input is exhausted.
 void DecompressReader::decompress() {
-    if (this->zstream.avail_in == 0) {
-        this->zstream.avail_out = S3_ZIP_DECOMPRESS_CHUNKSIZE;
-        this->zstream.next_out = (Byte *)this->out;
-
-        // read S3_ZIP_DECOMPRESS_CHUNKSIZE data from underlying reader and put into this->in
-        // buffer. read() might happen more than once when reaching EOF, make sure every time read()
-        // will return 0.
-        uint64_t hasRead = this->reader->read(this->in, S3_ZIP_DECOMPRESS_CHUNKSIZE);
-
-        // EOF, no more data to decompress.
-        if (hasRead == 0) {
-            S3DEBUG(
-                "No more data to decompress: avail_in = %u, avail_out = %u, total_in = %u, "
-                "total_out = %u",
-                zstream.avail_in, zstream.avail_out,
-		(unsigned int) zstream.total_in, (unsigned int) zstream.total_out);
-            return;
-        }
+    do {
+        if (this->zstream.avail_in == 0) {
+            this->zstream.avail_out = S3_ZIP_DECOMPRESS_CHUNKSIZE;
+            this->zstream.next_out = (Byte *)this->out;
+
+            // read S3_ZIP_DECOMPRESS_CHUNKSIZE data from underlying reader and put into this->in
+            // buffer. read() might happen more than once when reaching EOF, make sure every time
+            // read() will return 0.
+            uint64_t hasRead = this->reader->read(this->in, S3_ZIP_DECOMPRESS_CHUNKSIZE);
+
+            // EOF, no more data to decompress.
+            if (hasRead == 0) {
+                S3DEBUG(
+                    "No more data to decompress: avail_in = %u, avail_out = %u, total_in = %u, "
+                    "total_out = %u",
+                    zstream.avail_in, zstream.avail_out,
+                    (unsigned int) zstream.total_in, (unsigned int) zstream.total_out);
+                return;
+            }
 
-        // Fill this->in as possible as it could, otherwise data in this->in might not be able to be
-        // inflated.
-        while (hasRead < S3_ZIP_DECOMPRESS_CHUNKSIZE) {
-            uint64_t count =
-                this->reader->read(this->in + hasRead, S3_ZIP_DECOMPRESS_CHUNKSIZE - hasRead);
+            // Fill this->in as possible as it could, otherwise data in this->in might not be able
+            // to be inflated.
+            while (hasRead < S3_ZIP_DECOMPRESS_CHUNKSIZE) {
+                uint64_t count =
+                    this->reader->read(this->in + hasRead, S3_ZIP_DECOMPRESS_CHUNKSIZE - hasRead);
 
-            if (count == 0) {
-                break;
+                if (count == 0) {
+                    break;
+                }
+
+                hasRead += count;
             }
 
-            hasRead += count;
+            this->zstream.next_in = (Byte *)this->in;
+            this->zstream.avail_in = hasRead;
+        } else {
+            // Still have more data in 'in' buffer to decode.
+            this->zstream.avail_out = S3_ZIP_DECOMPRESS_CHUNKSIZE;
+            this->zstream.next_out = (Byte *)this->out;
         }
 
-        this->zstream.next_in = (Byte *)this->in;
-        this->zstream.avail_in = hasRead;
-    } else {
-        // Still have more data in 'in' buffer to decode.
-        this->zstream.avail_out = S3_ZIP_DECOMPRESS_CHUNKSIZE;
-        this->zstream.next_out = (Byte *)this->out;
-    }
-
-    int status = inflate(&this->zstream, Z_NO_FLUSH);
-    if (status == Z_STREAM_END) {
-        S3DEBUG("Decompression finished: Z_STREAM_END.");
-    } else if (status < 0 || status == Z_NEED_DICT) {
-        inflateEnd(&this->zstream);
-        S3_CHECK_OR_DIE(
-            false, S3RuntimeError,
-            string("Failed to decompress data: ") + std::to_string((unsigned long long)status));
-    }
+        int status = inflate(&this->zstream, Z_NO_FLUSH);
+        if (status == Z_STREAM_END) {
+            S3DEBUG("Decompression finished: Z_STREAM_END.");
+
+            // get ready for the next member, if any
+            inflateReset(&this->zstream);
+        } else if (status < 0 || status == Z_NEED_DICT) {
+            inflateEnd(&this->zstream);
+            S3_CHECK_OR_DIE(
+                false, S3RuntimeError,
+                string("Failed to decompress data: ") + std::to_string((unsigned long long)status));
+        }
+    } while (this->getDecompressedBytesNum() == 0);
 }
 
 void DecompressReader::close() {
@@ -13,15 +13,23 @@ extern "C" {
 
 #include "access/external.h"
 #include "access/extprotocol.h"
+#include "access/stratnum.h"
 #include "access/xact.h"
 #include "catalog/pg_proc.h"
+#include "catalog/pg_type.h"
 #include "commands/defrem.h"
+#include "extaccess.h"
 #include "fmgr.h"
 #include "funcapi.h"
+#include "optimizer/optimizer.h"
 #include "utils/array.h"
 #include "utils/builtins.h"
+#include "utils/date.h"
+#include "utils/guc.h"
+#include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/resowner.h"
+#include "utils/typcache.h"
 
 #ifdef __clang__
 #pragma clang diagnostic pop
@@ -169,6 +177,194 @@ static void parseFormatOpts(FunctionCallInfo fcinfo) {
     }
 }
 
+static bool isScanFilterNumberType(Oid type) {
+    return type == INT2OID || type == INT4OID || type == INT8OID || type == FLOAT4OID ||
+           type == FLOAT8OID;
+}
+
+/*
+ * Turn a clause "column op constant" (or "constant op column") on an integer,
+ * floating point or date column into an S3ScanFilter, so that readers can
+ * skip data that can't pass it. Other clauses are left to the executor, which
+ * evaluates all of them anyway.
+ */
+static void addScanFilter(Node *clause, const vector<int> &columnOfAttr, S3ScanDesc &scanDesc) {
+    if (IsA(clause, BoolExpr) && ((BoolExpr *)clause)->boolop == AND_EXPR) {
+        ListCell *lc;
+
+        foreach (lc, ((BoolExpr *)clause)->args) {
+            addScanFilter((Node *)lfirst(lc), columnOfAttr, scanDesc);
+        }
+        return;
+    }
+
+    if (!IsA(clause, OpExpr) || list_length(((OpExpr *)clause)->args) != 2) {
+        return;
+    }
+
+    OpExpr *opExpr = (OpExpr *)clause;
+    Node *left = (Node *)linitial(opExpr->args);
+    Node *right = (Node *)lsecond(opExpr->args);
+    bool commuted = false;
+
+    if (IsA(left, RelabelType)) left = (Node *)((RelabelType *)left)->arg;
+    if (IsA(right, RelabelType)) right = (Node *)((RelabelType *)right)->arg;
+
+    if (IsA(left, Const) && IsA(right, Var)) {
+        std::swap(left, right);
+        commuted = true;
+    }
+
+    if (!IsA(left, Var) || !IsA(right, Const)) {
+        return;
+    }
+
+    Var *var = (Var *)left;
+    Const *value = (Const *)right;
+
+    if (var->varattno <= 0 || var->varattno >= (AttrNumber)columnOfAttr.size() ||
+        columnOfAttr[var->varattno] < 0 || value->constisnull) {
+        return;
+    }
+
+    S3ScanFilter filter;
+    filter.column = columnOfAttr[var->varattno];
+    filter.isInteger = true;
+    filter.intValue = 0;
+    filter.floatValue = 0;
+
+    if (isScanFilterNumberType(var->vartype) && isScanFilterNumberType(value->consttype)) {
+        filter.type = S3_FILTER_NUMBER;
+        switch (value->consttype) {
+            case INT2OID:
+                filter.intValue = DatumGetInt16(value->constvalue);
+                break;
+            case INT4OID:
+                filter.intValue = DatumGetInt32(value->constvalue);
+                break;
+            case INT8OID:
+                filter.intValue = DatumGetInt64(value->constvalue);
+                break;
+            case FLOAT4OID:
+                filter.isInteger = false;
+                filter.floatValue = DatumGetFloat4(value->constvalue);
+                break;
+            default:
+                filter.isInteger = false;
+                filter.floatValue = DatumGetFloat8(value->constvalue);
+                break;
+        }
+
+        // NaN sorts above every other value in PostgreSQL, but not in Parquet.
+        if (!filter.isInteger && isnan(filter.floatValue)) {
+            return;
+        }
+    } else if (var->vartype == DATEOID && value->consttype == DATEOID) {
+        DateADT date = DatumGetDateADT(value->constvalue);
+
+        if (DATE_NOT_FINITE(date)) {
+            return;
+        }
+        filter.type = S3_FILTER_DATE;
+        filter.intValue = (int64_t)date + (POSTGRES_EPOCH_JDATE - UNIX_EPOCH_JDATE);
+    } else {
+        return;
+    }
+
+    // The operator must be a btree comparison of the column's type, possibly
+    // cross-type within its operator family, like int4 < int8.
+    TypeCacheEntry *typentry = lookup_type_cache(var->vartype, TYPECACHE_BTREE_OPFAMILY);
+    if (!OidIsValid(typentry->btree_opf)) {
+        return;
+    }
+
+    switch (get_op_opfamily_strategy(opExpr->opno, typentry->btree_opf)) {
+        case BTLessStrategyNumber:
+            filter.op = commuted ? S3_FILTER_GT : S3_FILTER_LT;
+            break;
+        case BTLessEqualStrategyNumber:
+            filter.op = commuted ? S3_FILTER_GE : S3_FILTER_LE;
+            break;
+        case BTEqualStrategyNumber:
+            filter.op = S3_FILTER_EQ;
+            break;
+        case BTGreaterEqualStrategyNumber:
+            filter.op = commuted ? S3_FILTER_LE : S3_FILTER_GE;
+            break;
+        case BTGreaterStrategyNumber:
+            filter.op = commuted ? S3_FILTER_LT : S3_FILTER_GT;
+            break;
+        default:
+            return;
+    }
+
+    scanDesc.filters.push_back(filter);
+}
+
+/*
+ * Collect the columns of the external table, and from the select desc of the
+ * scan the columns it uses and the quals it evaluates. Readers that can skip
+ * data, like the one of Parquet files, use them to read less.
+ *
+ * The quals are known only when gp_external_enable_filter_pushdown is on. If
+ * it is off, the columns used by the quals are unknown, so all are needed.
+ */
+static void getScanDesc(FunctionCallInfo fcinfo, S3ScanDesc &scanDesc) {
+    Relation rel = EXTPROTOCOL_GET_RELATION(fcinfo);
+    ExternalSelectDesc desc = EXTPROTOCOL_GET_EXTERNAL_SELECT_DESC(fcinfo);
+    TupleDesc tupdesc = RelationGetDescr(rel);
+
+    // Dropped columns are not in the data, so attribute numbers and column
+    // indexes differ.
+    vector<int> columnOfAttr(tupdesc->natts + 1, -1);
+    for (int i = 0; i < tupdesc->natts; i++) {
+        Form_pg_attribute attr = TupleDescAttr(tupdesc, i);
+
+        if (!attr->attisdropped) {
+            columnOfAttr[attr->attnum] = scanDesc.columns.size();
+            scanDesc.columns.push_back(NameStr(attr->attname));
+        }
+    }
+
+    if (desc == NULL || !gp_external_enable_filter_pushdown) {
+        return;
+    }
+
+    ListCell *lc;
+
+    foreach (lc, desc->filter_quals) {
+        addScanFilter((Node *)lfirst(lc), columnOfAttr, scanDesc);
+    }
+
+    // Without a projection the scan returns the whole row.
+    if (desc->projInfo == NULL) {
+        return;
+    }
+
+    List *vars = list_concat(
+        pull_var_clause((Node *)desc->projInfo->pi_state.expr,
+                        PVC_RECURSE_AGGREGATES | PVC_RECURSE_WINDOWFUNCS | PVC_RECURSE_PLACEHOLDERS),
+        pull_var_clause((Node *)desc->filter_quals, PVC_RECURSE_AGGREGATES |
+                                                        PVC_RECURSE_WINDOWFUNCS |
+                                                        PVC_RECURSE_PLACEHOLDERS));
+
+    scanDesc.needed.assign(scanDesc.columns.size(), false);
+    foreach (lc, vars) {
+        Var *var = (Var *)lfirst(lc);
+
+        if (var->varattno == InvalidAttrNumber) {
+            // a whole-row reference
+            scanDesc.needed.clear();
+            break;
+        }
+        if (var->varattno > 0 && var->varattno < (AttrNumber)columnOfAttr.size() &&
+            columnOfAttr[var->varattno] >= 0) {
+            scanDesc.needed[columnOfAttr[var->varattno]] = true;
+        }
+    }
+    list_free(vars);
+}
+
 typedef struct gpcloudResHandle {
     GPReader *gpreader;
     GPWriter *gpwriter;
@@ -292,9 +488,12 @@ Datum s3_import(PG_FUNCTION_ARGS) {
         // has HEADER? and newline EOL?
         parseFormatOpts(fcinfo);
 
+        S3ScanDesc scanDesc;
+        getScanDesc(fcinfo, scanDesc);
+
         thread_setup();
 
-        resHandle->gpreader = reader_init(url_with_options);
+        resHandle->gpreader = reader_init(url_with_options, scanDesc);
         if (!resHandle->gpreader) {
             ereport(ERROR, errmsg("Failed to init gpcloud extension (segid = %d, "
 				  "segnum = %d), please check your "
@@ -67,7 +67,8 @@ void GPReader::open(const S3Params& params) {
     this->s3InterfaceService.setRESTfulService(this->restfulServicePtr);
     this->bucketReader.setS3InterfaceService(&this->s3InterfaceService);
     this->bucketReader.setUpstreamReader(&this->commonReader);
-    this->commonReader.setS3InterfaceService(&this->s3InterfaceService);
+    this->bucketReader.setPrefetchNextKey(true);
+    this->commonReader.setS3InterfaceService(this->bucketReader.getKeyPrefetcher());
     this->bucketReader.open(this->params);
 }
 
@@ -83,7 +84,7 @@ void GPReader::close() {
 }
 
 // invoked by s3_import(), need to be exception safe
-GPReader* reader_init(const char* url_with_options) {
+GPReader* reader_init(const char* url_with_options, const S3ScanDesc& scanDesc) {
     GPReader* reader = NULL;
     s3extErrorMessage.clear();
 
@@ -95,6 +96,7 @@ GPReader* reader_init(const char* url_with_options) {
         string urlWithOptions(url_with_options);
 
         S3Params params = InitConfig(urlWithOptions);
+        params.setScanDesc(scanDesc);
 
         InitRemoteLog();
 
@@ -0,0 +1,1649 @@
+#include "parquet_reader.h"
+
+#include <cmath>
+
+// Parquet files end with a 4-byte little-endian footer length and the magic.
+#define PARQUET_MAGIC "PAR1"
+#define PARQUET_MAGIC_LEN 4
+#define PARQUET_TRAILER_LEN 8
+
+// Bytes fetched to parse a page header; more only if it is longer.
+#define PARQUET_PAGE_HEADER_WINDOW (64 * 1024)
+
+// Pages are decoded whole. Writers keep them around 1MB, refuse anything
+// that would not fit in memory comfortably.
+#define PARQUET_MAX_PAGE_SIZE (256 * 1024 * 1024)
+
+// Smallest window of a column chunk fetched at once.
+#define PARQUET_MIN_FETCH_WINDOW (1024 * 1024)
+
+#define PARQUET_JULIAN_DAY_OF_EPOCH 2440588
+#define SECONDS_PER_DAY 86400
+
+// Field types of the Thrift compact protocol, in which Parquet metadata is encoded.
+enum ThriftCompactType {
+    THRIFT_STOP = 0,
+    THRIFT_TRUE = 1,
+    THRIFT_FALSE = 2,
+    THRIFT_BYTE = 3,
+    THRIFT_I16 = 4,
+    THRIFT_I32 = 5,
+    THRIFT_I64 = 6,
+    THRIFT_DOUBLE = 7,
+    THRIFT_BINARY = 8,
+    THRIFT_LIST = 9,
+    THRIFT_SET = 10,
+    THRIFT_MAP = 11,
+    THRIFT_STRUCT = 12
+};
+
+// Legacy converted types from parquet.thrift that affect how values are rendered.
+enum ParquetConvertedType {
+    PARQUET_CONVERTED_UTF8 = 0,
+    PARQUET_CONVERTED_ENUM = 4,
+    PARQUET_CONVERTED_DECIMAL = 5,
+    PARQUET_CONVERTED_DATE = 6,
+    PARQUET_CONVERTED_TIME_MILLIS = 7,
+    PARQUET_CONVERTED_TIME_MICROS = 8,
+    PARQUET_CONVERTED_TIMESTAMP_MILLIS = 9,
+    PARQUET_CONVERTED_TIMESTAMP_MICROS = 10,
+    PARQUET_CONVERTED_UINT_8 = 11,
+    PARQUET_CONVERTED_UINT_64 = 14,
+    PARQUET_CONVERTED_JSON = 19
+};
+
+// A minimal decoder of the Thrift compact protocol. Callers walk a struct
+// with nextField() and skip() whatever they are not interested in.
+class ThriftCompactReader {
+   public:
+    ThriftCompactReader(const uint8_t *data, uint64_t len)
+        : begin(data), pos(data), end(data + len), truncated(false) {
+    }
+
+    uint64_t consumed() const {
+        return this->pos - this->begin;
+    }
+
+    // Whether decoding failed because it ran past the end of the data.
+    bool isTruncated() const {
+        return this->truncated;
+    }
+
+    uint64_t readVarint() {
+        uint64_t result = 0;
+
+        for (int shift = 0; shift < 64; shift += 7) {
+            this->need(1);
+            uint8_t byte = *this->pos++;
+            result |= (uint64_t)(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return result;
+            }
+        }
+
+        S3_DIE(S3RuntimeError, "corrupted Parquet metadata: varint too long");
+    }
+
+    int64_t readI64() {
+        uint64_t v = this->readVarint();
+        return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+    }
+
+    int32_t readI32() {
+        return (int32_t)this->readI64();
+    }
+
+    string readBinary() {
+        uint64_t len = this->readVarint();
+        this->need(len);
+        string result((const char *)this->pos, len);
+        this->pos += len;
+        return result;
+    }
+
+    void beginStruct() {
+        this->lastFieldIds.push_back(0);
+    }
+
+    // Read the next field header of the current struct. Return false at the
+    // end of the struct. Boolean fields carry their value in the type.
+    bool nextField(int16_t &id, uint8_t &type) {
+        this->need(1);
+        uint8_t byte = *this->pos++;
+
+        type = byte & 0x0f;
+        if (type == THRIFT_STOP) {
+            this->lastFieldIds.pop_back();
+            return false;
+        }
+
+        uint8_t delta = byte >> 4;
+        id = delta ? this->lastFieldIds.back() + delta : (int16_t)this->readI64();
+        this->lastFieldIds.back() = id;
+        return true;
+    }
+
+    uint64_t readListHeader(uint8_t &elemType) {
+        this->need(1);
+        uint8_t byte = *this->pos++;
+
+        elemType = byte & 0x0f;
+        uint64_t size = byte >> 4;
+        return size == 15 ? this->readVarint() : size;
+    }
+
+    void skip(uint8_t type) {
+        switch (type) {
+            case THRIFT_TRUE:
+            case THRIFT_FALSE:
+                break;
+            case THRIFT_BYTE:
+                this->need(1);
+                this->pos++;
+                break;
+            case THRIFT_I16:
+            case THRIFT_I32:
+            case THRIFT_I64:
+                this->readVarint();
+                break;
+            case THRIFT_DOUBLE:
+                this->need(8);
+                this->pos += 8;
+                break;
+            case THRIFT_BINARY: {
+                uint64_t len = this->readVarint();
+                this->need(len);
+                this->pos += len;
+                break;
+            }
+            case THRIFT_LIST:
+            case THRIFT_SET: {
+                uint8_t elemType;
+                uint64_t size = this->readListHeader(elemType);
+                for (uint64_t i = 0; i < size; i++) {
+                    this->skipElement(elemType);
+                }
+                break;
+            }
+            case THRIFT_MAP: {
+                uint64_t size = this->readVarint();
+                if (size > 0) {
+                    this->need(1);
+                    uint8_t kvType = *this->pos++;
+                    for (uint64_t i = 0; i < size; i++) {
+                        this->skipElement(kvType >> 4);
+                        this->skipElement(kvType & 0x0f);
+                    }
+                }
+                break;
+            }
+            case THRIFT_STRUCT: {
+                int16_t id;
+                uint8_t fieldType;
+                this->beginStruct();
+                while (this->nextField(id, fieldType)) {
+                    this->skip(fieldType);
+                }
+                break;
+            }
+            default:
+                S3_DIE(S3RuntimeError, "corrupted Parquet metadata: unknown thrift type");
+        }
+    }
+
+   private:
+    // Booleans inside collections take a whole byte, unlike struct fields.
+    void skipElement(uint8_t type) {
+        if (type == THRIFT_TRUE || type == THRIFT_FALSE) {
+            this->need(1);
+            this->pos++;
+        } else {
+            this->skip(type);
+        }
+    }
+
+    void need(uint64_t len) {
+        if (len > (uint64_t)(this->end - this->pos)) {
+            this->truncated = true;
+            S3_DIE(S3RuntimeError, "corrupted Parquet metadata: unexpected end of data");
+        }
+    }
+
+    const uint8_t *begin;
+    const uint8_t *pos;
+    const uint8_t *end;
+    bool truncated;
+    vector<int16_t> lastFieldIds;
+};
+
+// Decoder of the RLE/bit-packing hybrid encoding used for definition levels,
+// dictionary indexes and RLE booleans.
+class RleBitPackedDecoder {
+   public:
+    RleBitPackedDecoder(const uint8_t *data, uint64_t len, int bitWidth)
+        : pos(data),
+          end(data + len),
+          bitWidth(bitWidth),
+          repeatCount(0),
+          repeatValue(0),
+          literalCount(0),
+          literalData(NULL),
+          literalBit(0) {
+        S3_CHECK_OR_DIE(bitWidth >= 0 && bitWidth <= 32, S3RuntimeError,
+                        "corrupted Parquet page: invalid bit width");
+    }
+
+    uint32_t next() {
+        while (this->repeatCount == 0 && this->literalCount == 0) {
+            this->readRunHeader();
+        }
+
+        if (this->repeatCount > 0) {
+            this->repeatCount--;
+            return this->repeatValue;
+        }
+
+        // Values of a bit-packed run are packed LSB first and span at most 5 bytes.
+        const uint8_t *from = this->literalData + (this->literalBit >> 3);
+        uint64_t shift = this->literalBit & 7;
+        uint64_t word = 0;
+
+        this->literalBit += this->bitWidth;
+        this->literalCount--;
+
+        if (this->bitWidth == 0) {
+            return 0;
+        }
+
+        S3_CHECK_OR_DIE(from < this->end, S3RuntimeError,
+                        "corrupted Parquet page: bit-packed run exhausted");
+        uint64_t avail = std::min((uint64_t)(this->end - from), (shift + this->bitWidth + 7) / 8);
+        for (uint64_t i = 0; i < avail; i++) {
+            word |= (uint64_t)from[i] << (8 * i);
+        }
+        return (uint32_t)((word >> shift) & ((1ULL << this->bitWidth) - 1));
+    }
+
+   private:
+    void readRunHeader() {
+        S3_CHECK_OR_DIE(this->pos < this->end, S3RuntimeError,
+                        "corrupted Parquet page: run-length data exhausted");
+
+        ThriftCompactReader varint(this->pos, this->end - this->pos);
+        uint64_t header = varint.readVarint();
+        this->pos += varint.consumed();
+
+        if (header & 1) {
+            uint64_t groups = header >> 1;
+            this->literalCount = groups * 8;
+            this->literalData = this->pos;
+            this->literalBit = 0;
+            this->pos += std::min(groups * this->bitWidth, (uint64_t)(this->end - this->pos));
+        } else {
+            uint64_t valueBytes = (this->bitWidth + 7) / 8;
+            S3_CHECK_OR_DIE(valueBytes <= (uint64_t)(this->end - this->pos), S3RuntimeError,
+                            "corrupted Parquet page: truncated run");
+            this->repeatCount = header >> 1;
+            this->repeatValue = 0;
+            for (uint64_t i = 0; i < valueBytes; i++) {
+                this->repeatValue |= (uint32_t)this->pos[i] << (8 * i);
+            }
+            this->pos += valueBytes;
+        }
+    }
+
+    const uint8_t *pos;
+    const uint8_t *end;
+    int bitWidth;
+
+    uint64_t repeatCount;
+    uint32_t repeatValue;
+
+    uint64_t literalCount;
+    const uint8_t *literalData;
+    uint64_t literalBit;
+};
+
+// Cursor over PLAIN encoded values.
+struct PlainCursor {
+    PlainCursor(const uint8_t *data, uint64_t len) : pos(data), end(data + len), bit(0) {
+    }
+
+    const uint8_t *take(uint64_t len) {
+        S3_CHECK_OR_DIE(len <= (uint64_t)(this->end - this->pos), S3RuntimeError,
+                        "corrupted Parquet page: values exhausted");
+        const uint8_t *result = this->pos;
+        this->pos += len;
+        return result;
+    }
+
+    const uint8_t *pos;
+    const uint8_t *end;
+    int bit;  // next bit of *pos, for bit-packed booleans
+};
+
+struct ParquetPageHeader {
+    ParquetPageHeader()
+        : type(-1),
+          uncompressedSize(0),
+          compressedSize(0),
+          numValues(0),
+          encoding(PARQUET_PLAIN),
+          defLevelsLength(0),
+          repLevelsLength(0),
+          isCompressed(true) {
+    }
+
+    int32_t type;
+    int32_t uncompressedSize;
+    int32_t compressedSize;
+    int32_t numValues;
+    int32_t encoding;
+
+    // data page v2 only
+    int32_t defLevelsLength;
+    int32_t repLevelsLength;
+    bool isCompressed;
+};
+
+static inline uint32_t readLE32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint64_t readLE64(const uint8_t *p) {
+    return (uint64_t)readLE32(p) | ((uint64_t)readLE32(p + 4) << 32);
+}
+
+static void parsePageHeader(ThriftCompactReader &reader, ParquetPageHeader &header) {
+    int16_t id;
+    uint8_t type;
+
+    reader.beginStruct();
+    while (reader.nextField(id, type)) {
+        if (id == 1 && type == THRIFT_I32) {
+            header.type = reader.readI32();
+        } else if (id == 2 && type == THRIFT_I32) {
+            header.uncompressedSize = reader.readI32();
+        } else if (id == 3 && type == THRIFT_I32) {
+            header.compressedSize = reader.readI32();
+        } else if ((id == 5 || id == 7 || id == 8) && type == THRIFT_STRUCT) {
+            // DataPageHeader, DictionaryPageHeader and DataPageHeaderV2 all
+            // start with num_values; the encoding is field 2 or 4.
+            int16_t subId;
+            uint8_t subType;
+            int16_t encodingId = (id == 8) ? 4 : 2;
+
+            reader.beginStruct();
+            while (reader.nextField(subId, subType)) {
+                if (subId == 1 && subType == THRIFT_I32) {
+                    header.numValues = reader.readI32();
+                } else if (subId == encodingId && subType == THRIFT_I32) {
+                    header.encoding = reader.readI32();
+                } else if (id == 8 && subId == 5 && subType == THRIFT_I32) {
+                    header.defLevelsLength = reader.readI32();
+                } else if (id == 8 && subId == 6 && subType == THRIFT_I32) {
+                    header.repLevelsLength = reader.readI32();
+                } else if (id == 8 && subId == 7 &&
+                           (subType == THRIFT_TRUE || subType == THRIFT_FALSE)) {
+                    header.isCompressed = (subType == THRIFT_TRUE);
+                } else {
+                    reader.skip(subType);
+                }
+            }
+        } else {
+            reader.skip(type);
+        }
+    }
+
+    S3_CHECK_OR_DIE(header.compressedSize >= 0 && header.uncompressedSize >= 0 &&
+                        header.numValues >= 0,
+                    S3RuntimeError, "corrupted Parquet page header");
+}
+
+// Decompress a raw snappy block; Parquet pages carry no snappy framing. The
+// length in the preamble of the block must be dstLen, the uncompressed size
+// from the page header, which has been checked against the maximum page size.
+static void snappyUncompress(const uint8_t *src, uint64_t srcLen, vector<uint8_t> &dst,
+                             uint64_t dstLen) {
+    ThriftCompactReader preamble(src, srcLen);
+    S3_CHECK_OR_DIE(preamble.readVarint() == dstLen, S3RuntimeError,
+                    "corrupted Parquet page: unexpected uncompressed size");
+    const uint8_t *p = src + preamble.consumed();
+    const uint8_t *end = src + srcLen;
+    uint64_t outPos = 0;
+
+    dst.resize(dstLen);
+
+    while (p < end) {
+        uint8_t tag = *p++;
+        uint64_t len;
+        uint64_t offset = 0;
+
+        if ((tag & 0x03) == 0) {
+            // literal
+            len = tag >> 2;
+            if (len >= 60) {
+                uint64_t lenBytes = len - 59;
+                S3_CHECK_OR_DIE(lenBytes <= (uint64_t)(end - p), S3RuntimeError,
+                                "corrupted snappy data");
+                len = 0;
+                for (uint64_t i = 0; i < lenBytes; i++) {
+                    len |= (uint64_t)p[i] << (8 * i);
+                }
+                p += lenBytes;
+            }
+            len += 1;
+
+            S3_CHECK_OR_DIE(len <= (uint64_t)(end - p) && len <= dstLen - outPos, S3RuntimeError,
+                            "corrupted snappy data");
+            memcpy(dst.data() + outPos, p, len);
+            p += len;
+            outPos += len;
+            continue;
+        }
+
+        switch (tag & 0x03) {
+            case 1:
+                S3_CHECK_OR_DIE(p < end, S3RuntimeError, "corrupted snappy data");
+                len = ((tag >> 2) & 0x07) + 4;
+                offset = ((uint64_t)(tag >> 5) << 8) | *p++;
+                break;
+            case 2:
+                S3_CHECK_OR_DIE(end - p >= 2, S3RuntimeError, "corrupted snappy data");
+                len = (tag >> 2) + 1;
+                offset = (uint64_t)p[0] | ((uint64_t)p[1] << 8);
+                p += 2;
+                break;
+            default:
+                S3_CHECK_OR_DIE(end - p >= 4, S3RuntimeError, "corrupted snappy data");
+                len = (tag >> 2) + 1;
+                offset = readLE32(p);
+                p += 4;
+                break;
+        }
+
+        S3_CHECK_OR_DIE(offset > 0 && offset <= outPos && len <= dstLen - outPos, S3RuntimeError,
+                        "corrupted snappy data");
+
+        // Copies may overlap their own output, so go byte by byte.
+        uint8_t *out = dst.data() + outPos;
+        const uint8_t *from = out - offset;
+        for (uint64_t i = 0; i < len; i++) {
+            out[i] = from[i];
+        }
+        outPos += len;
+    }
+
+    S3_CHECK_OR_DIE(outPos == dstLen, S3RuntimeError, "corrupted snappy data");
+}
+
+static void gzipUncompress(const uint8_t *src, uint64_t srcLen, vector<uint8_t> &dst,
+                           uint64_t dstLen) {
+    z_stream zstream;
+
+    memset(&zstream, 0, sizeof(zstream));
+    int ret = inflateInit2(&zstream, S3_INFLATE_WINDOWSBITS);
+    S3_CHECK_OR_DIE(ret == Z_OK, S3RuntimeError, "failed to initialize zlib library");
+
+    dst.resize(dstLen);
+    zstream.next_in = (Bytef *)src;
+    zstream.avail_in = srcLen;
+    zstream.next_out = (Bytef *)dst.data();
+    zstream.avail_out = dstLen;
+
+    ret = inflate(&zstream, Z_FINISH);
+    uint64_t produced = dstLen - zstream.avail_out;
+    inflateEnd(&zstream);
+
+    S3_CHECK_OR_DIE(ret == Z_STREAM_END && produced == dstLen, S3RuntimeError,
+                    "failed to decompress GZIP Parquet page");
+}
+
+// Return the page body uncompressed, either in place or in buf.
+static const uint8_t *uncompressPage(int32_t codec, const uint8_t *data, uint64_t len,
+                                     uint64_t uncompressedLen, vector<uint8_t> &buf) {
+    switch (codec) {
+        case PARQUET_UNCOMPRESSED:
+            return data;
+        case PARQUET_SNAPPY:
+            snappyUncompress(data, len, buf, uncompressedLen);
+            return buf.data();
+        case PARQUET_GZIP:
+            gzipUncompress(data, len, buf, uncompressedLen);
+            return buf.data();
+        default:
+            S3_DIE(S3RuntimeError,
+                   "unsupported Parquet compression codec " + std::to_string((long long)codec));
+    }
+}
+
+// Append a CSV field, quoting it if needed. The empty string must be quoted
+// to tell it apart from NULL, and a lone \. would read as end of data.
+static void appendCsvText(string &out, const char *s, uint64_t len) {
+    bool quote = (len == 0) || (len == 2 && s[0] == '\\' && s[1] == '.');
+
+    for (uint64_t i = 0; i < len && !quote; i++) {
+        char c = s[i];
+        quote = (c == ',' || c == '"' || c == '\n' || c == '\r');
+    }
+
+    if (!quote) {
+        out.append(s, len);
+        return;
+    }
+
+    out += '"';
+    for (uint64_t i = 0; i < len; i++) {
+        if (s[i] == '"') {
+            out += '"';
+        }
+        out += s[i];
+    }
+    out += '"';
+}
+
+static void appendUnsigned(string &out, uint64_t v) {
+    char buf[24];
+    char *p = buf + sizeof(buf);
+
+    do {
+        *--p = '0' + (v % 10);
+        v /= 10;
+    } while (v);
+
+    out.append(p, buf + sizeof(buf) - p);
+}
+
+static void appendSigned(string &out, int64_t v) {
+    if (v < 0) {
+        out += '-';
+        appendUnsigned(out, 0 - (uint64_t)v);
+    } else {
+        appendUnsigned(out, v);
+    }
+}
+
+static void appendDecimal(string &out, __int128 unscaled, int32_t scale) {
+    char buf[48];
+
+    S3_CHECK_OR_DIE(scale >= 0 && scale <= 38, S3RuntimeError,
+                    "unsupported Parquet DECIMAL scale " + std::to_string((long long)scale));
+
+    char *p = buf + sizeof(buf);
+    bool negative = unscaled < 0;
+    unsigned __int128 v = negative ? -(unsigned __int128)unscaled : (unsigned __int128)unscaled;
+    int digits = 0;
+
+    do {
+        *--p = '0' + (int)(v % 10);
+        v /= 10;
+        digits++;
+        if (digits == scale) {
+            *--p = '.';
+        }
+    } while (v || digits <= scale);
+
+    if (negative) {
+        *--p = '-';
+    }
+
+    out.append(p, buf + sizeof(buf) - p);
+}
+
+static void appendHex(string &out, const uint8_t *data, uint64_t len) {
+    static const char hex[] = "0123456789abcdef";
+
+    out += "\\x";
+    for (uint64_t i = 0; i < len; i++) {
+        out += hex[data[i] >> 4];
+        out += hex[data[i] & 0x0f];
+    }
+}
+
+static void appendFloat(string &out, double v, int precision) {
+    char buf[32];
+
+    if (std::isnan(v)) {
+        out += "NaN";
+    } else if (std::isinf(v)) {
+        out += (v > 0) ? "Infinity" : "-Infinity";
+    } else {
+        snprintf(buf, sizeof(buf), "%.*g", precision, v);
+        out += buf;
+    }
+}
+
+// Days since 1970-01-01 to a proleptic Gregorian date, in PostgreSQL's
+// input syntax; years before 1 are written with BC.
+static void appendDate(string &out, int64_t days, bool *bc) {
+    char buf[32];
+    int64_t z = days + 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    int64_t d = doy - (153 * mp + 2) / 5 + 1;
+    int64_t m = mp < 10 ? mp + 3 : mp - 9;
+    int64_t y = yoe + era * 400 + (m <= 2);
+
+    *bc = (y <= 0);
+    if (*bc) {
+        y = 1 - y;
+    }
+
+    snprintf(buf, sizeof(buf), "%04" PRId64 "-%02" PRId64 "-%02" PRId64, y, m, d);
+    out += buf;
+}
+
+// Time of day in the given units, with microsecond precision.
+static void appendTimeOfDay(string &out, int64_t units, int64_t unitsPerSecond) {
+    char buf[32];
+    int64_t seconds = units / unitsPerSecond;
+    int64_t micros = (units % unitsPerSecond) * 1000000 / unitsPerSecond;
+
+    snprintf(buf, sizeof(buf), "%02" PRId64 ":%02" PRId64 ":%02" PRId64, seconds / 3600,
+             seconds / 60 % 60, seconds % 60);
+    out += buf;
+
+    if (micros != 0) {
+        snprintf(buf, sizeof(buf), ".%06" PRId64, micros);
+        out += buf;
+    }
+}
+
+static void appendTimestamp(string &out, int64_t units, int64_t unitsPerSecond, bool utc) {
+    int64_t unitsPerDay = unitsPerSecond * SECONDS_PER_DAY;
+    int64_t days = units / unitsPerDay;
+    int64_t rest = units % unitsPerDay;
+    bool bc;
+
+    if (rest < 0) {
+        days--;
+        rest += unitsPerDay;
+    }
+
+    appendDate(out, days, &bc);
+    out += ' ';
+    appendTimeOfDay(out, rest, unitsPerSecond);
+
+    if (utc) {
+        out += "+00";
+    }
+    if (bc) {
+        out += " BC";
+    }
+}
+
+// Big-endian two's complement, as used by DECIMAL in byte arrays.
+static __int128 decodeBigEndianInteger(const uint8_t *data, uint64_t len) {
+    S3_CHECK_OR_DIE(len <= 16, S3RuntimeError, "Parquet DECIMAL wider than 128 bits");
+
+    __int128 v = (len > 0 && (data[0] & 0x80)) ? -1 : 0;
+    for (uint64_t i = 0; i < len; i++) {
+        v = (__int128)(((unsigned __int128)v << 8) | data[i]);
+    }
+    return v;
+}
+
+static void appendBinary(string &out, const ParquetColumn &column, const uint8_t *data,
+                         uint64_t len) {
+    switch (column.kind) {
+        case PARQUET_KIND_STRING:
+            appendCsvText(out, (const char *)data, len);
+            break;
+        case PARQUET_KIND_DECIMAL:
+            appendDecimal(out, decodeBigEndianInteger(data, len), column.scale);
+            break;
+        default:
+            appendHex(out, data, len);
+            break;
+    }
+}
+
+static void appendInteger(string &out, const ParquetColumn &column, int64_t v, bool is32) {
+    bool bc;
+
+    switch (column.kind) {
+        case PARQUET_KIND_UNSIGNED:
+            appendUnsigned(out, is32 ? (uint64_t)(uint32_t)v : (uint64_t)v);
+            break;
+        case PARQUET_KIND_DECIMAL:
+            appendDecimal(out, v, column.scale);
+            break;
+        case PARQUET_KIND_DATE:
+            appendDate(out, v, &bc);
+            if (bc) {
+                out += " BC";
+            }
+            break;
+        case PARQUET_KIND_TIME:
+            appendTimeOfDay(out, v, column.unitsPerSecond);
+            if (column.adjustedToUTC) {
+                out += "+00";
+            }
+            break;
+        case PARQUET_KIND_TIMESTAMP:
+            appendTimestamp(out, v, column.unitsPerSecond, column.adjustedToUTC);
+            break;
+        default:
+            appendSigned(out, v);
+            break;
+    }
+}
+
+// Decode one PLAIN value at the cursor and append its text.
+static void appendPlainValue(string &out, const ParquetColumn &column, PlainCursor &cursor) {
+    switch (column.type) {
+        case PARQUET_BOOLEAN: {
+            const uint8_t *byte = cursor.pos;
+            S3_CHECK_OR_DIE(byte < cursor.end, S3RuntimeError,
+                            "corrupted Parquet page: values exhausted");
+            out += ((*byte >> cursor.bit) & 1) ? 't' : 'f';
+            if (++cursor.bit == 8) {
+                cursor.bit = 0;
+                cursor.pos++;
+            }
+            break;
+        }
+        case PARQUET_INT32:
+            appendInteger(out, column, (int32_t)readLE32(cursor.take(4)), true);
+            break;
+        case PARQUET_INT64:
+            appendInteger(out, column, (int64_t)readLE64(cursor.take(8)), false);
+            break;
+        case PARQUET_INT96: {
+            // Legacy timestamp: nanoseconds of the day, then the Julian day.
+            const uint8_t *p = cursor.take(12);
+            int64_t nanos = (int64_t)readLE64(p);
+            int64_t days = (int64_t)(int32_t)readLE32(p + 8) - PARQUET_JULIAN_DAY_OF_EPOCH;
+            appendTimestamp(out, days * SECONDS_PER_DAY * 1000000 + nanos / 1000, 1000000, false);
+            break;
+        }
+        case PARQUET_FLOAT: {
+            uint32_t bits = readLE32(cursor.take(4));
+            float v;
+            memcpy(&v, &bits, sizeof(v));
+            appendFloat(out, v, 9);
+            break;
+        }
+        case PARQUET_DOUBLE: {
+            uint64_t bits = readLE64(cursor.take(8));
+            double v;
+            memcpy(&v, &bits, sizeof(v));
+            appendFloat(out, v, 17);
+            break;
+        }
+        case PARQUET_BYTE_ARRAY: {
+            uint32_t len = readLE32(cursor.take(4));
+            appendBinary(out, column, cursor.take(len), len);
+            break;
+        }
+        case PARQUET_FIXED_LEN_BYTE_ARRAY:
+            appendBinary(out, column, cursor.take(column.typeLength), column.typeLength);
+            break;
+        default:
+            S3_DIE(S3RuntimeError,
+                   "unsupported Parquet type " + std::to_string((long long)column.type));
+    }
+}
+
+// Set how a column is rendered from its LogicalType union.
+static void parseLogicalType(ThriftCompactReader &reader, ParquetColumn &column) {
+    int16_t id;
+    uint8_t type;
+
+    reader.beginStruct();
+    while (reader.nextField(id, type)) {
+        if (type != THRIFT_STRUCT) {
+            reader.skip(type);
+            continue;
+        }
+
+        int16_t subId;
+        uint8_t subType;
+        reader.beginStruct();
+
+        switch (id) {
+            case 1:   // STRING
+            case 4:   // ENUM
+            case 12:  // JSON
+                column.kind = PARQUET_KIND_STRING;
+                break;
+            case 5:  // DECIMAL
+                column.kind = PARQUET_KIND_DECIMAL;
+                break;
+            case 6:  // DATE
+                column.kind = PARQUET_KIND_DATE;
+                break;
+            case 7:  // TIME
+                column.kind = PARQUET_KIND_TIME;
+                break;
+            case 8:  // TIMESTAMP
+                column.kind = PARQUET_KIND_TIMESTAMP;
+                break;
+            default:
+                break;
+        }
+
+        while (reader.nextField(subId, subType)) {
+            if (id == 5 && subId == 1 && subType == THRIFT_I32) {
+                column.scale = reader.readI32();
+            } else if ((id == 7 || id == 8) && subId == 1 &&
+                       (subType == THRIFT_TRUE || subType == THRIFT_FALSE)) {
+                column.adjustedToUTC = (subType == THRIFT_TRUE);
+            } else if ((id == 7 || id == 8) && subId == 2 && subType == THRIFT_STRUCT) {
+                // TimeUnit union: MILLIS, MICROS or NANOS
+                int16_t unitId;
+                uint8_t unitType;
+                reader.beginStruct();
+                while (reader.nextField(unitId, unitType)) {
+                    column.unitsPerSecond = (unitId == 1) ? 1000 : (unitId == 2) ? 1000000
+                                                                                 : 1000000000;
+                    reader.skip(unitType);
+                }
+            } else if (id == 10 && subId == 2 &&
+                       (subType == THRIFT_TRUE || subType == THRIFT_FALSE)) {
+                // INTEGER: isSigned
+                column.kind = (subType == THRIFT_TRUE) ? PARQUET_KIND_DEFAULT : PARQUET_KIND_UNSIGNED;
+            } else {
+                reader.skip(subType);
+            }
+        }
+    }
+}
+
+// Map a legacy converted type; a logical type, if present, takes precedence.
+static void applyConvertedType(ParquetColumn &column, int32_t convertedType) {
+    switch (convertedType) {
+        case PARQUET_CONVERTED_UTF8:
+        case PARQUET_CONVERTED_ENUM:
+        case PARQUET_CONVERTED_JSON:
+            column.kind = PARQUET_KIND_STRING;
+            break;
+        case PARQUET_CONVERTED_DECIMAL:
+            column.kind = PARQUET_KIND_DECIMAL;
+            break;
+        case PARQUET_CONVERTED_DATE:
+            column.kind = PARQUET_KIND_DATE;
+            break;
+        case PARQUET_CONVERTED_TIME_MILLIS:
+        case PARQUET_CONVERTED_TIME_MICROS:
+            column.kind = PARQUET_KIND_TIME;
+            column.unitsPerSecond =
+                (convertedType == PARQUET_CONVERTED_TIME_MILLIS) ? 1000 : 1000000;
+            break;
+        case PARQUET_CONVERTED_TIMESTAMP_MILLIS:
+        case PARQUET_CONVERTED_TIMESTAMP_MICROS:
+            column.kind = PARQUET_KIND_TIMESTAMP;
+            column.unitsPerSecond =
+                (convertedType == PARQUET_CONVERTED_TIMESTAMP_MILLIS) ? 1000 : 1000000;
+            column.adjustedToUTC = true;
+            break;
+        default:
+            if (convertedType >= PARQUET_CONVERTED_UINT_8 &&
+                convertedType <= PARQUET_CONVERTED_UINT_64) {
+                column.kind = PARQUET_KIND_UNSIGNED;
+            }
+            break;
+    }
+}
+
+// Parse a SchemaElement. Return its number of children.
+static int32_t parseSchemaElement(ThriftCompactReader &reader, ParquetColumn &column) {
+    int16_t id;
+    uint8_t type;
+    int32_t numChildren = 0;
+    int32_t convertedType = -1;
+    bool hasLogicalType = false;
+    ParquetColumn logical;
+
+    reader.beginStruct();
+    while (reader.nextField(id, type)) {
+        if (id == 1 && type == THRIFT_I32) {
+            column.type = reader.readI32();
+        } else if (id == 2 && type == THRIFT_I32) {
+            column.typeLength = reader.readI32();
+        } else if (id == 3 && type == THRIFT_I32) {
+            int32_t repetition = reader.readI32();
+            S3_CHECK_OR_DIE(repetition != 2, S3RuntimeError,
+                            "repeated Parquet columns are not supported");
+            column.optional = (repetition == 1);
+        } else if (id == 4 && type == THRIFT_BINARY) {
+            column.name = reader.readBinary();
+        } else if (id == 5 && type == THRIFT_I32) {
+            numChildren = reader.readI32();
+        } else if (id == 6 && type == THRIFT_I32) {
+            convertedType = reader.readI32();
+        } else if (id == 7 && type == THRIFT_I32) {
+            column.scale = reader.readI32();
+        } else if (id == 10 && type == THRIFT_STRUCT) {
+            parseLogicalType(reader, logical);
+            hasLogicalType = true;
+        } else {
+            reader.skip(type);
+        }
+    }
+
+    if (hasLogicalType && logical.kind != PARQUET_KIND_DEFAULT) {
+        column.kind = logical.kind;
+        column.unitsPerSecond = logical.unitsPerSecond;
+        column.adjustedToUTC = logical.adjustedToUTC;
+        if (logical.kind == PARQUET_KIND_DECIMAL) {
+            column.scale = logical.scale;
+        }
+    } else if (!hasLogicalType) {
+        applyConvertedType(column, convertedType);
+    }
+
+    return numChildren;
+}
+
+// Fields 1 and 2 are the deprecated max and min, which writers ordered as
+// signed values. Prefer 5 and 6, which are ordered as the logical type says.
+static void parseStatistics(ThriftCompactReader &reader, ParquetColumnChunk &chunk) {
+    int16_t id;
+    uint8_t type;
+    bool hasMin = false, hasMax = false;
+    bool hasOldMin = false, hasOldMax = false;
+    string oldMin, oldMax;
+
+    reader.beginStruct();
+    while (reader.nextField(id, type)) {
+        if (id == 1 && type == THRIFT_BINARY) {
+            oldMax = reader.readBinary();
+            hasOldMax = true;
+        } else if (id == 2 && type == THRIFT_BINARY) {
+            oldMin = reader.readBinary();
+            hasOldMin = true;
+        } else if (id == 3 && type == THRIFT_I64) {
+            chunk.nullCount = reader.readI64();
+        } else if (id == 5 && type == THRIFT_BINARY) {
+            chunk.maxValue = reader.readBinary();
+            hasMax = true;
+        } else if (id == 6 && type == THRIFT_BINARY) {
+            chunk.minValue = reader.readBinary();
+            hasMin = true;
+        } else {
+            reader.skip(type);
+        }
+    }
+
+    if (hasMin && hasMax) {
+        chunk.hasMinMax = true;
+    } else if (hasOldMin && hasOldMax) {
+        chunk.minValue = oldMin;
+        chunk.maxValue = oldMax;
+        chunk.hasMinMax = true;
+    }
+}
+
+static void parseColumnMetaData(ThriftCompactReader &reader, ParquetColumnChunk &chunk) {
+    int16_t id;
+    uint8_t type;
+    int64_t dataPageOffset = -1;
+    int64_t dictionaryPageOffset = -1;
+    int64_t compressedSize = -1;
+
+    reader.beginStruct();
+    while (reader.nextField(id, type)) {
+        if (id == 4 && type == THRIFT_I32) {
+            chunk.codec = reader.readI32();
+        } else if (id == 5 && type == THRIFT_I64) {
+            chunk.numValues = reader.readI64();
+        } else if (id == 7 && type == THRIFT_I64) {
+            compressedSize = reader.readI64();
+        } else if (id == 9 && type == THRIFT_I64) {
+            dataPageOffset = reader.readI64();
+        } else if (id == 11 && type == THRIFT_I64) {
+            dictionaryPageOffset = reader.readI64();
+        } else if (id == 12 && type == THRIFT_STRUCT) {
+            parseStatistics(reader, chunk);
+        } else {
+            reader.skip(type);
+        }
+    }
+
+    S3_CHECK_OR_DIE(dataPageOffset >= 0 && compressedSize >= 0, S3RuntimeError,
+                    "corrupted Parquet metadata: column chunk without data pages");
+
+    // Some writers store 0 when there is no dictionary page.
+    if (dictionaryPageOffset > 0 && dictionaryPageOffset < dataPageOffset) {
+        chunk.offset = dictionaryPageOffset;
+    } else {
+        chunk.offset = dataPageOffset;
+    }
+    chunk.length = compressedSize;
+}
+
+static void parseRowGroup(ThriftCompactReader &reader, ParquetRowGroup &rowGroup) {
+    int16_t id;
+    uint8_t type;
+
+    rowGroup.numRows = 0;
+
+    reader.beginStruct();
+    while (reader.nextField(id, type)) {
+        if (id == 1 && type == THRIFT_LIST) {
+            uint8_t elemType;
+            uint64_t size = reader.readListHeader(elemType);
+
+            rowGroup.columns.resize(size);
+            for (uint64_t i = 0; i < size; i++) {
+                int16_t chunkId;
+                uint8_t chunkType;
+                bool hasMetaData = false;
+
+                reader.beginStruct();
+                while (reader.nextField(chunkId, chunkType)) {
+                    if (chunkId == 1 && chunkType == THRIFT_BINARY) {
+                        S3_DIE(S3RuntimeError,
+                               "Parquet column chunks in external files are not supported");
+                    } else if (chunkId == 3 && chunkType == THRIFT_STRUCT) {
+                        parseColumnMetaData(reader, rowGroup.columns[i]);
+                        hasMetaData = true;
+                    } else {
+                        reader.skip(chunkType);
+                    }
+                }
+
+                S3_CHECK_OR_DIE(hasMetaData, S3RuntimeError,
+                                "corrupted Parquet metadata: column chunk without metadata");
+            }
+        } else if (id == 3 && type == THRIFT_I64) {
+            rowGroup.numRows = reader.readI64();
+        } else {
+            reader.skip(type);
+        }
+    }
+}
+
+void ParquetReader::parseFileMetaData(const uint8_t *data, uint64_t len) {
+    ThriftCompactReader reader(data, len);
+    int16_t id;
+    uint8_t type;
+
+    this->schema.clear();
+    this->rowGroups.clear();
+
+    reader.beginStruct();
+    while (reader.nextField(id, type)) {
+        if (id == 2 && type == THRIFT_LIST) {
+            uint8_t elemType;
+            uint64_t size = reader.readListHeader(elemType);
+
+            S3_CHECK_OR_DIE(elemType == THRIFT_STRUCT, S3RuntimeError,
+                            "corrupted Parquet metadata: bad schema");
+
+            // The first element is the root; a flat schema has only leaves below it.
+            for (uint64_t i = 0; i < size; i++) {
+                ParquetColumn column;
+                int32_t numChildren = parseSchemaElement(reader, column);
+
+                if (i == 0) {
+                    continue;
+                }
+
+                S3_CHECK_OR_DIE(numChildren == 0, S3RuntimeError,
+                                "nested Parquet column '" + column.name + "' is not supported");
+                this->schema.push_back(column);
+            }
+        } else if (id == 4 && type == THRIFT_LIST) {
+            uint8_t elemType;
+            uint64_t size = reader.readListHeader(elemType);
+
+            this->rowGroups.resize(size);
+            for (uint64_t i = 0; i < size; i++) {
+                parseRowGroup(reader, this->rowGroups[i]);
+                S3_CHECK_OR_DIE(this->rowGroups[i].columns.size() == this->schema.size(),
+                                S3RuntimeError,
+                                "corrupted Parquet metadata: row group does not match schema");
+            }
+        } else {
+            reader.skip(type);
+        }
+    }
+}
+
+// Fetch len bytes of the file at offset into out. Responses are held in the
+// preallocated buffers of the memory context, which are chunksize bytes each
+// and only threadnum + 1 of them, so fetch at most chunksize bytes at a time
+// and copy them out, giving the buffer back before the next request.
+void ParquetReader::fetchRange(uint64_t offset, uint64_t len, vector<uint8_t> &out) {
+    uint64_t pieceSize = this->params.getChunkSize();
+
+    out.clear();
+    out.reserve(len);
+
+    while (out.size() < len) {
+        S3VectorUInt8 piece(this->params.getMemoryContext());
+        uint64_t pieceLen = std::min(pieceSize, len - out.size());
+
+        this->s3InterfaceService->fetchData(offset + out.size(), piece, pieceLen,
+                                            this->params.getS3Url());
+        S3_CHECK_OR_DIE(piece.size() == pieceLen, S3PartialResponseError, pieceLen, piece.size());
+        out.insert(out.end(), piece.begin(), piece.end());
+    }
+}
+
+void ParquetReader::readFileMetaData() {
+    uint64_t keySize = this->params.getKeySize();
+    const S3Url &s3Url = this->params.getS3Url();
+    vector<uint8_t> trailer;
+
+    S3_CHECK_OR_DIE(keySize >= PARQUET_MAGIC_LEN + PARQUET_TRAILER_LEN, S3RuntimeError,
+                    s3Url.getFullUrlForCurl() + " is too small to be a Parquet file");
+
+    this->fetchRange(keySize - PARQUET_TRAILER_LEN, PARQUET_TRAILER_LEN, trailer);
+    S3_CHECK_OR_DIE(memcmp(trailer.data() + 4, PARQUET_MAGIC, PARQUET_MAGIC_LEN) == 0,
+                    S3RuntimeError, s3Url.getFullUrlForCurl() + " is not a Parquet file");
+
+    uint64_t footerLen = readLE32(trailer.data());
+    S3_CHECK_OR_DIE(footerLen > 0 && footerLen <= keySize - PARQUET_MAGIC_LEN - PARQUET_TRAILER_LEN,
+                    S3RuntimeError, "corrupted Parquet footer in " + s3Url.getFullUrlForCurl());
+
+    vector<uint8_t> footer;
+    this->fetchRange(keySize - PARQUET_TRAILER_LEN - footerLen, footerLen, footer);
+    this->parseFileMetaData(footer.data(), footer.size());
+}
+
+// Decide which Parquet columns to read for the columns of the external table.
+// Without columns in the scan desc, as from gpcheckcloud, all columns are
+// read in file order.
+void ParquetReader::setProjection(const S3ScanDesc &scanDesc) {
+    const vector<string> &columns = scanDesc.columns;
+
+    this->readColumns.clear();
+    this->projection.clear();
+    this->filters.clear();
+
+    if (columns.empty()) {
+        for (size_t i = 0; i < this->schema.size(); i++) {
+            this->readColumns.push_back(i);
+            this->projection.push_back(i);
+        }
+        return;
+    }
+
+    // Match columns by name if all of them are in the file, else by position.
+    vector<size_t> columnToSchema(columns.size());
+    bool byName = true;
+    for (size_t i = 0; i < columns.size() && byName; i++) {
+        size_t j = 0;
+        while (j < this->schema.size() && this->schema[j].name != columns[i]) {
+            j++;
+        }
+        byName = (j < this->schema.size());
+        columnToSchema[i] = j;
+    }
+
+    if (!byName) {
+        S3_CHECK_OR_DIE(columns.size() == this->schema.size(), S3RuntimeError,
+                        "Parquet file " + this->params.getS3Url().getFullUrlForCurl() + " has " +
+                            std::to_string((unsigned long long)this->schema.size()) +
+                            " columns, but the external table has " +
+                            std::to_string((unsigned long long)columns.size()) +
+                            " and they don't match by name");
+        for (size_t i = 0; i < columns.size(); i++) {
+            columnToSchema[i] = i;
+        }
+    }
+
+    for (size_t i = 0; i < columns.size(); i++) {
+        if (!scanDesc.needed.empty() && !scanDesc.needed[i]) {
+            this->projection.push_back(-1);
+            continue;
+        }
+
+        this->projection.push_back(this->readColumns.size());
+        this->readColumns.push_back(columnToSchema[i]);
+    }
+
+    // Rows of a single empty cell would be empty lines, which are easily taken
+    // for no rows at all, so read the column after all.
+    if (this->projection.size() == 1 && this->readColumns.empty()) {
+        this->projection[0] = 0;
+        this->readColumns.push_back(columnToSchema[0]);
+    }
+
+    for (size_t i = 0; i < scanDesc.filters.size(); i++) {
+        S3ScanFilter filter = scanDesc.filters[i];
+
+        if (filter.column < columns.size()) {
+            filter.column = columnToSchema[filter.column];
+            this->filters.push_back(filter);
+        }
+    }
+}
+
+void ParquetReader::open(const S3Params &params) {
+    this->params = params;
+    this->rowGroupIndex = 0;
+    this->rowIndex = 0;
+    this->rowsInGroup = 0;
+    this->out.clear();
+    this->outOffset = 0;
+
+    S3_CHECK_OR_DIE(params.getChunkSize() > 0, S3RuntimeError,
+                    "chunk size must be greater than zero");
+
+    this->readFileMetaData();
+    this->setProjection(params.getScanDesc());
+    this->chunks.resize(this->readColumns.size());
+}
+
+// Return len bytes of the column chunk at the cursor's position. They are
+// served from the window of the chunk fetched last, or a new window is
+// fetched from there. The windows of all columns together take about
+// chunksize bytes, but each is at least PARQUET_MIN_FETCH_WINDOW and len.
+const uint8_t *ParquetReader::fetchChunkBytes(ParquetChunkCursor &cursor, uint64_t len) {
+    const ParquetColumnChunk &chunk = cursor.chunk;
+
+    S3_CHECK_OR_DIE(len <= chunk.length - cursor.pos, S3RuntimeError,
+                    "corrupted Parquet column chunk: page runs past the end of the chunk");
+
+    if (cursor.pos < cursor.rawOffset || cursor.pos + len > cursor.rawOffset + cursor.raw.size()) {
+        uint64_t window = std::max(this->params.getChunkSize() / this->chunks.size(),
+                                   (uint64_t)PARQUET_MIN_FETCH_WINDOW);
+        uint64_t size = std::min(std::max(len, window), chunk.length - cursor.pos);
+
+        this->fetchRange(chunk.offset + cursor.pos, size, cursor.raw);
+        cursor.rawOffset = cursor.pos;
+    }
+
+    return cursor.raw.data() + (cursor.pos - cursor.rawOffset);
+}
+
+// Parse the header of the page at the cursor's position and move past it.
+// Headers are short unless they carry long statistics, so start with a
+// small window and grow it only if the header doesn't fit.
+void ParquetReader::readPageHeader(ParquetChunkCursor &cursor, ParquetPageHeader &header) {
+    uint64_t remaining = cursor.chunk.length - cursor.pos;
+
+    for (uint64_t window = PARQUET_PAGE_HEADER_WINDOW;; window *= 2) {
+        uint64_t len = std::min(window, remaining);
+        ThriftCompactReader headerReader(this->fetchChunkBytes(cursor, len), len);
+
+        try {
+            header = ParquetPageHeader();
+            parsePageHeader(headerReader, header);
+        } catch (S3RuntimeError &e) {
+            if (headerReader.isTruncated() && len < remaining) {
+                continue;
+            }
+            throw;
+        }
+
+        cursor.pos += headerReader.consumed();
+        return;
+    }
+}
+
+// Decode the next data page of a column chunk into cursor.cells, replacing
+// the values of the previous one. Dictionary pages on the way are decoded
+// into cursor.dictionary. Only one page of a chunk is held at a time, so
+// memory use depends on the page size, not on the size of the row group.
+void ParquetReader::decodeNextPage(const ParquetColumn &column, ParquetChunkCursor &cursor) {
+    const ParquetColumnChunk &chunk = cursor.chunk;
+
+    cursor.firstRow = cursor.valuesRead;
+    cursor.cells.clear();
+
+    while (cursor.cells.ends.empty()) {
+        S3_CHECK_OR_DIE(cursor.valuesRead < chunk.numValues && cursor.pos < chunk.length,
+                        S3RuntimeError, "corrupted Parquet column chunk of '" + column.name + "'");
+
+        ParquetPageHeader header;
+        this->readPageHeader(cursor, header);
+
+        S3_CHECK_OR_DIE(header.compressedSize >= 0 && header.uncompressedSize >= 0,
+                        S3RuntimeError, "corrupted Parquet column chunk of '" + column.name + "'");
+        S3_CHECK_OR_DIE(
+            header.compressedSize <= PARQUET_MAX_PAGE_SIZE &&
+                header.uncompressedSize <= PARQUET_MAX_PAGE_SIZE,
+            S3RuntimeError,
+            "Parquet page of '" + column.name + "' is too large: " +
+                std::to_string((long long)std::max(header.compressedSize, header.uncompressedSize)) +
+                " bytes, the maximum is " + std::to_string((long long)PARQUET_MAX_PAGE_SIZE));
+
+        const uint8_t *page = this->fetchChunkBytes(cursor, header.compressedSize);
+        cursor.pos += header.compressedSize;
+
+        if (header.type == PARQUET_DICTIONARY_PAGE) {
+            S3_CHECK_OR_DIE(
+                header.encoding == PARQUET_PLAIN || header.encoding == PARQUET_PLAIN_DICTIONARY,
+                S3RuntimeError, "unsupported Parquet dictionary encoding");
+
+            const uint8_t *values = uncompressPage(chunk.codec, page, header.compressedSize,
+                                                   header.uncompressedSize, cursor.pageBuf);
+            PlainCursor plain(values, header.uncompressedSize);
+
+            cursor.dictionary.clear();
+            cursor.dictionary.ends.reserve(header.numValues);
+            for (int32_t i = 0; i < header.numValues; i++) {
+                appendPlainValue(cursor.dictionary.text, column, plain);
+                cursor.dictionary.ends.push_back(cursor.dictionary.text.size());
+            }
+            continue;
+        }
+
+        if (header.type != PARQUET_DATA_PAGE && header.type != PARQUET_DATA_PAGE_V2) {
+            continue;
+        }
+
+        // Locate the definition levels and the values of the page.
+        const uint8_t *levels;
+        uint64_t levelsLen;
+        const uint8_t *values;
+        uint64_t valuesLen;
+
+        if (header.type == PARQUET_DATA_PAGE) {
+            const uint8_t *body = uncompressPage(chunk.codec, page, header.compressedSize,
+                                                 header.uncompressedSize, cursor.pageBuf);
+            values = body;
+            valuesLen = header.uncompressedSize;
+            levels = body;
+            levelsLen = 0;
+
+            if (column.optional) {
+                S3_CHECK_OR_DIE(valuesLen >= 4, S3RuntimeError, "corrupted Parquet data page");
+                levelsLen = readLE32(body);
+                levels = body + 4;
+                S3_CHECK_OR_DIE(levelsLen <= valuesLen - 4, S3RuntimeError,
+                                "corrupted Parquet data page");
+                values = levels + levelsLen;
+                valuesLen -= 4 + levelsLen;
+            }
+        } else {
+            uint64_t levelsTotal = (uint64_t)header.defLevelsLength + header.repLevelsLength;
+            S3_CHECK_OR_DIE(header.defLevelsLength >= 0 && header.repLevelsLength >= 0 &&
+                                levelsTotal <= (uint64_t)header.compressedSize &&
+                                levelsTotal <= (uint64_t)header.uncompressedSize,
+                            S3RuntimeError, "corrupted Parquet data page");
+
+            // Levels of v2 pages are never compressed.
+            levels = page + header.repLevelsLength;
+            levelsLen = header.defLevelsLength;
+            valuesLen = header.uncompressedSize - levelsTotal;
+            values = uncompressPage(header.isCompressed ? chunk.codec : PARQUET_UNCOMPRESSED,
+                                    page + levelsTotal, header.compressedSize - levelsTotal,
+                                    valuesLen, cursor.pageBuf);
+        }
+
+        int32_t numValues = header.numValues;
+        S3_CHECK_OR_DIE(numValues >= 0 && cursor.valuesRead + numValues <= chunk.numValues,
+                        S3RuntimeError, "corrupted Parquet column chunk of '" + column.name + "'");
+
+        ParquetCells &cells = cursor.cells;
+        vector<uint8_t> &defLevels = cursor.defLevels;
+        cells.ends.reserve(numValues);
+
+        // A flat optional column has definition level 1 for non-null values.
+        int32_t nonNull = numValues;
+        defLevels.assign(numValues, 1);
+        if (column.optional) {
+            RleBitPackedDecoder levelDecoder(levels, levelsLen, 1);
+            nonNull = 0;
+            for (int32_t i = 0; i < numValues; i++) {
+                defLevels[i] = levelDecoder.next();
+                nonNull += defLevels[i];
+            }
+        }
+
+        switch (header.encoding) {
+            case PARQUET_PLAIN: {
+                PlainCursor plain(values, valuesLen);
+                for (int32_t i = 0; i < numValues; i++) {
+                    if (defLevels[i]) {
+                        appendPlainValue(cells.text, column, plain);
+                    }
+                    cells.ends.push_back(cells.text.size());
+                }
+                break;
+            }
+            case PARQUET_PLAIN_DICTIONARY:
+            case PARQUET_RLE_DICTIONARY: {
+                const ParquetCells &dictionary = cursor.dictionary;
+                S3_CHECK_OR_DIE(valuesLen >= 1 || nonNull == 0, S3RuntimeError,
+                                "corrupted Parquet data page");
+                RleBitPackedDecoder indexDecoder(values + 1, valuesLen ? valuesLen - 1 : 0,
+                                                 valuesLen ? values[0] : 0);
+                for (int32_t i = 0; i < numValues; i++) {
+                    if (defLevels[i]) {
+                        uint32_t index = indexDecoder.next();
+                        S3_CHECK_OR_DIE(index < dictionary.ends.size(), S3RuntimeError,
+                                        "corrupted Parquet data page: bad dictionary index");
+                        uint64_t from = index ? dictionary.ends[index - 1] : 0;
+                        cells.text.append(dictionary.text, from, dictionary.ends[index] - from);
+                    }
+                    cells.ends.push_back(cells.text.size());
+                }
+                break;
+            }
+            case PARQUET_RLE: {
+                S3_CHECK_OR_DIE(column.type == PARQUET_BOOLEAN && valuesLen >= 4, S3RuntimeError,
+                                "unsupported Parquet RLE encoding of '" + column.name + "'");
+                RleBitPackedDecoder boolDecoder(values + 4, valuesLen - 4, 1);
+                for (int32_t i = 0; i < numValues; i++) {
+                    if (defLevels[i]) {
+                        cells.text += boolDecoder.next() ? 't' : 'f';
+                    }
+                    cells.ends.push_back(cells.text.size());
+                }
+                break;
+            }
+            default:
+                S3_DIE(S3RuntimeError, "unsupported Parquet encoding " +
+                                           std::to_string((long long)header.encoding) + " of '" +
+                                           column.name + "'");
+        }
+
+        cursor.valuesRead += numValues;
+    }
+}
+
+// Decode a min or max statistic of a numeric or date column as a number,
+// returning false if the column is of another type.
+static bool decodeStatistic(const ParquetColumn &column, const string &value, bool &isInteger,
+                            int64_t &intValue, double &floatValue) {
+    const uint8_t *p = (const uint8_t *)value.data();
+
+    isInteger = true;
+    switch (column.type) {
+        case PARQUET_INT32:
+            if (value.size() != 4) return false;
+            intValue = (int32_t)readLE32(p);
+            return true;
+        case PARQUET_INT64:
+            if (value.size() != 8) return false;
+            intValue = (int64_t)readLE64(p);
+            return true;
+        case PARQUET_FLOAT: {
+            float f;
+            if (value.size() != sizeof(f)) return false;
+            memcpy(&f, p, sizeof(f));
+            isInteger = false;
+            floatValue = f;
+            return !std::isnan(floatValue);
+        }
+        case PARQUET_DOUBLE:
+            if (value.size() != sizeof(floatValue)) return false;
+            memcpy(&floatValue, p, sizeof(floatValue));
+            isInteger = false;
+            return !std::isnan(floatValue);
+        default:
+            return false;
+    }
+}
+
+// Compare a statistic with the value of a filter: negative, zero or positive.
+static int compareWithFilter(bool isInteger, int64_t intValue, double floatValue,
+                             const S3ScanFilter &filter) {
+    if (isInteger && filter.isInteger) {
+        return (intValue > filter.intValue) - (intValue < filter.intValue);
+    }
+
+    double a = isInteger ? (double)intValue : floatValue;
+    double b = filter.isInteger ? (double)filter.intValue : filter.floatValue;
+    return (a > b) - (a < b);
+}
+
+// Whether the statistics of a row group show that no row passes the filters.
+bool ParquetReader::canSkipRowGroup(const ParquetRowGroup &rowGroup) const {
+    for (size_t i = 0; i < this->filters.size(); i++) {
+        const S3ScanFilter &filter = this->filters[i];
+        const ParquetColumn &column = this->schema[filter.column];
+        const ParquetColumnChunk &chunk = rowGroup.columns[filter.column];
+
+        // No comparison with NULL is true.
+        if (chunk.nullCount == rowGroup.numRows) {
+            return true;
+        }
+
+        if (!chunk.hasMinMax) {
+            continue;
+        }
+
+        if (filter.type == S3_FILTER_DATE) {
+            if (column.kind != PARQUET_KIND_DATE || column.type != PARQUET_INT32) continue;
+        } else if (column.kind != PARQUET_KIND_DEFAULT) {
+            continue;
+        }
+
+        bool minIsInteger, maxIsInteger;
+        int64_t minInt, maxInt;
+        double minFloat, maxFloat;
+        if (!decodeStatistic(column, chunk.minValue, minIsInteger, minInt, minFloat) ||
+            !decodeStatistic(column, chunk.maxValue, maxIsInteger, maxInt, maxFloat)) {
+            continue;
+        }
+
+        int minCmp = compareWithFilter(minIsInteger, minInt, minFloat, filter);
+        int maxCmp = compareWithFilter(maxIsInteger, maxInt, maxFloat, filter);
+        bool skip = false;
+
+        switch (filter.op) {
+            case S3_FILTER_LT:
+                skip = (minCmp >= 0);
+                break;
+            case S3_FILTER_LE:
+                skip = (minCmp > 0);
+                break;
+            case S3_FILTER_EQ:
+                skip = (minCmp > 0 || maxCmp < 0);
+                break;
+            case S3_FILTER_GE:
+                skip = (maxCmp < 0);
+                break;
+            case S3_FILTER_GT:
+                skip = (maxCmp <= 0);
+                break;
+        }
+
+        if (skip) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ParquetReader::loadNextRowGroup() {
+    while (this->rowGroupIndex < this->rowGroups.size()) {
+        const ParquetRowGroup &rowGroup = this->rowGroups[this->rowGroupIndex++];
+
+        if (rowGroup.numRows == 0) {
+            continue;
+        }
+
+        if (this->canSkipRowGroup(rowGroup)) {
+            S3DEBUG("Skipped row group %zu of %s by its statistics", this->rowGroupIndex - 1,
+                    this->params.getS3Url().getFullUrlForCurl().c_str());
+            continue;
+        }
+
+        for (size_t i = 0; i < this->readColumns.size(); i++) {
+            const ParquetColumnChunk &chunk = rowGroup.columns[this->readColumns[i]];
+            const ParquetColumn &column = this->schema[this->readColumns[i]];
+
+            S3_CHECK_OR_DIE(chunk.numValues == rowGroup.numRows, S3RuntimeError,
+                            "corrupted Parquet metadata: '" + column.name +
+                                "' does not have a value for every row");
+            this->chunks[i].reset(chunk);
+        }
+
+        this->rowIndex = 0;
+        this->rowsInGroup = rowGroup.numRows;
+        return true;
+    }
+
+    return false;
+}
+
+// Render rows of the current row group into out, until there are at least
+// count bytes or the row group is exhausted. The pages of the columns don't
+// line up, so each column moves on to its next page when its rows run out.
+void ParquetReader::formatRows(uint64_t count) {
+    while (this->rowIndex < this->rowsInGroup && this->out.size() < count) {
+        for (size_t i = 0; i < this->projection.size(); i++) {
+            if (i > 0) {
+                this->out += ',';
+            }
+
+            if (this->projection[i] < 0) {
+                continue;
+            }
+
+            ParquetChunkCursor &cursor = this->chunks[this->projection[i]];
+
+            if (this->rowIndex >= cursor.firstRow + (int64_t)cursor.cells.ends.size()) {
+                this->decodeNextPage(this->schema[this->readColumns[this->projection[i]]], cursor);
+            }
+
+            const ParquetCells &column = cursor.cells;
+            int64_t row = this->rowIndex - cursor.firstRow;
+            uint64_t from = row ? column.ends[row - 1] : 0;
+
+            this->out.append(column.text, from, column.ends[row] - from);
+        }
+
+        this->out += '\n';
+        this->rowIndex++;
+    }
+}
+
+// read() attempts to read up to count bytes into the buffer.
+// Return 0 if EOF. Throw exception if encounters errors.
+uint64_t ParquetReader::read(char *buf, uint64_t count) {
+    while (this->outOffset == this->out.size()) {
+        this->out.clear();
+        this->outOffset = 0;
+
+        if (this->rowIndex == this->rowsInGroup && !this->loadNextRowGroup()) {
+            return 0;
+        }
+
+        this->formatRows(count);
+    }
+
+    uint64_t len = std::min(count, (uint64_t)(this->out.size() - this->outOffset));
+    memcpy(buf, this->out.data() + this->outOffset, len);
+    this->outOffset += len;
+
+    return len;
+}
+
+// This should be reentrant, has no side effects when called multiple times.
+void ParquetReader::close() {
+    this->schema.clear();
+    this->rowGroups.clear();
+    this->readColumns.clear();
+    this->projection.clear();
+    this->filters.clear();
+    this->chunks.clear();
+    this->rowGroupIndex = 0;
+    this->rowIndex = 0;
+    this->rowsInGroup = 0;
+    this->out.clear();
+    this->outOffset = 0;
+}
@@ -1,5 +1,96 @@
 #include "s3bucket_reader.h"
 
+static void* PrefetchThreadFunc(void* data) {
+    MaskThreadSignals();
+
+    S3KeyPrefetcher* prefetcher = static_cast<S3KeyPrefetcher*>(data);
+    prefetcher->fetchPending();
+
+    return NULL;
+}
+
+void S3KeyPrefetcher::prefetch(const S3Params& readerParams) {
+    S3_CHECK_OR_DIE(this->s3Interface != NULL, S3RuntimeError, "s3Interface is NULL");
+
+    this->join();
+
+    this->pendingParams = readerParams;
+    this->pending.clear();
+    this->pending.url = readerParams.getS3Url().getFullUrlForCurl();
+
+    if (pthread_create(&this->thread, NULL, PrefetchThreadFunc, this) != 0) {
+        this->thread = 0;
+        S3DEBUG("Failed to start prefetching %s", this->pending.url.c_str());
+    }
+}
+
+// Errors only mean the key is not prefetched, its reader fetches it again and
+// reports them.
+void S3KeyPrefetcher::fetchPending() {
+    const S3Url& s3Url = this->pendingParams.getS3Url();
+    uint64_t keySize = this->pendingParams.getKeySize();
+
+    try {
+        this->pending.compressionType = this->s3Interface->checkCompressionType(s3Url);
+
+        // Take the preallocated chunk only while the request is in flight, the
+        // downloading threads of the current key need theirs.
+        S3VectorUInt8 chunk(this->pendingParams.getMemoryContext());
+        uint64_t readLen = this->s3Interface->fetchData(0, chunk, keySize, s3Url);
+        if (readLen == keySize) {
+            this->pending.data.assign(chunk.begin(), chunk.end());
+            this->pending.ready = true;
+        }
+    } catch (...) {
+        S3DEBUG("Failed to prefetch %s", this->pending.url.c_str());
+        this->pending.ready = false;
+    }
+}
+
+void S3KeyPrefetcher::join() {
+    if (this->thread != 0) {
+        pthread_join(this->thread, NULL);
+        this->thread = 0;
+    }
+}
+
+void S3KeyPrefetcher::serve(const S3Url& s3Url) {
+    this->join();
+
+    this->served.clear();
+    if (this->pending.ready && this->pending.url == s3Url.getFullUrlForCurl()) {
+        std::swap(this->served, this->pending);
+        S3DEBUG("Reading prefetched key %s", this->served.url.c_str());
+    }
+    this->pending.clear();
+}
+
+void S3KeyPrefetcher::close() {
+    this->join();
+
+    this->pending.clear();
+    this->served.clear();
+}
+
+uint64_t S3KeyPrefetcher::fetchData(uint64_t offset, S3VectorUInt8& data, uint64_t len,
+                                    const S3Url& s3Url) {
+    if (this->isServing(s3Url) && offset + len <= this->served.data.size()) {
+        const uint8_t* begin = this->served.data.data() + offset;
+        data.assign(begin, begin + len);
+        return len;
+    }
+
+    return this->s3Interface->fetchData(offset, data, len, s3Url);
+}
+
+S3CompressionType S3KeyPrefetcher::checkCompressionType(const S3Url& s3Url) {
+    if (this->isServing(s3Url)) {
+        return this->served.compressionType;
+    }
+
+    return this->s3Interface->checkCompressionType(s3Url);
+}
+
 S3BucketReader::S3BucketReader() : Reader() {
     this->keyIndex = 0;  // doesn't matter, be set in open()
 
@@ -8,6 +99,8 @@ S3BucketReader::S3BucketReader() : Reader() {
 
     this->needNewReader = true;
     this->isFirstFile = true;
+
+    this->prefetchNextKey = false;
 }
 
 S3BucketReader::~S3BucketReader() {
@@ -103,10 +196,24 @@ uint64_t S3BucketReader::read(char* buf, uint64_t count) {
                 return 0;
             }
             BucketContent& key = this->getNextKey();
+            S3Params readerParams = constructReaderParams(key);
+
+            if (this->prefetchNextKey) {
+                this->keyPrefetcher.serve(readerParams.getS3Url());
+            }
 
-            this->upstreamReader->open(constructReaderParams(key));
+            this->upstreamReader->open(readerParams);
             this->needNewReader = false;
 
+            // Only keys that fit in a chunk are prefetched, larger ones are
+            // downloaded by several threads anyway.
+            if (this->prefetchNextKey && this->keyIndex < this->keyList.contents.size()) {
+                BucketContent& nextKey = this->keyList.contents[this->keyIndex];
+                if (nextKey.getSize() > 0 && nextKey.getSize() <= this->params.getChunkSize()) {
+                    this->keyPrefetcher.prefetch(constructReaderParams(nextKey));
+                }
+            }
+
             // ignore header line if it is not the first file
             if (hasHeader && !this->isFirstFile) {
                 readCount = readWithoutHeaderLine(buf, count);
@@ -134,6 +241,8 @@ void S3BucketReader::close() {
         this->upstreamReader = NULL;
     }
 
+    this->keyPrefetcher.close();
+
     if (!this->keyList.contents.empty()) {
         this->keyList.contents.clear();
     }
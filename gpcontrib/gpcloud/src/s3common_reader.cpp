@@ -14,6 +14,10 @@ void S3CommonReader::open(const S3Params &params) {
         case S3_COMPRESSION_PLAIN:
             this->upstreamReader = &this->keyReader;
             break;
+        case S3_COMPRESSION_PARQUET:
+            this->upstreamReader = &this->parquetReader;
+            this->parquetReader.setS3InterfaceService(s3InterfaceService);
+            break;
         default:
             S3_CHECK_OR_DIE(false, S3RuntimeError, "unknown file type");
     };
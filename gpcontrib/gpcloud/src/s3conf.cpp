@@ -125,6 +125,9 @@ S3Params InitConfig(const string& urlWithOptions) {
 
     params.setAutoCompress(s3Cfg.GetBool(configSection, "autocompress", "true"));
 
+    int64_t numOfCompressThreads = s3Cfg.SafeScan("compress_threadnum", configSection, 1, 1, 8);
+    params.setNumOfCompressThreads(numOfCompressThreads);
+
     params.setVerifyCert(s3Cfg.GetBool(configSection, "verifycert", "true"));
 
     string sse_type = s3Cfg.Get(configSection, "server_side_encryption", "");
@@ -370,6 +370,8 @@ S3CompressionType S3InterfaceService::checkCompressionType(const S3Url &s3Url) {
     string ext = s3Url.getExtension();
     if (ext == ".deflate") {
         return S3_COMPRESSION_DEFLATE;
+    } else if (ext == ".parquet") {
+        return S3_COMPRESSION_PARQUET;
     }
 
     HTTPHeaders headers;
@@ -400,6 +402,10 @@ S3CompressionType S3InterfaceService::checkCompressionType(const S3Url &s3Url) {
         if ((responseData[0] == 0x1f) && (responseData[1] == 0x8b)) {
             return S3_COMPRESSION_GZIP;
         }
+
+        if (memcmp(responseData.data(), "PAR1", S3_MAGIC_BYTES_NUM) == 0) {
+            return S3_COMPRESSION_PARQUET;
+        }
     } else if (resp.getStatus() == RESPONSE_ERROR) {
         S3MessageParser s3msg(resp);
         S3_DIE(S3LogicError, s3msg.getCode(), s3msg.getMessage());
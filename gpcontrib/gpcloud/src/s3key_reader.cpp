@@ -20,6 +20,38 @@ Range OffsetMgr::getNextOffset() {
     return ret;
 }
 
+// Start chunks at initialChunkSize, or at the size the previous key ended with,
+// and let reportFetch() grow them up to the chunk size set before.
+void OffsetMgr::setAdaptiveChunkSize(uint64_t initialChunkSize) {
+    pthread_mutex_lock(&this->offsetLock);
+    this->adaptive = true;
+    uint64_t startSize = this->learnedChunkSize ? this->learnedChunkSize : initialChunkSize;
+    this->chunkSize = std::min(startSize, this->maxChunkSize);
+    pthread_mutex_unlock(&this->offsetLock);
+}
+
+// Double the chunk size as long as a full chunk of the new size comes in
+// noticeably faster (in bytes per second) than one of the old size did, the
+// request latency is paid once per chunk. Once that stops, keep the size.
+void OffsetMgr::reportFetch(uint64_t length, double seconds) {
+    pthread_mutex_lock(&this->offsetLock);
+    if (this->adaptive && !this->chunkSizeSettled && length == this->chunkSize &&
+        this->chunkSize < this->maxChunkSize && seconds > 0) {
+        double throughput = length / seconds;
+
+        if (this->lastThroughput > 0 &&
+            throughput < this->lastThroughput * S3_THROUGHPUT_MIN_GAIN) {
+            this->chunkSizeSettled = true;
+            S3DEBUG("Chunk size settles at %" PRIu64, this->chunkSize);
+        } else {
+            this->lastThroughput = throughput;
+            this->chunkSize = std::min(this->chunkSize * 2, this->maxChunkSize);
+            S3DEBUG("Chunk size grows to %" PRIu64, this->chunkSize);
+        }
+    }
+    pthread_mutex_unlock(&this->offsetLock);
+}
+
 ChunkBuffer::ChunkBuffer(const S3Url& s3Url, S3KeyReader& reader, const S3MemoryContext& context)
     : s3Url(s3Url), chunkData(context), offsetMgr(reader.getOffsetMgr()), sharedKeyReader(reader) {
     s3Interface = NULL;
@@ -119,12 +151,16 @@ uint64_t ChunkBuffer::fill() {
 
     if (leftLen != 0) {
         try {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
             readLen = this->s3Interface->fetchData(offset, this->chunkData, leftLen, this->s3Url);
             if (readLen != leftLen) {
                 S3DEBUG("Failed to fetch expected data from S3");
                 this->setSharedError(true, S3PartialResponseError(leftLen, readLen));
             } else {
                 S3DEBUG("Got %" PRIu64 " bytes from S3", readLen);
+
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                this->offsetMgr.reportFetch(readLen, elapsed.count());
             }
         } catch (S3Exception& e) {
             S3DEBUG("Failed to fetch expected data from S3");
@@ -185,9 +221,10 @@ void S3KeyReader::open(const S3Params& params) {
     S3_CHECK_OR_DIE(this->s3Interface != NULL, S3RuntimeError, "s3Interface must not be NULL");
 
     this->sharedError = false;
+    this->params = params;
 
-    this->numOfChunks = params.getNumOfChunks();
-    S3_CHECK_OR_DIE(this->numOfChunks > 0, S3RuntimeError, "numOfChunks must not be zero");
+    this->maxNumOfChunks = params.getNumOfChunks();
+    S3_CHECK_OR_DIE(this->maxNumOfChunks > 0, S3RuntimeError, "numOfChunks must not be zero");
 
     this->offsetMgr.setKeySize(params.getKeySize());
     this->offsetMgr.setChunkSize(params.getChunkSize());
@@ -195,18 +232,68 @@ void S3KeyReader::open(const S3Params& params) {
     S3_CHECK_OR_DIE(params.getChunkSize() > 0, S3RuntimeError,
                     "chunk size must be greater than zero");
 
-    this->chunkBuffers.reserve(this->numOfChunks);
+    this->offsetMgr.setAdaptiveChunkSize(S3_INITIAL_CHUNK_SIZE);
+
+    // Don't start more downloading threads than the key has chunks, small keys
+    // would otherwise pay for idle threads on every key.
+    uint64_t chunkSize = this->offsetMgr.getChunkSize();
+    uint64_t keyChunks = (params.getKeySize() + chunkSize - 1) / chunkSize;
+    uint64_t startChunks = this->learnedNumOfChunks ? this->learnedNumOfChunks : 1;
+    startChunks = std::min(startChunks, this->maxNumOfChunks);
+    startChunks = std::max((uint64_t)1, std::min(startChunks, keyChunks));
 
-    for (uint64_t i = 0; i < this->numOfChunks; i++) {
-        this->chunkBuffers.emplace_back(params.getS3Url(), *this, params.getMemoryContext());
+    // Threads keep pointers to their buffers, so the vector must never
+    // reallocate while they run.
+    this->chunkBuffers.reserve(this->maxNumOfChunks);
+
+    for (uint64_t i = 0; i < startChunks; i++) {
+        this->addChunkBuffer();
     }
 
-    for (uint64_t i = 0; i < this->numOfChunks; i++) {
-        this->chunkBuffers[i].setS3InterfaceService(this->s3Interface);
+    this->roundStart = std::chrono::steady_clock::now();
+}
+
+void S3KeyReader::addChunkBuffer() {
+    this->chunkBuffers.emplace_back(this->params.getS3Url(), *this,
+                                    this->params.getMemoryContext());
 
-        pthread_t thread;
-        pthread_create(&thread, NULL, DownloadThreadFunc, &this->chunkBuffers[i]);
-        this->threads.push_back(thread);
+    ChunkBuffer& buffer = this->chunkBuffers.back();
+    buffer.setS3InterfaceService(this->s3Interface);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, DownloadThreadFunc, &buffer);
+    this->threads.push_back(thread);
+
+    this->numOfChunks = this->chunkBuffers.size();
+}
+
+// Called after each round over all buffers. Adds one more downloading thread
+// while every round brings noticeably more bytes per second than the previous
+// one, and stops growing for this key as soon as one does not.
+void S3KeyReader::adjustConcurrency() {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed = now - this->roundStart;
+    double throughput = elapsed.count() > 0 ? this->roundBytes / elapsed.count() : 0;
+
+    this->roundStart = now;
+    this->roundBytes = 0;
+
+    if (this->concurrencySettled) {
+        return;
+    }
+
+    if (this->lastRoundThroughput > 0 &&
+        throughput < this->lastRoundThroughput * S3_THROUGHPUT_MIN_GAIN) {
+        this->concurrencySettled = true;
+        S3DEBUG("Downloading threads settle at %" PRIu64, this->numOfChunks);
+        return;
+    }
+    this->lastRoundThroughput = throughput;
+
+    if (this->numOfChunks < this->maxNumOfChunks &&
+        this->offsetMgr.getCurPos() < this->offsetMgr.getKeySize()) {
+        this->addChunkBuffer();
+        S3DEBUG("Downloading threads grow to %" PRIu64, this->numOfChunks);
     }
 }
 
@@ -229,7 +316,7 @@ uint64_t S3KeyReader::read(char* buf, uint64_t count) {
             return 0;
         }
 
-        ChunkBuffer& buffer = chunkBuffers[this->curReadingChunk % this->numOfChunks];
+        ChunkBuffer& buffer = chunkBuffers[this->curBuffer];
 
         readLen = buffer.read(buf, count);
 
@@ -242,6 +329,7 @@ uint64_t S3KeyReader::read(char* buf, uint64_t count) {
         }
 
         this->transferredKeyLen += readLen;
+        this->roundBytes += readLen;
         if (this->transferredKeyLen == fileLen) {
             if (buf[readLen - 1] == '\r' || buf[readLen - 1] == '\n') {
                 this->hasEol = true;
@@ -250,6 +338,11 @@ uint64_t S3KeyReader::read(char* buf, uint64_t count) {
 
         if (readLen < count) {
             this->curReadingChunk++;
+
+            if (++this->curBuffer == this->numOfChunks) {
+                this->curBuffer = 0;
+                this->adjustConcurrency();
+            }
         }
 
         count -= readLen;
@@ -263,8 +356,19 @@ uint64_t S3KeyReader::read(char* buf, uint64_t count) {
 void S3KeyReader::reset() {
     this->sharedError = false;
     this->curReadingChunk = 0;
+    this->curBuffer = 0;
     this->transferredKeyLen = 0;
 
+    // Let the next key start with the threads this one found worthwhile. A
+    // key too small to ramp up tells nothing, so it only ever raises the count.
+    if (this->concurrencySettled || this->numOfChunks > this->learnedNumOfChunks) {
+        this->learnedNumOfChunks = this->numOfChunks;
+    }
+    this->numOfChunks = 0;
+    this->roundBytes = 0;
+    this->lastRoundThroughput = 0;
+    this->concurrencySettled = false;
+
     this->offsetMgr.reset();
 
     this->chunkBuffers.clear();
@@ -8,6 +8,9 @@ void S3KeyWriter::open(const S3Params& params) {
 
     buffer.reserve(this->params.getChunkSize());
 
+    this->totalBytes = 0;
+    this->startTime = std::chrono::steady_clock::now();
+
     this->uploadId = this->s3Interface->getUploadId(this->params.getS3Url());
     S3_CHECK_OR_DIE(!this->uploadId.empty(), S3RuntimeError, "Failed to get upload id");
 
@@ -136,6 +139,7 @@ void S3KeyWriter::flushBuffer() {
         pthread_t writerThread;
         ThreadParams* params = new ThreadParams();
         params->keyWriter = this;
+        this->totalBytes += this->buffer.size();
         params->data.swap(this->buffer);
         params->currentNumber = ++this->partNumber;
         pthread_create(&writerThread, NULL, UploadThreadFunc, params);
@@ -171,8 +175,13 @@ void S3KeyWriter::completeKeyWriting() {
         this->s3Interface->completeMultiPart(this->params.getS3Url(), this->uploadId, etags);
     }
 
-    S3DEBUG("Segment %d has finished uploading \"%s\"", s3ext_segid,
-            this->params.getS3Url().getFullUrlForCurl().c_str());
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - this->startTime).count();
+    S3DEBUG("Segment %d has finished uploading \"%s\": %" PRIu64 " bytes in %" PRIu64
+            " parts with %" PRIu64 " threads in %.3f seconds (%.2f MB/s)",
+            s3ext_segid, this->params.getS3Url().getFullUrlForCurl().c_str(), this->totalBytes,
+            this->partNumber, this->params.getNumOfChunks(), seconds,
+            seconds > 0 ? this->totalBytes / seconds / (1024 * 1024) : 0.0);
 
     this->buffer.clear();
     this->etagList.clear();
@@ -33,6 +33,9 @@ S3RESTfulService::S3RESTfulService(const S3Params &params)
 }
 
 S3RESTfulService::~S3RESTfulService() {
+    // Handles must go before the library is cleaned up.
+    this->handlePool.clear();
+
     // This function is not thread safe, must NOT call it when any other
     // threads are running, that is, do NOT put it in threads.
     curl_global_cleanup();
@@ -94,28 +97,63 @@ static size_t RESTfulServiceReadFuncCallback(char *ptr, size_t size, size_t nmem
     return copiedItemNum;
 }
 
+CURLHandlePool::~CURLHandlePool() {
+    this->clear();
+    pthread_mutex_destroy(&this->mutex);
+}
+
+void CURLHandlePool::clear() {
+    UniqueLock lock(&this->mutex);
+
+    for (size_t i = 0; i < this->idleHandles.size(); i++) {
+        curl_easy_cleanup(this->idleHandles[i]);
+    }
+    this->idleHandles.clear();
+}
+
+CURL *CURLHandlePool::acquire() {
+    {
+        UniqueLock lock(&this->mutex);
+        if (!this->idleHandles.empty()) {
+            CURL *curl = this->idleHandles.back();
+            this->idleHandles.pop_back();
+            return curl;
+        }
+    }
+
+    return curl_easy_init();
+}
+
+// Reset the options of the handle, but keep its connection and DNS caches.
+void CURLHandlePool::release(CURL *curl) {
+    curl_easy_reset(curl);
+
+    UniqueLock lock(&this->mutex);
+    this->idleHandles.push_back(curl);
+}
+
 struct CURLWrapper {
-    CURLWrapper(const string &url, curl_slist *headers, uint64_t lowSpeedLimit,
-                uint64_t lowSpeedTime, bool debugCurl, string proxy) {
-        curl = curl_easy_init();
+    CURLWrapper(S3RESTfulService &service, const string &url, curl_slist *headers)
+        : pool(service.handlePool) {
+        curl = pool.acquire();
         curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_FORBID_REUSE, 1L);
         curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
         curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, lowSpeedLimit);
-        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, lowSpeedTime);
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, service.lowSpeedLimit);
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, service.lowSpeedTime);
 
-        if (debugCurl) {
+        if (service.debugCurl) {
             curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
         }
 
-        if (!proxy.empty()) {
-            curl_easy_setopt(curl, CURLOPT_PROXY, proxy.c_str());
+        if (!service.proxy.empty()) {
+            curl_easy_setopt(curl, CURLOPT_PROXY, service.proxy.c_str());
         }
     }
     ~CURLWrapper() {
-        curl_easy_cleanup(curl);
+        pool.release(curl);
     }
+    CURLHandlePool &pool;
     CURL *curl;
 };
 
@@ -148,8 +186,7 @@ Response S3RESTfulService::get(const string &url, HTTPHeaders &headers) {
     response.getRawData().reserve(this->chunkBufferSize);
 
     headers.CreateList();
-    CURLWrapper wrapper(url, headers.GetList(), this->lowSpeedLimit, this->lowSpeedTime,
-                        this->debugCurl, this->proxy);
+    CURLWrapper wrapper(*this, url, headers.GetList());
     CURL *curl = wrapper.curl;
 
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&response);
@@ -181,8 +218,7 @@ Response S3RESTfulService::put(const string &url, HTTPHeaders &headers, const S3
     Response response(RESPONSE_ERROR);
 
     headers.CreateList();
-    CURLWrapper wrapper(url, headers.GetList(), this->lowSpeedLimit, this->lowSpeedTime,
-                        this->debugCurl, this->proxy);
+    CURLWrapper wrapper(*this, url, headers.GetList());
     CURL *curl = wrapper.curl;
 
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&response);
@@ -224,8 +260,7 @@ Response S3RESTfulService::post(const string &url, HTTPHeaders &headers,
     Response response(RESPONSE_ERROR);
 
     headers.CreateList();
-    CURLWrapper wrapper(url, headers.GetList(), this->lowSpeedLimit, this->lowSpeedTime,
-                        this->debugCurl, this->proxy);
+    CURLWrapper wrapper(*this, url, headers.GetList());
     CURL *curl = wrapper.curl;
 
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&response);
@@ -269,8 +304,7 @@ ResponseCode S3RESTfulService::head(const string &url, HTTPHeaders &headers) {
     Response response(RESPONSE_ERROR);
 
     headers.CreateList();
-    CURLWrapper wrapper(url, headers.GetList(), this->lowSpeedLimit, this->lowSpeedTime,
-                        this->debugCurl, this->proxy);
+    CURLWrapper wrapper(*this, url, headers.GetList());
     CURL *curl = wrapper.curl;
 
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "HEAD");
@@ -302,8 +336,7 @@ Response S3RESTfulService::deleteRequest(const string &url, HTTPHeaders &headers
     Response response(RESPONSE_ERROR);
 
     headers.CreateList();
-    CURLWrapper wrapper(url, headers.GetList(), this->lowSpeedLimit, this->lowSpeedTime,
-                        this->debugCurl, this->proxy);
+    CURLWrapper wrapper(*this, url, headers.GetList());
     CURL *curl = wrapper.curl;
 
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&response);
@@ -85,6 +85,38 @@ class CompressWriterTest : public testing::Test {
         inflateEnd(&zstream);
     }
 
+    // Inflate a series of gzip members, as written with several compression threads.
+    uint64_t uncompressMembers(Byte *input, uint64_t len, Byte *output, uint64_t out_len) {
+        z_stream zstream;
+
+        zstream.zalloc = Z_NULL;
+        zstream.zfree = Z_NULL;
+        zstream.opaque = Z_NULL;
+
+        int ret = inflateInit2(&zstream, S3_INFLATE_WINDOWSBITS);
+        S3_CHECK_OR_DIE(ret == Z_OK, S3RuntimeError, "failed to initialize zlib library");
+
+        zstream.avail_in = len;
+        zstream.next_in = input;
+        zstream.next_out = output;
+        zstream.avail_out = out_len;
+
+        int members = 0;
+        while ((ret = inflate(&zstream, Z_NO_FLUSH)) == Z_STREAM_END) {
+            members++;
+            if (zstream.avail_in == 0) {
+                break;
+            }
+            inflateReset(&zstream);
+        }
+
+        EXPECT_EQ(Z_STREAM_END, ret);
+
+        inflateEnd(&zstream);
+
+        return members;
+    }
+
     CompressWriter compressWriter;
     MockWriter writer;
 
@@ -210,3 +242,81 @@ TEST_F(CompressWriterTest, CompressCompressedData) {
 
     EXPECT_TRUE(memcmp(compressedData.data(), result.get(), compressedData.size()) == 0);
 }
+
+TEST_F(CompressWriterTest, ParallelCompressionKeepsOrderOfBlocks) {
+    S3Params params("s3://abc/def");
+    params.setNumOfCompressThreads(4);
+
+    compressWriter.close();
+    writer.getRawDataVector().clear();
+    compressWriter.open(params);
+
+    // 10 blocks and a bit, each line distinct so reordering would show
+    string input;
+    for (uint64_t i = 0; input.length() < S3_ZIP_COMPRESS_CHUNKSIZE * 10 + 100; i++) {
+        input.append(std::to_string((unsigned long long)i)).append(",quick brown fox\n");
+    }
+
+    // odd-sized writes so blocks are cut in the middle of them
+    for (uint64_t offset = 0; offset < input.length(); offset += 1000003) {
+        compressWriter.write(input.c_str() + offset,
+                             std::min((uint64_t)1000003, input.length() - offset));
+    }
+    compressWriter.close();
+
+    std::unique_ptr<Byte[]> result(new Byte[input.length() + 1]);
+    EXPECT_EQ((uint64_t)11, this->uncompressMembers((Byte *)writer.getRawData(),
+                                                    writer.getDataSize(), result.get(),
+                                                    input.length() + 1));
+
+    EXPECT_TRUE(memcmp(input.c_str(), result.get(), input.length()) == 0);
+}
+
+TEST_F(CompressWriterTest, ParallelCompressionReusesWorkerThreads) {
+    S3Params params("s3://abc/def");
+    params.setNumOfCompressThreads(2);
+
+    compressWriter.close();
+    writer.getRawDataVector().clear();
+    compressWriter.open(params);
+    EXPECT_EQ((uint64_t)2, compressWriter.getNumOfWorkers());
+
+    // many more blocks than workers
+    string line = "the quick brown fox jumps over the lazy dog\n";
+    string input;
+    while (input.length() < S3_ZIP_COMPRESS_CHUNKSIZE * 7) {
+        input.append(line);
+    }
+
+    compressWriter.write(input.c_str(), input.length());
+    EXPECT_EQ((uint64_t)2, compressWriter.getNumOfWorkers());
+
+    compressWriter.close();
+    EXPECT_EQ((uint64_t)0, compressWriter.getNumOfWorkers());
+
+    std::unique_ptr<Byte[]> result(new Byte[input.length() + 1]);
+    EXPECT_EQ((uint64_t)8, this->uncompressMembers((Byte *)writer.getRawData(),
+                                                   writer.getDataSize(), result.get(),
+                                                   input.length() + 1));
+    EXPECT_TRUE(memcmp(input.c_str(), result.get(), input.length()) == 0);
+}
+
+TEST_F(CompressWriterTest, ParallelCompressionOfEmptyData) {
+    S3Params params("s3://abc/def");
+    params.setNumOfCompressThreads(4);
+
+    compressWriter.close();
+    writer.getRawDataVector().clear();
+    compressWriter.open(params);
+    compressWriter.close();
+
+    // still a valid, empty gzip file
+    const char *header = writer.getRawData();
+    ASSERT_LT((size_t)2, writer.getDataSize());
+    ASSERT_TRUE(header[0] == char(0x1f));
+    ASSERT_TRUE(header[1] == char(0x8b));
+
+    Byte result[16];
+    EXPECT_EQ((uint64_t)1, this->uncompressMembers((Byte *)writer.getRawData(),
+                                                   writer.getDataSize(), result, sizeof(result)));
+}
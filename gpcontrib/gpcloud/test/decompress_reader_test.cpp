@@ -311,3 +311,25 @@ TEST_F(DecompressReaderTest, AbleToDecompressWithIncorrectEncodedStream) {
 
     EXPECT_THROW(decompressReader.read(outputBuffer, sizeof(outputBuffer)), S3RuntimeError);
 }
+
+TEST_F(DecompressReaderTest, AbleToDecompressConcatenatedMembers) {
+    // Parallel CompressWriter writes one stream per block, one after another.
+    const char first[] = "The quick brown fox ";
+    const char second[] = "jumps over the lazy dog";
+
+    uLong firstLen = sizeof(compressionBuff) / 2;
+    ASSERT_EQ(Z_OK, compress(compressionBuff, &firstLen, (const Bytef *)first, strlen(first)));
+    uLong secondLen = sizeof(compressionBuff) / 2;
+    ASSERT_EQ(Z_OK, compress(compressionBuff + firstLen, &secondLen, (const Bytef *)second,
+                             sizeof(second)));
+    bufReader.setData(compressionBuff, firstLen + secondLen);
+
+    char buf[10000];
+    uint64_t offset = 0, count;
+    while ((count = decompressReader.read(buf + offset, sizeof(buf) - offset)) > 0) {
+        offset += count;
+    }
+
+    EXPECT_EQ(strlen(first) + sizeof(second), offset);
+    EXPECT_STREQ("The quick brown fox jumps over the lazy dog", buf);
+}
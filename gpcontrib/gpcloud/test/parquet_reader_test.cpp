@@ -0,0 +1,383 @@
+#include "parquet_reader.cpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "mock_classes.h"
+
+using ::testing::_;
+using ::testing::Gt;
+using ::testing::Invoke;
+using ::testing::Le;
+
+// Written by pyarrow, snappy compressed and dictionary encoded:
+//   id int32 | name string | price decimal(9,2)
+//   1        | alice       | 1.50
+//   2        | NULL        | -0.05
+//   3        | b,"c"       | NULL
+static const uint8_t tinyParquet[] = {
+    0x50, 0x41, 0x52, 0x31, 0x15, 0x04, 0x15, 0x18, 0x15, 0x1c, 0x4c, 0x15,
+    0x06, 0x15, 0x00, 0x12, 0x00, 0x00, 0x0c, 0x2c, 0x01, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x15, 0x00, 0x15, 0x14,
+    0x15, 0x18, 0x2c, 0x15, 0x06, 0x15, 0x10, 0x15, 0x06, 0x15, 0x06, 0x1c,
+    0x00, 0x00, 0x00, 0x0a, 0x24, 0x02, 0x00, 0x00, 0x00, 0x06, 0x01, 0x02,
+    0x03, 0x24, 0x00, 0x15, 0x04, 0x15, 0x24, 0x15, 0x28, 0x4c, 0x15, 0x04,
+    0x15, 0x00, 0x12, 0x00, 0x00, 0x12, 0x44, 0x05, 0x00, 0x00, 0x00, 0x61,
+    0x6c, 0x69, 0x63, 0x65, 0x05, 0x00, 0x00, 0x00, 0x62, 0x2c, 0x22, 0x63,
+    0x22, 0x15, 0x00, 0x15, 0x12, 0x15, 0x16, 0x2c, 0x15, 0x06, 0x15, 0x10,
+    0x15, 0x06, 0x15, 0x06, 0x1c, 0x00, 0x00, 0x00, 0x09, 0x20, 0x02, 0x00,
+    0x00, 0x00, 0x03, 0x05, 0x01, 0x03, 0x02, 0x15, 0x04, 0x15, 0x10, 0x15,
+    0x14, 0x4c, 0x15, 0x04, 0x15, 0x00, 0x12, 0x00, 0x00, 0x08, 0x1c, 0x00,
+    0x00, 0x00, 0x96, 0xff, 0xff, 0xff, 0xfb, 0x15, 0x00, 0x15, 0x12, 0x15,
+    0x16, 0x2c, 0x15, 0x06, 0x15, 0x10, 0x15, 0x06, 0x15, 0x06, 0x1c, 0x00,
+    0x00, 0x00, 0x09, 0x20, 0x02, 0x00, 0x00, 0x00, 0x03, 0x03, 0x01, 0x03,
+    0x02, 0x15, 0x04, 0x19, 0x4c, 0x35, 0x00, 0x18, 0x06, 0x73, 0x63, 0x68,
+    0x65, 0x6d, 0x61, 0x15, 0x06, 0x00, 0x15, 0x02, 0x25, 0x02, 0x18, 0x02,
+    0x69, 0x64, 0x00, 0x15, 0x0c, 0x25, 0x02, 0x18, 0x04, 0x6e, 0x61, 0x6d,
+    0x65, 0x25, 0x00, 0x4c, 0x1c, 0x00, 0x00, 0x00, 0x15, 0x0e, 0x15, 0x08,
+    0x15, 0x02, 0x18, 0x05, 0x70, 0x72, 0x69, 0x63, 0x65, 0x25, 0x0a, 0x15,
+    0x04, 0x15, 0x12, 0x2c, 0x5c, 0x15, 0x04, 0x15, 0x12, 0x00, 0x00, 0x00,
+    0x16, 0x06, 0x19, 0x1c, 0x19, 0x3c, 0x26, 0x00, 0x1c, 0x15, 0x02, 0x19,
+    0x35, 0x00, 0x06, 0x10, 0x19, 0x18, 0x02, 0x69, 0x64, 0x15, 0x02, 0x16,
+    0x06, 0x16, 0x6e, 0x16, 0x76, 0x26, 0x40, 0x26, 0x08, 0x29, 0x2c, 0x15,
+    0x04, 0x15, 0x00, 0x15, 0x02, 0x00, 0x15, 0x00, 0x15, 0x10, 0x15, 0x02,
+    0x00, 0x3c, 0x29, 0x06, 0x19, 0x26, 0x00, 0x06, 0x00, 0x00, 0x00, 0x26,
+    0x00, 0x1c, 0x15, 0x0c, 0x19, 0x35, 0x00, 0x06, 0x10, 0x19, 0x18, 0x04,
+    0x6e, 0x61, 0x6d, 0x65, 0x15, 0x02, 0x16, 0x06, 0x16, 0x78, 0x16, 0x80,
+    0x01, 0x26, 0xc2, 0x01, 0x26, 0x7e, 0x29, 0x2c, 0x15, 0x04, 0x15, 0x00,
+    0x15, 0x02, 0x00, 0x15, 0x00, 0x15, 0x10, 0x15, 0x02, 0x00, 0x3c, 0x16,
+    0x14, 0x19, 0x06, 0x19, 0x26, 0x02, 0x04, 0x00, 0x00, 0x00, 0x26, 0x00,
+    0x1c, 0x15, 0x0e, 0x19, 0x35, 0x00, 0x06, 0x10, 0x19, 0x18, 0x05, 0x70,
+    0x72, 0x69, 0x63, 0x65, 0x15, 0x02, 0x16, 0x06, 0x16, 0x64, 0x16, 0x6c,
+    0x26, 0xae, 0x02, 0x26, 0xfe, 0x01, 0x29, 0x2c, 0x15, 0x04, 0x15, 0x00,
+    0x15, 0x02, 0x00, 0x15, 0x00, 0x15, 0x10, 0x15, 0x02, 0x00, 0x3c, 0x29,
+    0x06, 0x19, 0x26, 0x02, 0x04, 0x00, 0x00, 0x00, 0x16, 0xca, 0x02, 0x16,
+    0x06, 0x26, 0x08, 0x16, 0xe2, 0x02, 0x00, 0x28, 0x20, 0x70, 0x61, 0x72,
+    0x71, 0x75, 0x65, 0x74, 0x2d, 0x63, 0x70, 0x70, 0x2d, 0x61, 0x72, 0x72,
+    0x6f, 0x77, 0x20, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x32,
+    0x36, 0x2e, 0x30, 0x2e, 0x30, 0x19, 0x3c, 0x1c, 0x00, 0x00, 0x1c, 0x00,
+    0x00, 0x1c, 0x00, 0x00, 0x00, 0x30, 0x01, 0x00, 0x00, 0x50, 0x41, 0x52,
+    0x31,
+};
+
+// Written by pyarrow, uncompressed, PLAIN encoded, with statistics:
+//   id int32, rows 1 and 2 in the first row group, 3 and 4 in the second
+static const uint8_t statsParquet[] = {
+    0x50, 0x41, 0x52, 0x31, 0x15, 0x00, 0x15, 0x1c, 0x15, 0x1c, 0x2c, 0x15,
+    0x04, 0x15, 0x00, 0x15, 0x06, 0x15, 0x06, 0x1c, 0x18, 0x04, 0x02, 0x00,
+    0x00, 0x00, 0x18, 0x04, 0x01, 0x00, 0x00, 0x00, 0x16, 0x00, 0x28, 0x04,
+    0x02, 0x00, 0x00, 0x00, 0x18, 0x04, 0x01, 0x00, 0x00, 0x00, 0x11, 0x11,
+    0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x04, 0x01, 0x01, 0x00, 0x00,
+    0x00, 0x02, 0x00, 0x00, 0x00, 0x15, 0x00, 0x15, 0x1c, 0x15, 0x1c, 0x2c,
+    0x15, 0x04, 0x15, 0x00, 0x15, 0x06, 0x15, 0x06, 0x1c, 0x18, 0x04, 0x04,
+    0x00, 0x00, 0x00, 0x18, 0x04, 0x03, 0x00, 0x00, 0x00, 0x16, 0x00, 0x28,
+    0x04, 0x04, 0x00, 0x00, 0x00, 0x18, 0x04, 0x03, 0x00, 0x00, 0x00, 0x11,
+    0x11, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x04, 0x01, 0x03, 0x00,
+    0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x15, 0x04, 0x19, 0x2c, 0x35, 0x00,
+    0x18, 0x06, 0x73, 0x63, 0x68, 0x65, 0x6d, 0x61, 0x15, 0x02, 0x00, 0x15,
+    0x02, 0x25, 0x02, 0x18, 0x02, 0x69, 0x64, 0x00, 0x16, 0x08, 0x19, 0x2c,
+    0x19, 0x1c, 0x26, 0x00, 0x1c, 0x15, 0x02, 0x19, 0x25, 0x06, 0x00, 0x19,
+    0x18, 0x02, 0x69, 0x64, 0x15, 0x00, 0x16, 0x04, 0x16, 0x7a, 0x16, 0x7a,
+    0x26, 0x08, 0x3c, 0x18, 0x04, 0x02, 0x00, 0x00, 0x00, 0x18, 0x04, 0x01,
+    0x00, 0x00, 0x00, 0x16, 0x00, 0x28, 0x04, 0x02, 0x00, 0x00, 0x00, 0x18,
+    0x04, 0x01, 0x00, 0x00, 0x00, 0x11, 0x11, 0x00, 0x19, 0x1c, 0x15, 0x00,
+    0x15, 0x00, 0x15, 0x02, 0x00, 0x3c, 0x29, 0x06, 0x19, 0x26, 0x00, 0x04,
+    0x00, 0x00, 0x00, 0x16, 0x7a, 0x16, 0x04, 0x26, 0x08, 0x16, 0x7a, 0x00,
+    0x19, 0x1c, 0x26, 0x00, 0x1c, 0x15, 0x02, 0x19, 0x25, 0x06, 0x00, 0x19,
+    0x18, 0x02, 0x69, 0x64, 0x15, 0x00, 0x16, 0x04, 0x16, 0x7a, 0x16, 0x7a,
+    0x26, 0x82, 0x01, 0x3c, 0x18, 0x04, 0x04, 0x00, 0x00, 0x00, 0x18, 0x04,
+    0x03, 0x00, 0x00, 0x00, 0x16, 0x00, 0x28, 0x04, 0x04, 0x00, 0x00, 0x00,
+    0x18, 0x04, 0x03, 0x00, 0x00, 0x00, 0x11, 0x11, 0x00, 0x19, 0x1c, 0x15,
+    0x00, 0x15, 0x00, 0x15, 0x02, 0x00, 0x3c, 0x29, 0x06, 0x19, 0x26, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x16, 0x7a, 0x16, 0x04, 0x26, 0x82, 0x01, 0x16,
+    0x7a, 0x00, 0x28, 0x20, 0x70, 0x61, 0x72, 0x71, 0x75, 0x65, 0x74, 0x2d,
+    0x63, 0x70, 0x70, 0x2d, 0x61, 0x72, 0x72, 0x6f, 0x77, 0x20, 0x76, 0x65,
+    0x72, 0x73, 0x69, 0x6f, 0x6e, 0x20, 0x32, 0x36, 0x2e, 0x30, 0x2e, 0x30,
+    0x19, 0x1c, 0x1c, 0x00, 0x00, 0x00, 0xf0, 0x00, 0x00, 0x00, 0x50, 0x41,
+    0x52, 0x31,
+};
+
+class MockS3InterfaceForParquetRead : public MockS3Interface {
+   public:
+    MockS3InterfaceForParquetRead(const uint8_t *file, uint64_t len) : file(file), len(len) {
+    }
+
+    uint64_t mockFetchData(uint64_t offset, S3VectorUInt8 &data, uint64_t count,
+                           const S3Url &s3Url) {
+        EXPECT_LE(offset + count, this->len);
+        data.assign(this->file + offset, this->file + offset + count);
+        return count;
+    }
+
+   private:
+    const uint8_t *file;
+    uint64_t len;
+};
+
+class ParquetReaderTest : public testing::Test, public ParquetReader {
+   protected:
+    ParquetReaderTest()
+        : mockS3Interface(tinyParquet, sizeof(tinyParquet)),
+          testParams("https://s3-us-west-2.amazonaws.com/bucket/tiny.parquet") {
+    }
+
+    // Remember that SetUp() is run immediately before a test starts.
+    virtual void SetUp() {
+        this->setS3InterfaceService(&mockS3Interface);
+        ON_CALL(mockS3Interface, fetchData(_, _, _, _))
+            .WillByDefault(Invoke(&mockS3Interface, &MockS3InterfaceForParquetRead::mockFetchData));
+
+        testParams.setKeySize(sizeof(tinyParquet));
+        testParams.setChunkSize(8 * 1024 * 1024);
+    }
+
+    // TearDown() is invoked immediately after a test finishes.
+    virtual void TearDown() {
+        this->close();
+    }
+
+    string readAll(uint64_t bufSize) {
+        string result;
+        char buf[1024];
+        uint64_t count;
+
+        while ((count = this->read(buf, bufSize)) > 0) {
+            result.append(buf, count);
+        }
+        return result;
+    }
+
+    void setScanColumns(const string &c1, const string &c2, const string &c3) {
+        S3ScanDesc scanDesc = testParams.getScanDesc();
+        scanDesc.columns.clear();
+        scanDesc.columns.push_back(c1);
+        scanDesc.columns.push_back(c2);
+        if (!c3.empty()) {
+            scanDesc.columns.push_back(c3);
+        }
+        testParams.setScanDesc(scanDesc);
+    }
+
+    void addScanFilter(size_t column, S3ScanFilterOp op, int64_t value) {
+        S3ScanDesc scanDesc = testParams.getScanDesc();
+        S3ScanFilter filter;
+
+        filter.column = column;
+        filter.op = op;
+        filter.type = S3_FILTER_NUMBER;
+        filter.isInteger = true;
+        filter.intValue = value;
+        filter.floatValue = 0;
+        scanDesc.filters.push_back(filter);
+        testParams.setScanDesc(scanDesc);
+    }
+
+    MockS3InterfaceForParquetRead mockS3Interface;
+    S3Params testParams;
+};
+
+TEST_F(ParquetReaderTest, ReadSchema) {
+    // footer trailer, then footer
+    EXPECT_CALL(mockS3Interface, fetchData(_, _, _, _)).Times(2);
+    this->open(testParams);
+
+    ASSERT_EQ(3, this->schema.size());
+    EXPECT_EQ("id", this->schema[0].name);
+    EXPECT_EQ(PARQUET_INT32, this->schema[0].type);
+    EXPECT_EQ(PARQUET_KIND_STRING, this->schema[1].kind);
+    EXPECT_TRUE(this->schema[1].optional);
+    EXPECT_EQ(PARQUET_KIND_DECIMAL, this->schema[2].kind);
+    EXPECT_EQ(2, this->schema[2].scale);
+    ASSERT_EQ(1, this->rowGroups.size());
+    EXPECT_EQ(3, this->rowGroups[0].numRows);
+}
+
+TEST_F(ParquetReaderTest, ReadAllColumns) {
+    // footer, plus one ranged GET per column chunk
+    EXPECT_CALL(mockS3Interface, fetchData(_, _, _, _)).Times(5);
+    this->open(testParams);
+
+    EXPECT_EQ("1,alice,1.50\n2,,-0.05\n3,\"b,\"\"c\"\"\",\n", this->readAll(1024));
+    EXPECT_EQ(0, this->read(NULL, 1024));
+}
+
+TEST_F(ParquetReaderTest, ReadWithSmallBuffer) {
+    this->open(testParams);
+
+    EXPECT_EQ("1,alice,1.50\n2,,-0.05\n3,\"b,\"\"c\"\"\",\n", this->readAll(5));
+}
+
+TEST_F(ParquetReaderTest, FetchAtMostChunkSize) {
+    // the footer and the chunks are longer than that, so they take several GETs
+    EXPECT_CALL(mockS3Interface, fetchData(_, _, Gt(16), _)).Times(0);
+    EXPECT_CALL(mockS3Interface, fetchData(_, _, Le(16), _)).Times(testing::AtLeast(10));
+    testParams.setChunkSize(16);
+    this->open(testParams);
+
+    EXPECT_EQ("1,alice,1.50\n2,,-0.05\n3,\"b,\"\"c\"\"\",\n", this->readAll(1024));
+}
+
+TEST_F(ParquetReaderTest, MatchColumnsByName) {
+    // only the chunks of the columns of the table are fetched
+    EXPECT_CALL(mockS3Interface, fetchData(_, _, _, _)).Times(4);
+    setScanColumns("price", "id", "");
+    this->open(testParams);
+
+    EXPECT_EQ("1.50,1\n-0.05,2\n,3\n", this->readAll(1024));
+}
+
+TEST_F(ParquetReaderTest, MatchColumnsByPosition) {
+    setScanColumns("a", "b", "c");
+    this->open(testParams);
+
+    EXPECT_EQ("1,alice,1.50\n2,,-0.05\n3,\"b,\"\"c\"\"\",\n", this->readAll(1024));
+}
+
+TEST_F(ParquetReaderTest, ColumnsDoNotMatch) {
+    setScanColumns("id", "nosuchcolumn", "");
+
+    EXPECT_THROW(this->open(testParams), S3RuntimeError);
+}
+
+TEST_F(ParquetReaderTest, ReadOnlyNeededColumns) {
+    // the chunk of name is not fetched, and its cells are NULL
+    EXPECT_CALL(mockS3Interface, fetchData(_, _, _, _)).Times(4);
+    setScanColumns("id", "name", "price");
+    S3ScanDesc scanDesc = testParams.getScanDesc();
+    scanDesc.needed.push_back(true);
+    scanDesc.needed.push_back(false);
+    scanDesc.needed.push_back(true);
+    testParams.setScanDesc(scanDesc);
+    this->open(testParams);
+
+    EXPECT_EQ("1,,1.50\n2,,-0.05\n3,,\n", this->readAll(1024));
+}
+
+TEST_F(ParquetReaderTest, SkipRowGroupByStatistics) {
+    // footer, plus the chunk of the second row group only
+    MockS3InterfaceForParquetRead statsFile(statsParquet, sizeof(statsParquet));
+    EXPECT_CALL(statsFile, fetchData(_, _, _, _))
+        .Times(3)
+        .WillRepeatedly(Invoke(&statsFile, &MockS3InterfaceForParquetRead::mockFetchData));
+    this->setS3InterfaceService(&statsFile);
+    testParams.setKeySize(sizeof(statsParquet));
+
+    S3ScanDesc scanDesc;
+    scanDesc.columns.push_back("id");
+    testParams.setScanDesc(scanDesc);
+    addScanFilter(0, S3_FILTER_GT, 2);
+    this->open(testParams);
+
+    ASSERT_EQ(2, this->rowGroups.size());
+    EXPECT_TRUE(this->rowGroups[0].columns[0].hasMinMax);
+    EXPECT_EQ("3\n4\n", this->readAll(1024));
+}
+
+TEST_F(ParquetReaderTest, CompareFiltersWithStatistics) {
+    MockS3InterfaceForParquetRead statsFile(statsParquet, sizeof(statsParquet));
+    ON_CALL(statsFile, fetchData(_, _, _, _))
+        .WillByDefault(Invoke(&statsFile, &MockS3InterfaceForParquetRead::mockFetchData));
+    this->setS3InterfaceService(&statsFile);
+    testParams.setKeySize(sizeof(statsParquet));
+    this->open(testParams);
+
+    // the first row group has id 1 and 2
+    const ParquetRowGroup &rowGroup = this->rowGroups[0];
+    struct {
+        S3ScanFilterOp op;
+        int64_t value;
+        bool skip;
+    } cases[] = {
+        {S3_FILTER_LT, 1, true},  {S3_FILTER_LT, 2, false}, {S3_FILTER_LE, 0, true},
+        {S3_FILTER_LE, 1, false}, {S3_FILTER_EQ, 0, true},  {S3_FILTER_EQ, 2, false},
+        {S3_FILTER_EQ, 3, true},  {S3_FILTER_GE, 2, false}, {S3_FILTER_GE, 3, true},
+        {S3_FILTER_GT, 1, false}, {S3_FILTER_GT, 2, true},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        S3ScanFilter filter;
+        filter.column = 0;
+        filter.op = cases[i].op;
+        filter.type = S3_FILTER_NUMBER;
+        filter.isInteger = true;
+        filter.intValue = cases[i].value;
+        filter.floatValue = 0;
+
+        this->filters.assign(1, filter);
+        EXPECT_EQ(cases[i].skip, this->canSkipRowGroup(rowGroup)) << "case " << i;
+
+        // the same as a floating point value
+        this->filters[0].isInteger = false;
+        this->filters[0].floatValue = cases[i].value;
+        EXPECT_EQ(cases[i].skip, this->canSkipRowGroup(rowGroup)) << "case " << i;
+    }
+
+    // dates never match an integer column
+    this->filters[0].type = S3_FILTER_DATE;
+    this->filters[0].isInteger = true;
+    this->filters[0].intValue = 100;
+    EXPECT_FALSE(this->canSkipRowGroup(rowGroup));
+}
+
+TEST_F(ParquetReaderTest, NotParquetFile) {
+    static const uint8_t notParquet[] = "a,b,c\n1,2,3\n4,5,6\n";
+    MockS3InterfaceForParquetRead textFile(notParquet, sizeof(notParquet) - 1);
+
+    ON_CALL(textFile, fetchData(_, _, _, _))
+        .WillByDefault(Invoke(&textFile, &MockS3InterfaceForParquetRead::mockFetchData));
+    this->setS3InterfaceService(&textFile);
+    testParams.setKeySize(sizeof(notParquet) - 1);
+
+    EXPECT_THROW(this->open(testParams), S3RuntimeError);
+}
+
+TEST(ParquetSnappy, UncompressLiteralAndCopy) {
+    // "abcd" as a literal, then a 1-byte-offset copy of 8 bytes at offset 4
+    const uint8_t compressed[] = {0x0c, 0x0c, 'a', 'b', 'c', 'd', 0x11, 0x04};
+    vector<uint8_t> out;
+
+    snappyUncompress(compressed, sizeof(compressed), out, 12);
+    EXPECT_EQ("abcdabcdabcd", string(out.begin(), out.end()));
+}
+
+TEST(ParquetSnappy, RejectLengthOtherThanPageHeader) {
+    // the preamble claims 2^35 bytes, the page header 12
+    const uint8_t compressed[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 'a'};
+    vector<uint8_t> out;
+
+    EXPECT_THROW(snappyUncompress(compressed, sizeof(compressed), out, 12), S3RuntimeError);
+    EXPECT_EQ(0, out.size());
+}
+
+TEST(ParquetRleBitPacked, DecodeMixedRuns) {
+    // RLE run of 3 x 5, then one bit-packed group of 8 values 0..7 at width 3
+    const uint8_t data[] = {0x06, 0x05, 0x03, 0x88, 0xc6, 0xfa};
+    RleBitPackedDecoder decoder(data, sizeof(data), 3);
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(5, decoder.next());
+    }
+    for (uint32_t i = 0; i < 8; i++) {
+        EXPECT_EQ(i, decoder.next());
+    }
+}
+
+TEST(ParquetFormat, AppendDecimal) {
+    string out;
+
+    appendDecimal(out, 5, 2);
+    out += ' ';
+    appendDecimal(out, -12345, 3);
+    out += ' ';
+    appendDecimal(out, 42, 0);
+    EXPECT_EQ("0.05 -12.345 42", out);
+}
+
+TEST(ParquetFormat, AppendCsvText) {
+    string out;
+
+    appendCsvText(out, "", 0);
+    out += ' ';
+    appendCsvText(out, "a\"b", 3);
+    out += ' ';
+    appendCsvText(out, "plain", 5);
+    EXPECT_EQ("\"\" \"a\"\"b\" plain", out);
+}
@@ -17,6 +17,41 @@ class MockS3Reader : public Reader {
     }
 };
 
+// Reads a whole key with a single request, like S3KeyReader does with small keys.
+class SingleRequestKeyReader : public Reader {
+   public:
+    SingleRequestKeyReader() : s3Interface(NULL), curPos(0) {
+    }
+
+    void setS3InterfaceService(S3Interface* s3) {
+        this->s3Interface = s3;
+    }
+
+    void open(const S3Params& params) {
+        EXPECT_EQ(S3_COMPRESSION_PLAIN, this->s3Interface->checkCompressionType(params.getS3Url()));
+
+        S3VectorUInt8 data;
+        this->s3Interface->fetchData(0, data, params.getKeySize(), params.getS3Url());
+        this->content.assign(data.begin(), data.end());
+        this->curPos = 0;
+    }
+
+    uint64_t read(char* buf, uint64_t count) {
+        uint64_t len = std::min(count, (uint64_t)(this->content.size() - this->curPos));
+        memcpy(buf, this->content.data() + this->curPos, len);
+        this->curPos += len;
+        return len;
+    }
+
+    void close() {
+    }
+
+   private:
+    S3Interface* s3Interface;
+    vector<uint8_t> content;
+    uint64_t curPos;
+};
+
 // ================== S3BucketReaderTest ===================
 
 class S3BucketReaderTest : public testing::Test {
@@ -45,6 +80,7 @@ class S3BucketReaderTest : public testing::Test {
 
     MockS3Interface s3Interface;
     MockS3Reader s3Reader;
+    SingleRequestKeyReader keyReader;
 };
 
 TEST_F(S3BucketReaderTest, OpenURL) {
@@ -285,3 +321,105 @@ TEST_F(S3BucketReaderTest, ReadBucketFileWithHeaderAndFuzyMatch) {
     eolString[0] = '\n';
     eolString[1] = '\0';
 }
+
+// Fills the key with the last letter of its name.
+class MockFetchKey {
+   public:
+    uint64_t operator()(uint64_t offset, S3VectorUInt8& data, uint64_t len, const S3Url& s3Url) {
+        string url = s3Url.getFullUrlForCurl();
+        data.assign(len, url[url.size() - 1]);
+        return len;
+    }
+};
+
+TEST_F(S3BucketReaderTest, ReadPrefetchedKeyFromMemory) {
+    ListBucketResult result;
+    result.contents.emplace_back("foo", 8);
+    result.contents.emplace_back("bar", 16);
+
+    EXPECT_CALL(s3Interface, listBucket(_)).Times(1).WillOnce(Return(result));
+
+    // bar is fetched by the prefetching thread only, and read from memory.
+    EXPECT_CALL(s3Interface, checkCompressionType(_))
+        .Times(2)
+        .WillRepeatedly(Return(S3_COMPRESSION_PLAIN));
+    EXPECT_CALL(s3Interface, fetchData(_, _, _, _)).Times(2).WillRepeatedly(Invoke(MockFetchKey()));
+
+    s3ext_segid = 0;
+    s3ext_segnum = 1;
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setChunkSize(64);
+
+    keyReader.setS3InterfaceService(bucketReader->getKeyPrefetcher());
+    bucketReader->open(params);
+    bucketReader->setUpstreamReader(&keyReader);
+    bucketReader->setPrefetchNextKey(true);
+
+    EXPECT_EQ((uint64_t)8, bucketReader->read(buf, sizeof(buf)));
+    EXPECT_EQ(string(8, 'o'), string(buf, 8));
+    EXPECT_EQ((uint64_t)16, bucketReader->read(buf, sizeof(buf)));
+    EXPECT_EQ(string(16, 'r'), string(buf, 16));
+    EXPECT_EQ((uint64_t)0, bucketReader->read(buf, sizeof(buf)));
+}
+
+TEST_F(S3BucketReaderTest, DoNotPrefetchKeyLargerThanChunk) {
+    ListBucketResult result;
+    result.contents.emplace_back("foo", 8);
+    result.contents.emplace_back("bar", 16);
+
+    EXPECT_CALL(s3Interface, listBucket(_)).Times(1).WillOnce(Return(result));
+
+    EXPECT_CALL(s3Interface, checkCompressionType(_))
+        .Times(2)
+        .WillRepeatedly(Return(S3_COMPRESSION_PLAIN));
+    EXPECT_CALL(s3Interface, fetchData(_, _, _, _)).Times(2).WillRepeatedly(Invoke(MockFetchKey()));
+
+    s3ext_segid = 0;
+    s3ext_segnum = 1;
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setChunkSize(12);
+
+    keyReader.setS3InterfaceService(bucketReader->getKeyPrefetcher());
+    bucketReader->open(params);
+    bucketReader->setUpstreamReader(&keyReader);
+    bucketReader->setPrefetchNextKey(true);
+
+    EXPECT_EQ((uint64_t)8, bucketReader->read(buf, sizeof(buf)));
+    EXPECT_FALSE(bucketReader->getKeyPrefetcher()->isServing(S3Url(
+        "https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whateverbar")));
+    EXPECT_EQ((uint64_t)16, bucketReader->read(buf, sizeof(buf)));
+    EXPECT_EQ(string(16, 'r'), string(buf, 16));
+    EXPECT_EQ((uint64_t)0, bucketReader->read(buf, sizeof(buf)));
+}
+
+TEST_F(S3BucketReaderTest, FetchKeyAgainWhenPrefetchFails) {
+    ListBucketResult result;
+    result.contents.emplace_back("foo", 8);
+    result.contents.emplace_back("bar", 16);
+
+    EXPECT_CALL(s3Interface, listBucket(_)).Times(1).WillOnce(Return(result));
+
+    EXPECT_CALL(s3Interface, checkCompressionType(_))
+        .Times(3)
+        .WillRepeatedly(Return(S3_COMPRESSION_PLAIN));
+    EXPECT_CALL(s3Interface, fetchData(_, _, _, _))
+        .Times(3)
+        .WillOnce(Invoke(MockFetchKey()))
+        .WillOnce(Throw(S3FailedAfterRetry("", 3, "")))
+        .WillOnce(Invoke(MockFetchKey()));
+
+    s3ext_segid = 0;
+    s3ext_segnum = 1;
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setChunkSize(64);
+
+    keyReader.setS3InterfaceService(bucketReader->getKeyPrefetcher());
+    bucketReader->open(params);
+    bucketReader->setUpstreamReader(&keyReader);
+    bucketReader->setPrefetchNextKey(true);
+
+    EXPECT_EQ((uint64_t)8, bucketReader->read(buf, sizeof(buf)));
+    EXPECT_EQ((uint64_t)16, bucketReader->read(buf, sizeof(buf)));
+    EXPECT_EQ(string(16, 'r'), string(buf, 16));
+    EXPECT_EQ((uint64_t)0, bucketReader->read(buf, sizeof(buf)));
+}
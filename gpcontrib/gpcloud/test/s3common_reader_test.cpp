@@ -61,6 +61,18 @@ TEST_F(S3CommonReaderTest, OpenPlain) {
     ASSERT_TRUE(NULL != dynamic_cast<S3KeyReader *>(this->upstreamReader));
 }
 
+TEST_F(S3CommonReaderTest, OpenParquet) {
+    // test case for: the file is Parquet, then ParquetReader should be called
+    EXPECT_CALL(mockS3Interface, checkCompressionType(_)).WillOnce(Return(S3_COMPRESSION_PARQUET));
+    EXPECT_CALL(mockS3Interface, fetchData(_, _, _, _)).WillOnce(Throw(S3RuntimeError("stop")));
+    S3Params params("s3://abc/def");
+    params.setKeySize(1024);
+    params.setChunkSize(1024 * 1024 * 2);
+    EXPECT_THROW(this->open(params), S3RuntimeError);
+
+    ASSERT_EQ(this->upstreamReader, &this->parquetReader);
+}
+
 TEST_F(S3CommonReaderTest, ReadGZip) {
     Byte compressionBuff[0x100];
     uLong compressedLen = sizeof(compressionBuff);
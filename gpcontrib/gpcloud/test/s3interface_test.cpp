@@ -426,6 +426,20 @@ TEST_F(S3InterfaceServiceTest, checkItsNotCompressed) {
     EXPECT_EQ(S3_COMPRESSION_PLAIN, this->checkCompressionType(s3Url));
 }
 
+TEST_F(S3InterfaceServiceTest, checkItsParquetByExtension) {
+    S3Url s3Url("https://s3-us-west-2.amazonaws.com/s3test.pivotal.io/whatever.parquet");
+    EXPECT_EQ(S3_COMPRESSION_PARQUET, this->checkCompressionType(s3Url));
+}
+
+TEST_F(S3InterfaceServiceTest, checkItsParquetByMagic) {
+    vector<uint8_t> raw = {'P', 'A', 'R', '1'};
+    Response response(RESPONSE_OK, raw);
+    EXPECT_CALL(mockRESTfulService, get(_, _)).WillOnce(Return(response));
+
+    S3Url s3Url("https://s3-us-west-2.amazonaws.com/s3test.pivotal.io/whatever");
+    EXPECT_EQ(S3_COMPRESSION_PARQUET, this->checkCompressionType(s3Url));
+}
+
 TEST_F(S3InterfaceServiceTest, checkCompreesionTypeWithResponseError) {
     uint8_t xml[] =
         "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
@@ -1,4 +1,6 @@
 #include "s3key_reader.cpp"
+#include <mutex>
+#include <thread>
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "mock_classes.h"
@@ -216,6 +218,89 @@ TEST(OffsetMgr, reset) {
     EXPECT_EQ((uint64_t)0, o.getCurPos());
 }
 
+TEST(OffsetMgr, AdaptiveChunkSizeKeepsGrowingWhileFaster) {
+    OffsetMgr o;
+    o.setKeySize(4096);
+    o.setChunkSize(800);
+    o.setAdaptiveChunkSize(100);
+
+    EXPECT_EQ((uint64_t)100, o.getChunkSize());
+
+    Range r = o.getNextOffset();
+    EXPECT_EQ((uint64_t)0, r.offset);
+    EXPECT_EQ((uint64_t)100, r.length);
+
+    // partial chunks tell nothing about the chunk size
+    o.reportFetch(50, 1.0);
+    EXPECT_EQ((uint64_t)100, o.getChunkSize());
+
+    o.reportFetch(100, 1.0);
+    EXPECT_EQ((uint64_t)200, o.getChunkSize());
+
+    r = o.getNextOffset();
+    EXPECT_EQ((uint64_t)100, r.offset);
+    EXPECT_EQ((uint64_t)200, r.length);
+
+    // 200 bytes per second after 100, grow again
+    o.reportFetch(200, 1.0);
+    EXPECT_EQ((uint64_t)400, o.getChunkSize());
+
+    // 400 bytes in 4 seconds is slower than 200 bytes a second, settle
+    o.reportFetch(400, 4.0);
+    EXPECT_EQ((uint64_t)400, o.getChunkSize());
+
+    o.reportFetch(400, 0.1);
+    EXPECT_EQ((uint64_t)400, o.getChunkSize());
+
+    r = o.getNextOffset();
+    EXPECT_EQ((uint64_t)300, r.offset);
+    EXPECT_EQ((uint64_t)400, r.length);
+}
+
+TEST(OffsetMgr, AdaptiveChunkSizeIsLimitedByChunkSize) {
+    OffsetMgr o;
+    o.setKeySize(4096);
+    o.setChunkSize(300);
+    o.setAdaptiveChunkSize(200);
+
+    o.reportFetch(200, 1.0);
+    EXPECT_EQ((uint64_t)300, o.getChunkSize());
+
+    o.reportFetch(300, 0.1);
+    EXPECT_EQ((uint64_t)300, o.getChunkSize());
+
+    o.setChunkSize(100);
+    o.setAdaptiveChunkSize(1000);
+    EXPECT_EQ((uint64_t)100, o.getChunkSize());
+}
+
+TEST(OffsetMgr, AdaptiveChunkSizeIsKeptForNextKey) {
+    OffsetMgr o;
+    o.setKeySize(4096);
+    o.setChunkSize(800);
+    o.setAdaptiveChunkSize(100);
+    o.reportFetch(100, 1.0);
+    o.reportFetch(200, 1.0);
+    EXPECT_EQ((uint64_t)400, o.getChunkSize());
+
+    o.reset();
+    EXPECT_EQ((uint64_t)0, o.getChunkSize());
+
+    o.setKeySize(4096);
+    o.setChunkSize(800);
+    o.setAdaptiveChunkSize(100);
+    EXPECT_EQ((uint64_t)400, o.getChunkSize());
+}
+
+TEST(OffsetMgr, FixedChunkSizeDoesNotGrow) {
+    OffsetMgr o;
+    o.setKeySize(4096);
+    o.setChunkSize(100);
+
+    o.reportFetch(100, 1.0);
+    EXPECT_EQ((uint64_t)100, o.getChunkSize());
+}
+
 TEST_F(S3KeyReaderTest, OpenWithZeroChunk) {
     S3Params params("s3://abc/def");
 
@@ -518,6 +603,7 @@ TEST_F(S3KeyReaderTest, MTReadWithRedundantChunks) {
     EXPECT_CALL(s3Interface, fetchData(192, _, _, _)).WillOnce(Invoke(MockFetchData(63, 64)));
 
     this->open(params);
+    EXPECT_EQ((uint64_t)1, this->getChunkBuffers().size());
 
     EXPECT_EQ((uint64_t)32, this->read(buffer, 32));
     EXPECT_EQ((uint64_t)32, this->read(buffer, 32));
@@ -529,6 +615,8 @@ TEST_F(S3KeyReaderTest, MTReadWithRedundantChunks) {
     EXPECT_EQ((uint64_t)31, this->read(buffer, 32));
     EXPECT_EQ((uint64_t)1, this->read(buffer, 32));
     EXPECT_EQ((uint64_t)0, this->read(buffer, 32));
+
+    EXPECT_GE((uint64_t)4, this->getChunkBuffers().size());
 }
 
 TEST_F(S3KeyReaderTest, MTReadWithReusedAndUnreusedChunks) {
@@ -833,6 +921,89 @@ TEST_F(S3KeyReaderTest, MTReadWithHundredsOfThreadsAndSignalCancel) {
     EXPECT_THROW(this->read(buffer, 31), S3QueryAbort);
 }
 
+// fetchData() that takes a while, in parallel with other threads or, when
+// serialized, one request at a time as if the bandwidth were saturated.
+class MockSlowFetchData {
+   public:
+    MockSlowFetchData(bool serialized) : serialized(serialized) {
+    }
+
+    uint64_t operator()(uint64_t offset, S3VectorUInt8 &data, uint64_t len,
+                        const S3Url &sourceUrl) {
+        static std::mutex bandwidth;
+        std::unique_lock<std::mutex> lock(bandwidth, std::defer_lock);
+        if (serialized) {
+            lock.lock();
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        data.resize(len);
+        return len;
+    }
+
+   private:
+    bool serialized;
+};
+
+TEST_F(S3KeyReaderTest, MTReadAddsThreadsWhileThroughputGrows) {
+    S3Params params("s3://abc/def");
+    params.setNumOfChunks(4);
+
+    params.setKeySize(64 * 24);
+    params.setChunkSize(64);
+
+    EXPECT_CALL(s3Interface, fetchData(_, _, _, _))
+        .WillRepeatedly(Invoke(MockSlowFetchData(false)));
+
+    this->open(params);
+    EXPECT_EQ((uint64_t)1, this->getChunkBuffers().size());
+
+    while (this->read(buffer, 64) != 0)
+        ;
+
+    EXPECT_EQ((uint64_t)64 * 24, this->getTransferredKeyLen());
+    EXPECT_EQ((uint64_t)4, this->getChunkBuffers().size());
+}
+
+TEST_F(S3KeyReaderTest, MTReadStopsAddingThreadsWhenThroughputIsFlat) {
+    S3Params params("s3://abc/def");
+    params.setNumOfChunks(4);
+
+    params.setKeySize(64 * 24);
+    params.setChunkSize(64);
+
+    EXPECT_CALL(s3Interface, fetchData(_, _, _, _))
+        .WillRepeatedly(Invoke(MockSlowFetchData(true)));
+
+    this->open(params);
+
+    while (this->read(buffer, 64) != 0)
+        ;
+
+    EXPECT_EQ((uint64_t)64 * 24, this->getTransferredKeyLen());
+    EXPECT_EQ((uint64_t)2, this->getChunkBuffers().size());
+}
+
+TEST_F(S3KeyReaderTest, MTReadStartsNextKeyWithLearnedThreads) {
+    S3Params params("s3://abc/def");
+    params.setNumOfChunks(4);
+
+    params.setKeySize(64 * 24);
+    params.setChunkSize(64);
+
+    EXPECT_CALL(s3Interface, fetchData(_, _, _, _))
+        .WillRepeatedly(Invoke(MockSlowFetchData(false)));
+
+    this->open(params);
+    while (this->read(buffer, 64) != 0)
+        ;
+    this->close();
+
+    this->open(params);
+    EXPECT_EQ((uint64_t)4, this->getChunkBuffers().size());
+}
+
 TEST(ChunkBuffer, ChunkBufferOperatorEqual) {
     S3Url s3Url("s3://whatever");
     S3KeyReader reader;
@@ -1,6 +1,46 @@
 #include "s3restful_service.cpp"
 #include "gtest/gtest.h"
 
+TEST(CURLHandlePool, ReuseReleasedHandle) {
+    CURLHandlePool pool;
+
+    CURL *first = pool.acquire();
+    ASSERT_TRUE(first != NULL);
+    pool.release(first);
+
+    CURL *second = pool.acquire();
+    EXPECT_EQ(first, second);
+    pool.release(second);
+}
+
+TEST(CURLHandlePool, HandleInUseIsNotShared) {
+    CURLHandlePool pool;
+
+    CURL *first = pool.acquire();
+    CURL *second = pool.acquire();
+    EXPECT_NE(first, second);
+
+    pool.release(first);
+    pool.release(second);
+
+    CURL *third = pool.acquire();
+    EXPECT_EQ(second, third);
+    pool.release(third);
+}
+
+TEST(CURLHandlePool, RequestsOfServiceReuseHandle) {
+    S3RESTfulService service;
+    CURL *curl;
+
+    {
+        CURLWrapper wrapper(service, "https://www.bing.com/", NULL);
+        curl = wrapper.curl;
+    }
+
+    CURLWrapper wrapper(service, "https://www.bing.com/", NULL);
+    EXPECT_EQ(curl, wrapper.curl);
+}
+
 TEST(S3RESTfulService, GetWithWrongHeader) {
     HTTPHeaders headers;
     S3RESTfulService service;
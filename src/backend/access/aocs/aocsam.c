@@ -350,9 +350,23 @@ initscan_with_colinfo(AOCSScanDesc scan)
 static int
 open_next_scan_seg(AOCSScanDesc scan)
 {
-	while (++scan->cur_seg < scan->total_seg)
+	for (;;)
 	{
-		AOCSFileSegInfo *curSegInfo = scan->seginfo[scan->cur_seg];
+		AOCSFileSegInfo *curSegInfo;
+
+		/*
+		 * In a parallel scan, all participants scan the segment file the
+		 * shared state is at, each its own row ranges of it.
+		 */
+		if (scan->rs_base.rs_parallel != NULL)
+			scan->cur_seg = appendonly_parallelscan_cursegidx(scan->rs_base.rs_parallel);
+		else
+			scan->cur_seg++;
+
+		if (scan->cur_seg >= scan->total_seg)
+			break;
+
+		curSegInfo = scan->seginfo[scan->cur_seg];
 
 		if (curSegInfo->total_tupcount > 0)
 		{
@@ -408,6 +422,9 @@ open_next_scan_seg(AOCSScanDesc scan)
 				return scan->cur_seg;
 			}
 		}
+
+		if (scan->rs_base.rs_parallel != NULL)
+			appendonly_parallelscan_segdone(scan->rs_base.rs_parallel, scan->cur_seg);
 	}
 
 	return -1;
@@ -428,6 +445,8 @@ static bool
 open_scan_seg(AOCSScanDesc scan, int fsInfoIdx)
 {
 	Assert(fsInfoIdx >= 0 && fsInfoIdx < scan->total_seg);
+	/* segment files are handed out by the shared allocator in parallel scans */
+	Assert(scan->rs_base.rs_parallel == NULL);
 
 	scan->cur_seg = fsInfoIdx - 1;
 	return open_next_scan_seg(scan) == fsInfoIdx;
@@ -1191,6 +1210,51 @@ aocs_get_target_tuple(AOCSScanDesc aoscan, int64 targrow, TupleTableSlot *slot)
 	return aocs_gettuple(aoscan, targrow, slot);
 }
 
+/*
+ * In a parallel scan, claim the next row range of the current segment file
+ * for a participant that has reached row 'minrow' in it. Unless the range
+ * starts right there, position the datum streams before its start, passing
+ * over the rows of the other participants, and set *positioned.
+ *
+ * Returns false, having closed the segment file, if there's nothing more in
+ * it for this participant.
+ */
+static bool
+aocs_parallelscan_nextrange(AOCSScanDesc scan, int64 minrow, bool *positioned)
+{
+	ParallelTableScanDesc pscan = scan->rs_base.rs_parallel;
+
+	*positioned = false;
+
+	if (!appendonly_parallelscan_nextrange(pscan, scan->cur_seg, minrow,
+										   &scan->parallel_startrow))
+	{
+		/* the other participants are done with this file */
+		close_cur_scan_seg(scan);
+		return false;
+	}
+	scan->parallel_endrow = scan->parallel_startrow + APPENDONLY_PARALLEL_SCAN_ROWS;
+
+	if (scan->parallel_startrow == minrow)
+		return true;
+
+	for (AttrNumber i = 0; i < scan->columnScanInfo.num_proj_atts; i++)
+	{
+		AttrNumber	attno = scan->columnScanInfo.proj_atts[i];
+
+		if (datumstreamread_seek_row(scan->columnScanInfo.ds[attno],
+									 scan->parallel_startrow) < 0)
+		{
+			appendonly_parallelscan_segdone(pscan, scan->cur_seg);
+			close_cur_scan_seg(scan);
+			return false;
+		}
+	}
+	*positioned = true;
+
+	return true;
+}
+
 bool
 aocs_getnext(AOCSScanDesc scan, ScanDirection direction, TupleTableSlot *slot)
 {
@@ -1245,6 +1309,22 @@ ReadNext:
 				return false;
 			}
 			scan->segrowsprocessed = 0;
+
+			/*
+			 * In a parallel scan, start at the first row range we claim. Row
+			 * numbers start at 1, so the datum streams are always positioned.
+			 */
+			if (scan->rs_base.rs_parallel != NULL)
+			{
+				bool		positioned;
+
+				if (!aocs_parallelscan_nextrange(scan, 0, &positioned))
+				{
+					err = -1;
+					goto ReadNext;
+				}
+				Assert(positioned);
+			}
 		}
 
 		/* We shouldn't have a 0-column projection as we should've bailed out above */
@@ -1268,6 +1348,9 @@ ReadNext:
 					/*
 					 * Ha, cannot read next block, we need to go to next seg
 					 */
+					if (scan->rs_base.rs_parallel != NULL)
+						appendonly_parallelscan_segdone(scan->rs_base.rs_parallel,
+														scan->cur_seg);
 					close_cur_scan_seg(scan);
 					goto ReadNext;
 				}
@@ -1307,6 +1390,30 @@ ReadNext:
 #endif
 		}
 
+		/*
+		 * In a parallel scan, a row past the end of our range needs a new
+		 * range. Skip ahead to its start if another participant took this
+		 * row.
+		 */
+		if (scan->rs_base.rs_parallel != NULL &&
+			rowNum >= scan->parallel_endrow)
+		{
+			bool		positioned;
+
+			Assert(rowNum != InvalidAORowNum);
+			if (!aocs_parallelscan_nextrange(scan, rowNum, &positioned))
+			{
+				err = -1;
+				rowNum = InvalidAORowNum;
+				goto ReadNext;
+			}
+			if (positioned)
+			{
+				rowNum = InvalidAORowNum;
+				goto ReadNext;
+			}
+		}
+
 		scan->segrowsprocessed++;
 		if (rowNum == InvalidAORowNum)
 		{
@@ -28,6 +28,7 @@
 #include "catalog/pg_appendonly.h"
 #include "catalog/storage.h"
 #include "catalog/storage_xlog.h"
+#include "cdb/cdbappendonlyam.h"
 #include "cdb/cdbaocsam.h"
 #include "cdb/cdbvars.h"
 #include "commands/progress.h"
@@ -638,14 +639,17 @@ aoco_beginscan(Relation relation,
 {
 	AOCSScanDesc	aoscan;
 
-	/* Parallel scan not supported for AO_COLUMN tables */
-	Assert(pscan == NULL);
-
 	aoscan = aocs_beginscan(relation,
 							snapshot,
 							NULL,
 							flags);
 
+	/*
+	 * Segment files are opened lazily, so it's enough to attach the shared
+	 * parallel scan state here; see open_next_scan_seg().
+	 */
+	aoscan->rs_base.rs_parallel = pscan;
+
 	return (TableScanDesc) aoscan;
 }
 
@@ -715,24 +719,6 @@ aoco_getnextslot(TableScanDesc scan, ScanDirection direction, TupleTableSlot *sl
 	return false;
 }
 
-static Size
-aoco_parallelscan_estimate(Relation rel)
-{
-	elog(ERROR, "parallel SeqScan not implemented for AO_COLUMN tables");
-}
-
-static Size
-aoco_parallelscan_initialize(Relation rel, ParallelTableScanDesc pscan)
-{
-	elog(ERROR, "parallel SeqScan not implemented for AO_COLUMN tables");
-}
-
-static void
-aoco_parallelscan_reinitialize(Relation rel, ParallelTableScanDesc pscan)
-{
-	elog(ERROR, "parallel SeqScan not implemented for AO_COLUMN tables");
-}
-
 static IndexFetchTableData *
 aoco_index_fetch_begin(Relation rel)
 {
@@ -2734,9 +2720,9 @@ static const TableAmRoutine ao_column_methods = {
 	.scan_rescan = aoco_rescan,
 	.scan_getnextslot = aoco_getnextslot,
 
-	.parallelscan_estimate = aoco_parallelscan_estimate,
-	.parallelscan_initialize = aoco_parallelscan_initialize,
-	.parallelscan_reinitialize = aoco_parallelscan_reinitialize,
+	.parallelscan_estimate = appendonly_parallelscan_estimate,
+	.parallelscan_initialize = appendonly_parallelscan_initialize,
+	.parallelscan_reinitialize = appendonly_parallelscan_reinitialize,
 
 	.index_fetch_begin = aoco_index_fetch_begin,
 	.index_fetch_reset = aoco_index_fetch_reset,
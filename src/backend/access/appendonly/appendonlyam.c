@@ -208,16 +208,31 @@ SetNextFileSegForRead(AppendOnlyScanDesc scan)
 	/*
 	 * Do we have more segment files to read or are we done?
 	 */
-	while (scan->aos_segfiles_processed < scan->aos_total_segfiles)
+	for (;;)
 	{
+		FileSegInfo *fsinfo;
+		int			segidx;
+
+		/*
+		 * In a parallel scan, all participants scan the segment file the
+		 * shared state is at, each its own row ranges of it.
+		 */
+		if (scan->rs_base.rs_parallel != NULL)
+			segidx = appendonly_parallelscan_cursegidx(scan->rs_base.rs_parallel);
+		else
+			segidx = scan->aos_segfiles_processed;
+
+		if (segidx >= scan->aos_total_segfiles)
+			break;
+
 		/* still have more segment files to read. get info of the next one */
-		FileSegInfo *fsinfo = scan->aos_segfile_arr[scan->aos_segfiles_processed];
+		fsinfo = scan->aos_segfile_arr[segidx];
 
 		segno = fsinfo->segno;
 		formatversion = fsinfo->formatversion;
 		eof = (int64) fsinfo->eof;
 
-		scan->aos_segfiles_processed++;
+		scan->aos_segfiles_processed = segidx + 1;
 
 		/*
 		 * If the 'eof' is zero or it's just a lingering dropped segment
@@ -241,6 +256,9 @@ SetNextFileSegForRead(AppendOnlyScanDesc scan)
 			finished_all_files = false;
 			break;
 		}
+
+		if (scan->rs_base.rs_parallel != NULL)
+			appendonly_parallelscan_segdone(scan->rs_base.rs_parallel, segidx);
 	}
 
 	if (finished_all_files)
@@ -271,6 +289,10 @@ SetNextFileSegForRead(AppendOnlyScanDesc scan)
 												 &scan->executorReadBlock,
 												  /* blockFirstRowNum */ 1);
 
+	/* no row range of this segment file claimed yet */
+	scan->aos_parallel_startrow = 0;
+	scan->aos_parallel_endrow = 0;
+
 	/* ready to go! */
 	scan->aos_need_new_segfile = false;
 
@@ -306,6 +328,8 @@ static bool
 SetSegFileForRead(AppendOnlyScanDesc aoscan, int fsInfoIdx)
 {
 	Assert(fsInfoIdx >= 0 && fsInfoIdx < aoscan->aos_total_segfiles);
+	/* segment files are handed out by the shared allocator in parallel scans */
+	Assert(aoscan->rs_base.rs_parallel == NULL);
 
 	/*
 	 * Advance aos_segfiles_processed pointer to target segment, so that it
@@ -1127,19 +1151,57 @@ getNextBlock(AppendOnlyScanDesc scan)
 			return false;
 	}
 
-	if (!AppendOnlyExecutorReadBlock_GetBlockInfo(
-												  &scan->storageRead,
-												  &scan->executorReadBlock))
+	for (;;)
 	{
-		if (scan->blockDirectory)
+		if (!AppendOnlyExecutorReadBlock_GetBlockInfo(
+													  &scan->storageRead,
+													  &scan->executorReadBlock))
 		{
-			AppendOnlyBlockDirectory_End_forInsert(scan->blockDirectory);
+			if (scan->blockDirectory)
+			{
+				AppendOnlyBlockDirectory_End_forInsert(scan->blockDirectory);
+			}
+
+			if (scan->rs_base.rs_parallel != NULL)
+				appendonly_parallelscan_segdone(scan->rs_base.rs_parallel,
+												scan->aos_segfiles_processed - 1);
+
+			/* done reading the file */
+			CloseScannedFileSeg(scan);
+
+			return false;
 		}
 
-		/* done reading the file */
-		CloseScannedFileSeg(scan);
+		if (scan->rs_base.rs_parallel == NULL)
+			break;
 
-		return false;
+		/*
+		 * In a parallel scan, a varblock belongs to the participant that
+		 * claimed the row range its first row falls into. Claim ranges until
+		 * we have one that reaches this block, and skip the block without
+		 * decompressing it if it's in somebody else's range.
+		 */
+		Assert(scan->blockDirectory == NULL);
+		while (scan->executorReadBlock.blockFirstRowNum >= scan->aos_parallel_endrow)
+		{
+			if (!appendonly_parallelscan_nextrange(scan->rs_base.rs_parallel,
+												   scan->aos_segfiles_processed - 1,
+												   scan->executorReadBlock.blockFirstRowNum,
+												   &scan->aos_parallel_startrow))
+			{
+				/* the other participants are done with this file */
+				CloseScannedFileSeg(scan);
+				return false;
+			}
+			scan->aos_parallel_endrow =
+				scan->aos_parallel_startrow + APPENDONLY_PARALLEL_SCAN_ROWS;
+		}
+
+		if (scan->executorReadBlock.blockFirstRowNum >= scan->aos_parallel_startrow)
+			break;
+
+		AppendOnlyStorageRead_SkipCurrentBlock(&scan->storageRead);
+		AppendOnlyExecutionReadBlock_FinishedScanBlock(&scan->executorReadBlock);
 	}
 
 	if (scan->blockDirectory)
@@ -1936,6 +1998,116 @@ appendonly_beginscan(Relation relation,
 	return (TableScanDesc) aoscan;
 }
 
+/* ----------------
+ * Parallel scan support
+ *
+ * Shared by the ao_row and ao_column access methods. The unit of work handed
+ * to a participant is a range of row numbers in a segment file; see
+ * ParallelAppendOnlyScanDescData.
+ * ----------------
+ */
+Size
+appendonly_parallelscan_estimate(Relation rel)
+{
+	return sizeof(ParallelAppendOnlyScanDescData);
+}
+
+Size
+appendonly_parallelscan_initialize(Relation rel, ParallelTableScanDesc pscan)
+{
+	ParallelAppendOnlyScanDesc aopscan = (ParallelAppendOnlyScanDesc) pscan;
+
+	aopscan->base.phs_relid = RelationGetRelid(rel);
+	/* AO tables don't take part in synchronized scans */
+	aopscan->base.phs_syncscan = false;
+	SpinLockInit(&aopscan->phs_mutex);
+	aopscan->phs_segidx = 0;
+	/* row numbers in a segment file start at 1 */
+	aopscan->phs_nextrow = 1;
+
+	return sizeof(ParallelAppendOnlyScanDescData);
+}
+
+void
+appendonly_parallelscan_reinitialize(Relation rel, ParallelTableScanDesc pscan)
+{
+	ParallelAppendOnlyScanDesc aopscan = (ParallelAppendOnlyScanDesc) pscan;
+
+	SpinLockAcquire(&aopscan->phs_mutex);
+	aopscan->phs_segidx = 0;
+	aopscan->phs_nextrow = 1;
+	SpinLockRelease(&aopscan->phs_mutex);
+}
+
+/*
+ * Return the segfile array index of the segment file being scanned.
+ *
+ * Returns a value >= the number of segment files once all of them have been
+ * scanned.
+ */
+int
+appendonly_parallelscan_cursegidx(ParallelTableScanDesc pscan)
+{
+	ParallelAppendOnlyScanDesc aopscan = (ParallelAppendOnlyScanDesc) pscan;
+	int			segidx;
+
+	SpinLockAcquire(&aopscan->phs_mutex);
+	segidx = aopscan->phs_segidx;
+	SpinLockRelease(&aopscan->phs_mutex);
+
+	return segidx;
+}
+
+/*
+ * Claim the next range of APPENDONLY_PARALLEL_SCAN_ROWS row numbers of the
+ * segment file at 'segidx', returning its first row number in *startrow.
+ *
+ * 'minrow' is the row number the caller has reached in the file. Row numbers
+ * only grow along a segment file, so there are no rows between the end of
+ * the caller's last range and 'minrow', and the range can start there right
+ * away instead of stepping over row number gaps one range at a time.
+ *
+ * Returns false if the scan has moved on from that segment file.
+ */
+bool
+appendonly_parallelscan_nextrange(ParallelTableScanDesc pscan, int segidx,
+								  int64 minrow, int64 *startrow)
+{
+	ParallelAppendOnlyScanDesc aopscan = (ParallelAppendOnlyScanDesc) pscan;
+	bool		result = false;
+
+	SpinLockAcquire(&aopscan->phs_mutex);
+	if (aopscan->phs_segidx == segidx)
+	{
+		if (aopscan->phs_nextrow < minrow)
+			aopscan->phs_nextrow = minrow;
+		*startrow = aopscan->phs_nextrow;
+		aopscan->phs_nextrow += APPENDONLY_PARALLEL_SCAN_ROWS;
+		result = true;
+	}
+	SpinLockRelease(&aopscan->phs_mutex);
+
+	return result;
+}
+
+/*
+ * The end of the segment file at 'segidx' was reached, move on to the next
+ * one unless somebody already did.
+ */
+void
+appendonly_parallelscan_segdone(ParallelTableScanDesc pscan, int segidx)
+{
+	ParallelAppendOnlyScanDesc aopscan = (ParallelAppendOnlyScanDesc) pscan;
+
+	SpinLockAcquire(&aopscan->phs_mutex);
+	if (aopscan->phs_segidx == segidx)
+	{
+		aopscan->phs_segidx++;
+		aopscan->phs_nextrow = 1;
+	}
+	SpinLockRelease(&aopscan->phs_mutex);
+}
+
 /* ----------------
  *		appendonly_rescan		- restart a relation scan
  *
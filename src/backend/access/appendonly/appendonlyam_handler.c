@@ -472,27 +472,11 @@ appendonly_free_memtuple(MemTuple tuple)
 
 /* ------------------------------------------------------------------------
  * Parallel aware Seq Scan callbacks for ao_row AM
+ *
+ * These are in appendonlyam.c, and shared with the ao_column AM
  * ------------------------------------------------------------------------
  */
 
-static Size
-appendonly_parallelscan_estimate(Relation rel)
-{
-	elog(ERROR, "parallel SeqScan not implemented for AO_ROW tables");
-}
-
-static Size
-appendonly_parallelscan_initialize(Relation rel, ParallelTableScanDesc pscan)
-{
-	elog(ERROR, "parallel SeqScan not implemented for AO_ROW tables");
-}
-
-static void
-appendonly_parallelscan_reinitialize(Relation rel, ParallelTableScanDesc pscan)
-{
-	elog(ERROR, "parallel SeqScan not implemented for AO_ROW tables");
-}
-
 /* ------------------------------------------------------------------------
  * Seq Scan callbacks for appendonly AM
  *
@@ -72,6 +72,8 @@ InsertAppendOnlyEntry(Oid relid,
 	values[Anum_pg_appendonly_blkdirrelid - 1] = ObjectIdGetDatum(blkdirrelid);
 	values[Anum_pg_appendonly_visimaprelid - 1] = ObjectIdGetDatum(visimaprelid);
 	values[Anum_pg_appendonly_version - 1] = Int16GetDatum(version);
+	values[Anum_pg_appendonly_analyzemodcount - 1] = Int64GetDatum(-1);
+	values[Anum_pg_appendonly_analyzestatsig - 1] = Int32GetDatum(0);
 
 	/*
 	 * form the tuple and insert it
@@ -201,6 +203,64 @@ UpdateAppendOnlyEntryAuxOids(Oid relid,
 	CacheInvalidateRelcacheByRelid(relid);
 }
 
+/*
+ * Remember the total modcount of the segfiles of an appendonly relation at
+ * the time it was analyzed, along with a signature of what ANALYZE collected
+ * statistics for, or forget it by passing -1. gp_toolkit.gp_stats_stale_ao
+ * lists the relation once the modcount changes, and with
+ * gp_analyze_skip_unmodified_ao ANALYZE skips it for as long as both stay the
+ * same.
+ */
+void
+UpdateAppendOnlyEntryAnalyzeModCount(Oid relid, int64 analyzemodcount,
+									 int32 analyzestatsig)
+{
+	Relation	pg_appendonly;
+	ScanKeyData key[1];
+	SysScanDesc scan;
+	HeapTuple	tuple, newTuple;
+	Datum		newValues[Natts_pg_appendonly];
+	bool		newNulls[Natts_pg_appendonly];
+	bool		replace[Natts_pg_appendonly];
+
+	pg_appendonly = table_open(AppendOnlyRelationId, RowExclusiveLock);
+
+	ScanKeyInit(&key[0],
+				Anum_pg_appendonly_relid,
+				BTEqualStrategyNumber, F_OIDEQ,
+				ObjectIdGetDatum(relid));
+
+	scan = systable_beginscan(pg_appendonly, AppendOnlyRelidIndexId, true,
+							  NULL, 1, key);
+	tuple = systable_getnext(scan);
+	if (!HeapTupleIsValid(tuple))
+		ereport(ERROR,
+				(errcode(ERRCODE_UNDEFINED_OBJECT),
+				 errmsg("missing pg_appendonly entry for relation \"%s\"",
+						get_rel_name(relid))));
+
+	MemSet(newValues, 0, sizeof(newValues));
+	MemSet(newNulls, false, sizeof(newNulls));
+	MemSet(replace, false, sizeof(replace));
+
+	replace[Anum_pg_appendonly_analyzemodcount - 1] = true;
+	newValues[Anum_pg_appendonly_analyzemodcount - 1] = Int64GetDatum(analyzemodcount);
+	replace[Anum_pg_appendonly_analyzestatsig - 1] = true;
+	newValues[Anum_pg_appendonly_analyzestatsig - 1] = Int32GetDatum(analyzestatsig);
+
+	newTuple = heap_modify_tuple(tuple, RelationGetDescr(pg_appendonly),
+								 newValues, newNulls, replace);
+	CatalogTupleUpdate(pg_appendonly, &newTuple->t_self, newTuple);
+
+	heap_freetuple(newTuple);
+
+	systable_endscan(scan);
+	table_close(pg_appendonly, RowExclusiveLock);
+
+	/* The relcache entry carries a copy of the pg_appendonly tuple */
+	CacheInvalidateRelcacheByRelid(relid);
+}
+
 /*
  * Remove all pg_appendonly entries that the table we are DROPing
  * refers to (using the table's relfilenode)
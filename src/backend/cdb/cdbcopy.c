@@ -575,6 +575,7 @@ cdbCopyEndInternal(CdbCopy *c, char *abort_msg,
 			if (q->conn->wrote_xlog)
 			{
 				MarkTopTransactionWriteXLogOnExecutor();
+				addToGxactXLogSegments(q->segindex);
 
 				/*
 				* Reset the worte_xlog here. Since if the received pgresult not process
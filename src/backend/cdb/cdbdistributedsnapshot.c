@@ -23,6 +23,64 @@
 #include "utils/snapmgr.h"
 #include "storage/procarray.h"
 
+/*
+ * The in-progress array is shipped with every dispatched statement. It is
+ * sorted and all of its xids lie in [xmin, xmax), so instead of 8 bytes per
+ * xid we send the gap from the previous xid (from xmin, for the first one)
+ * as a variable-length integer: 7 bits per byte, low bits first, the high
+ * bit set on all but the last byte. Concurrent gxids are usually close
+ * together, which makes that one or two bytes each.
+ */
+#define DXID_VARINT_MAX_BYTES 10
+
+static inline int
+dxid_varint_size(uint64 value)
+{
+	int			size = 1;
+
+	while (value >= 0x80)
+	{
+		value >>= 7;
+		size++;
+	}
+	return size;
+}
+
+static inline int
+dxid_varint_encode(uint64 value, char *buf)
+{
+	unsigned char *p = (unsigned char *) buf;
+
+	while (value >= 0x80)
+	{
+		*p++ = (unsigned char) (value | 0x80);
+		value >>= 7;
+	}
+	*p++ = (unsigned char) value;
+
+	return (char *) p - buf;
+}
+
+static inline int
+dxid_varint_decode(const char *buf, uint64 *value)
+{
+	const unsigned char *p = (const unsigned char *) buf;
+	uint64		result = 0;
+	int			shift = 0;
+
+	for (;;)
+	{
+		Assert(shift < 7 * DXID_VARINT_MAX_BYTES);
+		result |= (uint64) (*p & 0x7F) << shift;
+		if ((*p++ & 0x80) == 0)
+			break;
+		shift += 7;
+	}
+	*value = result;
+
+	return (const char *) p - buf;
+}
+
 int
 GetMaxSnapshotDistributedXidCount()
 {
@@ -43,6 +101,8 @@ DistributedSnapshotWithLocalMapping_CommittedTest(
 {
 	DistributedSnapshot *ds = &dslm->ds;
 	uint32		i;
+	uint32		lo,
+				hi;
 	DistributedTransactionId distribXid = InvalidDistributedTransactionId;
 
 	Assert(!IS_QUERY_DISPATCHER());
@@ -159,45 +219,49 @@ DistributedSnapshotWithLocalMapping_CommittedTest(
 		return DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS;
 	}
 
-	for (i = 0; i < ds->count; i++)
+	/*
+	 * Leverage the fact that ds->inProgressXidArray is sorted in ascending
+	 * order based on distribXid while creating the snapshot in
+	 * CreateDistributedSnapshot(), and binary search it.
+	 */
+	lo = 0;
+	hi = ds->count;
+	while (lo < hi)
 	{
-		if (distribXid == ds->inProgressXidArray[i])
+		i = lo + (hi - lo) / 2;
+		if (ds->inProgressXidArray[i] < distribXid)
+			lo = i + 1;
+		else
+			hi = i;
+	}
+
+	if (lo < ds->count && distribXid == ds->inProgressXidArray[lo])
+	{
+		/*
+		 * Save the relationship to the local xid so we may avoid checking
+		 * the distributed committed log in a subsequent check. We can
+		 * only record local xids till cache size permits.
+		 */
+		if (dslm->currentLocalXidsCount < ds->count)
 		{
-			/*
-			 * Save the relationship to the local xid so we may avoid checking
-			 * the distributed committed log in a subsequent check. We can
-			 * only record local xids till cache size permits.
-			 */
-			if (dslm->currentLocalXidsCount < ds->count)
+			Assert(dslm->inProgressMappedLocalXids != NULL);
+			dslm->inProgressMappedLocalXids[dslm->currentLocalXidsCount++] =
+				localXid;
+
+			if (!TransactionIdIsValid(dslm->minCachedLocalXid) ||
+				TransactionIdPrecedes(localXid, dslm->minCachedLocalXid))
 			{
-				Assert(dslm->inProgressMappedLocalXids != NULL);
-				dslm->inProgressMappedLocalXids[dslm->currentLocalXidsCount++] =
-					localXid;
-
-				if (!TransactionIdIsValid(dslm->minCachedLocalXid) ||
-					TransactionIdPrecedes(localXid, dslm->minCachedLocalXid))
-				{
-					dslm->minCachedLocalXid = localXid;
-				}
-
-				if (!TransactionIdIsValid(dslm->maxCachedLocalXid) ||
-					TransactionIdFollows(localXid, dslm->maxCachedLocalXid))
-				{
-					dslm->maxCachedLocalXid = localXid;
-				}
+				dslm->minCachedLocalXid = localXid;
 			}
 
-			return DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS;
+			if (!TransactionIdIsValid(dslm->maxCachedLocalXid) ||
+				TransactionIdFollows(localXid, dslm->maxCachedLocalXid))
+			{
+				dslm->maxCachedLocalXid = localXid;
+			}
 		}
 
-		/*
-		 * Leverage the fact that ds->inProgressXidArray is sorted in
-		 * ascending order based on distribXid while creating the snapshot in
-		 * CreateDistributedSnapshot(). So, can fail fast once known are
-		 * lower than rest of them.
-		 */
-		if (distribXid < ds->inProgressXidArray[i])
-			break;
+		return DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS;
 	}
 
 	/*
@@ -269,19 +333,30 @@ DistributedSnapshot_Copy(DistributedSnapshot *target,
 int
 DistributedSnapshot_SerializeSize(DistributedSnapshot *ds)
 {
-	return sizeof(DistributedSnapshotId) +
+	int			size;
+	DistributedTransactionId prev = ds->xmin;
+
+	size = sizeof(DistributedSnapshotId) +
 	/* xminAllDistributedSnapshots, xmin, xmax */
 		3 * sizeof(DistributedTransactionId) +
 	/* count */
-		sizeof(int32) +
-	/* Size of inProgressXidArray */
-		sizeof(DistributedTransactionId) * ds->count;
+		sizeof(int32);
+
+	/* Size of the encoded inProgressXidArray */
+	for (int i = 0; i < ds->count; i++)
+	{
+		size += dxid_varint_size(ds->inProgressXidArray[i] - prev);
+		prev = ds->inProgressXidArray[i];
+	}
+
+	return size;
 }
 
 int
 DistributedSnapshot_Serialize(DistributedSnapshot *ds, char *buf)
 {
 	char	   *p = buf;
+	DistributedTransactionId prev;
 
 	memcpy(p, &ds->xminAllDistributedSnapshots, sizeof(DistributedTransactionId));
 	p += sizeof(DistributedTransactionId);
@@ -294,8 +369,13 @@ DistributedSnapshot_Serialize(DistributedSnapshot *ds, char *buf)
 	memcpy(p, &ds->count, sizeof(int32));
 	p += sizeof(int32);
 
-	memcpy(p, ds->inProgressXidArray, sizeof(DistributedTransactionId) * ds->count);
-	p += sizeof(DistributedTransactionId) * ds->count;
+	prev = ds->xmin;
+	for (int i = 0; i < ds->count; i++)
+	{
+		Assert(ds->inProgressXidArray[i] >= prev);
+		p += dxid_varint_encode(ds->inProgressXidArray[i] - prev, p);
+		prev = ds->inProgressXidArray[i];
+	}
 
 	Assert((p - buf) == DistributedSnapshot_SerializeSize(ds));
 
@@ -320,7 +400,7 @@ DistributedSnapshot_Deserialize(const char *buf, DistributedSnapshot *ds)
 
 	if (ds->count > 0)
 	{
-		int xipsize = sizeof(DistributedTransactionId) * ds->count;
+		DistributedTransactionId prev = ds->xmin;
 
 		if (ds->inProgressXidArray == NULL)
 		{
@@ -332,8 +412,14 @@ DistributedSnapshot_Deserialize(const char *buf, DistributedSnapshot *ds)
 						 errmsg("out of memory")));
 		}
 
-		memcpy(ds->inProgressXidArray, p, xipsize);
-		p += xipsize;
+		for (int i = 0; i < ds->count; i++)
+		{
+			uint64		delta;
+
+			p += dxid_varint_decode(p, &delta);
+			prev += delta;
+			ds->inProgressXidArray[i] = prev;
+		}
 	}
 
 	Assert((p - buf) == DistributedSnapshot_SerializeSize(ds));
@@ -222,6 +222,13 @@ add_multi_dqas_hash_agg_path(PlannerInfo *root,
 							 RelOptInfo *output_rel,
 							 cdb_dqas_info *info);
 
+static void
+add_multi_dqas_group_hash_agg_path(PlannerInfo *root,
+								   Path *path,
+								   cdb_agg_planning_context *ctx,
+								   RelOptInfo *output_rel,
+								   cdb_dqas_info *info);
+
 static void
 add_multi_mixed_dqas_hash_agg_path(PlannerInfo *root,
 							 Path *path,
@@ -520,6 +527,12 @@ cdb_create_multistage_grouping_paths(PlannerInfo *root,
 											 &ctx,
 											 output_rel,
 											 &info);
+
+				add_multi_dqas_group_hash_agg_path(root,
+												   cheapest_path,
+												   &ctx,
+												   output_rel,
+												   &info);
 			}
 			break;
 		case MULTI_DQAS_WITHAGG:
@@ -1925,6 +1938,107 @@ add_multi_dqas_hash_agg_path(PlannerInfo *root,
 	add_path(output_rel, path);
 }
 
+/*
+ * Create a Path for multiple DISTINCT-qualified aggregates with GROUP BY,
+ * redistributing the input only once, on the GROUP BY keys.
+ *
+ * add_multi_dqas_hash_agg_path() redistributes the split tuples, so the
+ * motion carries up to one row per input row and DQA. Once the input is
+ * collocated by the GROUP BY keys, all the tuples of a group, and all the
+ * duplicates of its DISTINCT arguments, are on the same segment, and the
+ * tuple split, the deduplication and the aggregation can all be done locally.
+ *
+ * This is added alongside the Path from add_multi_dqas_hash_agg_path(), and
+ * the cheaper one wins. Nothing is added if the GUC is off or the input
+ * cannot be collocated by the GROUP BY keys.
+ */
+static void
+add_multi_dqas_group_hash_agg_path(PlannerInfo *root,
+								   Path *path,
+								   cdb_agg_planning_context *ctx,
+								   RelOptInfo *output_rel,
+								   cdb_dqas_info *info)
+{
+	List	   *group_tles;
+	CdbPathLocus group_locus;
+	bool		group_need_redistribute;
+	double		dNumGroups;
+	double		dNumDistinctGroups;
+	AggClauseCosts DedupCost = {};
+
+	if (!gp_enable_multi_dqa_group_redistribute || !ctx->groupClause)
+		return;
+
+	/* see add_multi_dqas_hash_agg_path() */
+	path = apply_projection_to_path(root, path->parent, path, info->input_proj_target);
+
+	group_tles = get_common_group_tles(info->input_proj_target,
+									   ctx->groupClause, NIL);
+	group_locus = choose_grouping_locus(root, path, group_tles,
+										&group_need_redistribute);
+	if (group_need_redistribute && !CdbPathLocus_IsHashed(group_locus))
+		return;
+
+	/*
+	 *  HashAggregate (to aggregate)
+	 *     -> HashAggregate (to remove duplicates)
+	 *          -> TupleSplit (according to DISTINCT expr)
+	 *               -> Redistribute Motion (according to GROUP BY)
+	 *                    -> input
+	 */
+	if (group_need_redistribute)
+		path = cdbpath_create_motion_path(root, path, NIL, false,
+										  group_locus);
+
+	if (CdbPathLocus_IsPartitioned(group_locus))
+	{
+		dNumGroups = clamp_row_est(ctx->dNumGroupsTotal /
+								   CdbPathLocus_NumSegments(group_locus));
+		dNumDistinctGroups = clamp_row_est(info->dNumDistinctGroups /
+										   CdbPathLocus_NumSegments(group_locus));
+	}
+	else
+	{
+		dNumGroups = ctx->dNumGroupsTotal;
+		dNumDistinctGroups = info->dNumDistinctGroups;
+	}
+
+	path = (Path *) create_tup_split_path(root,
+										  output_rel,
+										  path,
+										  info->tup_split_target,
+										  ctx->groupClause,
+										  info->dqa_expr_lst);
+
+	get_agg_clause_costs(root, (Node *) info->tup_split_target->exprs,
+						 AGGSPLIT_SIMPLE,
+						 &DedupCost);
+	path = (Path *) create_agg_path(root,
+									output_rel,
+									path,
+									info->tup_split_target,
+									AGG_HASHED,
+									AGGSPLIT_SIMPLE,
+									false, /* streaming */
+									info->dqa_group_clause,
+									NIL,
+									&DedupCost,
+									dNumDistinctGroups);
+
+	path = (Path *) create_agg_path(root,
+									output_rel,
+									path,
+									info->final_target,
+									AGG_HASHED,
+									AGGSPLIT_DEDUPLICATED,
+									false, /* streaming */
+									ctx->groupClause,
+									ctx->havingQual,
+									ctx->agg_costs, /* transitions are done here */
+									dNumGroups);
+	add_path(output_rel, path);
+}
+
 static void
 add_multi_mixed_dqas_hash_agg_path(PlannerInfo *root,
 							Path *path,
@@ -2766,8 +2880,12 @@ fetch_multi_dqas_info(PlannerInfo *root,
 			                                          NULL);
 		}
 
-		/* assign an agg_expr_id value to aggref*/
+		/*
+		 * assign an agg_expr_id value to aggref, and to the final aggref in
+		 * case it is computed directly from the split tuples
+		 */
 		aggref->agg_expr_id = agg_expr_id;
+		aggref_final->agg_expr_id = agg_expr_id;
 
 		/* rid of filter in aggref, will push them down to the TupleSplit node */
 		aggref->aggfilter = NULL;
@@ -32,6 +32,16 @@ static char *uncompress_string(const char *src, int size, int *uncompressed_size
 
 #endif			/* USE_ZSTD */
 
+/* Plans cached by this QE, indexed by DispatchPlanCacheSlot() */
+typedef struct DispatchedPlan
+{
+	DispatchPlanId id;			/* size is 0 if the slot is empty */
+	char	   *plan;
+} DispatchedPlan;
+
+static DispatchedPlan dispatchedPlans[DISPATCH_PLAN_CACHE_SLOTS];
+static MemoryContext DispatchedPlanContext = NULL;
+
 /*
  * This is used by dispatcher to serialize Plan and Query Trees for
  * dispatching to qExecs.
@@ -93,6 +103,65 @@ deserializeNode(const char *strNode, int size)
 	return node;
 }
 
+/*
+ * Identify a serialized plan in the plan cache of QEs.  The QE runs whatever
+ * plan it has under the identity the QD sends, so it must not collide.
+ */
+void
+computeDispatchPlanId(const char *plan, int size, DispatchPlanId *id)
+{
+	pg_sha256_ctx ctx;
+
+	Assert(size > 0);
+
+	pg_sha256_init(&ctx);
+	pg_sha256_update(&ctx, (const uint8 *) plan, size);
+	pg_sha256_final(&ctx, id->digest);
+	id->size = size;
+}
+
+/*
+ * Called in a QE to keep a dispatched plan, replacing whatever was in its
+ * slot.
+ */
+void
+storeDispatchedPlan(const DispatchPlanId *id, const char *plan)
+{
+	DispatchedPlan *slot = &dispatchedPlans[DispatchPlanCacheSlot(id)];
+
+	Assert(id->size > 0);
+
+	if (DispatchedPlanContext == NULL)
+		DispatchedPlanContext = AllocSetContextCreate(TopMemoryContext,
+													  "Dispatched plan cache",
+													  ALLOCSET_DEFAULT_SIZES);
+
+	slot->id.size = 0;
+	if (slot->plan)
+	{
+		pfree(slot->plan);
+		slot->plan = NULL;
+	}
+	slot->plan = MemoryContextAlloc(DispatchedPlanContext, id->size);
+	memcpy(slot->plan, plan, id->size);
+	slot->id = *id;
+}
+
+/*
+ * Called in a QE to get a plan that the QD has sent before.  Returns NULL if
+ * it's not here.
+ */
+const char *
+lookupDispatchedPlan(const DispatchPlanId *id)
+{
+	DispatchedPlan *slot = &dispatchedPlans[DispatchPlanCacheSlot(id)];
+
+	if (slot->id.size == 0 || !DispatchPlanIdEquals(&slot->id, id))
+		return NULL;
+
+	return slot->plan;
+}
+
 #ifdef USE_ZSTD
 /*
  * Compress a (binary) string using libzstd
@@ -864,9 +864,15 @@ prepareDtxTransaction(void)
 	 * has been assigned on the QD either, or there is no xlog writing related
 	 * to this transaction on all segments, we can perform one-phase commit.
 	 * Otherwise, broadcast PREPARE TRANSACTION to the segments.
+	 *
+	 * With gp_enable_single_writer_one_phase_commit, it is enough that only
+	 * one segment wrote xlog: the others have nothing to commit that must be
+	 * kept atomic with it.
 	 */
 	if (!TopXactExecutorDidWriteXLog() ||
-		(!markXidCommitted && list_length(MyTmGxactLocal->dtxSegments) < 2))
+		(!markXidCommitted && list_length(MyTmGxactLocal->dtxSegments) < 2) ||
+		(!markXidCommitted && gp_enable_single_writer_one_phase_commit &&
+		 bms_membership(MyTmGxactLocal->xlogSegmentsMap) != BMS_MULTIPLE))
 	{
 		setCurrentDtxState(DTX_STATE_ONE_PHASE_COMMIT);
 		/*
@@ -1450,6 +1456,7 @@ resetTmGxact(void)
 	MyTmGxactLocal->writerGangLost = false;
 	MyTmGxactLocal->dtxSegmentsMap = NULL;
 	MyTmGxactLocal->dtxSegments = NIL;
+	MyTmGxactLocal->xlogSegmentsMap = NULL;
 	MyTmGxactLocal->isOnePhaseCommit = false;
 	if (MyTmGxactLocal->waitGxids != NULL)
 	{
@@ -2428,6 +2435,28 @@ addToGxactDtxSegments(Gang *gang)
 	MemoryContextSwitchTo(oldContext);
 }
 
+/*
+ * Record that a QE of the segment reported writing xlog in the current
+ * transaction.
+ */
+void
+addToGxactXLogSegments(int segindex)
+{
+	MemoryContext oldContext;
+
+	/* entry db is just a reader, will not involve in two phase commit */
+	if (segindex < 0 || !IsTransactionState())
+		return;
+
+	if (bms_is_member(segindex, MyTmGxactLocal->xlogSegmentsMap))
+		return;
+
+	oldContext = MemoryContextSwitchTo(TopTransactionContext);
+	MyTmGxactLocal->xlogSegmentsMap =
+		bms_add_member(MyTmGxactLocal->xlogSegmentsMap, segindex);
+	MemoryContextSwitchTo(oldContext);
+}
+
 bool
 CurrentDtxIsRollingback(void)
 {
@@ -82,6 +82,9 @@ int			gp_external_max_segs;	/* max segdbs per gpfdist/gpfdists URI */
 int			gp_cached_gang_threshold;	/* How many gangs to keep around from
 										 * stmt to stmt. */
 
+bool		gp_prewarm_writer_gang = false;	/* connect a writer gang at
+												 * session start */
+
 bool		Gp_write_shared_snapshot;	/* tell the writer QE to write the
 										 * shared snapshot */
 
@@ -198,6 +201,8 @@ int			Gp_interconnect_queue_depth = 4;	/* max number of messages
 												 * waiting in rx-queue before
 												 * we drop. */
 int			Gp_interconnect_snd_queue_depth = 2;
+int			Gp_interconnect_compress_level = 0;	/* zstd level for motion
+													 * packets, 0 = off */
 int			Gp_interconnect_cursor_ic_table_size = 128;
 int			Gp_interconnect_timer_period = 5;
 int			Gp_interconnect_timer_checking_period = 20;
@@ -289,6 +294,9 @@ int			gp_segworker_relative_priority = PRIO_MAX;
 /* Max size of dispatched plans; 0 if no limit */
 int			gp_max_plan_size = 0;
 
+/* Send only the digest of plans that QEs already have */
+bool		gp_enable_dispatch_plan_cache = false;
+
 /* Disable setting of tuple hints while reading */
 bool		gp_disable_tuple_hints = false;
 
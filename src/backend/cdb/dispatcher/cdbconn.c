@@ -90,6 +90,7 @@ cdbconn_createSegmentDescriptor(struct CdbComponentDatabaseInfo *cdbinfo, int id
 	segdbDesc->identifier = identifier;
 	segdbDesc->isWriter = isWriter;
 	segdbDesc->establishConnTime = 0;
+	segdbDesc->cachedPlans = NULL;
 
 	MemoryContextSwitchTo(oldContext);
 	return segdbDesc;
@@ -334,6 +335,13 @@ cdbconn_disconnect(SegmentDatabaseDescriptor *segdbDesc)
 
 	PQfinish(segdbDesc->conn);
 	segdbDesc->conn = NULL;
+
+	/* The QE is gone, and with it the plans it had cached */
+	if (segdbDesc->cachedPlans != NULL)
+	{
+		pfree(segdbDesc->cachedPlans);
+		segdbDesc->cachedPlans = NULL;
+	}
 }
 
 /*
@@ -28,6 +28,7 @@
 #include "libpq/pqformat.h"
 #include "cdb/cdbfts.h"
 #include "cdb/cdbgang.h"
+#include "cdb/cdbsrlz.h"
 #include "cdb/cdbsreh.h"
 #include "cdb/cdbvars.h"
 #include "utils/resowner.h"
@@ -331,6 +332,9 @@ cdbdisp_makeDispatcherState(bool isExtendedQuery)
 	handle->dispatcherState->largestGangSize = 0;
 	handle->dispatcherState->rootGangSize = 0;
 	handle->dispatcherState->destroyIdleReaderGang = false;
+	handle->dispatcherState->planId.size = 0;
+	handle->dispatcherState->cachedPlanQueryText = NULL;
+	handle->dispatcherState->cachedPlanQueryTextLen = 0;
 
 	return handle->dispatcherState;
 }
@@ -389,7 +393,22 @@ cdbdisp_destroyDispatcherState(CdbDispatcherState *ds)
 
 		for (i = 0; i < results->resultCount; i++)
 		{
-			cdbdisp_termResult(&results->resultArray[i]);
+			CdbDispatchResult *dispatchResult = &results->resultArray[i];
+
+			/*
+			 * A QE that completed the dispatched plan has it in its cache now.
+			 * Otherwise, it may or may not have it, and the slot stays
+			 * cleared, see cdbdisp_dispatchToGang_async().
+			 */
+			if (ds->planId.size != 0 &&
+				dispatchResult->segdbDesc &&
+				dispatchResult->segdbDesc->cachedPlans &&
+				dispatchResult->hasDispatched &&
+				!dispatchResult->stillRunning &&
+				dispatchResult->errcode == 0)
+				dispatchResult->segdbDesc->cachedPlans[DispatchPlanCacheSlot(&ds->planId)] = ds->planId;
+
+			cdbdisp_termResult(dispatchResult);
 		}
 		results->resultArray = NULL;
 	}
@@ -33,8 +33,11 @@
 #include "libpq-int.h"
 #include "cdb/cdbfts.h"
 #include "cdb/cdbgang.h"
+#include "cdb/cdbsrlz.h"
+#include "cdb/cdbtm.h"
 #include "cdb/cdbvars.h"
 #include "cdb/cdbpq.h"
+#include "cdb/cdbutil.h"
 #include "miscadmin.h"
 #include "commands/sequence.h"
 #include "access/xact.h"
@@ -55,6 +58,13 @@
 #define DISPATCH_NO_WAIT 0
 #define DISPATCH_WAIT_UNTIL_FINISH -1
 
+/*
+ * Bucket i of the dispatch latency histogram counts QEs that completed in
+ * [2^i, 2^(i+1)) microseconds after the command was sent; the last bucket
+ * holds everything slower.
+ */
+#define DISPATCH_LATENCY_BUCKETS 26
+
 typedef struct CdbDispatchCmdAsync
 {
 
@@ -93,6 +103,16 @@ typedef struct CdbDispatchCmdAsync
 	char	   *query_text;
 	int			query_text_len;
 
+	/*
+	 * Statistics for log_dispatch_stats: how many times we woke up to wait
+	 * for QEs, how many ready connections those wakeups returned, and a
+	 * log2 histogram of the time from sending the command to a QE to its
+	 * completion.
+	 */
+	long		nwakeups;
+	long		nreadyEvents;
+	int			latencyHist[DISPATCH_LATENCY_BUCKETS];
+
 } CdbDispatchCmdAsync;
 
 static void *cdbdisp_makeDispatchParams_async(int maxSlices, int largestGangSize, char *queryText, int len);
@@ -140,8 +160,16 @@ static void
 static void
 			handlePollError(CdbDispatchCmdAsync *pParms);
 
+static int
+			handlePollSuccess(CdbDispatchCmdAsync *pParms, WaitEvent *revents, int nready,
+							  int *ack_count, bool *rescan);
+
 static void
-			handlePollSuccess(CdbDispatchCmdAsync *pParms, WaitEvent *revents, int nready);
+			recordDispatchLatency(CdbDispatchCmdAsync *pParms,
+								  CdbDispatchResult *dispatchResult);
+
+static void
+			logDispatchLatency(CdbDispatchCmdAsync *pParms);
 
 static bool
 			checkAckMessage(CdbDispatchResult *dispatchResult, const char *message);
@@ -225,18 +253,32 @@ cdbdisp_waitDispatchFinish_async(struct CdbDispatcherState *ds)
 
 	WaitEvent 		*revents = palloc(sizeof(WaitEvent) * dispatchCount);
 	int 			*added = palloc0(sizeof(int) * dispatchCount);
+	int				npending = 0;
+	int				nready = 0;
+	bool			firstPass = true;
+
 	while (true)
 	{
 		int			pollRet;
-		bool		allFlushed = true;
+		int			n;
 
-		for (i = 0; i < dispatchCount; i++)
+		/*
+		 * The first pass tries every connection; after that, only those
+		 * the wait set reported writable need another send.
+		 */
+		n = firstPass ? dispatchCount : nready;
+		for (int j = 0; j < n; j++)
 		{
-			CdbDispatchResult *qeResult = pParms->dispatchResultPtrArray[i];
-			SegmentDatabaseDescriptor *segdbDesc = qeResult->segdbDesc;
-			PGconn	   *conn = segdbDesc->conn;
+			CdbDispatchResult *qeResult;
+			SegmentDatabaseDescriptor *segdbDesc;
+			PGconn	   *conn;
 			int			ret = 0;
 
+			i = firstPass ? j : (long) revents[j].user_data;
+			qeResult = pParms->dispatchResultPtrArray[i];
+			segdbDesc = qeResult->segdbDesc;
+			conn = segdbDesc->conn;
+
 			/* skip already completed connections */
 			if (conn->outCount == 0)
 				continue;
@@ -248,19 +290,23 @@ cdbdisp_waitDispatchFinish_async(struct CdbDispatcherState *ds)
 			ret = pqFlushNonBlocking(conn);
 
 			if (ret == 0)
+			{
+				if (added[i])
+					npending--;
 				continue;
+			}
 			else if (ret > 0)
 			{
 				/* add segment sock to the waitset */
 				if (!added[i])
 				{
 					int 	sock = PQsocket(conn);
+					long 	ev_userdata = i; /* the index "i" as the event's userdata */
 					Assert(sock >= 0);
-					AddWaitEventToSet(DispWaitSet, WL_SOCKET_WRITEABLE, sock, NULL, NULL);
+					AddWaitEventToSet(DispWaitSet, WL_SOCKET_WRITEABLE, sock, NULL, (void *)ev_userdata);
 					added[i] = 1;
+					npending++;
 				}
-
-				allFlushed = false;
 			}
 			else if (ret < 0)
 			{
@@ -273,8 +319,9 @@ cdbdisp_waitDispatchFinish_async(struct CdbDispatcherState *ds)
 						errmsg("Command could not be dispatch to segment %s: %s", qeResult->segdbDesc->whoami, msg ? msg : "unknown error")));
 			}
 		}
+		firstPass = false;
 
-		if (allFlushed)
+		if (npending == 0)
 			break;
 
 		/* guarantee poll() is interruptible */
@@ -288,6 +335,7 @@ cdbdisp_waitDispatchFinish_async(struct CdbDispatcherState *ds)
 				ELOG_DISPATCHER_DEBUG("cdbdisp_waitDispatchFinish_async(): Dispatch poll timeout after %d ms", DISPATCH_POLL_TIMEOUT);
 		}
 		while (pollRet == 0);
+		nready = pollRet;
 	}
 	pfree(revents);
 	pfree(added);
@@ -329,6 +377,36 @@ cdbdisp_dispatchToGang_async(struct CdbDispatcherState *ds,
 		}
 		pParms->dispatchResultPtrArray[pParms->dispatchCount++] = qeResult;
 
+		if (ds->planId.size != 0)
+		{
+			DispatchPlanId *cached;
+			bool		hit;
+
+			if (segdbDesc->cachedPlans == NULL)
+				segdbDesc->cachedPlans =
+					MemoryContextAllocZero(CdbComponentsContext,
+										   DISPATCH_PLAN_CACHE_SLOTS * sizeof(DispatchPlanId));
+			cached = &segdbDesc->cachedPlans[DispatchPlanCacheSlot(&ds->planId)];
+
+			/* Anything but an exact match gets the full plan */
+			hit = cached->size != 0 && DispatchPlanIdEquals(cached, &ds->planId);
+
+			/*
+			 * The QE is going to replace whatever it has in the slot, or may
+			 * fail to find the plan; we'll know it has the plan only when it
+			 * completes.  Until then, and for good if it fails, the next
+			 * dispatch to it sends the full plan.
+			 */
+			cached->size = 0;
+
+			if (hit)
+			{
+				dispatchCommand(qeResult, ds->cachedPlanQueryText,
+								ds->cachedPlanQueryTextLen);
+				continue;
+			}
+		}
+
 		dispatchCommand(qeResult, pParms->query_text, pParms->query_text_len);
 	}
 }
@@ -409,6 +487,9 @@ cdbdisp_checkDispatchResult_async(struct CdbDispatcherState *ds,
 		pParms->waitMode = waitMode;
 
 	checkDispatchResult(ds, DISPATCH_WAIT_UNTIL_FINISH);
+
+	if (log_dispatch_stats)
+		logDispatchLatency(pParms);
 }
 
 /*
@@ -461,6 +542,9 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 	ResetWaitEventSet(&DispWaitSet, TopMemoryContext, db_count);
 	int 	*added = palloc0(db_count * sizeof(int));
 	WaitEvent *revents = palloc(sizeof(WaitEvent) * db_count);
+	int			nfds = 0;
+	int			ack_count = 0;
+	bool		rescan = true;
 
 	/*
 	 * OK, we are finished submitting the command to the segdbs. Now, we have
@@ -470,8 +554,7 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 	for (;;)
 	{
 		int			n;
-		int			nfds = 0;
-		int			ack_count = 0;
+		bool		scan;
 		PGconn		*conn;
 
 		/*
@@ -497,8 +580,20 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 
 		/*
 		 * Which QEs are still running and could send results to us?
+		 *
+		 * With thousands of connections, walking all of them on every wakeup
+		 * costs more than the wait itself. So we only do that the first time
+		 * through and after something other than a QE's own input (an error,
+		 * a timeout, a signal) may have changed their state. In between,
+		 * handlePollSuccess() keeps nfds and ack_count up to date while it
+		 * looks at just the connections that are ready.
 		 */
-		for (i = 0; i < db_count; i++)
+		scan = rescan;
+		rescan = false;
+		if (scan)
+			nfds = ack_count = 0;
+
+		for (i = 0; scan && i < db_count; i++)
 		{
 			dispatchResult = pParms->dispatchResultPtrArray[i];
 			segdbDesc = dispatchResult->segdbDesc;
@@ -587,6 +682,10 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 				added[i] = 1;
 			}
 			nfds++;
+
+			/* keep scanning while there are commands not fully sent */
+			if (conn->outCount > 0)
+				rescan = true;
 		}
 
 		/*
@@ -614,6 +713,7 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 			timeout = DISPATCH_WAIT_CANCEL_TIMEOUT_MSEC;
 
 		n = WaitEventSetWait(DispWaitSet, timeout, revents, db_count, WAIT_EVENT_DISP_RESULT);
+		pParms->nwakeups++;
 
 		/*
 		 * poll returns with an error, including one due to an interrupted
@@ -629,6 +729,7 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 			elog(LOG, "handlePollError poll() failed; errno=%d", sock_errno);
 
 			handlePollError(pParms);
+			rescan = true;
 
 			/*
 			 * Since an error was detected for the segment, request
@@ -654,6 +755,8 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 		/* If the time limit expires, poll() returns 0 */
 		else if (n == 0)
 		{
+			rescan = true;
+
 			if (pParms->waitMode != DISPATCH_WAIT_NONE &&
 				pParms->waitMode != DISPATCH_WAIT_ACK_ROOT)
 			{
@@ -682,7 +785,10 @@ checkDispatchResult(CdbDispatcherState *ds, int timeout_sec)
 		}
 		/* We have data waiting on one or more of the connections. */
 		else
-			handlePollSuccess(pParms, revents, n);
+		{
+			pParms->nreadyEvents += n;
+			nfds -= handlePollSuccess(pParms, revents, n, &ack_count, &rescan);
+		}
 	} /* for (;;) */
 
 	pfree(revents);
@@ -701,7 +807,7 @@ dispatchCommand(CdbDispatchResult *dispatchResult,
 	long		secs;
 	int			usecs;
 
-	if (DEBUG1 >= log_min_messages)
+	if (DEBUG1 >= log_min_messages || log_dispatch_stats)
 		beforeSend = GetCurrentTimestamp();
 
 	/*
@@ -735,6 +841,7 @@ dispatchCommand(CdbDispatchResult *dispatchResult,
 	 */
 	dispatchResult->stillRunning = true;
 	dispatchResult->hasDispatched = true;
+	dispatchResult->dispatchTime = log_dispatch_stats ? beforeSend : 0;
 
 	ELOG_DISPATCHER_DEBUG("Command dispatched to QE (%s)", dispatchResult->segdbDesc->whoami);
 }
@@ -823,12 +930,19 @@ handlePollError(CdbDispatchCmdAsync *pParms)
 
 /*
  * Receive and process results from QEs.
+ *
+ * Only the connections in revents are looked at. Returns the number of them
+ * that we no longer need to wait for, because they finished or, in
+ * DISPATCH_WAIT_ACK_ROOT mode, acknowledged; the latter are also counted in
+ * *ack_count. *rescan is set if a connection is left with unsent output.
  */
-static void
+static int
 handlePollSuccess(CdbDispatchCmdAsync *pParms,
-				  WaitEvent *revents, int nready)
+				  WaitEvent *revents, int nready,
+				  int *ack_count, bool *rescan)
 {
 	int			i = 0;
+	int			ndone = 0;
 
 	/*
 	 * We have data waiting on one or more of the connections.
@@ -872,12 +986,24 @@ handlePollSuccess(CdbDispatchCmdAsync *pParms,
 		 */
 		finished = processResults(dispatchResult);
 
+		if (pParms->waitMode == DISPATCH_WAIT_ACK_ROOT &&
+			checkAckMessage(dispatchResult, pParms->ackMessage))
+		{
+			(*ack_count)++;
+			ndone++;
+		}
+		else if (finished)
+			ndone++;
+		else if (segdbDesc->conn->outCount > 0)
+			*rescan = true;
+
 		/*
 		 * Are we through with this QE now?
 		 */
 		if (finished)
 		{
 			dispatchResult->stillRunning = false;
+			recordDispatchLatency(pParms, dispatchResult);
 
 			ELOG_DISPATCHER_DEBUG("processResults says we are finished with %ld of %d (%s)",
 								  pos + 1, pParms->dispatchCount, segdbDesc->whoami);
@@ -904,6 +1030,79 @@ handlePollSuccess(CdbDispatchCmdAsync *pParms,
 			ELOG_DISPATCHER_DEBUG("processResults says we have more to do with %ld of %d (%s)",
 								  pos + 1, pParms->dispatchCount, segdbDesc->whoami);
 	}
+
+	return ndone;
+}
+
+/*
+ * Add the time a QE took to complete its command to the latency histogram.
+ */
+static void
+recordDispatchLatency(CdbDispatchCmdAsync *pParms,
+					  CdbDispatchResult *dispatchResult)
+{
+	long		secs;
+	int			usecs;
+	uint64		elapsed;
+	int			bucket = 0;
+
+	if (dispatchResult->dispatchTime == 0)
+		return;
+
+	TimestampDifference(dispatchResult->dispatchTime, GetCurrentTimestamp(),
+						&secs, &usecs);
+	elapsed = (uint64) secs * 1000000 + usecs;
+
+	while (elapsed > 1 && bucket < DISPATCH_LATENCY_BUCKETS - 1)
+	{
+		elapsed >>= 1;
+		bucket++;
+	}
+	pParms->latencyHist[bucket]++;
+	dispatchResult->dispatchTime = 0;
+}
+
+/*
+ * Report the dispatch latency histogram and wakeup counts collected since
+ * the last report, for log_dispatch_stats.
+ */
+static void
+logDispatchLatency(CdbDispatchCmdAsync *pParms)
+{
+	StringInfoData buf;
+	int			nqes = 0;
+
+	for (int i = 0; i < DISPATCH_LATENCY_BUCKETS; i++)
+		nqes += pParms->latencyHist[i];
+
+	if (nqes == 0 && pParms->nwakeups == 0)
+		return;
+
+	initStringInfo(&buf);
+	appendStringInfo(&buf, "%d QEs completed, %ld wakeups returned %ld ready connections",
+					 nqes, pParms->nwakeups, pParms->nreadyEvents);
+
+	for (int i = 0; i < DISPATCH_LATENCY_BUCKETS; i++)
+	{
+		if (pParms->latencyHist[i] == 0)
+			continue;
+		if (i == DISPATCH_LATENCY_BUCKETS - 1)
+			appendStringInfo(&buf, "\n  >= " UINT64_FORMAT " us: %d",
+							 UINT64CONST(1) << i, pParms->latencyHist[i]);
+		else
+			appendStringInfo(&buf, "\n  " UINT64_FORMAT " - " UINT64_FORMAT " us: %d",
+							 UINT64CONST(1) << i, (UINT64CONST(1) << (i + 1)) - 1,
+							 pParms->latencyHist[i]);
+	}
+
+	ereport(LOG,
+			(errmsg("dispatch latency"),
+			 errdetail_internal("%s", buf.data)));
+	pfree(buf.data);
+
+	pParms->nwakeups = 0;
+	pParms->nreadyEvents = 0;
+	memset(pParms->latencyHist, 0, sizeof(pParms->latencyHist));
 }
 
 /*
@@ -1094,6 +1293,7 @@ processResults(CdbDispatchResult *dispatchResult)
 		if (segdbDesc->conn->wrote_xlog)
 		{
 			MarkTopTransactionWriteXLogOnExecutor();
+			addToGxactXLogSegments(segdbDesc->segindex);
 
 			/*
 			 * Reset the worte_xlog here. Since if the received pgresult not process
@@ -51,6 +51,14 @@
 
 #define QUERY_STRING_TRUNCATE_SIZE (1024)
 
+/*
+ * Smaller plans are cheap enough to send every time, don't cache them in QEs.
+ * Larger ones aren't cached either, so that a QE holds at most
+ * DISPATCH_PLAN_CACHE_SLOTS * DISPATCH_PLAN_CACHE_MAX_SIZE bytes of plans.
+ */
+#define DISPATCH_PLAN_CACHE_MIN_SIZE (4 * 1024)
+#define DISPATCH_PLAN_CACHE_MAX_SIZE (1024 * 1024)
+
 extern bool Test_print_direct_dispatch_info;
 
 extern bool gp_print_create_gang_time;
@@ -84,6 +92,7 @@ typedef struct DispatchCommandQueryParms
 	int			strCommandlen;
 	char	   *serializedPlantree;
 	int			serializedPlantreelen;
+	DispatchPlanId serializedPlantreeId;	/* for QEs to cache it, or size 0 */
 	char	   *serializedQueryDispatchDesc;
 	int			serializedQueryDispatchDesclen;
 
@@ -666,6 +675,10 @@ cdbdisp_buildPlanQueryParms(struct QueryDesc *queryDesc,
 	pQueryParms->strCommand = queryDesc->sourceText;
 	pQueryParms->serializedPlantree = splan;
 	pQueryParms->serializedPlantreelen = splan_len;
+	if (gp_enable_dispatch_plan_cache &&
+		splan_len >= DISPATCH_PLAN_CACHE_MIN_SIZE &&
+		splan_len <= DISPATCH_PLAN_CACHE_MAX_SIZE)
+		computeDispatchPlanId(splan, splan_len, &pQueryParms->serializedPlantreeId);
 	pQueryParms->serializedQueryDispatchDesc = sddesc;
 	pQueryParms->serializedQueryDispatchDesclen = sddesc_len;
 
@@ -861,6 +874,7 @@ buildGpQueryString(DispatchCommandQueryParms *pQueryParms,
 	int			is_hs_dispatch = IS_HOT_STANDBY_QD() ? 1 : 0;
 	const char *plantree = pQueryParms->serializedPlantree;
 	int			plantree_len = pQueryParms->serializedPlantreelen;
+	const DispatchPlanId *plantree_id = &pQueryParms->serializedPlantreeId;
 	const char *sddesc = pQueryParms->serializedQueryDispatchDesc;
 	int			sddesc_len = pQueryParms->serializedQueryDispatchDesclen;
 	const char *dtxContextInfo = pQueryParms->serializedDtxContextInfo;
@@ -916,6 +930,8 @@ buildGpQueryString(DispatchCommandQueryParms *pQueryParms,
 		sizeof(is_hs_dispatch) +
 		sizeof(command_len) +
 		sizeof(plantree_len) +
+		sizeof(plantree_id->size) +
+		(plantree_id->size != 0 ? sizeof(plantree_id->digest) : 0) +
 		sizeof(sddesc_len) +
 		sizeof(dtxContextInfo_len) +
 		dtxContextInfo_len +
@@ -981,6 +997,16 @@ buildGpQueryString(DispatchCommandQueryParms *pQueryParms,
 	memcpy(pos, &tmp, sizeof(plantree_len));
 	pos += sizeof(plantree_len);
 
+	tmp = htonl(plantree_id->size);
+	memcpy(pos, &tmp, sizeof(plantree_id->size));
+	pos += sizeof(plantree_id->size);
+
+	if (plantree_id->size != 0)
+	{
+		memcpy(pos, plantree_id->digest, sizeof(plantree_id->digest));
+		pos += sizeof(plantree_id->digest);
+	}
+
 	tmp = htonl(sddesc_len);
 	memcpy(pos, &tmp, sizeof(tmp));
 	pos += sizeof(tmp);
@@ -1110,6 +1136,23 @@ cdbdisp_dispatchX(QueryDesc* queryDesc,
 	pQueryParms = cdbdisp_buildPlanQueryParms(queryDesc, planRequiresTxn);
 	queryText = buildGpQueryString(pQueryParms, &queryTextLength);
 
+	/*
+	 * QEs that still have the plan from an earlier dispatch get a version of
+	 * the query text without it.  The dispatcher keeps track of that in the
+	 * segment descriptors.  Note that a QE always caches a plan in the slot
+	 * given by its digest, and the dispatcher only takes it as cached once
+	 * the QE completed the query.
+	 */
+	if (pQueryParms->serializedPlantreeId.size != 0)
+	{
+		DispatchCommandQueryParms cachedPlanParms = *pQueryParms;
+
+		cachedPlanParms.serializedPlantreelen = 0;
+		ds->planId = pQueryParms->serializedPlantreeId;
+		ds->cachedPlanQueryText = buildGpQueryString(&cachedPlanParms,
+													 &ds->cachedPlanQueryTextLen);
+	}
+
 	/*
 	 * Allocate result array with enough slots for QEs of primary gangs.
 	 */
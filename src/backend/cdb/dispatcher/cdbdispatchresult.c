@@ -212,6 +212,7 @@ cdbdisp_resetResult(CdbDispatchResult *dispatchResult)
 	dispatchResult->receivedAckMsg = false;
 	dispatchResult->sentSignal = DISPATCH_WAIT_NONE;
 	dispatchResult->wasCanceled = false;
+	dispatchResult->dispatchTime = 0;
 
 	/*
 	 * Empty (but don't free) the error message buffer and result buffer.
@@ -47,6 +47,8 @@
 #include "funcapi.h"
 #include "utils/builtins.h"
 
+extern bool gp_print_create_gang_time;
+
 /*
  * All QEs are managed by cdb_component_dbs in QD, QD assigned
  * a unique identifier for each QE, when a QE is created, this
@@ -1004,6 +1006,69 @@ ResetAllGangs(void)
 	GpDropTempTables();
 }
 
+/*
+ * Connect a writer gang on all segments once, at the start of a session,
+ * and leave its QEs idle for the first query to pick up.
+ *
+ * This is called while the client is preparing its first command, so the
+ * cost of forking and authenticating the QEs overlaps with the client's
+ * think time instead of adding to its first query. Failures are only
+ * logged; the first query will try again the usual way.
+ *
+ * Returns true if the gang was created.
+ */
+bool
+PrewarmWriterGang(void)
+{
+	static bool done = false;
+	MemoryContext oldcontext = CurrentMemoryContext;
+	volatile bool created = false;
+
+	if (done)
+		return false;
+	done = true;
+
+	if (Gp_role != GP_ROLE_DISPATCH || !gp_prewarm_writer_gang ||
+		IsTransactionOrTransactionBlock() || cdbcomponent_qesExist())
+		return false;
+
+	StartTransactionCommand();
+	PG_TRY();
+	{
+		CdbDispatcherState *ds = cdbdisp_makeDispatcherState(false);
+		Gang	   *gang;
+
+		gang = AllocateGang(ds, GANGTYPE_PRIMARY_WRITER,
+							cdbcomponent_getCdbComponentsList());
+		if (gp_print_create_gang_time)
+			printCreateGangTime(-1, gang);
+
+		/* hands the QEs back to the idle pool */
+		cdbdisp_destroyDispatcherState(ds);
+		CommitTransactionCommand();
+		created = true;
+	}
+	PG_CATCH();
+	{
+		ErrorData  *edata;
+
+		MemoryContextSwitchTo(oldcontext);
+		edata = CopyErrorData();
+		FlushErrorState();
+		AbortCurrentTransaction();
+		MemoryContextSwitchTo(oldcontext);
+
+		ereport(LOG,
+				(errmsg("could not pre-warm writer gang: %s", edata->message)));
+		FreeErrorData(edata);
+	}
+	PG_END_TRY();
+
+	MemoryContextSwitchTo(oldcontext);
+
+	return created;
+}
+
 /*
  * Used by gp_backend_info() to find a single character that represents a
  * backend type.
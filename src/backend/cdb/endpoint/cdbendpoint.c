@@ -28,11 +28,12 @@
  * endpoint queries or on QE's retrieve session by UDF gp_get_segment_endpoints().
  *
  * Instead of returning the query result to QD through a normal dest receiver,
- * endpoints write the results to TQueueDestReceiver which is a shared memory
- * queue and can be retrieved from a different process. See
- * SetupEndpointExecState(). The information about the message queue
- * is also stored in the Endpoint so that the retrieve session on the same QE
- * can know.
+ * endpoints write the results to a shared memory message queue which can be
+ * retrieved from a different process. See SetupEndpointExecState(). Tuples are
+ * packed several to a message, up to gp_endpoint_batch_size, to keep the
+ * per-message synchronization of shm_mq off the per-tuple path. The
+ * information about the message queue is also stored in the Endpoint so that
+ * the retrieve session on the same QE can know.
  *
  * The token is stored in a different structure EndpointTokenEntry to make the
  * tokens same for all backends within the same session under the same postmaster.
@@ -86,12 +87,6 @@
 
 #define WAIT_ENDPOINT_TIMEOUT_MS	100
 
-/*
- * The size of endpoint tuple queue in bytes.
- * This value refers upstream PARALLEL_TUPLE_QUEUE_SIZE
- */
-#define ENDPOINT_TUPLE_QUEUE_SIZE		65536
-
 #define SHMEM_ENDPOINTS_ENTRIES			"SharedMemoryEndpointEntries"
 #define SHMEM_ENPOINTS_SESSION_INFO		"EndpointsSessionInfosHashtable"
 #define SHMEM_PARALLEL_CURSOR_COUNT		"ParallelCursorCount"
@@ -103,6 +98,20 @@
 
 static EndpointExecState * CurrentEndpointExecState;
 
+/*
+ * DestReceiver that sends tuples to the endpoint's message queue in batches.
+ * See ENDPOINT_BATCH_ITEMSZ() for the layout of a batch.
+ */
+typedef struct EndpointDestReceiver
+{
+	DestReceiver pub;			/* public fields */
+	shm_mq_handle *queue;		/* shm_mq to send to */
+	Endpoint   *endpoint;		/* to publish statistics in */
+	Size		batchSize;		/* send the batch once it is this large */
+	StringInfoData batch;		/* tuples not sent yet */
+	uint64		batchTuples;	/* number of tuples in batch */
+} EndpointDestReceiver;
+
 typedef struct EndpointTokenTag
 {
 	int			sessionID;
@@ -145,6 +154,9 @@ static void free_endpoint(Endpoint *endpoint);
 static void create_and_connect_mq(TupleDesc tupleDesc,
 								  dsm_segment **mqSeg /* out */ ,
 								  shm_mq_handle **mqHandle /* out */ );
+static DestReceiver *create_endpoint_dest_receiver(shm_mq_handle *handle,
+												   Endpoint *endpoint);
+static bool flush_endpoint_batch(EndpointDestReceiver *receiver);
 static void detach_mq(dsm_segment *dsmSeg);
 static void setup_endpoint_token_entry(void);
 static void wait_receiver(void);
@@ -336,7 +348,8 @@ SetupEndpointExecState(TupleDesc tupleDesc, const char *cursorName,
 		alloc_endpoint(cursorName, dsm_segment_handle(CurrentEndpointExecState->dsmSeg));
 	setup_endpoint_token_entry();
 
-	CurrentEndpointExecState->dest = CreateTupleQueueDestReceiver(shmMqHandle);
+	CurrentEndpointExecState->dest =
+		create_endpoint_dest_receiver(shmMqHandle, CurrentEndpointExecState->endpoint);
 	(CurrentEndpointExecState->dest->rStartup)(CurrentEndpointExecState->dest, operation, tupleDesc);
 	*endpointDest = CurrentEndpointExecState->dest;
 }
@@ -359,6 +372,12 @@ DestroyEndpointExecState()
 	Assert(CurrentEndpointExecState->endpoint);
 	Assert(CurrentEndpointExecState->dsmSeg);
 
+	/*
+	 * Send the last, partial batch. This is not done in the rShutdown
+	 * callback, which also runs on abort.
+	 */
+	flush_endpoint_batch((EndpointDestReceiver *) endpointDest);
+
 	/*
 	 * wait for receiver to start tuple retrieving. ackDone latch will be
 	 * reset to be re-used when retrieving finished. See notify_sender()
@@ -493,6 +512,8 @@ static Endpoint
 	sharedEndpoints[i].empty = false;
 	sharedEndpoints[i].mqDsmHandle = dsmHandle;
 	sharedEndpoints[i].sessionDsmHandle = session_dsm_handle;
+	sharedEndpoints[i].tuplesSent = 0;
+	sharedEndpoints[i].bytesSent = 0;
 	OwnLatch(&sharedEndpoints[i].ackDone);
 	ret = &sharedEndpoints[i];
 
@@ -534,7 +555,7 @@ create_and_connect_mq(TupleDesc tupleDesc, dsm_segment **mqSeg /* out */ ,
 	shm_toc_initialize_estimator(&tocEst);
 	shm_toc_estimate_chunk(&tocEst, sizeof(tupdescLen));
 	shm_toc_estimate_chunk(&tocEst, tupdescLen);
-	shm_toc_estimate_chunk(&tocEst, ENDPOINT_TUPLE_QUEUE_SIZE);
+	shm_toc_estimate_chunk(&tocEst, (Size) gp_endpoint_tuple_queue_size * 1024);
 	shm_toc_estimate_keys(&tocEst, 3);
 	tocSize = shm_toc_estimate(&tocEst);
 
@@ -554,8 +575,8 @@ create_and_connect_mq(TupleDesc tupleDesc, dsm_segment **mqSeg /* out */ ,
 	memcpy(tupdescSpace, tupdescSer, tupdescLen);
 	shm_toc_insert(toc, ENDPOINT_KEY_TUPLE_DESC, tupdescSpace);
 
-	mq = shm_mq_create(shm_toc_allocate(toc, ENDPOINT_TUPLE_QUEUE_SIZE),
-					   ENDPOINT_TUPLE_QUEUE_SIZE);
+	mq = shm_mq_create(shm_toc_allocate(toc, (Size) gp_endpoint_tuple_queue_size * 1024),
+					   (Size) gp_endpoint_tuple_queue_size * 1024);
 	shm_toc_insert(toc, ENDPOINT_KEY_TUPLE_QUEUE, mq);
 	shm_mq_set_sender(mq, MyProc);
 	*mqHandle = shm_mq_attach(mq, *mqSeg, NULL);
@@ -564,6 +585,136 @@ create_and_connect_mq(TupleDesc tupleDesc, dsm_segment **mqSeg /* out */ ,
 						errmsg("attach to endpoint shared message queue failed")));
 }
 
+/*
+ * Send the tuples in the batch to the message queue.
+ *
+ * Returns true if successful, false if the receiver has detached.
+ */
+static bool
+flush_endpoint_batch(EndpointDestReceiver *receiver)
+{
+	shm_mq_result result;
+
+	if (receiver->queue == NULL || receiver->batch.len == 0)
+		return true;
+
+	result = shm_mq_send(receiver->queue, receiver->batch.len, receiver->batch.data, false);
+
+	/* Only the sender writes these, readers look at them under the lock. */
+	receiver->endpoint->tuplesSent += receiver->batchTuples;
+	receiver->endpoint->bytesSent += receiver->batch.len;
+
+	resetStringInfo(&receiver->batch);
+	receiver->batchTuples = 0;
+
+	if (result == SHM_MQ_DETACHED)
+		return false;
+	else if (result != SHM_MQ_SUCCESS && result != SHM_MQ_QUERY_FINISH)
+		ereport(ERROR,
+				(errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+				 errmsg("could not send tuple to shared-memory queue")));
+
+	return true;
+}
+
+/*
+ * Add a tuple to the batch, and send the batch when it is full.
+ *
+ * Returns true if successful, false if the receiver has detached.
+ */
+static bool
+endpoint_receive_slot(TupleTableSlot *slot, DestReceiver *self)
+{
+	EndpointDestReceiver *receiver = (EndpointDestReceiver *) self;
+	HeapTuple	tuple;
+	bool		should_free;
+	bool		ok = true;
+	Size		itemSize;
+	char	   *item;
+
+	tuple = ExecFetchSlotHeapTuple(slot, true, &should_free);
+	itemSize = ENDPOINT_BATCH_ITEMSZ(tuple->t_len);
+
+	/* Don't let a large tuple grow the batch much past its size. */
+	if (receiver->batch.len > 0 && receiver->batch.len + itemSize > receiver->batchSize)
+		ok = flush_endpoint_batch(receiver);
+
+	if (ok)
+	{
+		enlargeStringInfo(&receiver->batch, itemSize);
+		item = receiver->batch.data + receiver->batch.len;
+
+		MemSet(item, 0, itemSize);
+		memcpy(item, &tuple->t_len, sizeof(uint32));
+		memcpy(item + ENDPOINT_BATCH_HDRSZ, tuple->t_data, tuple->t_len);
+		receiver->batch.len += itemSize;
+		receiver->batchTuples++;
+
+		if (receiver->batch.len >= receiver->batchSize)
+			ok = flush_endpoint_batch(receiver);
+	}
+
+	if (should_free)
+		heap_freetuple(tuple);
+
+	return ok;
+}
+
+static void
+endpoint_startup_receiver(DestReceiver *self, int operation, TupleDesc typeinfo)
+{
+	/* do nothing */
+}
+
+/*
+ * Detach from the message queue. A partial batch is dropped here, the normal
+ * end of execution sends it first, see DestroyEndpointExecState().
+ */
+static void
+endpoint_shutdown_receiver(DestReceiver *self)
+{
+	EndpointDestReceiver *receiver = (EndpointDestReceiver *) self;
+
+	if (receiver->queue != NULL)
+		shm_mq_detach(receiver->queue);
+	receiver->queue = NULL;
+}
+
+static void
+endpoint_destroy_receiver(DestReceiver *self)
+{
+	EndpointDestReceiver *receiver = (EndpointDestReceiver *) self;
+
+	/* We probably already detached from queue, but let's be sure */
+	if (receiver->queue != NULL)
+		shm_mq_detach(receiver->queue);
+	pfree(receiver->batch.data);
+	pfree(self);
+}
+
+/*
+ * Create a DestReceiver that sends tuples to the endpoint's message queue.
+ */
+static DestReceiver *
+create_endpoint_dest_receiver(shm_mq_handle *handle, Endpoint *endpoint)
+{
+	EndpointDestReceiver *self;
+
+	self = (EndpointDestReceiver *) palloc0(sizeof(EndpointDestReceiver));
+
+	self->pub.receiveSlot = endpoint_receive_slot;
+	self->pub.rStartup = endpoint_startup_receiver;
+	self->pub.rShutdown = endpoint_shutdown_receiver;
+	self->pub.rDestroy = endpoint_destroy_receiver;
+	self->pub.mydest = DestTupleQueue;
+	self->queue = handle;
+	self->endpoint = endpoint;
+	self->batchSize = (Size) gp_endpoint_batch_size * 1024;
+	initStringInfo(&self->batch);
+
+	return (DestReceiver *) self;
+}
+
 /*
  * Create/reuse EndpointTokenEntry for current session in shared memory.
  * EndpointTokenEntry is used for authentication in the retrieve sessions.
@@ -28,6 +28,14 @@
 
 #define ENDPOINT_MSG_QUEUE_MAGIC		0x1949100119980802U
 
+/*
+ * A message in the endpoint tuple queue is a batch of tuples. Each tuple is
+ * its length as a uint32, then the HeapTupleHeader and data, both padded to
+ * MAXALIGN so that the receiver can use the tuples in place.
+ */
+#define ENDPOINT_BATCH_HDRSZ			MAXALIGN(sizeof(uint32))
+#define ENDPOINT_BATCH_ITEMSZ(len)		(ENDPOINT_BATCH_HDRSZ + MAXALIGN(len))
+
 /*
  * Naming rules for endpoint:
  * cursorname_sessionIdHex_segIndexHex
@@ -82,8 +82,11 @@ typedef struct RetrieveExecEntry
 	shm_mq_handle *mqHandle;
 	/* tuple slot used for retrieve data */
 	TupleTableSlot *retrieveTs;
-	/* TupleQueueReader to read tuple from message queue */
-	TupleQueueReader *tqReader;
+	/* Batch of tuples last received from message queue */
+	char	   *batchData;
+	Size		batchLen;
+	Size		batchOffset;	/* next tuple in batchData */
+	HeapTupleData batchTuple;	/* points to the current tuple in batchData */
 	/* Track retrieve state */
 	enum RetrieveState retrieveState;
 }			RetrieveExecEntry;
@@ -234,6 +237,9 @@ init_retrieve_exec_entry(RetrieveExecEntry * entry)
 	entry->endpoint = NULL;
 	entry->mqHandle = NULL;
 	entry->retrieveTs = NULL;
+	entry->batchData = NULL;
+	entry->batchLen = 0;
+	entry->batchOffset = 0;
 	entry->retrieveState = RETRIEVE_STATE_INIT;
 }
 
@@ -482,8 +488,9 @@ attach_receiver_mq(dsm_handle dsmHandle)
 	else
 		entry->retrieveTs = MakeTupleTableSlot(td, &TTSOpsHeapTuple);
 
-	/* Create the tuple queue reader. */
-	entry->tqReader = CreateTupleQueueReader(entry->mqHandle);
+	entry->batchData = NULL;
+	entry->batchLen = 0;
+	entry->batchOffset = 0;
 	entry->retrieveState = RETRIEVE_STATE_ATTACHED;
 
 	MemoryContextSwitchTo(oldcontext);
@@ -520,6 +527,57 @@ notify_sender(bool finished)
 	LWLockRelease(ParallelCursorEndpointLock);
 }
 
+/*
+ * Return the next tuple of the current batch, receiving a new batch from the
+ * message queue when this one is used up.
+ *
+ * The tuple points into the message, which stays valid until the next
+ * shm_mq_receive(), i.e. until the next call. Returns NULL if nowait is true
+ * and no batch is ready yet, or if the sender has detached, in which case
+ * *done is set to true.
+ */
+static HeapTuple
+receive_batched_tuple(RetrieveExecEntry * entry, bool nowait, bool *done)
+{
+	uint32		len;
+
+	*done = false;
+
+	if (entry->batchOffset >= entry->batchLen)
+	{
+		shm_mq_result result;
+		Size		nbytes;
+		void	   *data;
+
+		result = shm_mq_receive(entry->mqHandle, &nbytes, &data, nowait);
+		if (result == SHM_MQ_DETACHED)
+		{
+			*done = true;
+			return NULL;
+		}
+		if (result == SHM_MQ_WOULD_BLOCK)
+			return NULL;
+		Assert(result == SHM_MQ_SUCCESS);
+		Assert(nbytes >= ENDPOINT_BATCH_HDRSZ);
+
+		entry->batchData = data;
+		entry->batchLen = nbytes;
+		entry->batchOffset = 0;
+	}
+
+	memcpy(&len, entry->batchData + entry->batchOffset, sizeof(uint32));
+	Assert(entry->batchOffset + ENDPOINT_BATCH_ITEMSZ(len) <= entry->batchLen);
+
+	ItemPointerSetInvalid(&entry->batchTuple.t_self);
+	entry->batchTuple.t_tableOid = InvalidOid;
+	entry->batchTuple.t_len = len;
+	entry->batchTuple.t_data =
+		(HeapTupleHeader) (entry->batchData + entry->batchOffset + ENDPOINT_BATCH_HDRSZ);
+	entry->batchOffset += ENDPOINT_BATCH_ITEMSZ(len);
+
+	return &entry->batchTuple;
+}
+
 /*
  * Read a tuple from shared memory message queue.
  *
@@ -542,7 +600,7 @@ retrieve_next_tuple()
 		 * try to receive data with nowait, so that empty result will not hang
 		 * here
 		 */
-		tup = TupleQueueReaderNext(entry->tqReader, true, &readerdone);
+		tup = receive_batched_tuple(entry, true, &readerdone);
 
 		entry->retrieveState = RETRIEVE_STATE_RECEIVING;
 
@@ -562,14 +620,15 @@ retrieve_next_tuple()
 	 * the first time retrieve an invalid data, but not finish
 	 */
 	if (readerdone == false && tup == NULL)
-		tup = TupleQueueReaderNext(entry->tqReader, false, &readerdone);
+		tup = receive_batched_tuple(entry, false, &readerdone);
 
 	/* readerdone returns true only after sender detached message queue */
 	if (readerdone)
 	{
 		Assert(!tup);
-		DestroyTupleQueueReader(entry->tqReader);
-		entry->tqReader = NULL;
+		entry->batchData = NULL;
+		entry->batchLen = 0;
+		entry->batchOffset = 0;
 
 		/*
 		 * dsm_detach will send SIGUSR1 to sender which may interrupt the
@@ -407,8 +407,8 @@ gp_get_segment_endpoints(PG_FUNCTION_ARGS)
 
 	FuncCallContext *funcctx;
 	MemoryContext oldcontext;
-	Datum		values[10];
-	bool		nulls[10];
+	Datum		values[12];
+	bool		nulls[12];
 	HeapTuple	tuple;
 	int		   *endpoint_idx;
 
@@ -421,7 +421,7 @@ gp_get_segment_endpoints(PG_FUNCTION_ARGS)
 		oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
 
 		/* build tuple descriptor */
-		TupleDesc	tupdesc = CreateTemplateTupleDesc(10);
+		TupleDesc	tupdesc = CreateTemplateTupleDesc(12);
 
 		TupleDescInitEntry(tupdesc, (AttrNumber) 1, "auth_token", TEXTOID, -1, 0);
 		TupleDescInitEntry(tupdesc, (AttrNumber) 2, "databaseid", OIDOID, -1, 0);
@@ -433,6 +433,8 @@ gp_get_segment_endpoints(PG_FUNCTION_ARGS)
 		TupleDescInitEntry(tupdesc, (AttrNumber) 8, "username", TEXTOID, -1, 0);
 		TupleDescInitEntry(tupdesc, (AttrNumber) 9, "endpointname", TEXTOID, -1, 0);
 		TupleDescInitEntry(tupdesc, (AttrNumber) 10, "cursorname", TEXTOID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 11, "tuplessent", INT8OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 12, "bytessent", INT8OID, -1, 0);
 
 		funcctx->tuple_desc = BlessTupleDesc(tupdesc);
 
@@ -478,6 +480,8 @@ gp_get_segment_endpoints(PG_FUNCTION_ARGS)
 			values[7] = CStringGetTextDatum(GetUserNameFromId(entry->userID, false));
 			values[8] = CStringGetTextDatum(entry->name);
 			values[9] = CStringGetTextDatum(entry->cursorName);
+			values[10] = Int64GetDatum((int64) entry->tuplesSent);
+			values[11] = Int64GetDatum((int64) entry->bytesSent);
 
 			tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
 			result = HeapTupleGetDatum(tuple);
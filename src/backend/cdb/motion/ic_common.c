@@ -96,6 +96,8 @@ RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates)
 	TupleChunkListItem lastTcItem = NULL;
 	uint32		tcSize;
 	int			bytesProcessed = 0;
+	uint8	   *msgPos;
+	int32		msgSize;
 
 	if (Gp_interconnect_type == INTERCONNECT_TYPE_TCP ||
 		Gp_interconnect_type == INTERCONNECT_TYPE_PROXY)
@@ -103,11 +105,17 @@ RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates)
 		/* read the packet in from the network. */
 		readPacket(conn, transportStates);
 
+		/* decompress it, if the sender compressed it */
+		msgPos = expandPacketTCP(conn, &msgSize);
+
 		/* go through and form us some TupleChunks. */
 		bytesProcessed = PACKET_HEADER_SIZE;
 	}
 	else
 	{
+		/* decompress it, if the sender compressed it */
+		msgPos = expandPacketUDPIFC(conn, &msgSize);
+
 		/* go through and form us some TupleChunks. */
 		bytesProcessed = sizeof(struct icpkthdr);
 	}
@@ -117,9 +125,9 @@ RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates)
 		 conn->recvBytes, conn->msgSize, conn->pBuff, conn->msgPos);
 #endif
 
-	while (bytesProcessed != conn->msgSize)
+	while (bytesProcessed != msgSize)
 	{
-		if (conn->msgSize - bytesProcessed < TUPLE_CHUNK_HEADER_SIZE)
+		if (msgSize - bytesProcessed < TUPLE_CHUNK_HEADER_SIZE)
 		{
 			logChunkParseDetails(conn, transportStates->sliceTable->ic_instance_id);
 
@@ -127,10 +135,10 @@ RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates)
 					(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
 					 errmsg("interconnect error parsing message: insufficient data received"),
 					 errdetail("conn->msgSize %d bytesProcessed %d < chunk-header %d",
-							   conn->msgSize, bytesProcessed, TUPLE_CHUNK_HEADER_SIZE)));
+							   msgSize, bytesProcessed, TUPLE_CHUNK_HEADER_SIZE)));
 		}
 
-		tcSize = TUPLE_CHUNK_HEADER_SIZE + (*(uint16 *) (conn->msgPos + bytesProcessed));
+		tcSize = TUPLE_CHUNK_HEADER_SIZE + (*(uint16 *) (msgPos + bytesProcessed));
 
 		/* sanity check */
 		if (tcSize > Gp_max_packet_size)
@@ -157,7 +165,7 @@ RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates)
 					 errdetail("tcSize %d > max %d header %d processed %d/%d from %p",
 							   tcSize, Gp_max_packet_size,
 							   TUPLE_CHUNK_HEADER_SIZE, bytesProcessed,
-							   conn->msgSize, conn->msgPos)));
+							   msgSize, msgPos)));
 		}
 
 
@@ -168,7 +176,7 @@ RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates)
 		if (Gp_interconnect_type == INTERCONNECT_TYPE_TCP ||
 			Gp_interconnect_type == INTERCONNECT_TYPE_PROXY)
 		{
-			if (tcSize >= conn->msgSize)
+			if (tcSize >= msgSize)
 			{
 				/*
 				 * see MPP-720: it is possible that our message got messed up
@@ -182,10 +190,10 @@ RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates)
 						(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
 						 errmsg("interconnect error parsing message"),
 						 errdetail("tcSize %d >= conn->msgSize %d",
-								   tcSize, conn->msgSize)));
+								   tcSize, msgSize)));
 			}
 		}
-		Assert(tcSize < conn->msgSize);
+		Assert(tcSize < msgSize);
 
 		/*
 		 * We store the data inplace, and handle any necessary copying later
@@ -195,7 +203,7 @@ RecvTupleChunk(MotionConn *conn, ChunkTransportState *transportStates)
 
 		tcItem->p_next = NULL;
 		tcItem->chunk_length = tcSize;
-		tcItem->inplace = (char *) (conn->msgPos + bytesProcessed);
+		tcItem->inplace = (char *) (msgPos + bytesProcessed);
 
 		bytesProcessed += tcSize;
 
@@ -640,6 +648,8 @@ createChunkTransportState(ChunkTransportState *transportStates,
 	pEntry->scanStart = 0;
 	pEntry->sendSlice = sendSlice;
 	pEntry->recvSlice = recvSlice;
+	pEntry->stat_compress_bytes_in = 0;
+	pEntry->stat_compress_bytes_out = 0;
 
 	pEntry->conns = palloc0(pEntry->numConns * sizeof(pEntry->conns[0]));
 
@@ -40,6 +40,10 @@
 #include <sys/time.h>
 #include <netinet/in.h>
 
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
 #define USECS_PER_SECOND 1000000
 #define MSECS_PER_SECOND 1000
 
@@ -119,6 +123,9 @@ static bool flushBuffer(ChunkTransportState *transportStates,
 			ChunkTransportStateEntry *pEntry, MotionConn *conn, int16 motionId);
 
 static void doSendStopMessageTCP(ChunkTransportState *transportStates, int16 motNodeID);
+#ifdef USE_ZSTD
+static uint8 *compressPacket(ChunkTransportStateEntry *pEntry, MotionConn *conn, int32 *msgSize);
+#endif
 
 #ifdef AMS_VERBOSE_LOGGING
 static void dumpEntryConnections(int elevel, ChunkTransportStateEntry *pEntry);
@@ -463,6 +470,172 @@ readPacket(MotionConn *conn, ChunkTransportState *transportStates)
 #endif
 }
 
+/*
+ * Packet compression.
+ *
+ * With gp_interconnect_compress_level set, flushBuffer() compresses the
+ * chunks of each outgoing packet with zstd, and sends them wrapped in a
+ * single TC_COMPRESSED chunk:
+ *
+ *	 [packet length][TC_COMPRESSED chunk header][zstd frame of the chunks]
+ *
+ * The packet length stays a plain byte count, so the interconnect proxy, which
+ * only looks at that, is unaffected.  The receiver expands such packets in
+ * expandPacketTCP() before cutting them into chunks.
+ *
+ * A packet that doesn't shrink is sent as it is.  The data of a motion tends
+ * to compress about equally well throughout, so every such failure also
+ * doubles the number of packets the connection sends before trying again, up
+ * to IC_COMPRESS_MAX_BACKOFF, and incompressible streams don't keep paying
+ * for the compressor.
+ *
+ * The scratch buffers are per process, which is fine as both sides are done
+ * with a packet before handling the next one: the sender has written it to
+ * the socket, and the receiver has processed all its chunks.
+ */
+#define IC_COMPRESS_MAX_BACKOFF 64
+
+#define IC_COMPRESSED_HEADER_SIZE (PACKET_HEADER_SIZE + TUPLE_CHUNK_HEADER_SIZE)
+
+#ifdef USE_ZSTD
+static ZSTD_CCtx *icCompressCxt = NULL;
+static ZSTD_DCtx *icDecompressCxt = NULL;
+static uint8 *icCompressBuf = NULL;
+static uint8 *icDecompressBuf = NULL;
+
+/*
+ * Compress the packet being flushed on 'conn'.
+ *
+ * Returns the buffer to send, and its length in *msgSize, which are either the
+ * compressed packet, or conn->pBuff and conn->msgSize.
+ */
+static uint8 *
+compressPacket(ChunkTransportStateEntry *pEntry, MotionConn *conn, int32 *msgSize)
+{
+	size_t		bound = ZSTD_compressBound(Gp_max_packet_size);
+	size_t		compressed_size;
+
+	*msgSize = conn->msgSize;
+	pEntry->stat_compress_bytes_in += conn->msgSize;
+
+	if (conn->compressSkip > 0)
+	{
+		conn->compressSkip--;
+		pEntry->stat_compress_bytes_out += conn->msgSize;
+		return conn->pBuff;
+	}
+
+	if (icCompressCxt == NULL)
+	{
+		icCompressBuf = MemoryContextAlloc(TopMemoryContext,
+										   IC_COMPRESSED_HEADER_SIZE +
+										   ZSTD_compressBound(MAX_PACKET_SIZE));
+		icCompressCxt = ZSTD_createCCtx();
+		if (icCompressCxt == NULL)
+			elog(ERROR, "out of memory");
+	}
+
+	compressed_size = ZSTD_compressCCtx(icCompressCxt,
+										icCompressBuf + IC_COMPRESSED_HEADER_SIZE,
+										bound,
+										conn->pBuff + PACKET_HEADER_SIZE,
+										conn->msgSize - PACKET_HEADER_SIZE,
+										Gp_interconnect_compress_level);
+	if (ZSTD_isError(compressed_size))
+		elog(ERROR, "interconnect packet compression failed: %s",
+			 ZSTD_getErrorName(compressed_size));
+
+	if (IC_COMPRESSED_HEADER_SIZE + compressed_size >= conn->msgSize)
+	{
+		/* didn't help, back off */
+		conn->compressBackoff = Min(Max(conn->compressBackoff * 2, 1),
+									IC_COMPRESS_MAX_BACKOFF);
+		conn->compressSkip = conn->compressBackoff;
+		pEntry->stat_compress_bytes_out += conn->msgSize;
+		return conn->pBuff;
+	}
+	conn->compressBackoff = 0;
+
+	SetChunkDataSize(icCompressBuf + PACKET_HEADER_SIZE, compressed_size);
+	SetChunkType(icCompressBuf + PACKET_HEADER_SIZE, TC_COMPRESSED);
+
+	*msgSize = IC_COMPRESSED_HEADER_SIZE + compressed_size;
+	pEntry->stat_compress_bytes_out += *msgSize;
+
+	return icCompressBuf;
+}
+#endif							/* USE_ZSTD */
+
+/*
+ * Return the packet at conn->msgPos, read by readPacket(), ready to be cut
+ * into chunks: if the sender compressed it, it's decompressed into a scratch
+ * buffer first.  The packet's length is returned in *msgSize.
+ *
+ * conn->msgSize is left alone, it still counts the bytes of the packet as
+ * received.
+ */
+uint8 *
+expandPacketTCP(MotionConn *conn, int32 *msgSize)
+{
+	uint16		chunkType;
+	uint16		compressed_size;
+
+	*msgSize = conn->msgSize;
+
+	if (conn->msgSize < IC_COMPRESSED_HEADER_SIZE)
+		return conn->msgPos;
+
+	memcpy(&chunkType, conn->msgPos + PACKET_HEADER_SIZE + 2, sizeof(uint16));
+	if (chunkType != TC_COMPRESSED)
+		return conn->msgPos;
+
+	memcpy(&compressed_size, conn->msgPos + PACKET_HEADER_SIZE, sizeof(uint16));
+	if (IC_COMPRESSED_HEADER_SIZE + compressed_size != conn->msgSize)
+		ereport(ERROR,
+				(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+				 errmsg("interconnect error parsing message: compressed packet size mismatch"),
+				 errdetail("compressed size %d, packet size %d from seg%d at %s",
+						   compressed_size, conn->msgSize,
+						   conn->remoteContentId, conn->remoteHostAndPort)));
+
+#ifdef USE_ZSTD
+	{
+		size_t		decompressed_size;
+
+		if (icDecompressCxt == NULL)
+		{
+			icDecompressBuf = MemoryContextAlloc(TopMemoryContext, MAX_PACKET_SIZE);
+			icDecompressCxt = ZSTD_createDCtx();
+			if (icDecompressCxt == NULL)
+				elog(ERROR, "out of memory");
+		}
+
+		decompressed_size = ZSTD_decompressDCtx(icDecompressCxt,
+												icDecompressBuf + PACKET_HEADER_SIZE,
+												MAX_PACKET_SIZE - PACKET_HEADER_SIZE,
+												conn->msgPos + IC_COMPRESSED_HEADER_SIZE,
+												compressed_size);
+		if (ZSTD_isError(decompressed_size))
+			ereport(ERROR,
+					(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+					 errmsg("interconnect error decompressing message: %s",
+							ZSTD_getErrorName(decompressed_size)),
+					 errdetail("from seg%d at %s",
+							   conn->remoteContentId, conn->remoteHostAndPort)));
+
+		*msgSize = PACKET_HEADER_SIZE + decompressed_size;
+		memcpy(icDecompressBuf, msgSize, sizeof(uint32));
+
+		return icDecompressBuf;
+	}
+#else
+	ereport(ERROR,
+			(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+			 errmsg("interconnect error: received a compressed packet, but compression is not supported by this build")));
+	return NULL;				/* keep compiler quiet */
+#endif
+}
+
 static void
 flushIncomingData(int fd)
 {
@@ -2790,6 +2963,7 @@ flushBuffer(ChunkTransportState *transportStates,
 			ChunkTransportStateEntry *pEntry, MotionConn *conn, int16 motionId)
 {
 	char	   *sendptr;
+	int32		sendsize;
 	int			n,
 				sent = 0;
 	mpp_fd_set	wset;
@@ -2805,11 +2979,18 @@ flushBuffer(ChunkTransportState *transportStates,
 	}
 #endif
 
+	sendptr = (char *) conn->pBuff;
+	sendsize = conn->msgSize;
+
+#ifdef USE_ZSTD
+	if (Gp_interconnect_compress_level > 0)
+		sendptr = (char *) compressPacket(pEntry, conn, &sendsize);
+#endif
+
 	/* first set header length */
-	*(uint32 *) conn->pBuff = conn->msgSize;
+	*(uint32 *) sendptr = sendsize;
 
 	/* now send message */
-	sendptr = (char *) conn->pBuff;
 	sent = 0;
 	do
 	{
@@ -2837,7 +3018,7 @@ flushBuffer(ChunkTransportState *transportStates,
 			return false;
 		}
 
-		if ((n = send(conn->sockfd, sendptr + sent, conn->msgSize - sent, 0)) < 0)
+		if ((n = send(conn->sockfd, sendptr + sent, sendsize - sent, 0)) < 0)
 		{
 			int			send_errno = errno;
 
@@ -2949,7 +3130,7 @@ flushBuffer(ChunkTransportState *transportStates,
 		{
 			sent += n;
 		}
-	} while (sent < conn->msgSize);
+	} while (sent < sendsize);
 
 	conn->tupleCount = 0;
 	conn->msgSize = PACKET_HEADER_SIZE;
@@ -31,6 +31,10 @@
 #include <arpa/inet.h>
 #include <netinet/in.h>
 
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
 #include "access/transam.h"
 #include "access/xact.h"
 #include "common/ip.h"
@@ -151,6 +155,7 @@ int
 #define UDPIC_FLAGS_DISORDER    		(32)
 #define UDPIC_FLAGS_DUPLICATE   		(64)
 #define UDPIC_FLAGS_CAPACITY    		(128)
+#define UDPIC_FLAGS_COMPRESSED    		(256)
 
 #define UDPIC_MIN_BUF_SIZE (128 * 1024)
 
@@ -753,7 +758,10 @@ static bool handleDataPacket(MotionConn *conn, icpkthdr *pkt, struct sockaddr_st
 static bool handleAckForDuplicatePkt(MotionConn *conn, icpkthdr *pkt);
 static bool handleAckForDisorderPkt(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, MotionConn *conn, icpkthdr *pkt);
 
-static inline void prepareXmit(MotionConn *conn);
+static inline void prepareXmit(ChunkTransportStateEntry *pEntry, MotionConn *conn);
+#ifdef USE_ZSTD
+static bool compressPacketUDPIFC(ChunkTransportStateEntry *pEntry, MotionConn *conn);
+#endif
 static inline void addCRC(icpkthdr *pkt);
 static inline bool checkCRC(icpkthdr *pkt);
 static void sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, MotionConn *conn);
@@ -4539,20 +4547,171 @@ checkCRC(icpkthdr *pkt)
 }
 
 
+/*
+ * Packet compression.
+ *
+ * With gp_interconnect_compress_level set, prepareXmit() compresses the
+ * chunks of each data packet with zstd, in place in its send buffer, and
+ * marks the packet with UDPIC_FLAGS_COMPRESSED.  The packet length in the
+ * header is the compressed length, so retransmissions, acks and the CRC all
+ * work on the packet as it is on the wire.  The receiver expands the packet
+ * in expandPacketUDPIFC() before cutting it into chunks.
+ *
+ * Like the TCP interconnect, a packet that doesn't shrink is sent as it is,
+ * and the connection backs off from compressing for a growing number of
+ * packets, up to IC_COMPRESS_MAX_BACKOFF.
+ *
+ * The scratch buffers are per process: the sender copies the compressed data
+ * back into the send buffer right away, and the receiver is done with the
+ * chunks of a packet before it expands the next one (chunks of incomplete
+ * tuples are copied out, see materializeChunk()).
+ */
+#define IC_COMPRESS_MAX_BACKOFF 64
+
+#ifdef USE_ZSTD
+static ZSTD_CCtx *icCompressCxt = NULL;
+static ZSTD_DCtx *icDecompressCxt = NULL;
+static uint8 *icCompressBuf = NULL;
+static uint8 *icDecompressBuf = NULL;
+
+/*
+ * Compress the packet being prepared on 'conn', in place.
+ *
+ * Returns true, and updates conn->msgSize, if the packet was compressed.
+ */
+static bool
+compressPacketUDPIFC(ChunkTransportStateEntry *pEntry, MotionConn *conn)
+{
+	int32		dataSize = conn->msgSize - sizeof(icpkthdr);
+	size_t		compressed_size;
+
+	pEntry->stat_compress_bytes_in += conn->msgSize;
+
+	if (dataSize <= 0 || conn->compressSkip > 0)
+	{
+		if (conn->compressSkip > 0)
+			conn->compressSkip--;
+		pEntry->stat_compress_bytes_out += conn->msgSize;
+		return false;
+	}
+
+	if (icCompressCxt == NULL)
+	{
+		icCompressBuf = MemoryContextAlloc(TopMemoryContext,
+										   ZSTD_compressBound(MAX_PACKET_SIZE));
+		icCompressCxt = ZSTD_createCCtx();
+		if (icCompressCxt == NULL)
+			elog(ERROR, "out of memory");
+	}
+
+	compressed_size = ZSTD_compressCCtx(icCompressCxt,
+										icCompressBuf,
+										ZSTD_compressBound(dataSize),
+										conn->pBuff + sizeof(icpkthdr),
+										dataSize,
+										Gp_interconnect_compress_level);
+	if (ZSTD_isError(compressed_size))
+		elog(ERROR, "interconnect packet compression failed: %s",
+			 ZSTD_getErrorName(compressed_size));
+
+	if (compressed_size >= dataSize)
+	{
+		/* didn't help, back off */
+		conn->compressBackoff = Min(Max(conn->compressBackoff * 2, 1),
+									IC_COMPRESS_MAX_BACKOFF);
+		conn->compressSkip = conn->compressBackoff;
+		pEntry->stat_compress_bytes_out += conn->msgSize;
+		return false;
+	}
+	conn->compressBackoff = 0;
+
+	memcpy(conn->pBuff + sizeof(icpkthdr), icCompressBuf, compressed_size);
+	conn->msgSize = sizeof(icpkthdr) + compressed_size;
+	pEntry->stat_compress_bytes_out += conn->msgSize;
+
+	return true;
+}
+#endif							/* USE_ZSTD */
+
+/*
+ * Return the packet at conn->msgPos ready to be cut into chunks: if the
+ * sender compressed it, it's decompressed into a scratch buffer first.  The
+ * packet's length is returned in *msgSize.
+ *
+ * The packet itself is left alone, it's still released and acked as received.
+ */
+uint8 *
+expandPacketUDPIFC(MotionConn *conn, int32 *msgSize)
+{
+	icpkthdr   *pkt = (icpkthdr *) conn->msgPos;
+
+	*msgSize = conn->msgSize;
+
+	if ((pkt->flags & UDPIC_FLAGS_COMPRESSED) == 0)
+		return conn->msgPos;
+
+#ifdef USE_ZSTD
+	{
+		size_t		decompressed_size;
+
+		if (icDecompressCxt == NULL)
+		{
+			icDecompressBuf = MemoryContextAlloc(TopMemoryContext, MAX_PACKET_SIZE);
+			icDecompressCxt = ZSTD_createDCtx();
+			if (icDecompressCxt == NULL)
+				elog(ERROR, "out of memory");
+		}
+
+		decompressed_size = ZSTD_decompressDCtx(icDecompressCxt,
+												icDecompressBuf + sizeof(icpkthdr),
+												MAX_PACKET_SIZE - sizeof(icpkthdr),
+												conn->msgPos + sizeof(icpkthdr),
+												conn->msgSize - sizeof(icpkthdr));
+		if (ZSTD_isError(decompressed_size))
+			ereport(ERROR,
+					(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+					 errmsg("interconnect error decompressing message: %s",
+							ZSTD_getErrorName(decompressed_size)),
+					 errdetail("from seg%d at %s",
+							   conn->remoteContentId, conn->remoteHostAndPort)));
+
+		memcpy(icDecompressBuf, pkt, sizeof(icpkthdr));
+		*msgSize = sizeof(icpkthdr) + decompressed_size;
+
+		return icDecompressBuf;
+	}
+#else
+	ereport(ERROR,
+			(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+			 errmsg("interconnect error: received a compressed packet, but compression is not supported by this build")));
+	return NULL;				/* keep compiler quiet */
+#endif
+}
+
 /*
  * prepareXmit
  * 		Prepare connection for transmit.
  */
 static inline void
-prepareXmit(MotionConn *conn)
+prepareXmit(ChunkTransportStateEntry *pEntry, MotionConn *conn)
 {
+	bool		compressed = false;
+
 	Assert(conn != NULL);
 
+#ifdef USE_ZSTD
+	if (Gp_interconnect_compress_level > 0)
+		compressed = compressPacketUDPIFC(pEntry, conn);
+#endif
+
 	conn->conn_info.len = conn->msgSize;
 	conn->conn_info.crc = 0;
 
 	memcpy(conn->pBuff, &conn->conn_info, sizeof(conn->conn_info));
 
+	if (compressed)
+		((icpkthdr *) conn->pBuff)->flags |= UDPIC_FLAGS_COMPRESSED;
+
 	/* increase the sequence no */
 	conn->conn_info.seq++;
 
@@ -4711,7 +4870,7 @@ handleStopMsgs(ChunkTransportState *transportStates, ChunkTransportStateEntry *p
 			conn->pBuff[conn->msgSize] = 'S';
 			conn->msgSize += 1;
 
-			prepareXmit(conn);
+			prepareXmit(pEntry, conn);
 
 			/* now ready to actually send */
 			if (gp_log_interconnect >= GPVARS_VERBOSITY_DEBUG)
@@ -5495,7 +5654,7 @@ SendChunkUDPIFC(ChunkTransportState *transportStates,
 
 	/* try to send it */
 
-	prepareXmit(conn);
+	prepareXmit(pEntry, conn);
 
 	icBufferListAppend(&conn->sndQueue, conn->curBuff);
 	sendBuffers(transportStates, pEntry, conn);
@@ -5625,7 +5784,7 @@ SendEosUDPIFC(ChunkTransportState *transportStates,
 			if (pEntry->sendingEos)
 				conn->conn_info.flags |= UDPIC_FLAGS_EOS;
 
-			prepareXmit(conn);
+			prepareXmit(pEntry, conn);
 
 			/* place it into the send queue */
 			icBufferListAppend(&conn->sndQueue, conn->curBuff);
@@ -39,6 +39,10 @@
  */
 #define RECORD_CACHE_MAGIC_TUPLEN	-1
 
+/* Offset of a MinimalTuple header field from the start of the tuple body */
+#define MINIMAL_TUPLE_FIELD_OFFSET(field) \
+	(offsetof(MinimalTupleData, field) - MINIMAL_TUPLE_DATA_OFFSET)
+
 static void addByteStringToChunkList(TupleChunkList tcList, char *data, int datalen, TupleChunkListCache *cache);
 
 #define addCharToChunkList(tcList, x, c)							\
@@ -84,6 +88,7 @@ InitSerTupInfo(TupleDesc tupdesc, SerTupInfo *pSerInfo)
 	pSerInfo->chunkCache.items = NULL;
 
 	pSerInfo->has_record_types = false;
+	pSerInfo->all_fixed_width = true;
 
 	/*
 	 * If we have some attributes, go ahead and prepare the information for
@@ -139,6 +144,9 @@ InitSerTupInfo(TupleDesc tupdesc, SerTupInfo *pSerInfo)
 			attrInfo->typlen = pt->typlen;
 			attrInfo->typbyval = pt->typbyval;
 
+			if (attrInfo->typlen <= 0)
+				pSerInfo->all_fixed_width = false;
+
 			ReleaseSysCache(typeTuple);
 		}
 	}
@@ -333,6 +341,93 @@ CandidateForSerializeDirect(int16 targetRoute, struct directTransportBuffer *b)
 	return targetRoute != BROADCAST_SEGIDX && b->pri != NULL && b->prilen > TUPLE_CHUNK_HEADER_SIZE;
 }
 
+/*
+ * Form a virtual tuple with only fixed-width attributes directly in the
+ * direct transport buffer, without building an intermediate MinimalTuple
+ * first.
+ *
+ * heap_fill_tuple() aligns attributes by their absolute address, while the
+ * receiver copies the tuple body into a MAXALIGN'd MinimalTuple.  So that the
+ * two agree, the body is preceded by up to MAXIMUM_ALIGNOF - 1 zero bytes of
+ * padding, chosen so that the (virtual) start of the tuple is MAXALIGN'd.
+ * The receiver finds the padding from the chunk size and the length word.
+ * Returns the number of bytes used in the buffer, or 0 if the tuple doesn't
+ * fit.
+ */
+static int
+SerializeVirtualTupleDirect(TupleTableSlot *slot, struct directTransportBuffer *b)
+{
+	TupleDesc	tupdesc = slot->tts_tupleDescriptor;
+	int			natts = tupdesc->natts;
+	bool		hasnull = false;
+	char	   *tupbody;
+	uintptr_t	pad;
+	Size		hoff;
+	Size		data_len;
+	unsigned int tupbodylen;
+	uint16		infomask = 0;
+	uint16		infomask2;
+	uint8		t_hoff;
+	int			i;
+
+	/*
+	 * The fields of the MinimalTuple header before t_infomask2 are never
+	 * sent, so the header fields are written relative to the body, and the
+	 * tuple start is never formed as a pointer.
+	 */
+	tupbody = (char *) b->pri + TUPLE_CHUNK_HEADER_SIZE + sizeof(int);
+	pad = ((uintptr_t) tupbody - MINIMAL_TUPLE_DATA_OFFSET) % MAXIMUM_ALIGNOF;
+	if (pad != 0)
+		pad = MAXIMUM_ALIGNOF - pad;
+
+	slot_getallattrs(slot);
+
+	for (i = 0; i < natts; i++)
+	{
+		if (slot->tts_isnull[i])
+		{
+			hasnull = true;
+			break;
+		}
+	}
+
+	/* same layout computation as heap_form_minimal_tuple() */
+	hoff = SizeofMinimalTupleHeader;
+	if (hasnull)
+		hoff += BITMAPLEN(natts);
+	hoff = MAXALIGN(hoff);
+
+	data_len = heap_compute_data_size(tupdesc, slot->tts_values, slot->tts_isnull);
+
+	tupbodylen = hoff + data_len - MINIMAL_TUPLE_DATA_OFFSET;
+	if (TUPLE_CHUNK_HEADER_SIZE + sizeof(int) + pad + tupbodylen > b->prilen)
+		return 0;
+
+	memset(tupbody, 0, pad + tupbodylen);
+	tupbody += pad;
+
+	heap_fill_tuple(tupdesc,
+					slot->tts_values,
+					slot->tts_isnull,
+					tupbody + hoff - MINIMAL_TUPLE_DATA_OFFSET,
+					data_len,
+					&infomask,
+					(hasnull ? (bits8 *) (tupbody + MINIMAL_TUPLE_FIELD_OFFSET(t_bits)) : NULL));
+
+	infomask2 = natts & HEAP_NATTS_MASK;
+	t_hoff = hoff + MINIMAL_TUPLE_OFFSET;
+	memcpy(tupbody + MINIMAL_TUPLE_FIELD_OFFSET(t_infomask2), &infomask2, sizeof(infomask2));
+	memcpy(tupbody + MINIMAL_TUPLE_FIELD_OFFSET(t_infomask), &infomask, sizeof(infomask));
+	memcpy(tupbody + MINIMAL_TUPLE_FIELD_OFFSET(t_hoff), &t_hoff, sizeof(t_hoff));
+
+	memcpy(b->pri + TUPLE_CHUNK_HEADER_SIZE, &tupbodylen, sizeof(tupbodylen));
+
+	SetChunkType(b->pri, TC_WHOLE);
+	SetChunkDataSize(b->pri, sizeof(int) + pad + tupbodylen);
+
+	return TUPLE_CHUNK_HEADER_SIZE + sizeof(int) + pad + tupbodylen;
+}
+
 /*
  *
  * First try to serialize a tuple directly into a buffer.
@@ -373,6 +468,19 @@ SerializeTuple(TupleTableSlot *slot, SerTupInfo *pSerInfo, struct directTranspor
 		return TUPLE_CHUNK_HEADER_SIZE;
 	}
 
+	/*
+	 * Virtual tuples of fixed-width attributes can't contain toasted values,
+	 * and are formed in place in the transport buffer if they fit.
+	 */
+	if (pSerInfo->all_fixed_width && TTS_IS_VIRTUAL(slot) &&
+		CandidateForSerializeDirect(targetRoute, b))
+	{
+		int			sent = SerializeVirtualTupleDirect(slot, b);
+
+		if (sent > 0)
+			return sent;
+	}
+
 	tcList->p_first = NULL;
 	tcList->p_last = NULL;
 	tcList->num_chunks = 0;
@@ -561,6 +669,8 @@ CvtChunksToTup(TupleChunkList tcList, SerTupInfo *pSerInfo, TupleRemapper *remap
 		 * Re-assemble the chunks into a contiguous buffer..
 		 */
 		int			total_len;
+		int			first_len;
+		int			tupbodylen;
 		char	   *pos;
 
 		/* Sanity-check the chunk types, and compute total length. */
@@ -599,6 +709,53 @@ CvtChunksToTup(TupleChunkList tcList, SerTupInfo *pSerInfo, TupleRemapper *remap
 			tcItem = tcItem->p_next;
 		}
 
+		/*
+		 * A normal tuple is reassembled straight into the MinimalTuple we
+		 * return, rather than into an intermediate buffer that would then be
+		 * copied once more below.  The length word is always placed in the
+		 * first chunk by SerializeTuple(), but check anyway.
+		 */
+		first_len = firstTcItem->chunk_length - TUPLE_CHUNK_HEADER_SIZE;
+		if (first_len >= (int) sizeof(tupbodylen))
+		{
+			memcpy(&tupbodylen,
+				   (const char *) GetChunkDataPtr(firstTcItem) + TUPLE_CHUNK_HEADER_SIZE,
+				   sizeof(tupbodylen));
+
+			if (tupbodylen != RECORD_CACHE_MAGIC_TUPLEN)
+			{
+				if (tupbodylen != total_len - (int) sizeof(tupbodylen))
+					ereport(ERROR,
+							(errcode(ERRCODE_PROTOCOL_VIOLATION),
+							 errmsg("chunked tuple length %d does not match received length %d",
+									tupbodylen, total_len - (int) sizeof(tupbodylen))));
+
+				tup = palloc(tupbodylen + MINIMAL_TUPLE_DATA_OFFSET);
+				tup->t_len = tupbodylen + MINIMAL_TUPLE_DATA_OFFSET;
+
+				pos = (char *) tup + MINIMAL_TUPLE_DATA_OFFSET;
+				memcpy(pos,
+					   (const char *) GetChunkDataPtr(firstTcItem) + TUPLE_CHUNK_HEADER_SIZE + sizeof(tupbodylen),
+					   first_len - sizeof(tupbodylen));
+				pos += first_len - sizeof(tupbodylen);
+
+				tcItem = firstTcItem->p_next;
+				while (tcItem != NULL)
+				{
+					int			this_len = tcItem->chunk_length - TUPLE_CHUNK_HEADER_SIZE;
+
+					memcpy(pos,
+						   (const char *) GetChunkDataPtr(tcItem) + TUPLE_CHUNK_HEADER_SIZE,
+						   this_len);
+					pos += this_len;
+
+					tcItem = tcItem->p_next;
+				}
+
+				return tup;
+			}
+		}
+
 		serData.data = palloc(total_len);
 		serData.len = serData.maxlen = total_len;
 		serData.cursor = 0;
@@ -666,8 +823,27 @@ CvtChunksToTup(TupleChunkList tcList, SerTupInfo *pSerInfo, TupleRemapper *remap
 		{
 			/* A normal MinimalTuple */
 			unsigned int tuplen = tupbodylen + MINIMAL_TUPLE_DATA_OFFSET;
+			int			pad;
 			char	   *tupbody;
 
+			/*
+			 * A tuple formed in place by SerializeVirtualTupleDirect() is
+			 * preceded by alignment padding; skip it.
+			 */
+			pad = serData.len - (int) sizeof(tupbodylen) - tupbodylen;
+			if (pad < 0 || pad >= MAXIMUM_ALIGNOF)
+				ereport(ERROR,
+						(errcode(ERRCODE_PROTOCOL_VIOLATION),
+						 errmsg("tuple length %d does not match received length %d",
+								tupbodylen, serData.len - (int) sizeof(tupbodylen))));
+			pos += pad;
+
+			/*
+			 * The tuple must be copied out of the chunk even if it is whole:
+			 * it is queued in the chunk sorter's ready list, and reading
+			 * ahead can recycle the interconnect buffer the chunk was
+			 * received in before the tuple is consumed.
+			 */
 			tup = palloc(tuplen);
 			tup->t_len = tuplen;
 
@@ -153,6 +153,49 @@ test__DistributedSnapshotWithLocalMapping_CommittedTest(void **state)
 	free(dslm.inProgressMappedLocalXids);
 }
 
+static void
+test__DistributedSnapshot_SerializeRoundTrip(void **state)
+{
+	DistributedSnapshot ds;
+	DistributedSnapshot out;
+	DistributedTransactionId xids[] = {1000, 1001, 1003, 1200, 70000, UINT64CONST(0x100000000)};
+	int			nxids = lengthof(xids);
+	char	   *buf;
+	int			size;
+
+	ds.xminAllDistributedSnapshots = 900;
+	ds.distribSnapshotId = 12345;
+	ds.xmin = 1000;
+	ds.xmax = UINT64CONST(0x100000001);
+	ds.count = nxids;
+	ds.inProgressXidArray = xids;
+
+	out.inProgressXidArray =
+		(DistributedTransactionId *) malloc(nxids * sizeof(DistributedTransactionId));
+
+	size = DistributedSnapshot_SerializeSize(&ds);
+
+	/* the gaps between these xids take 1, 1, 1, 2, 3 and 5 bytes */
+	assert_int_equal(size, sizeof(DistributedSnapshotId) +
+					 3 * sizeof(DistributedTransactionId) + sizeof(int32) +
+					 1 + 1 + 1 + 2 + 3 + 5);
+
+	buf = palloc(size);
+	assert_int_equal(DistributedSnapshot_Serialize(&ds, buf), size);
+	assert_int_equal(DistributedSnapshot_Deserialize(buf, &out), size);
+
+	assert_true(out.xminAllDistributedSnapshots == ds.xminAllDistributedSnapshots);
+	assert_int_equal(out.distribSnapshotId, ds.distribSnapshotId);
+	assert_true(out.xmin == ds.xmin);
+	assert_true(out.xmax == ds.xmax);
+	assert_int_equal(out.count, nxids);
+	for (int i = 0; i < nxids; i++)
+		assert_true(out.inProgressXidArray[i] == xids[i]);
+
+	pfree(buf);
+	free(out.inProgressXidArray);
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -160,7 +203,8 @@ main(int argc, char* argv[])
 
 	const UnitTest tests[] =
 	{
-		unit_test(test__DistributedSnapshotWithLocalMapping_CommittedTest)
+		unit_test(test__DistributedSnapshotWithLocalMapping_CommittedTest),
+		unit_test(test__DistributedSnapshot_SerializeRoundTrip)
 	};
 
 	MemoryContextInit();
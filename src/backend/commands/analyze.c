@@ -84,6 +84,7 @@
 #include "catalog/pg_inherits.h"
 #include "catalog/pg_namespace.h"
 #include "catalog/pg_statistic_ext.h"
+#include "common/hashfn.h"
 #include "commands/dbcommands.h"
 #include "commands/progress.h"
 #include "commands/tablecmds.h"
@@ -118,6 +119,7 @@
 
 #include "catalog/heap.h"
 #include "catalog/pg_am.h"
+#include "catalog/pg_appendonly.h"
 #include "cdb/cdbappendonlyam.h"
 #include "cdb/cdbaocsam.h"
 #include "cdb/cdbdisp_query.h"
@@ -147,6 +149,12 @@
 /* Fix attr number of return record of function gp_acquire_sample_rows */
 #define FIX_ATTR_NUM  3
 
+#ifdef USE_ORCA
+extern void GPOPTSerializeColumnBuckets(Oid relid, int natts,
+										const AttrNumber *attnums,
+										bytea **buckets);
+#endif
+
 /* Per-index data for ANALYZE */
 typedef struct AnlIndexData
 {
@@ -186,6 +194,9 @@ static int acquire_sample_rows_dispatcher(Relation onerel, bool inh, int elevel,
 										  HeapTuple *rows, int targrows,
 										  double *totalrows, double *totaldeadrows);
 static BlockNumber acquire_index_number_of_blocks(Relation indexrel, Relation tablerel);
+static int64 acquire_ao_modcount(Relation onerel);
+static int32 ao_analyze_statsig(Relation onerel);
+static bool ao_rel_analyzed(Relation onerel);
 
 static void gp_acquire_correlations_dispatcher(Oid relOid, bool inh, float4 *correlations, bool *correlationsIsNull);
 static int	compare_rows(const void *a, const void *b);
@@ -194,6 +205,12 @@ static int	acquire_inherited_sample_rows(Relation onerel, int elevel,
 										  double *totalrows, double *totaldeadrows);
 static void update_attstats(Oid relid, bool inh,
 							int natts, VacAttrStats **vacattrstats);
+static void form_attstats_values(Oid relid, bool inh, VacAttrStats *stats,
+								 Datum *values, bool *nulls);
+#ifdef USE_ORCA
+static void store_orca_buckets(Relation onerel, bool inh,
+							   int natts, VacAttrStats **vacattrstats);
+#endif
 static Datum std_fetch_func(VacAttrStatsP stats, int rownum, bool *isNull);
 static Datum ind_fetch_func(VacAttrStatsP stats, int rownum, bool *isNull);
 
@@ -252,6 +269,9 @@ analyze_rel_internal(Oid relid, RangeVar *relation,
 	int			elevel;
 	AcquireSampleRowsFunc acquirefunc = NULL;
 	BlockNumber relpages = 0;
+	int64		aomodcount = -1;
+	int32		aostatsig = 0;
+	bool		skip_unmodified = false;
 
 	/* Select logging level */
 	if (params->options & VACOPT_VERBOSE)
@@ -396,6 +416,42 @@ analyze_rel_internal(Oid relid, RangeVar *relation,
 		return;
 	}
 
+	/*
+	 * GPDB: Every change to the segfiles of an append-optimized table bumps
+	 * their modcount, so the table is unmodified since it was last analyzed if
+	 * the total modcount over all the segments is still the one recorded by
+	 * the last ANALYZE of all its columns.  The statistics would still differ
+	 * if the statistics targets, the extended statistics or the expression
+	 * indexes changed since, so a signature of those is recorded too.  Both
+	 * are recorded by every such ANALYZE, and gp_toolkit.gp_stats_stale_ao
+	 * lists the tables whose modcount changed since.
+	 *
+	 * If gp_analyze_skip_unmodified_ao is set, an unmodified table is not
+	 * sampled again and keeps its statistics.  The statistics of a
+	 * partitioned table are merged from those of its leaves, so only the
+	 * modified leaves are sampled again.  Inheritance children are analyzed
+	 * as usual.
+	 */
+	if (Gp_role == GP_ROLE_DISPATCH &&
+		onerel->rd_rel->relkind == RELKIND_RELATION &&
+		RelationStorageIsAO(onerel) && va_cols == NIL)
+	{
+		aomodcount = acquire_ao_modcount(onerel);
+		aostatsig = ao_analyze_statsig(onerel);
+
+		if (gp_analyze_skip_unmodified_ao &&
+			!(params->options & VACOPT_FULLSCAN) &&
+			aomodcount == onerel->rd_appendonly->analyzemodcount &&
+			aostatsig == onerel->rd_appendonly->analyzestatsig &&
+			ao_rel_analyzed(onerel))
+		{
+			ereport(elevel == INFO ? INFO : LOG,
+					(errmsg("skipping \"%s\" --- not modified since it was last analyzed",
+							RelationGetRelationName(onerel))));
+			skip_unmodified = true;
+		}
+	}
+
 	/*
 	 * OK, let's do it.  First let other backends know I'm in ANALYZE.
 	 */
@@ -415,10 +471,18 @@ analyze_rel_internal(Oid relid, RangeVar *relation,
 	 * rows requests to QE.
 	 * To distinguish the two requests, we check the ctx->inherited value here.
 	 */
-	if (onerel->rd_rel->relkind != RELKIND_PARTITIONED_TABLE && (!ctx || !ctx->inherited))
+	if (onerel->rd_rel->relkind != RELKIND_PARTITIONED_TABLE && (!ctx || !ctx->inherited) &&
+		!skip_unmodified)
 		do_analyze_rel(onerel, params, va_cols, acquirefunc,
 					   relpages, false, in_outer_xact, elevel, ctx);
 
+	/* Remember what the statistics were computed at, see above */
+	if (aomodcount >= 0 && !skip_unmodified &&
+		(aomodcount != onerel->rd_appendonly->analyzemodcount ||
+		 aostatsig != onerel->rd_appendonly->analyzestatsig))
+		UpdateAppendOnlyEntryAnalyzeModCount(RelationGetRelid(onerel),
+											 aomodcount, aostatsig);
+
 	/*
 	 * If there are child tables, do recursive ANALYZE.
 	 */
@@ -461,6 +525,145 @@ analyze_rel_internal(Oid relid, RangeVar *relation,
 	LWLockRelease(ProcArrayLock);
 }
 
+/*
+ *	analyze_sample_attstats() -- compute statistics from a sample of a
+ *	relation, without storing them
+ *
+ * This is ANALYZE for the planner: it acquires a sample of at most 'targrows'
+ * rows the same way ANALYZE does, from the segments if the relation is
+ * distributed, and computes the statistics of every analyzable column. The
+ * statistics are returned as pg_statistic tuples, in an array indexed by
+ * attribute number - 1 with NULL for the columns that have none, and the
+ * estimated number of rows in the relation is returned in *totalrows.
+ * Nothing is written to the catalogs. The result is allocated in the
+ * caller's memory context.
+ *
+ * The caller must own the relation; the segments refuse to sample it
+ * otherwise.
+ */
+HeapTuple *
+analyze_sample_attstats(Relation onerel, int targrows, double *totalrows)
+{
+	int			natts = RelationGetNumberOfAttributes(onerel);
+	HeapTuple  *result;
+	MemoryContext caller_context = CurrentMemoryContext;
+	MemoryContext save_anl_context = anl_context;
+	BufferAccessStrategy save_vac_strategy = vac_strategy;
+	VacAttrStats **vacattrstats;
+	Bitmapset **colLargeRowIndexes;
+	double	   *colLargeRowLength;
+	HeapTuple  *rows;
+	HeapTuple  *validRows;
+	Relation	sd;
+	double		totaldeadrows;
+	int			numrows;
+	int			attr_cnt;
+	int			i;
+	bool		optimizerBackup;
+
+	result = (HeapTuple *) palloc0(natts * sizeof(HeapTuple));
+
+	anl_context = AllocSetContextCreate(caller_context,
+										"Analyze sample",
+										ALLOCSET_DEFAULT_SIZES);
+	vac_strategy = NULL;
+	MemoryContextSwitchTo(anl_context);
+
+	vacattrstats = (VacAttrStats **) palloc(natts * sizeof(VacAttrStats *));
+	attr_cnt = 0;
+	for (i = 1; i <= natts; i++)
+	{
+		vacattrstats[attr_cnt] = examine_attribute(onerel, i, NULL, DEBUG2);
+		if (vacattrstats[attr_cnt] != NULL)
+			attr_cnt++;
+	}
+
+	/* same lower bound as ANALYZE, for Vitter's algorithm */
+	targrows = Max(targrows, 100);
+	rows = (HeapTuple *) palloc(targrows * sizeof(HeapTuple));
+	colLargeRowIndexes = (Bitmapset **) palloc0(natts * sizeof(Bitmapset *));
+	colLargeRowLength = (double *) palloc0(natts * sizeof(double));
+
+	/*
+	 * Like analyze_rel(), plan the sampling query without ORCA. Besides, the
+	 * caller is usually ORCA itself, in the middle of optimizing a query.
+	 */
+	optimizerBackup = optimizer;
+	optimizer = false;
+
+	acquire_func_colLargeRowIndexes = colLargeRowIndexes;
+	acquire_func_colLargeRowLength = colLargeRowLength;
+	PG_TRY();
+	{
+		numrows = gp_acquire_sample_rows_func(onerel, DEBUG2, rows, targrows,
+											  totalrows, &totaldeadrows);
+	}
+	PG_CATCH();
+	{
+		optimizer = optimizerBackup;
+		acquire_func_colLargeRowIndexes = NULL;
+		acquire_func_colLargeRowLength = NULL;
+		PG_RE_THROW();
+	}
+	PG_END_TRY();
+	acquire_func_colLargeRowIndexes = NULL;
+	acquire_func_colLargeRowLength = NULL;
+	optimizer = optimizerBackup;
+
+	validRows = (HeapTuple *) palloc(Max(numrows, 1) * sizeof(HeapTuple));
+	sd = table_open(StatisticRelationId, AccessShareLock);
+
+	for (i = 0; i < attr_cnt && numrows > 0; i++)
+	{
+		VacAttrStats *stats = vacattrstats[i];
+		AttrNumber	attnum = stats->attr->attnum;
+		Bitmapset  *rowIndexes = colLargeRowIndexes[attnum - 1];
+		AttributeOpts *aopt;
+		int			validRowsLength = 0;
+		int			rownum;
+
+		/* leave the rows that were too wide to sample out, like ANALYZE */
+		for (rownum = 0; rownum < numrows; rownum++)
+		{
+			if (!bms_is_member(rownum, rowIndexes))
+				validRows[validRowsLength++] = rows[rownum];
+		}
+		if (validRowsLength == 0)
+			continue;
+
+		stats->tupDesc = onerel->rd_att;
+		stats->rows = validRows;
+		stats->totalwidelength = colLargeRowLength[attnum - 1];
+		stats->widerow_num = numrows - validRowsLength;
+		stats->compute_stats(stats, std_fetch_func, validRowsLength, *totalrows);
+
+		aopt = get_attribute_options(onerel->rd_id, attnum);
+		if (aopt != NULL && aopt->n_distinct != 0.0)
+			stats->stadistinct = aopt->n_distinct;
+
+		if (stats->stats_valid)
+		{
+			Datum		values[Natts_pg_statistic];
+			bool		nulls[Natts_pg_statistic];
+
+			form_attstats_values(RelationGetRelid(onerel), false, stats,
+								 values, nulls);
+			MemoryContextSwitchTo(caller_context);
+			result[attnum - 1] = heap_form_tuple(RelationGetDescr(sd),
+												 values, nulls);
+			MemoryContextSwitchTo(anl_context);
+		}
+	}
+
+	table_close(sd, AccessShareLock);
+	MemoryContextSwitchTo(caller_context);
+	MemoryContextDelete(anl_context);
+	anl_context = save_anl_context;
+	vac_strategy = save_vac_strategy;
+
+	return result;
+}
+
 /*
  *	do_analyze_rel() -- analyze one relation, recursively or not
  *
@@ -686,9 +889,19 @@ do_analyze_rel(Relation onerel, VacuumParams *params,
 	colLargeRowIndexes = (Bitmapset **) palloc0(sizeof(Bitmapset *) * onerel->rd_att->natts);
 	colLargeRowLength = (double *)palloc0(sizeof(double) * onerel->rd_att->natts);
 
-	if ((params->options & VACOPT_FULLSCAN) != 0)
+	/*
+	 * With FULLSCAN, the number of distinct values is estimated from HLL
+	 * counters computed by the segments over all their rows and merged, rather
+	 * than from the sample gathered on the coordinator, which badly
+	 * underestimates it for columns with many distinct values.
+	 */
+	if (!ctx &&
+		((params->options & VACOPT_FULLSCAN) != 0 ||
+		 (gp_analyze_hll_fullscan && Gp_role == GP_ROLE_DISPATCH)))
 	{
-		if (onerel->rd_rel->relispartition)
+		if (onerel->rd_rel->relispartition ||
+			(onerel->rd_rel->relkind == RELKIND_RELATION && !inh &&
+			 !IsSystemRelation(onerel)))
 		{
 			acquire_hll_by_query(onerel, attr_cnt, vacattrstats, elevel);
 
@@ -872,7 +1085,8 @@ do_analyze_rel(Relation onerel, VacuumParams *params,
 				/*
 				 * Store HLL/HLL fullscan information for leaf partitions in
 				 * the stats object. If table was created with "analyze_hll_non_part_table" option, also collect
-				 * HLL stats for non-leaf tables
+				 * HLL stats for non-leaf tables. A fullscan HLL counter is
+				 * stored for any table.
 				 */
 				bool analyze_hll_non_part_table = false;
 				if (onerel->rd_options != NULL &&
@@ -880,7 +1094,9 @@ do_analyze_rel(Relation onerel, VacuumParams *params,
 				{
 					analyze_hll_non_part_table = true;
 				}
-				if (onerel->rd_rel->relkind == RELKIND_RELATION && (onerel->rd_rel->relispartition || analyze_hll_non_part_table))
+				if (onerel->rd_rel->relkind == RELKIND_RELATION &&
+					(onerel->rd_rel->relispartition || analyze_hll_non_part_table ||
+					 stats->stahll_full != NULL))
 				{
 					MemoryContext old_context;
 					Datum *hll_values;
@@ -1062,6 +1278,17 @@ do_analyze_rel(Relation onerel, VacuumParams *params,
 							false /* isVacuum */);
 	}
 
+#ifdef USE_ORCA
+	/*
+	 * GPDB: also store the new statistics in the form GPORCA plans with, now
+	 * that reltuples is final. Plain inheritance parents are only done for
+	 * the inherited statistics, the ones GPORCA reads.
+	 */
+	if (optimizer_analyze_store_buckets && Gp_role == GP_ROLE_DISPATCH &&
+		(inh || !onerel->rd_rel->relhassubclass))
+		store_orca_buckets(onerel, inh, attr_cnt, vacattrstats);
+#endif
+
 	/*
 	 * Same for indexes. Vacuum always scans all indexes, so if we're part of
 	 * VACUUM ANALYZE, don't overwrite the accurate count already inserted by
@@ -2110,6 +2337,124 @@ AcquireNumberOfBlocks(Relation onerel)
 	}
 }
 
+/*
+ * Sum up the modcounts of the segfiles of an append-optimized relation over
+ * all the segments.
+ */
+static int64
+acquire_ao_modcount(Relation onerel)
+{
+	Oid			segrelid;
+	Oid			save_userid;
+	int			save_sec_context;
+	char	   *modcount_sql;
+	int64		modcount;
+
+	GetAppendOnlyEntryAuxOids(onerel, &segrelid, NULL, NULL);
+
+	/*
+	 * pg_aoseg and pg_aocsseg tables both keep the modcount of a segfile in a
+	 * column of that name.  Like the relation itself, they belong to its
+	 * owner.
+	 */
+	modcount_sql = psprintf("select pg_catalog.sum(modcount)::pg_catalog.int8 from %s",
+							quote_qualified_identifier(get_namespace_name(get_rel_namespace(segrelid)),
+													   get_rel_name(segrelid)));
+
+	GetUserIdAndSecContext(&save_userid, &save_sec_context);
+	SetUserIdAndSecContext(onerel->rd_rel->relowner,
+						   save_sec_context | SECURITY_RESTRICTED_OPERATION);
+
+	modcount = get_size_from_segDBs(modcount_sql);
+
+	SetUserIdAndSecContext(save_userid, save_sec_context);
+	pfree(modcount_sql);
+
+	return modcount;
+}
+
+/*
+ * Compute a signature of what ANALYZE collects statistics for on the
+ * relation: the statistics target of every column, the extended statistics
+ * objects, and the expression indexes with the statistics targets of their
+ * columns.
+ */
+static int32
+ao_analyze_statsig(Relation onerel)
+{
+	TupleDesc	tupdesc = RelationGetDescr(onerel);
+	List	   *statlist;
+	List	   *indexlist;
+	ListCell   *lc;
+	uint32		sig;
+
+	sig = hash_uint32((uint32) default_statistics_target);
+
+	for (int i = 0; i < tupdesc->natts; i++)
+	{
+		Form_pg_attribute att = TupleDescAttr(tupdesc, i);
+
+		if (att->attisdropped)
+			continue;
+
+		sig = hash_combine(sig, hash_uint32((uint32) att->attnum));
+		sig = hash_combine(sig, hash_uint32((uint32) att->attstattarget));
+	}
+
+	statlist = RelationGetStatExtList(onerel);
+	foreach(lc, statlist)
+		sig = hash_combine(sig, hash_uint32(lfirst_oid(lc)));
+	list_free(statlist);
+
+	indexlist = RelationGetIndexList(onerel);
+	foreach(lc, indexlist)
+	{
+		Relation	indexrel = index_open(lfirst_oid(lc), AccessShareLock);
+
+		if (RelationGetIndexExpressions(indexrel) != NIL)
+		{
+			TupleDesc	indexdesc = RelationGetDescr(indexrel);
+
+			sig = hash_combine(sig, hash_uint32(RelationGetRelid(indexrel)));
+			for (int i = 0; i < indexdesc->natts; i++)
+				sig = hash_combine(sig,
+								   hash_uint32((uint32) TupleDescAttr(indexdesc, i)->attstattarget));
+		}
+
+		index_close(indexrel, AccessShareLock);
+	}
+	list_free(indexlist);
+
+	return (int32) sig;
+}
+
+/*
+ * Does the relation have statistics for every column that ANALYZE would
+ * collect them for?  A column added since the relation was last analyzed,
+ * or an empty relation, has none.
+ */
+static bool
+ao_rel_analyzed(Relation onerel)
+{
+	TupleDesc	tupdesc = RelationGetDescr(onerel);
+
+	for (int i = 0; i < tupdesc->natts; i++)
+	{
+		Form_pg_attribute att = TupleDescAttr(tupdesc, i);
+
+		if (att->attisdropped || att->attstattarget == 0)
+			continue;
+
+		if (!SearchSysCacheExists3(STATRELATTINH,
+								   ObjectIdGetDatum(RelationGetRelid(onerel)),
+								   Int16GetDatum(att->attnum),
+								   BoolGetDatum(false)))
+			return false;
+	}
+
+	return true;
+}
+
 /*
  * Compute index relation's size.
  *
@@ -2716,6 +3061,89 @@ acquire_sample_rows_dispatcher(Relation onerel, bool inh, int elevel,
 	return sampleTuples;
 }
 
+/*
+ * form_attstats_values() -- fill in the columns of the pg_statistic tuple
+ * for one attribute
+ */
+static void
+form_attstats_values(Oid relid, bool inh, VacAttrStats *stats,
+					 Datum *values, bool *nulls)
+{
+	int			i,
+				k,
+				n;
+
+	for (i = 0; i < Natts_pg_statistic; ++i)
+		nulls[i] = false;
+
+	values[Anum_pg_statistic_starelid - 1] = ObjectIdGetDatum(relid);
+	values[Anum_pg_statistic_staattnum - 1] = Int16GetDatum(stats->attr->attnum);
+	values[Anum_pg_statistic_stainherit - 1] = BoolGetDatum(inh);
+	values[Anum_pg_statistic_stanullfrac - 1] = Float4GetDatum(stats->stanullfrac);
+	values[Anum_pg_statistic_stawidth - 1] = Int32GetDatum(stats->stawidth);
+	values[Anum_pg_statistic_stadistinct - 1] = Float4GetDatum(stats->stadistinct);
+	i = Anum_pg_statistic_stakind1 - 1;
+	for (k = 0; k < STATISTIC_NUM_SLOTS; k++)
+	{
+		values[i++] = Int16GetDatum(stats->stakind[k]); /* stakindN */
+	}
+	i = Anum_pg_statistic_staop1 - 1;
+	for (k = 0; k < STATISTIC_NUM_SLOTS; k++)
+	{
+		values[i++] = ObjectIdGetDatum(stats->staop[k]);	/* staopN */
+	}
+	i = Anum_pg_statistic_stacoll1 - 1;
+	for (k = 0; k < STATISTIC_NUM_SLOTS; k++)
+	{
+		values[i++] = ObjectIdGetDatum(stats->stacoll[k]);	/* stacollN */
+	}
+	i = Anum_pg_statistic_stanumbers1 - 1;
+	for (k = 0; k < STATISTIC_NUM_SLOTS; k++)
+	{
+		int			nnum = stats->numnumbers[k];
+
+		if (nnum > 0)
+		{
+			Datum	   *numdatums = (Datum *) palloc(nnum * sizeof(Datum));
+			ArrayType  *arry;
+
+			for (n = 0; n < nnum; n++)
+				numdatums[n] = Float4GetDatum(stats->stanumbers[k][n]);
+			/* XXX knows more than it should about type float4: */
+			arry = construct_array(numdatums, nnum,
+								   FLOAT4OID,
+								   sizeof(float4), FLOAT4PASSBYVAL, 'i');
+			values[i++] = PointerGetDatum(arry);	/* stanumbersN */
+		}
+		else
+		{
+			nulls[i] = true;
+			values[i++] = (Datum) 0;
+		}
+	}
+	i = Anum_pg_statistic_stavalues1 - 1;
+	for (k = 0; k < STATISTIC_NUM_SLOTS; k++)
+	{
+		if (stats->numvalues[k] > 0)
+		{
+			ArrayType  *arry;
+
+			arry = construct_array(stats->stavalues[k],
+								   stats->numvalues[k],
+								   stats->statypid[k],
+								   stats->statyplen[k],
+								   stats->statypbyval[k],
+								   stats->statypalign[k]);
+			values[i++] = PointerGetDatum(arry);	/* stavaluesN */
+		}
+		else
+		{
+			nulls[i] = true;
+			values[i++] = (Datum) 0;
+		}
+	}
+}
+
 /*
  *	update_attstats() -- update attribute statistics for one relation
  *
@@ -2754,9 +3182,7 @@ update_attstats(Oid relid, bool inh, int natts, VacAttrStats **vacattrstats)
 		VacAttrStats *stats = vacattrstats[attno];
 		HeapTuple	stup,
 					oldtup;
-		int			i,
-					k,
-					n;
+		int			i;
 		Datum		values[Natts_pg_statistic];
 		bool		nulls[Natts_pg_statistic];
 		bool		replaces[Natts_pg_statistic];
@@ -2769,77 +3195,8 @@ update_attstats(Oid relid, bool inh, int natts, VacAttrStats **vacattrstats)
 		 * Construct a new pg_statistic tuple
 		 */
 		for (i = 0; i < Natts_pg_statistic; ++i)
-		{
-			nulls[i] = false;
 			replaces[i] = true;
-		}
-
-		values[Anum_pg_statistic_starelid - 1] = ObjectIdGetDatum(relid);
-		values[Anum_pg_statistic_staattnum - 1] = Int16GetDatum(stats->attr->attnum);
-		values[Anum_pg_statistic_stainherit - 1] = BoolGetDatum(inh);
-		values[Anum_pg_statistic_stanullfrac - 1] = Float4GetDatum(stats->stanullfrac);
-		values[Anum_pg_statistic_stawidth - 1] = Int32GetDatum(stats->stawidth);
-		values[Anum_pg_statistic_stadistinct - 1] = Float4GetDatum(stats->stadistinct);
-		i = Anum_pg_statistic_stakind1 - 1;
-		for (k = 0; k < STATISTIC_NUM_SLOTS; k++)
-		{
-			values[i++] = Int16GetDatum(stats->stakind[k]); /* stakindN */
-		}
-		i = Anum_pg_statistic_staop1 - 1;
-		for (k = 0; k < STATISTIC_NUM_SLOTS; k++)
-		{
-			values[i++] = ObjectIdGetDatum(stats->staop[k]);	/* staopN */
-		}
-		i = Anum_pg_statistic_stacoll1 - 1;
-		for (k = 0; k < STATISTIC_NUM_SLOTS; k++)
-		{
-			values[i++] = ObjectIdGetDatum(stats->stacoll[k]);	/* stacollN */
-		}
-		i = Anum_pg_statistic_stanumbers1 - 1;
-		for (k = 0; k < STATISTIC_NUM_SLOTS; k++)
-		{
-			int			nnum = stats->numnumbers[k];
-
-			if (nnum > 0)
-			{
-				Datum	   *numdatums = (Datum *) palloc(nnum * sizeof(Datum));
-				ArrayType  *arry;
-
-				for (n = 0; n < nnum; n++)
-					numdatums[n] = Float4GetDatum(stats->stanumbers[k][n]);
-				/* XXX knows more than it should about type float4: */
-				arry = construct_array(numdatums, nnum,
-									   FLOAT4OID,
-									   sizeof(float4), FLOAT4PASSBYVAL, 'i');
-				values[i++] = PointerGetDatum(arry);	/* stanumbersN */
-			}
-			else
-			{
-				nulls[i] = true;
-				values[i++] = (Datum) 0;
-			}
-		}
-		i = Anum_pg_statistic_stavalues1 - 1;
-		for (k = 0; k < STATISTIC_NUM_SLOTS; k++)
-		{
-			if (stats->numvalues[k] > 0)
-			{
-				ArrayType  *arry;
-
-				arry = construct_array(stats->stavalues[k],
-									   stats->numvalues[k],
-									   stats->statypid[k],
-									   stats->statyplen[k],
-									   stats->statypbyval[k],
-									   stats->statypalign[k]);
-				values[i++] = PointerGetDatum(arry);	/* stavaluesN */
-			}
-			else
-			{
-				nulls[i] = true;
-				values[i++] = (Datum) 0;
-			}
-		}
+		form_attstats_values(relid, inh, stats, values, nulls);
 
 		/* Is there already a pg_statistic tuple for this attribute? */
 		oldtup = SearchSysCache3(STATRELATTINH,
@@ -2871,6 +3228,111 @@ update_attstats(Oid relid, bool inh, int natts, VacAttrStats **vacattrstats)
 	table_close(sd, RowExclusiveLock);
 }
 
+#ifdef USE_ORCA
+/*
+ *	store_orca_buckets() -- add GPORCA's buckets to new pg_statistic rows
+ *
+ * GPORCA converts the MCVs and histogram of a column into its own buckets
+ * every time it loads the column's statistics into its metadata cache.
+ * Have it do that once here, and keep the result in a free slot of the
+ * column's pg_statistic row, as STATISTIC_KIND_ORCA_BUCKETS. GPORCA checks
+ * that the stored buckets still match the row and pg_class before using
+ * them. Columns without a free slot, or that GPORCA can't handle, are left
+ * as they are.
+ */
+static void
+store_orca_buckets(Relation onerel, bool inh,
+				   int natts, VacAttrStats **vacattrstats)
+{
+	Relation	sd;
+	AttrNumber *attnums;
+	bytea	  **buckets;
+	int			nbuckets = 0;
+	int			i;
+
+	attnums = (AttrNumber *) palloc(natts * sizeof(AttrNumber));
+	for (i = 0; i < natts; i++)
+	{
+		if (vacattrstats[i]->stats_valid)
+			attnums[nbuckets++] = vacattrstats[i]->attr->attnum;
+	}
+	if (nbuckets == 0)
+	{
+		pfree(attnums);
+		return;
+	}
+
+	/* Let GPORCA see the rows and reltuples we just wrote */
+	CommandCounterIncrement();
+
+	buckets = (bytea **) palloc0(nbuckets * sizeof(bytea *));
+	GPOPTSerializeColumnBuckets(RelationGetRelid(onerel), nbuckets,
+								attnums, buckets);
+
+	sd = table_open(StatisticRelationId, RowExclusiveLock);
+
+	for (i = 0; i < nbuckets; i++)
+	{
+		HeapTuple	oldtup;
+		HeapTuple	stup;
+		Form_pg_statistic statform;
+		Datum		values[Natts_pg_statistic];
+		bool		nulls[Natts_pg_statistic];
+		bool		replaces[Natts_pg_statistic];
+		Datum		bucketsdatum;
+		int			slot;
+
+		if (buckets[i] == NULL)
+			continue;
+
+		oldtup = SearchSysCache3(STATRELATTINH,
+								 ObjectIdGetDatum(RelationGetRelid(onerel)),
+								 Int16GetDatum(attnums[i]),
+								 BoolGetDatum(inh));
+		if (!HeapTupleIsValid(oldtup))
+			continue;
+
+		statform = (Form_pg_statistic) GETSTRUCT(oldtup);
+		for (slot = 0; slot < STATISTIC_NUM_SLOTS; slot++)
+		{
+			if ((&statform->stakind1)[slot] == 0)
+				break;
+		}
+		if (slot == STATISTIC_NUM_SLOTS)
+		{
+			ReleaseSysCache(oldtup);
+			continue;
+		}
+
+		memset(replaces, false, sizeof(replaces));
+		memset(nulls, false, sizeof(nulls));
+
+		values[Anum_pg_statistic_stakind1 - 1 + slot] =
+			Int16GetDatum(STATISTIC_KIND_ORCA_BUCKETS);
+		values[Anum_pg_statistic_staop1 - 1 + slot] = ObjectIdGetDatum(InvalidOid);
+		values[Anum_pg_statistic_stacoll1 - 1 + slot] = ObjectIdGetDatum(InvalidOid);
+		nulls[Anum_pg_statistic_stanumbers1 - 1 + slot] = true;
+		bucketsdatum = PointerGetDatum(buckets[i]);
+		values[Anum_pg_statistic_stavalues1 - 1 + slot] =
+			PointerGetDatum(construct_array(&bucketsdatum, 1, BYTEAOID,
+											-1, false, 'i'));
+		replaces[Anum_pg_statistic_stakind1 - 1 + slot] = true;
+		replaces[Anum_pg_statistic_staop1 - 1 + slot] = true;
+		replaces[Anum_pg_statistic_stacoll1 - 1 + slot] = true;
+		replaces[Anum_pg_statistic_stanumbers1 - 1 + slot] = true;
+		replaces[Anum_pg_statistic_stavalues1 - 1 + slot] = true;
+
+		stup = heap_modify_tuple(oldtup, RelationGetDescr(sd),
+								 values, nulls, replaces);
+		ReleaseSysCache(oldtup);
+		CatalogTupleUpdate(sd, &stup->t_self, stup);
+		heap_freetuple(stup);
+	}
+
+	table_close(sd, RowExclusiveLock);
+}
+#endif
+
 /*
  * Standard fetch function for use by compute_stats subroutines.
  *
@@ -958,6 +958,11 @@ ExplainPrintPlan(ExplainState *es, QueryDesc *queryDesc)
                                      estate->dispatcherState->primaryResults,
                                      LocallyExecutingSliceIndex(estate),
                                      es->showstatctx);
+
+		/* Let ORCA learn from the rows its joins actually produced */
+		if (optimizer_cardinality_feedback &&
+			queryDesc->plannedstmt->planGen == PLANGEN_OPTIMIZER)
+			cdbexplain_recordCardinalityFeedback(queryDesc->planstate, es);
 	}
 
 	ExplainPreScanNode(queryDesc->planstate, &rels_used);
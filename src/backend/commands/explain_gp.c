@@ -30,6 +30,7 @@
 #include "cdb/memquota.h"
 #include "libpq/pqformat.h"		/* pq_beginmessage() etc. */
 #include "miscadmin.h"
+#include "optimizer/cardfeedback.h"
 #include "utils/resscheduler.h"
 #include "utils/tuplesort.h"
 #include "utils/memutils.h"		/* MemoryContextGetPeakSpace() */
@@ -298,6 +299,8 @@ static void cdbexplain_depositStatsToNode(PlanState *planstate,
 										  CdbExplain_RecvStatCtx *ctx);
 static int cdbexplain_collectExtraText(PlanState *planstate,
 									   StringInfo notebuf);
+static bool cdbexplain_recordCardinalityFeedback(PlanState *planstate,
+												 ExplainState *es);
 
 static void show_motion_keys(PlanState *planstate, List *hashExpr, int nkeys,
 							 AttrNumber *keycols, const char *qlabel,
@@ -1210,6 +1213,10 @@ cdbexplain_depositStatsToNode(PlanState *planstate, CdbExplain_RecvStatCtx *ctx)
 			cdbexplain_depStatAcc_saveText(&shared_blks_hit, ctx->extratextbuf, &saved);
 		if (shared_blks_read.agg.vsum > 0)
 			cdbexplain_depStatAcc_saveText(&shared_blks_read, ctx->extratextbuf, &saved);
+
+		/* Sending motion: the worker which sent the most rows */
+		if (IsA(planstate, MotionState))
+			cdbexplain_depStatAcc_saveText(&ntuples, ctx->extratextbuf, &saved);
 		if (shared_blks_written.agg.vsum > 0)
 			cdbexplain_depStatAcc_saveText(&shared_blks_written, ctx->extratextbuf, &saved);
 		if (shared_blks_dirtied.agg.vsum > 0)
@@ -1888,6 +1895,36 @@ ExplainPrintExecStatsEnd(ExplainState *es, QueryDesc *queryDesc)
 								queryDesc->estate, es);
 }
 
+/*
+ * cdbexplain_recordCardinalityFeedback
+ *	  Report the estimated and the actual rows of every join of the plan to
+ *	  the cardinality feedback kept for ORCA.
+ *
+ * The estimate on the node is per segment, the actual rows are summed over
+ * all the workers that ran the node. Joins that were rescanned are skipped,
+ * their estimate is per loop.
+ */
+static bool
+cdbexplain_recordCardinalityFeedback(PlanState *planstate, ExplainState *es)
+{
+	Plan	   *plan = planstate->plan;
+	Instrumentation *instr = planstate->instrument;
+
+	if ((IsA(plan, NestLoop) || IsA(plan, HashJoin) || IsA(plan, MergeJoin)) &&
+		instr && instr->cdbNodeSummary && instr->nloops <= 1)
+	{
+		CdbExplain_NodeSummary *ns = instr->cdbNodeSummary;
+
+		if (ns->ntuples.vcnt > 0)
+			RecordCardinalityFeedback(es->pstmt, (Join *) plan,
+									  plan->plan_rows * ns->ntuples.vcnt,
+									  ns->ntuples.vsum);
+	}
+
+	return planstate_tree_walker(planstate,
+								 cdbexplain_recordCardinalityFeedback, es);
+}
+
 /*
  * cdbexplain_showExecStatsEnd
  *	  Called by qDisp process to format the overall statistics for a query
@@ -2359,6 +2359,14 @@ ExecuteTruncateGuts(List *explicit_rels, List *relids, List *relids_logged,
 			reindex_relation(heap_relid, REINDEX_REL_PROCESS_TOAST, 0);
 		}
 
+		/*
+		 * The modcounts of the emptied segfiles start over, so ANALYZE can no
+		 * longer tell from them whether the table was modified since.
+		 */
+		if (RelationStorageIsAO(rel) &&
+			rel->rd_appendonly->analyzemodcount >= 0)
+			UpdateAppendOnlyEntryAnalyzeModCount(RelationGetRelid(rel), -1, 0);
+
 		pgstat_count_truncate(rel);
 	}
 
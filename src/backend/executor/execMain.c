@@ -2649,6 +2649,14 @@ ExecutePlan(EState *estate,
 	if (!execute_once)
 		use_parallel_mode = false;
 
+	/*
+	 * GPDB: Gather nodes only appear below the motions, so only the QEs
+	 * launch parallel workers. The QD just dispatches the plan and must not
+	 * be restricted to parallel mode while doing so.
+	 */
+	if (Gp_role == GP_ROLE_DISPATCH)
+		use_parallel_mode = false;
+
 	estate->es_use_parallel_mode = use_parallel_mode;
 	if (use_parallel_mode)
 		EnterParallelMode();
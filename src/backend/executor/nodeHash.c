@@ -1032,6 +1032,8 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 	Size		spaceFreed = 0;
 	HashJoinTableStats *stats = hashtable->stats;
 	HashMemoryChunk oldchunks;
+	uint32		hh_hashvalue = 0;
+	Size		hh_weight = 0;
 
 	/* do nothing if we've decided to shut off growth */
 	if (!hashtable->growEnabled)
@@ -1145,6 +1147,20 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 				/* keep tuple in memory - copy it into the new chunk */
 				HashJoinTuple copyTuple;
 
+				/*
+				 * Track the hash value most likely to dominate what stays in
+				 * memory (a weighted majority vote), see below.
+				 */
+				if (hashTuple->hashvalue == hh_hashvalue)
+					hh_weight += hashTupleSize;
+				else if (hh_weight >= hashTupleSize)
+					hh_weight -= hashTupleSize;
+				else
+				{
+					hh_hashvalue = hashTuple->hashvalue;
+					hh_weight = hashTupleSize - hh_weight;
+				}
+
 				copyTuple = (HashJoinTuple) dense_alloc(hashtable, hashTupleSize);
 				memcpy(copyTuple, hashTuple, hashTupleSize);
 
@@ -1194,6 +1210,7 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 		stats->workmem_max = Max(stats->workmem_max, spaceUsedBefore);
 		stats->batchstats[curbatch].spillspace_out += spaceFreed;
 		stats->batchstats[curbatch].spillrows_out += nfreed;
+		stats->nbatch_increases++;
 	}
 
 	/*
@@ -1212,7 +1229,47 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 			   hashtable);
 #endif
 	}
+	else if (hh_weight > 0)
+	{
+		/*
+		 * The same goes, to a lesser degree, if one heavy hitter hash value
+		 * holds much of the space: every further increase would only move
+		 * out part of the rest of the batch, at the price of rewriting it,
+		 * while the heavy hitter stays.  Keep it and the remaining tuples of
+		 * this batch in memory instead; tuples of other batches keep going
+		 * to their files as before.
+		 *
+		 * The vote above only gives a candidate, so count its actual space.
+		 * Tuples with equal hash values share a bucket.
+		 */
+		Size		hh_space = 0;
+		HashJoinTuple hashTuple;
+		int			bucketno;
+		int			batchno;
+
+		ExecHashGetBucketAndBatch(hashtable, hh_hashvalue, &bucketno, &batchno);
+		for (hashTuple = hashtable->buckets.unshared[bucketno];
+			 hashTuple != NULL;
+			 hashTuple = hashTuple->next.unshared)
+		{
+			if (hashTuple->hashvalue == hh_hashvalue)
+				hh_space += HJTUPLE_OVERHEAD + HJTUPLE_MINTUPLE(hashTuple)->t_len;
+		}
 
+		if (hh_space > hashtable->spaceAllowed * SKEW_HEAVY_HITTER_FRACTION)
+		{
+			hashtable->growEnabled = false;
+			if (stats)
+				stats->heavy_hitter_space = hh_space;
+#ifdef HJDEBUG
+			printf("Hashjoin %p: disabling further increase of nbatch, hash value %u holds %zu bytes\n",
+				   hashtable, hh_hashvalue, hh_space);
+#endif
+		}
+	}
+
+	if (!hashtable->growEnabled && stats)
+		stats->growth_stopped_batch = curbatch;
 }
 
 /*
@@ -2428,6 +2485,7 @@ ExecHashTableExplainInit(HashState *hashState, HashJoinState *hjstate,
     /* Create workarea and attach it to the HashJoinTable. */
     hashtable->stats = (HashJoinTableStats *)palloc0(sizeof(*hashtable->stats));
     hashtable->stats->endedbatch = -1;
+    hashtable->stats->growth_stopped_batch = -1;
 
     /* Create per-batch statistics array. */
     hashtable->stats->batchstats =
@@ -2537,6 +2595,34 @@ ExecHashTableExplainEnd(PlanState *planstate, struct StringInfoData *buf)
 		ResetWorkFileSetStatsInfo(hashtable);
     }
 
+    /* Report growth of the number of batches at run time. */
+    if (stats->nbatch_increases > 0)
+    {
+        appendStringInfo(buf,
+                         "Batches increased %d times, from %d to %d.",
+                         stats->nbatch_increases,
+                         hashtable->nbatch_original,
+                         hashtable->nbatch);
+        if (stats->growth_stopped_batch >= 0)
+        {
+            appendStringInfo(buf,
+                             "  Further increases disabled in batch %d",
+                             stats->growth_stopped_batch);
+            if (stats->heavy_hitter_space > 0)
+                appendStringInfo(buf,
+                                 ", a single hash value held %.0fK bytes",
+                                 ceil((double) stats->heavy_hitter_space / 1024));
+            appendStringInfoChar(buf, '.');
+        }
+        appendStringInfoChar(buf, '\n');
+    }
+
+    /* Report the skew optimization, which only applies to the first batch. */
+    if (hashtable->skewTuples > 0)
+        appendStringInfo(buf,
+                         "Skew optimization kept " UINT64_FORMAT " inner rows matching common outer values in memory.\n",
+                         hashtable->skewTuples);
+
     /* Report hash chain statistics. */
     total_buckets = stats->nonemptybatches * hashtable->nbuckets;
     if (total_buckets > 0)
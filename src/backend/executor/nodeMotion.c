@@ -57,6 +57,7 @@ static uint32 evalHashKey(ExprContext *econtext, List *hashkeys, CdbHash *h);
 
 static void doSendEndOfStream(Motion *motion, MotionState *node);
 static void doSendTuple(Motion *motion, MotionState *node, TupleTableSlot *outerTupleSlot);
+static void ExecMotionExplainEnd(PlanState *planstate, struct StringInfoData *buf);
 
 
 /*=========================================================================
@@ -822,6 +823,12 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 										   node->hashFuncs);
 	}
 
+	/* Report interconnect compression in EXPLAIN ANALYZE */
+	if (motionstate->mstype == MOTIONSTATE_SEND &&
+		(estate->es_instrument & INSTRUMENT_CDB) &&
+		Gp_interconnect_compress_level > 0)
+		motionstate->ps.cdbexplainfun = ExecMotionExplainEnd;
+
 	/*
 	 * Merge Receive: Set up the key comparator and priority queue.
 	 *
@@ -890,6 +897,32 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 	return motionstate;
 }
 
+/*
+ * ExecMotionExplainEnd
+ *		Called before ExecEndMotion on QEs when EXPLAIN ANALYZE was specified.
+ *
+ * Reports how much the packets of this sender were compressed.
+ */
+static void
+ExecMotionExplainEnd(PlanState *planstate, struct StringInfoData *buf)
+{
+	ChunkTransportState *transportStates = planstate->state->interconnect_context;
+	int			motNodeID = ((Motion *) planstate->plan)->motionID;
+	ChunkTransportStateEntry *pEntry;
+
+	if (transportStates == NULL ||
+		motNodeID <= 0 || motNodeID > transportStates->size)
+		return;
+
+	pEntry = &transportStates->states[motNodeID - 1];
+	if (!pEntry->valid || pEntry->stat_compress_bytes_in == 0)
+		return;
+
+	appendStringInfo(buf, "Interconnect compression: " UINT64_FORMAT " bytes compressed to " UINT64_FORMAT " bytes.",
+					 pEntry->stat_compress_bytes_in,
+					 pEntry->stat_compress_bytes_out);
+}
+
 /* ----------------------------------------------------------------
  *		ExecEndMotion(node)
  * ----------------------------------------------------------------
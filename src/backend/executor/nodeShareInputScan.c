@@ -35,6 +35,12 @@
  * the whole tuplestore, and advertises that it's ready in shared memory.
  * Consumer slices wait for that before trying to read the store.
  *
+ * If gp_shareinput_xslice_in_memory is on, the producer keeps the result in
+ * memory for as long as it fits in the operator memory of the node. If it
+ * still fits at the end, it is copied to a DSM segment, and the consumers
+ * read it from there instead of from a file. Otherwise, and if no DSM
+ * segment can be had, the result is shared through a file as usual.
+ *
  * The producer and the consumers communicate the status of the scan using
  * shared memory. There's a hash table in shared memory, containing a
  * 'shareinput_Xslice_state' struct for each shared scan. The producer uses
@@ -64,6 +70,7 @@
 #include "miscadmin.h"
 #include "pgstat.h"
 #include "storage/condition_variable.h"
+#include "storage/dsm.h"
 #include "storage/lwlock.h"
 #include "storage/shmem.h"
 #include "utils/faultinjector.h"
@@ -105,6 +112,7 @@ typedef struct shareinput_Xslice_state
 	int			refcount;		/* reference count of this entry */
 	pg_atomic_uint32	ready;	/* is the input fully materialized and ready to be read? */
 	pg_atomic_uint32	ndone;	/* # of consumers that have finished the scan */
+	dsm_handle	mem_handle;		/* DSM segment holding the result, if any */
 
 	/*
 	 * ready_done_cv is used for signaling when the scan becomes "ready", and
@@ -180,6 +188,9 @@ typedef struct shareinput_local_state
 
 	/* Tuplestore that holds the result */
 	Tuplestorestate *ts_state;
+
+	/* DSM segment the tuplestore reads from, for an in-memory cross-slice share */
+	dsm_segment *mem_seg;
 } shareinput_local_state;
 
 static shareinput_Xslice_reference *get_shareinput_reference(int share_id);
@@ -194,6 +205,9 @@ static void shareinput_reader_waitready(shareinput_Xslice_reference *ref);
 static void shareinput_reader_notifydone(shareinput_Xslice_reference *ref, int nconsumers);
 static void shareinput_writer_waitdone(shareinput_Xslice_reference *ref, int nconsumers);
 
+static Tuplestorestate *shareinput_writer_export_mem(ShareInputScanState *node,
+													 Tuplestorestate *ts);
+
 static void ExecShareInputScanExplainEnd(PlanState *planstate, struct StringInfoData *buf);
 
 
@@ -234,28 +248,25 @@ init_tuplestore_state(ShareInputScanState *node)
 				elog((Debug_shareinput_xslice ? LOG : DEBUG1), "SISC WRITER (shareid=%d, slice=%d): No tuplestore yet, creating tuplestore",
 					 sisc->share_id, currentSliceId);
 
-				ts = tuplestore_begin_heap(true, /* randomAccess */
-										   false, /* interXact */
-										   10); /* maxKBytes FIXME */
-
 				shareinput_create_bufname_prefix(rwfile_prefix, sizeof(rwfile_prefix), sisc->share_id);
-				tuplestore_make_shared(ts,
-									   get_shareinput_fileset(),
-									   rwfile_prefix);
-#ifdef FAULT_INJECTOR
-				if (SIMPLE_FAULT_INJECTOR("sisc_xslice_temp_files") == FaultInjectorTypeSkip)
+				if (gp_shareinput_xslice_in_memory)
 				{
-					const char *filename = tuplestore_get_buffilename(ts);
-					if (!filename)
-						ereport(NOTICE, (errmsg("sisc_xslice: buffilename is null")));
-					else if (strstr(filename, "base/" PG_TEMP_FILES_DIR) == filename)
-						ereport(NOTICE, (errmsg("sisc_xslice: Use default tablespace")));
-					else if (strstr(filename, "pg_tblspc/") == filename)
-						ereport(NOTICE, (errmsg("sisc_xslice: Use temp tablespace")));
-					else
-						ereport(NOTICE, (errmsg("sisc_xslice: Unexpected prefix of the tablespace path")));
+					ts = tuplestore_begin_heap(true, /* randomAccess */
+											   false, /* interXact */
+											   PlanStateOperatorMemKB((PlanState *) node));
+					tuplestore_make_shared_lazy(ts,
+												get_shareinput_fileset(),
+												rwfile_prefix);
+				}
+				else
+				{
+					ts = tuplestore_begin_heap(true, /* randomAccess */
+											   false, /* interXact */
+											   10); /* maxKBytes FIXME */
+					tuplestore_make_shared(ts,
+										   get_shareinput_fileset(),
+										   rwfile_prefix);
 				}
-#endif
 			}
 			else
 			{
@@ -296,7 +307,32 @@ init_tuplestore_state(ShareInputScanState *node)
 
 			if (sisc->cross_slice)
 			{
-				tuplestore_freeze(ts);
+				if (tuplestore_in_memory(ts))
+					ts = shareinput_writer_export_mem(node, ts);
+				else
+					tuplestore_freeze(ts);
+
+#ifdef FAULT_INJECTOR
+				/*
+				 * Report where the result is shared from. The file of a
+				 * store that started in memory only exists from here on.
+				 */
+				if (SIMPLE_FAULT_INJECTOR("sisc_xslice_temp_files") == FaultInjectorTypeSkip)
+				{
+					const char *filename = tuplestore_get_buffilename(ts);
+					if (local_state->mem_seg)
+						ereport(NOTICE, (errmsg("sisc_xslice: Use shared memory")));
+					else if (!filename)
+						ereport(NOTICE, (errmsg("sisc_xslice: buffilename is null")));
+					else if (strstr(filename, "base/" PG_TEMP_FILES_DIR) == filename)
+						ereport(NOTICE, (errmsg("sisc_xslice: Use default tablespace")));
+					else if (strstr(filename, "pg_tblspc/") == filename)
+						ereport(NOTICE, (errmsg("sisc_xslice: Use temp tablespace")));
+					else
+						ereport(NOTICE, (errmsg("sisc_xslice: Unexpected prefix of the tablespace path")));
+				}
+#endif
+
 				shareinput_writer_notifyready(node->ref);
 			}
 
@@ -314,8 +350,22 @@ init_tuplestore_state(ShareInputScanState *node)
 
 			shareinput_reader_waitready(node->ref);
 
-			shareinput_create_bufname_prefix(rwfile_prefix, sizeof(rwfile_prefix), sisc->share_id);
-			ts = tuplestore_open_shared(get_shareinput_fileset(), rwfile_prefix);
+			if (node->ref->xslice_state->mem_handle != DSM_HANDLE_INVALID)
+			{
+				dsm_segment *seg;
+
+				seg = dsm_attach(node->ref->xslice_state->mem_handle);
+				if (seg == NULL)
+					elog(ERROR, "could not attach to ShareInputScan DSM segment (shareid=%d)",
+						 sisc->share_id);
+				local_state->mem_seg = seg;
+				ts = tuplestore_open_shared_mem(dsm_segment_address(seg));
+			}
+			else
+			{
+				shareinput_create_bufname_prefix(rwfile_prefix, sizeof(rwfile_prefix), sisc->share_id);
+				ts = tuplestore_open_shared(get_shareinput_fileset(), rwfile_prefix);
+			}
 		}
 		local_state->ts_state = ts;
 		local_state->ready = true;
@@ -337,6 +387,98 @@ init_tuplestore_state(ShareInputScanState *node)
 	node->isready = true;
 }
 
+/*
+ * shareinput_create_mem_segment
+ *
+ *    Create a DSM segment of the given size, or return NULL if there is no
+ *    room for it. dsm_create() only returns NULL when it runs out of
+ *    segment slots; if the memory backing the segments is exhausted, it
+ *    throws an error instead. Catch that. The segment is created under a
+ *    resource owner of its own, so that a segment that failed halfway can
+ *    be released without touching the resources of the query. A segment
+ *    that was created stays with that owner, a child of the current one,
+ *    and is released with it.
+ */
+static dsm_segment *
+shareinput_create_mem_segment(Size size, int share_id)
+{
+	ResourceOwner oldowner = CurrentResourceOwner;
+	ResourceOwner owner;
+	MemoryContext oldcontext = CurrentMemoryContext;
+	dsm_segment *seg = NULL;
+	bool		failed = false;
+
+	owner = ResourceOwnerCreate(oldowner, "ShareInputScan DSM");
+	CurrentResourceOwner = owner;
+
+	PG_TRY();
+	{
+		seg = dsm_create(size, DSM_CREATE_NULL_IF_MAXSEGMENTS);
+	}
+	PG_CATCH();
+	{
+		ErrorData  *edata;
+
+		MemoryContextSwitchTo(oldcontext);
+		edata = CopyErrorData();
+		FlushErrorState();
+
+		elog((Debug_shareinput_xslice ? LOG : DEBUG1), "SISC WRITER (shareid=%d, slice=%d): could not create DSM segment of %zu bytes: %s",
+			 share_id, currentSliceId, size, edata->message);
+		FreeErrorData(edata);
+		failed = true;
+	}
+	PG_END_TRY();
+
+	CurrentResourceOwner = oldowner;
+
+	if (failed || seg == NULL)
+	{
+		ResourceOwnerRelease(owner, RESOURCE_RELEASE_BEFORE_LOCKS, false, false);
+		ResourceOwnerRelease(owner, RESOURCE_RELEASE_LOCKS, false, false);
+		ResourceOwnerRelease(owner, RESOURCE_RELEASE_AFTER_LOCKS, false, false);
+		ResourceOwnerDelete(owner);
+		return NULL;
+	}
+
+	return seg;
+}
+
+/*
+ * shareinput_writer_export_mem
+ *
+ *    Copy the result of an in-memory cross-slice share to a new DSM segment,
+ *    and return a tuplestore that reads it from there. If no DSM segment can
+ *    be had, freeze the tuplestore to a file instead, and return it as is.
+ */
+static Tuplestorestate *
+shareinput_writer_export_mem(ShareInputScanState *node, Tuplestorestate *ts)
+{
+	ShareInputScan *sisc = (ShareInputScan *) node->ss.ps.plan;
+	shareinput_local_state *local_state = node->local_state;
+	dsm_segment *seg;
+
+	seg = shareinput_create_mem_segment(tuplestore_shared_mem_size(ts),
+										sisc->share_id);
+	if (seg == NULL)
+	{
+		tuplestore_freeze(ts);
+		return ts;
+	}
+
+	tuplestore_export_shared_mem(ts, dsm_segment_address(seg));
+	tuplestore_end(ts);
+
+	local_state->mem_seg = seg;
+	node->ref->xslice_state->mem_handle = dsm_segment_handle(seg);
+
+	elog((Debug_shareinput_xslice ? LOG : DEBUG1), "SISC WRITER (shareid=%d, slice=%d): shared result in memory",
+		 sisc->share_id, currentSliceId);
+
+	/* read the result back from the segment, like the consumers do */
+	return tuplestore_open_shared_mem(dsm_segment_address(seg));
+}
+
 
 /* ------------------------------------------------------------------
  * 	ExecShareInputScan
@@ -586,6 +728,11 @@ ExecEndShareInputScan(ShareInputScanState *node)
 		tuplestore_end(local_state->ts_state);
 		local_state->ts_state = NULL;
 	}
+	if (local_state && local_state->mem_seg)
+	{
+		dsm_detach(local_state->mem_seg);
+		local_state->mem_seg = NULL;
+	}
 
 	/*
 	 * shutdown subplan.  First scanner of underlying share input will
@@ -833,6 +980,7 @@ get_shareinput_reference(int share_id)
 		xslice_state->refcount = 0;
 		pg_atomic_init_u32(&xslice_state->ready, 0);
 		pg_atomic_init_u32(&xslice_state->ndone, 0);
+		xslice_state->mem_handle = DSM_HANDLE_INVALID;
 
 		ConditionVariableInit(&xslice_state->ready_done_cv);
 		elog((Debug_shareinput_xslice ? LOG : DEBUG1), "SISC (shareid=%d, slice=%d): initialized xslice state",
@@ -959,6 +1107,9 @@ shareinput_reader_waitready(shareinput_Xslice_reference *ref)
 	}
 	ConditionVariableCancelSleep();
 
+	/* mem_handle was set before the exchange in notifyready */
+	pg_read_barrier();
+
 	/* it's ready now */
 	elog((Debug_shareinput_xslice ? LOG : DEBUG1), "SISC READER (shareid=%d, slice=%d): Wait ready got writer's handshake",
 		 ref->share_id, currentSliceId);
@@ -37,6 +37,7 @@
 #include "catalog/objectaccess.h"
 #include "catalog/pg_aggregate.h"
 #include "catalog/pg_proc.h"
+#include "catalog/pg_type.h"
 #include "executor/executor.h"
 #include "executor/nodeWindowAgg.h"
 #include "miscadmin.h"
@@ -57,9 +58,14 @@
 #include "utils/tuplesort.h"
 #include "windowapi.h"
 
+#include "cdb/cdbvars.h"
+
 #include "optimizer/optimizer.h" // for exprType
 #include "parser/parse_expr.h" // for exprType
 
+/* GUC variable */
+bool		gp_enable_window_agg_combine = true;
+
 /*
  * All the window function APIs are called with this object, which is passed
  * to window functions as fcinfo->context.
@@ -181,6 +187,20 @@ typedef struct WindowStatePerAggData
 
 	/* Data local to eval_windowaggregates() */
 	bool		restart;		/* need to restart this agg in this cycle? */
+
+	/*
+	 * Support for sliding the frame head with the combine function, for
+	 * aggregates that have no inverse transition function. transValue then
+	 * only holds the rows from frontend up to aggregatedupto, and the rows
+	 * before that are held in frontValues, see eval_windowaggregates().
+	 */
+	bool		use_combine;
+	FmgrInfo	combinefn;
+	MemoryContext frontcontext; /* holds frontValues and their states */
+	int64		frontbase;		/* first row held in frontValues */
+	int64		frontend;		/* first row held in transValue */
+	Datum	   *frontValues;	/* [i]: rows frontbase + i .. frontend - 1 */
+	bool	   *frontIsNull;
 } WindowStatePerAggData;
 
 static void initialize_windowaggregate(WindowAggState *winstate,
@@ -201,6 +221,21 @@ static void finalize_windowaggregate(WindowAggState *winstate,
 									 WindowStatePerAgg peraggstate,
 									 Datum *result, bool *isnull);
 
+static void combine_windowaggregate(WindowAggState *winstate,
+									WindowStatePerFunc perfuncstate,
+									WindowStatePerAgg peraggstate,
+									MemoryContext context,
+									Datum value1, bool isnull1,
+									Datum value2, bool isnull2,
+									Datum *result, bool *isnull);
+static void build_windowaggregate_front(WindowAggState *winstate,
+										WindowStatePerFunc perfuncstate,
+										WindowStatePerAgg peraggstate);
+static void finalize_windowaggregate_front(WindowAggState *winstate,
+										   WindowStatePerFunc perfuncstate,
+										   WindowStatePerAgg peraggstate,
+										   Datum *result, bool *isnull);
+
 static void eval_windowaggregates(WindowAggState *winstate);
 static void eval_windowfunction(WindowAggState *winstate,
 								WindowStatePerFunc perfuncstate,
@@ -263,6 +298,15 @@ initialize_windowaggregate(WindowAggState *winstate,
 	peraggstate->resultValue = (Datum) 0;
 	peraggstate->resultValueIsNull = true;
 
+	if (peraggstate->use_combine)
+	{
+		MemoryContextReset(peraggstate->frontcontext);
+		peraggstate->frontbase = winstate->frameheadpos;
+		peraggstate->frontend = winstate->frameheadpos;
+		peraggstate->frontValues = NULL;
+		peraggstate->frontIsNull = NULL;
+	}
+
 	if (peraggstate->isDistinct)
 	{
 		peraggstate->distinctSortState =
@@ -841,6 +885,211 @@ finalize_windowaggregate(WindowAggState *winstate,
 	MemoryContextSwitchTo(oldContext);
 }
 
+/*
+ * combine_windowaggregate
+ * combine two transition values of an aggregate with its combine function
+ *
+ * value1 must be a private copy in 'context', since the combine function may
+ * modify it in place. The result is allocated in 'context', but it may also
+ * point to value1 or value2.
+ */
+static void
+combine_windowaggregate(WindowAggState *winstate,
+						WindowStatePerFunc perfuncstate,
+						WindowStatePerAgg peraggstate,
+						MemoryContext context,
+						Datum value1, bool isnull1,
+						Datum value2, bool isnull2,
+						Datum *result, bool *isnull)
+{
+	LOCAL_FCINFO(fcinfo, 2);
+	MemoryContext oldContext;
+
+	/* same rules for strict combine functions as in nodeAgg.c */
+	if (peraggstate->combinefn.fn_strict)
+	{
+		if (isnull2)
+		{
+			*result = value1;
+			*isnull = isnull1;
+			return;
+		}
+		if (isnull1)
+		{
+			oldContext = MemoryContextSwitchTo(context);
+			*result = datumCopy(value2,
+								peraggstate->transtypeByVal,
+								peraggstate->transtypeLen);
+			*isnull = false;
+			MemoryContextSwitchTo(oldContext);
+			return;
+		}
+	}
+
+	oldContext = MemoryContextSwitchTo(context);
+
+	InitFunctionCallInfoData(*fcinfo, &(peraggstate->combinefn), 2,
+							 perfuncstate->winCollation,
+							 (void *) winstate, NULL);
+	fcinfo->args[0].value = value1;
+	fcinfo->args[0].isnull = isnull1;
+	fcinfo->args[1].value = value2;
+	fcinfo->args[1].isnull = isnull2;
+	winstate->curaggcontext = context;
+	*result = FunctionCallInvoke(fcinfo);
+	winstate->curaggcontext = NULL;
+	*isnull = fcinfo->isnull;
+
+	MemoryContextSwitchTo(oldContext);
+}
+
+/*
+ * build_windowaggregate_front
+ * move the rows of an aggregate using the combine function to the front
+ *
+ * Called when the frame head has moved past frontend, so that transValue
+ * holds rows that are no longer in the frame. The rows from the frame head up
+ * to aggregatedupto are aggregated again, last to first, so that frontValues
+ * holds the aggregate of every suffix of them, and transValue starts over.
+ * Every row is moved to the front at most once, so the cost per row stays
+ * constant, however large the frame.
+ */
+static void
+build_windowaggregate_front(WindowAggState *winstate,
+							WindowStatePerFunc perfuncstate,
+							WindowStatePerAgg peraggstate)
+{
+	WindowObject agg_winobj = winstate->agg_winobj;
+	TupleTableSlot *temp_slot = winstate->temp_slot_1;
+	MemoryContext aggcontext = peraggstate->aggcontext;
+	MemoryContext oldContext;
+	int64		frontbase = winstate->frameheadpos;
+	int64		frontend = winstate->aggregatedupto;
+	int64		pos;
+
+	Assert(frontbase < frontend);
+	Assert(aggcontext != winstate->aggcontext);
+
+	MemoryContextReset(peraggstate->frontcontext);
+	peraggstate->frontValues = (Datum *)
+		MemoryContextAllocHuge(peraggstate->frontcontext,
+							   (frontend - frontbase) * sizeof(Datum));
+	peraggstate->frontIsNull = (bool *)
+		MemoryContextAllocHuge(peraggstate->frontcontext,
+							   (frontend - frontbase) * sizeof(bool));
+
+	/*
+	 * Aggregate each row on its own, by pointing the aggregate's transition
+	 * value and context at the front for the duration.
+	 */
+	peraggstate->aggcontext = peraggstate->frontcontext;
+
+	for (pos = frontend - 1; pos >= frontbase; pos--)
+	{
+		int64		i = pos - frontbase;
+
+		if (!window_gettupleslot(agg_winobj, pos, temp_slot))
+			elog(ERROR, "could not re-fetch previously fetched frame row");
+		winstate->tmpcontext->ecxt_outertuple = temp_slot;
+
+		if (peraggstate->initValueIsNull)
+			peraggstate->transValue = peraggstate->initValue;
+		else
+		{
+			oldContext = MemoryContextSwitchTo(peraggstate->frontcontext);
+			peraggstate->transValue = datumCopy(peraggstate->initValue,
+												peraggstate->transtypeByVal,
+												peraggstate->transtypeLen);
+			MemoryContextSwitchTo(oldContext);
+		}
+		peraggstate->transValueIsNull = peraggstate->initValueIsNull;
+		peraggstate->transValueCount = 0;
+
+		advance_windowaggregate(winstate, perfuncstate, peraggstate);
+
+		if (pos == frontend - 1)
+		{
+			peraggstate->frontValues[i] = peraggstate->transValue;
+			peraggstate->frontIsNull[i] = peraggstate->transValueIsNull;
+		}
+		else
+			combine_windowaggregate(winstate, perfuncstate, peraggstate,
+									peraggstate->frontcontext,
+									peraggstate->transValue,
+									peraggstate->transValueIsNull,
+									peraggstate->frontValues[i + 1],
+									peraggstate->frontIsNull[i + 1],
+									&peraggstate->frontValues[i],
+									&peraggstate->frontIsNull[i]);
+
+		ResetExprContext(winstate->tmpcontext);
+		ExecClearTuple(temp_slot);
+	}
+
+	/* the rows are all in the front now, start transValue over */
+	peraggstate->aggcontext = aggcontext;
+	MemoryContextResetAndDeleteChildren(aggcontext);
+	if (peraggstate->initValueIsNull)
+		peraggstate->transValue = peraggstate->initValue;
+	else
+	{
+		oldContext = MemoryContextSwitchTo(aggcontext);
+		peraggstate->transValue = datumCopy(peraggstate->initValue,
+											peraggstate->transtypeByVal,
+											peraggstate->transtypeLen);
+		MemoryContextSwitchTo(oldContext);
+	}
+	peraggstate->transValueIsNull = peraggstate->initValueIsNull;
+	peraggstate->transValueCount = 0;
+
+	peraggstate->frontbase = frontbase;
+	peraggstate->frontend = frontend;
+}
+
+/*
+ * finalize_windowaggregate_front
+ * finalize an aggregate using the combine function, whose frame head is
+ * still in the front
+ */
+static void
+finalize_windowaggregate_front(WindowAggState *winstate,
+							   WindowStatePerFunc perfuncstate,
+							   WindowStatePerAgg peraggstate,
+							   Datum *result, bool *isnull)
+{
+	MemoryContext tmpcontext = winstate->tmpcontext->ecxt_per_tuple_memory;
+	MemoryContext oldContext;
+	int64		i = winstate->frameheadpos - peraggstate->frontbase;
+	Datum		frontValue = peraggstate->frontValues[i];
+	bool		frontIsNull = peraggstate->frontIsNull[i];
+	Datum		transValue = peraggstate->transValue;
+	bool		transValueIsNull = peraggstate->transValueIsNull;
+
+	Assert(i >= 0 && winstate->frameheadpos < peraggstate->frontend);
+
+	if (!frontIsNull)
+	{
+		oldContext = MemoryContextSwitchTo(tmpcontext);
+		frontValue = datumCopy(frontValue,
+							   peraggstate->transtypeByVal,
+							   peraggstate->transtypeLen);
+		MemoryContextSwitchTo(oldContext);
+	}
+	combine_windowaggregate(winstate, perfuncstate, peraggstate, tmpcontext,
+							frontValue, frontIsNull,
+							transValue, transValueIsNull,
+							&peraggstate->transValue,
+							&peraggstate->transValueIsNull);
+
+	/* finalize_windowaggregate() copies the result out of tmpcontext */
+	finalize_windowaggregate(winstate, perfuncstate, peraggstate,
+							 result, isnull);
+
+	peraggstate->transValue = transValue;
+	peraggstate->transValueIsNull = transValueIsNull;
+	ResetExprContext(winstate->tmpcontext);
+}
+
 /*
  * eval_windowaggregates
  * evaluate plain aggregates being used as window functions
@@ -859,6 +1108,7 @@ eval_windowaggregates(WindowAggState *winstate)
 	int			wfuncno,
 				numaggs,
 				numaggs_restart,
+				numaggs_combine,
 				i;
 	int64		aggregatedupto_nonrestarted;
 	MemoryContext oldContext;
@@ -905,6 +1155,18 @@ eval_windowaggregates(WindowAggState *winstate)
 	 * must perform the aggregation all over again for all tuples within the
 	 * new frame boundaries.
 	 *
+	 * GPDB: An aggregate that has no inverse transition function, but has a
+	 * combine function, such as MIN or MAX, doesn't need to restart either.
+	 * Its transition value only holds the rows from 'frontend' onwards, and
+	 * for the rows before that, we keep the aggregate of each suffix of them
+	 * in 'frontValues'. The aggregate over the frame is then the combination
+	 * of the suffix starting at the frame head with the transition value.
+	 * When the frame head moves past 'frontend', the rows from the frame
+	 * head on are aggregated again, from last to first, to build a new front.
+	 * Each row is aggregated at most twice that way, so the cost per row
+	 * doesn't grow with the size of the frame. See initialize_peragg() for
+	 * which aggregates are handled like this.
+	 *
 	 * If there's any exclusion clause, then we may have to aggregate over a
 	 * non-contiguous set of rows, so we punt and recalculate for every row.
 	 * (For some frame end choices, it might be that the frame is always
@@ -1027,12 +1289,14 @@ eval_windowaggregates(WindowAggState *winstate)
 	 *----------
 	 */
 	numaggs_restart = 0;
+	numaggs_combine = 0;
 	for (i = 0; i < numaggs; i++)
 	{
 		peraggstate = &winstate->peragg[i];
 		if (winstate->currentpos == 0 ||
 			(winstate->aggregatedbase != winstate->frameheadpos &&
-			 !OidIsValid(peraggstate->invtransfn_oid)) ||
+			 !OidIsValid(peraggstate->invtransfn_oid) &&
+			 !peraggstate->use_combine) ||
 			(winstate->frameOptions & FRAMEOPTION_EXCLUSION) ||
 			winstate->aggregatedupto <= winstate->frameheadpos ||
 			frame_head_moved_backwards ||
@@ -1042,7 +1306,11 @@ eval_windowaggregates(WindowAggState *winstate)
 			numaggs_restart++;
 		}
 		else
+		{
 			peraggstate->restart = false;
+			if (peraggstate->use_combine)
+				numaggs_combine++;
+		}
 	}
 
 	/*
@@ -1050,9 +1318,10 @@ eval_windowaggregates(WindowAggState *winstate)
 	 * aggregatedbase to match the frame's head by removing input rows that
 	 * fell off the top of the frame from the aggregations.  This can fail,
 	 * i.e. advance_windowaggregate_base() can return false, in which case
-	 * we'll restart that aggregate below.
+	 * we'll restart that aggregate below. Aggregates using the combine
+	 * function don't remove rows one by one, they are handled below.
 	 */
-	while (numaggs_restart < numaggs &&
+	while (numaggs_restart + numaggs_combine < numaggs &&
 		   winstate->aggregatedbase < winstate->frameheadpos)
 	{
 		/*
@@ -1075,7 +1344,7 @@ eval_windowaggregates(WindowAggState *winstate)
 			bool		ok;
 
 			peraggstate = &winstate->peragg[i];
-			if (peraggstate->restart)
+			if (peraggstate->restart || peraggstate->use_combine)
 				continue;
 
 			wfuncno = peraggstate->wfuncno;
@@ -1147,6 +1416,16 @@ eval_windowaggregates(WindowAggState *winstate)
 			peraggstate->resultValue = (Datum) 0;
 			peraggstate->resultValueIsNull = true;
 		}
+
+		/* Move rows to the front, if the frame head moved past it */
+		if (peraggstate->use_combine && !peraggstate->restart &&
+			winstate->frameheadpos > peraggstate->frontend)
+		{
+			wfuncno = peraggstate->wfuncno;
+			build_windowaggregate_front(winstate,
+										&winstate->perfunc[wfuncno],
+										peraggstate);
+		}
 	}
 
 	/*
@@ -1245,10 +1524,17 @@ next_tuple:
 		wfuncno = peraggstate->wfuncno;
 		result = &econtext->ecxt_aggvalues[wfuncno];
 		isnull = &econtext->ecxt_aggnulls[wfuncno];
-		finalize_windowaggregate(winstate,
-								 &winstate->perfunc[wfuncno],
-								 peraggstate,
-								 result, isnull);
+		if (peraggstate->use_combine &&
+			winstate->frameheadpos < peraggstate->frontend)
+			finalize_windowaggregate_front(winstate,
+										   &winstate->perfunc[wfuncno],
+										   peraggstate,
+										   result, isnull);
+		else
+			finalize_windowaggregate(winstate,
+									 &winstate->perfunc[wfuncno],
+									 peraggstate,
+									 result, isnull);
 
 		/*
 		 * save the result in case next row shares the same frame.
@@ -1595,6 +1881,8 @@ release_partition(WindowAggState *winstate)
 	{
 		if (winstate->peragg[i].aggcontext != winstate->aggcontext)
 			MemoryContextResetAndDeleteChildren(winstate->peragg[i].aggcontext);
+		if (winstate->peragg[i].use_combine)
+			MemoryContextReset(winstate->peragg[i].frontcontext);
 	}
 
 	if (winstate->buffer)
@@ -2919,6 +3207,8 @@ ExecEndWindowAgg(WindowAggState *node)
 	{
 		if (node->peragg[i].aggcontext != node->aggcontext)
 			MemoryContextDelete(node->peragg[i].aggcontext);
+		if (node->peragg[i].use_combine)
+			MemoryContextDelete(node->peragg[i].frontcontext);
 	}
 	MemoryContextDelete(node->partcontext);
 	MemoryContextDelete(node->aggcontext);
@@ -2995,12 +3285,15 @@ initialize_peragg(WindowAggState *winstate, WindowFunc *wfunc,
 	bool		use_ma_code;
 	Oid			transfn_oid,
 				invtransfn_oid,
-				finalfn_oid;
+				finalfn_oid,
+				combinefn_oid = InvalidOid;
 	bool		finalextra;
 	char		finalmodify;
 	Expr	   *transfnexpr,
 			   *invtransfnexpr,
-			   *finalfnexpr;
+			   *finalfnexpr,
+			   *combinefnexpr;
+	int			frameOptions = ((WindowAgg *) winstate->ss.ps.plan)->frameOptions;
 	Datum		textInitVal;
 	int			i;
 	ListCell   *lc;
@@ -3061,6 +3354,24 @@ initialize_peragg(WindowAggState *winstate, WindowFunc *wfunc,
 		finalmodify = aggform->aggfinalmodify;
 		aggtranstype = aggform->aggtranstype;
 		initvalAttNo = Anum_pg_aggregate_agginitval;
+
+		/*
+		 * Without an inverse transition function, slide the frame head with
+		 * the combine function instead of restarting, if we can. That needs
+		 * the same frame conditions as the moving-aggregate code, and for the
+		 * same reason, no volatile arguments. Also, the combine function must
+		 * not need an INTERNAL transition state, which can't be copied. And
+		 * leave out floating-point states: combining the rows in a different
+		 * order can change the result in the last digits, unlike restarting.
+		 * (winstate->frameOptions isn't set yet, look at the plan's.)
+		 */
+		if (gp_enable_window_agg_combine &&
+			OidIsValid(aggform->aggcombinefn) &&
+			!wfunc->windistinct &&
+			!(frameOptions & FRAMEOPTION_START_UNBOUNDED_PRECEDING) &&
+			!(frameOptions & FRAMEOPTION_EXCLUSION) &&
+			!contain_volatile_functions((Node *) wfunc))
+			combinefn_oid = aggform->aggcombinefn;
 	}
 
 	/*
@@ -3107,6 +3418,16 @@ initialize_peragg(WindowAggState *winstate, WindowFunc *wfunc,
 							   get_func_name(finalfn_oid));
 			InvokeFunctionExecuteHook(finalfn_oid);
 		}
+
+		if (OidIsValid(combinefn_oid))
+		{
+			aclresult = pg_proc_aclcheck(combinefn_oid, aggOwner,
+										 ACL_EXECUTE);
+			if (aclresult != ACLCHECK_OK)
+				aclcheck_error(aclresult, OBJECT_FUNCTION,
+							   get_func_name(combinefn_oid));
+			InvokeFunctionExecuteHook(combinefn_oid);
+		}
 	}
 
 	/*
@@ -3167,6 +3488,20 @@ initialize_peragg(WindowAggState *winstate, WindowFunc *wfunc,
 		fmgr_info_set_expr((Node *) finalfnexpr, &peraggstate->finalfn);
 	}
 
+	if (OidIsValid(combinefn_oid) &&
+		aggtranstype != INTERNALOID &&
+		aggtranstype != FLOAT4OID && aggtranstype != FLOAT8OID &&
+		aggtranstype != FLOAT4ARRAYOID && aggtranstype != FLOAT8ARRAYOID)
+	{
+		build_aggregate_combinefn_expr(aggtranstype,
+									   wfunc->inputcollid,
+									   combinefn_oid,
+									   &combinefnexpr);
+		fmgr_info(combinefn_oid, &peraggstate->combinefn);
+		fmgr_info_set_expr((Node *) combinefnexpr, &peraggstate->combinefn);
+		peraggstate->use_combine = true;
+	}
+
 	/* get info about relevant datatypes */
 	get_typlenbyval(wfunc->wintype,
 					&peraggstate->resulttypeLen,
@@ -3266,7 +3601,7 @@ initialize_peragg(WindowAggState *winstate, WindowFunc *wfunc,
 	 * they have historically been for plain aggregates, but that seems grotty
 	 * and likely to lead to memory leaks.
 	 */
-	if (OidIsValid(invtransfn_oid))
+	if (OidIsValid(invtransfn_oid) || peraggstate->use_combine)
 		peraggstate->aggcontext =
 			AllocSetContextCreate(CurrentMemoryContext,
 								  "WindowAgg Per Aggregate",
@@ -3274,6 +3609,12 @@ initialize_peragg(WindowAggState *winstate, WindowFunc *wfunc,
 	else
 		peraggstate->aggcontext = winstate->aggcontext;
 
+	if (peraggstate->use_combine)
+		peraggstate->frontcontext =
+			AllocSetContextCreate(CurrentMemoryContext,
+								  "WindowAgg Aggregate Front",
+								  ALLOCSET_DEFAULT_SIZES);
+
 	ReleaseSysCache(aggTuple);
 
 	return peraggstate;
@@ -148,6 +148,42 @@ CGPOptimizer::SerializeDXLPlan(Query *query)
 	return nullptr;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CGPOptimizer::GPOPTSerializeColumnBuckets
+//
+//	@doc:
+//		Serialize the optimizer's buckets for columns of a relation. Columns
+//		the optimizer fails to build buckets for are left NULL, and the
+//		optimizer converts their MCVs and histogram when planning instead.
+//
+//---------------------------------------------------------------------------
+void
+CGPOptimizer::GPOPTSerializeColumnBuckets(Oid relid, int natts,
+										  const AttrNumber *attnums,
+										  bytea **buckets)
+{
+	GPOS_TRY
+	{
+		COptTasks::SerializeColumnBuckets(relid, natts, attnums, buckets);
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		if (GPOS_MATCH_EX(ex, gpdxl::ExmaGPDB, gpdxl::ExmiGPDBError))
+		{
+			PG_RE_THROW();
+		}
+
+		for (int i = 0; i < natts; i++)
+		{
+			buckets[i] = nullptr;
+		}
+		elog(DEBUG1, "GPORCA failed to build buckets for relation %u", relid);
+	}
+	GPOS_CATCH_END;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		InitGPOPT()
@@ -219,6 +255,23 @@ SerializeDXLPlan(Query *query)
 }
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		GPOPTSerializeColumnBuckets
+//
+//	@doc:
+//		Expose bucket serialization to ANALYZE
+//
+//---------------------------------------------------------------------------
+extern "C" {
+void
+GPOPTSerializeColumnBuckets(Oid relid, int natts, const AttrNumber *attnums,
+							bytea **buckets)
+{
+	CGPOptimizer::GPOPTSerializeColumnBuckets(relid, natts, attnums, buckets);
+}
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		InitGPOPT()
@@ -39,7 +39,9 @@ extern "C" {
 #include "catalog/pg_inherits.h"
 #include "foreign/fdwapi.h"
 #include "nodes/nodeFuncs.h"
+#include "optimizer/cardfeedback.h"
 #include "optimizer/clauses.h"
+#include "optimizer/dynsample.h"
 #include "optimizer/optimizer.h"
 #include "optimizer/plancat.h"
 #include "optimizer/subselect.h"
@@ -2395,6 +2397,12 @@ gpdb::MDCacheNeedsReset(void)
 			register_mdcache_invalidation_callbacks();
 			mdcache_invalidation_counter_registered = true;
 		}
+		// statistics sampled by optimizer_dynamic_sampling are not in the
+		// catalogs, so no invalidation event tells when they change
+		if (DynamicSamplesChanged())
+		{
+			mdcache_invalidation_counter++;
+		}
 		if (last_mdcache_invalidation_counter == mdcache_invalidation_counter)
 		{
 			return false;
@@ -2419,6 +2427,58 @@ gpdb::IsAbortRequested(void)
 	return (QueryCancelPending || ProcDiePending);
 }
 
+// join cardinality corrections observed for the relations of the query
+List *
+gpdb::GetCardinalityFeedback(Query *query, HintState *hintstate)
+{
+	GP_WRAP_START;
+	{
+		return ::GetCardinalityFeedback(query, hintstate);
+	}
+	GP_WRAP_END;
+	return NIL;
+}
+
+// record on the joins of the plan the cardinality feedback applied to them
+void
+gpdb::AnnotateCardinalityFeedback(PlannedStmt *stmt, Query *query,
+								  List *feedback)
+{
+	GP_WRAP_START;
+	{
+		::AnnotateCardinalityFeedback(stmt, query, feedback);
+		return;
+	}
+	GP_WRAP_END;
+}
+
+// number of rows of a relation estimated by optimizer_dynamic_sampling,
+// false if the relation was not sampled
+bool
+gpdb::GetDynamicSampleRelStats(Oid relid, double *totalrows)
+{
+	GP_WRAP_START;
+	{
+		return ::GetDynamicSampleRelStats(relid, totalrows);
+	}
+	GP_WRAP_END;
+	return false;
+}
+
+// statistics of an attribute computed by optimizer_dynamic_sampling,
+// false if the relation was not sampled
+bool
+gpdb::GetDynamicSampleAttStats(Oid relid, AttrNumber attnum,
+							   HeapTuple *stats_tup)
+{
+	GP_WRAP_START;
+	{
+		return ::GetDynamicSampleAttStats(relid, attnum, stats_tup);
+	}
+	GP_WRAP_END;
+	return false;
+}
+
 // Given the type OID, get the typelem (InvalidOid if not an array type).
 Oid
 gpdb::GetElementType(Oid array_type_oid)
@@ -5683,17 +5683,31 @@ CTranslatorDXLToPlStmt::TranslatePlanCosts(const CDXLNode *dxlnode, Plan *plan)
 		CDXLPhysicalProperties::PdxlpropConvert(dxlnode->GetProperties())
 			->GetDXLOperatorCost();
 
-	plan->startup_cost = CostFromStr(costs->GetStartUpCostStr());
-	plan->total_cost = CostFromStr(costs->GetTotalCostStr());
-	plan->plan_width = CTranslatorUtils::GetIntFromStr(costs->GetWidthStr());
+	double rows;
+
+	if (costs->HasEstimates())
+	{
+		// plan straight from the optimizer, no need to parse the estimates
+		plan->startup_cost = 0;
+		plan->total_cost = costs->GetTotalCost().Get();
+		plan->plan_width = (int) costs->GetWidth();
+		rows = costs->GetRowsOut().Get();
+	}
+	else
+	{
+		plan->startup_cost = CostFromStr(costs->GetStartUpCostStr());
+		plan->total_cost = CostFromStr(costs->GetTotalCostStr());
+		plan->plan_width =
+			CTranslatorUtils::GetIntFromStr(costs->GetWidthStr());
+		rows = CostFromStr(costs->GetRowsOutStr());
+	}
 
 	// In the Postgres planner, the estimates on each node are per QE
 	// process, whereas the row estimates in GPORCA are global, across all
 	// processes. Divide the row count estimate by the number of segments
 	// executing it.
 	plan->plan_rows =
-		ceil(CostFromStr(costs->GetRowsOutStr()) /
-			 m_dxl_to_plstmt_context->GetCurrentSlice()->numsegments);
+		ceil(rows / m_dxl_to_plstmt_context->GetCurrentSlice()->numsegments);
 }
 
 //---------------------------------------------------------------------------
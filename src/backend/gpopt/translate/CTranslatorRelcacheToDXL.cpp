@@ -50,6 +50,13 @@ extern "C" {
 #include "gpopt/translate/CTranslatorUtils.h"
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/dxl/gpdb_types.h"
+#include "naucrates/dxl/operators/CDXLDatumBool.h"
+#include "naucrates/dxl/operators/CDXLDatumInt2.h"
+#include "naucrates/dxl/operators/CDXLDatumInt4.h"
+#include "naucrates/dxl/operators/CDXLDatumInt8.h"
+#include "naucrates/dxl/operators/CDXLDatumOid.h"
+#include "naucrates/dxl/operators/CDXLDatumStatsDoubleMappable.h"
+#include "naucrates/dxl/operators/CDXLDatumStatsLintMappable.h"
 #include "naucrates/dxl/xml/dxltokens.h"
 #include "naucrates/exception.h"
 #include "naucrates/md/CDXLColStats.h"
@@ -80,6 +87,293 @@ static const ULONG cmp_type_mappings[][2] = {
 	{IMDType::EcmptL, CmptLT},	  {IMDType::EcmptG, CmptGT},
 	{IMDType::EcmptGEq, CmptGEq}, {IMDType::EcmptLEq, CmptLEq}};
 
+// layout version of the buckets ANALYZE stores in a pg_statistic slot of
+// kind STATISTIC_KIND_ORCA_BUCKETS
+static const ULONG stored_buckets_version = 1;
+
+namespace
+{
+// appends values to a buffer of stored buckets; without a buffer it only
+// counts the bytes, so that the buffer can be sized by a first pass
+class CStoredBucketsWriter
+{
+private:
+	BYTE *m_buffer;
+
+	ULONG m_length;
+
+public:
+	explicit CStoredBucketsWriter(BYTE *buffer) : m_buffer(buffer), m_length(0)
+	{
+	}
+
+	void
+	Append(const void *data, ULONG length)
+	{
+		if (nullptr != m_buffer && 0 < length)
+		{
+			memcpy(m_buffer + m_length, data, length);
+		}
+		m_length += length;
+	}
+
+	template <typename T>
+	void
+	Append(T value)
+	{
+		Append(&value, sizeof(T));
+	}
+
+	ULONG
+	Length() const
+	{
+		return m_length;
+	}
+};
+
+// reads values back from stored buckets, remembering if it ran out of data
+class CStoredBucketsReader
+{
+private:
+	const BYTE *m_pos;
+
+	const BYTE *m_end;
+
+	BOOL m_is_valid;
+
+public:
+	CStoredBucketsReader(const BYTE *data, ULONG length)
+		: m_pos(data), m_end(data + length), m_is_valid(true)
+	{
+	}
+
+	const BYTE *
+	Read(ULONG length)
+	{
+		if (!m_is_valid || length > (ULONG)(m_end - m_pos))
+		{
+			m_is_valid = false;
+			return nullptr;
+		}
+		const BYTE *data = m_pos;
+		m_pos += length;
+		return data;
+	}
+
+	template <typename T>
+	T
+	Read()
+	{
+		T value = T();
+		const BYTE *data = Read(sizeof(T));
+		if (nullptr != data)
+		{
+			memcpy(&value, data, sizeof(T));
+		}
+		return value;
+	}
+
+	BOOL
+	IsValid() const
+	{
+		return m_is_valid;
+	}
+
+	BOOL
+	AtEnd() const
+	{
+		return m_pos == m_end;
+	}
+};
+}  // namespace
+
+// append a bucket boundary to stored buckets
+static void
+AppendStoredDatum(CStoredBucketsWriter *writer, const CDXLDatum *dxl_datum)
+{
+	CDXLDatum *datum = const_cast<CDXLDatum *>(dxl_datum);
+	CDXLDatum::EdxldatumType datum_type = datum->GetDatumType();
+
+	writer->Append<INT>(datum_type);
+	writer->Append<BYTE>(datum->IsNull());
+	writer->Append<INT>(datum->TypeModifier());
+
+	switch (datum_type)
+	{
+		case CDXLDatum::EdxldatumInt2:
+			writer->Append<SINT>(CDXLDatumInt2::Cast(datum)->Value());
+			break;
+		case CDXLDatum::EdxldatumInt4:
+			writer->Append<INT>(CDXLDatumInt4::Cast(datum)->Value());
+			break;
+		case CDXLDatum::EdxldatumInt8:
+			writer->Append<LINT>(CDXLDatumInt8::Cast(datum)->Value());
+			break;
+		case CDXLDatum::EdxldatumBool:
+			writer->Append<BYTE>(CDXLDatumBool::Cast(datum)->GetValue());
+			break;
+		case CDXLDatum::EdxldatumOid:
+			writer->Append<OID>(CDXLDatumOid::Cast(datum)->OidValue());
+			break;
+		default:
+		{
+			CDXLDatumGeneric *datum_generic = CDXLDatumGeneric::Cast(datum);
+			ULONG length = datum_generic->Length();
+
+			writer->Append<ULONG>(length);
+			writer->Append(datum_generic->GetByteArray(), length);
+			if (datum_generic->IsDatumMappableToDouble())
+			{
+				writer->Append<double>(
+					datum_generic->GetDoubleMapping().Get());
+			}
+			if (datum_generic->IsDatumMappableToLINT())
+			{
+				writer->Append<LINT>(datum_generic->GetLINTMapping());
+			}
+			break;
+		}
+	}
+}
+
+// read a bucket boundary back from stored buckets, NULL if it is malformed
+static CDXLDatum *
+ReadStoredDatum(CMemoryPool *mp, CStoredBucketsReader *reader,
+				IMDId *mdid_type)
+{
+	INT datum_type = reader->Read<INT>();
+	BOOL is_null = (0 != reader->Read<BYTE>());
+	INT type_modifier = reader->Read<INT>();
+
+	switch (datum_type)
+	{
+		case CDXLDatum::EdxldatumInt2:
+		{
+			SINT value = reader->Read<SINT>();
+			if (!reader->IsValid())
+			{
+				return nullptr;
+			}
+			mdid_type->AddRef();
+			return GPOS_NEW(mp) CDXLDatumInt2(mp, mdid_type, is_null, value);
+		}
+		case CDXLDatum::EdxldatumInt4:
+		{
+			INT value = reader->Read<INT>();
+			if (!reader->IsValid())
+			{
+				return nullptr;
+			}
+			mdid_type->AddRef();
+			return GPOS_NEW(mp) CDXLDatumInt4(mp, mdid_type, is_null, value);
+		}
+		case CDXLDatum::EdxldatumInt8:
+		{
+			LINT value = reader->Read<LINT>();
+			if (!reader->IsValid())
+			{
+				return nullptr;
+			}
+			mdid_type->AddRef();
+			return GPOS_NEW(mp) CDXLDatumInt8(mp, mdid_type, is_null, value);
+		}
+		case CDXLDatum::EdxldatumBool:
+		{
+			BOOL value = (0 != reader->Read<BYTE>());
+			if (!reader->IsValid())
+			{
+				return nullptr;
+			}
+			mdid_type->AddRef();
+			return GPOS_NEW(mp) CDXLDatumBool(mp, mdid_type, is_null, value);
+		}
+		case CDXLDatum::EdxldatumOid:
+		{
+			OID value = reader->Read<OID>();
+			if (!reader->IsValid())
+			{
+				return nullptr;
+			}
+			mdid_type->AddRef();
+			return GPOS_NEW(mp) CDXLDatumOid(mp, mdid_type, is_null, value);
+		}
+		case CDXLDatum::EdxldatumGeneric:
+		case CDXLDatum::EdxldatumStatsDoubleMappable:
+		case CDXLDatum::EdxldatumStatsLintMappable:
+		{
+			ULONG length = reader->Read<ULONG>();
+			const BYTE *bytes = reader->Read(length);
+			double double_value = 0;
+			LINT lint_value = 0;
+			if (CDXLDatum::EdxldatumStatsDoubleMappable == datum_type)
+			{
+				double_value = reader->Read<double>();
+			}
+			else if (CDXLDatum::EdxldatumStatsLintMappable == datum_type)
+			{
+				lint_value = reader->Read<LINT>();
+			}
+			if (!reader->IsValid())
+			{
+				return nullptr;
+			}
+
+			BYTE *data = nullptr;
+			if (0 < length)
+			{
+				data = GPOS_NEW_ARRAY(mp, BYTE, length);
+				memcpy(data, bytes, length);
+			}
+			mdid_type->AddRef();
+			if (CDXLDatum::EdxldatumStatsDoubleMappable == datum_type)
+			{
+				return GPOS_NEW(mp) CDXLDatumStatsDoubleMappable(
+					mp, mdid_type, type_modifier, is_null, data, length,
+					CDouble(double_value));
+			}
+			if (CDXLDatum::EdxldatumStatsLintMappable == datum_type)
+			{
+				return GPOS_NEW(mp) CDXLDatumStatsLintMappable(
+					mp, mdid_type, type_modifier, is_null, data, length,
+					lint_value);
+			}
+			return GPOS_NEW(mp) CDXLDatumGeneric(mp, mdid_type, type_modifier,
+												 is_null, data, length);
+		}
+		default:
+			return nullptr;
+	}
+}
+
+// append column stats to stored buckets, along with what they were built
+// from, so that they can be checked against the catalog when read back
+static void
+AppendStoredColStats(CStoredBucketsWriter *writer,
+					 const CDXLColStats *dxl_col_stats, OID att_type,
+					 CDouble num_distinct)
+{
+	writer->Append<ULONG>(stored_buckets_version);
+	writer->Append<OID>(att_type);
+	writer->Append<double>(num_distinct.Get());
+	writer->Append<double>(dxl_col_stats->GetNullFreq().Get());
+	writer->Append<double>(dxl_col_stats->GetDistinctRemain().Get());
+	writer->Append<double>(dxl_col_stats->GetFreqRemain().Get());
+
+	const ULONG num_buckets = dxl_col_stats->Buckets();
+	writer->Append<ULONG>(num_buckets);
+	for (ULONG ul = 0; ul < num_buckets; ul++)
+	{
+		const CDXLBucket *dxl_bucket = dxl_col_stats->GetDXLBucketAt(ul);
+
+		writer->Append<double>(dxl_bucket->GetFrequency().Get());
+		writer->Append<double>(dxl_bucket->GetNumDistinct().Get());
+		writer->Append<BYTE>(dxl_bucket->IsLowerClosed());
+		writer->Append<BYTE>(dxl_bucket->IsUpperClosed());
+		AppendStoredDatum(writer, dxl_bucket->GetDXLDatumLower());
+		AppendStoredDatum(writer, dxl_bucket->GetDXLDatumUpper());
+	}
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CTranslatorRelcacheToDXL::RetrieveObject
@@ -1839,7 +2133,10 @@ CTranslatorRelcacheToDXL::RetrieveRelStats(CMemoryPool *mp, IMDId *mdid)
 	// CMDName ctor created a copy of the string
 	GPOS_DELETE(relname_str);
 
-	num_rows = gpdb::CdbEstimatePartitionedNumTuples(rel.get());
+	if (!gpdb::GetDynamicSampleRelStats(rel_oid, &num_rows))
+	{
+		num_rows = gpdb::CdbEstimatePartitionedNumTuples(rel.get());
+	}
 
 	m_rel_stats_mdid->AddRef();
 
@@ -1874,6 +2171,22 @@ IMDCacheObject *
 CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 										   CMDAccessor *md_accessor,
 										   IMDId *mdid)
+{
+	return TranslateColStats(mp, md_accessor, mdid,
+							 true /* use_stored_buckets */,
+							 nullptr /* num_distinct */);
+}
+
+// Translate the pg_statistic entry of a column into column statistics.
+// The buckets stored by ANALYZE are used if asked for and still valid;
+// otherwise they are built from the MCVs and histogram. The number of
+// distinct values the buckets are built for is returned in num_distinct.
+CDXLColStats *
+CTranslatorRelcacheToDXL::TranslateColStats(CMemoryPool *mp,
+											CMDAccessor *md_accessor,
+											IMDId *mdid,
+											BOOL use_stored_buckets,
+											CDouble *num_distinct_out)
 {
 	CMDIdColStats *mdid_col_stats = CMDIdColStats::CastMdid(mdid);
 	IMDId *mdid_rel = mdid_col_stats->GetRelMdId();
@@ -1884,21 +2197,26 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 	const IMDColumn *md_col = md_rel->GetMdCol(pos);
 	AttrNumber attno = (AttrNumber) md_col->AttrNum();
 
-	// number of rows from pg_class
-	double num_rows;
-
-	num_rows =
-		gpdb::CdbEstimatePartitionedNumTuples(gpdb::GetRelation(rel_oid).get());
-
 	// extract column name and type
 	CMDName *md_colname =
 		GPOS_NEW(mp) CMDName(mp, md_col->Mdname().GetMDName());
 	OID att_type = CMDIdGPDB::CastMdid(md_col->MdidType())->Oid();
 
+	// histograms of text columns are not used, see TransformStatsToDXLBucketArray
+	IMDId *mdid_atttype = md_col->MdidType();
+	BOOL is_text_type = mdid_atttype->Equals(&CMDIdGPDB::m_mdid_varchar) ||
+						mdid_atttype->Equals(&CMDIdGPDB::m_mdid_bpchar) ||
+						mdid_atttype->Equals(&CMDIdGPDB::m_mdid_text);
+
 	CDXLBucketArray *dxl_stats_bucket_array = GPOS_NEW(mp) CDXLBucketArray(mp);
 
-	// extract out histogram and mcv information from pg_statistic
-	HeapTuple stats_tup = gpdb::GetAttStats(rel_oid, attno);
+	// extract out histogram and mcv information from pg_statistic, or from
+	// a sample of the relation if its statistics are missing or stale
+	HeapTuple stats_tup = nullptr;
+	if (!gpdb::GetDynamicSampleAttStats(rel_oid, attno, &stats_tup))
+	{
+		stats_tup = gpdb::GetAttStats(rel_oid, attno);
+	}
 
 	// if there is no colstats
 	if (!HeapTupleIsValid(stats_tup))
@@ -1910,12 +2228,8 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 
 		if (!md_col->IsDropped())
 		{
-			CMDIdGPDB *mdid_atttype =
-				GPOS_NEW(mp) CMDIdGPDB(IMDId::EmdidGeneral, att_type);
-			IMDType *md_type = RetrieveType(mp, mdid_atttype);
+			const IMDType *md_type = md_accessor->RetrieveType(mdid_atttype);
 			width = CStatisticsUtils::DefaultColumnWidth(md_type);
-			md_type->Release();
-			mdid_atttype->Release();
 		}
 
 		return CDXLColStats::CreateDXLDummyColStats(mp, mdid_col_stats,
@@ -1939,6 +2253,15 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 	if (form_pg_stats->stadistinct < 0)
 	{
 		GPOS_ASSERT(form_pg_stats->stadistinct > -1.01);
+
+		// number of rows from pg_class, through the relation stats so that
+		// it is estimated once per relation rather than once per column
+		mdid_rel->AddRef();
+		CMDIdRelStats *mdid_rel_stats =
+			GPOS_NEW(mp) CMDIdRelStats(CMDIdGPDB::CastMdid(mdid_rel));
+		CDouble num_rows = md_accessor->Pmdrelstats(mdid_rel_stats)->Rows();
+		mdid_rel_stats->Release();
+
 		num_distinct =
 			num_rows * (1 - null_freq) * CDouble(-form_pg_stats->stadistinct);
 	}
@@ -1948,6 +2271,26 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 	}
 	num_distinct = num_distinct.Ceil();
 
+	if (nullptr != num_distinct_out)
+	{
+		*num_distinct_out = num_distinct;
+	}
+
+	// use the buckets ANALYZE built from this same entry, if any, rather
+	// than converting the MCVs and histogram again
+	if (use_stored_buckets)
+	{
+		CDXLColStats *stored_col_stats =
+			RetrieveStoredColStats(mp, stats_tup, mdid_col_stats, md_colname,
+								   mdid_atttype, width, num_distinct);
+		if (nullptr != stored_col_stats)
+		{
+			dxl_stats_bucket_array->Release();
+			gpdb::FreeHeapTuple(stats_tup);
+			return stored_col_stats;
+		}
+	}
+
 	BOOL is_dummy_stats = false;
 	// most common values and their frequencies extracted from the pg_statistic
 	// tuple for a given column
@@ -2002,10 +2345,11 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 	// histogram values extracted from the pg_statistic tuple for a given column
 	AttStatsSlot hist_slot;
 
-	// get histogram datums from pg_statistic entry
+	// get histogram datums from pg_statistic entry, unless they would be
+	// thrown away anyway
 	(void) gpdb::GetAttrStatsSlot(&hist_slot, stats_tup,
 								  STATISTIC_KIND_HISTOGRAM, InvalidOid,
-								  ATTSTATSSLOT_VALUES);
+								  is_text_type ? 0 : ATTSTATSSLOT_VALUES);
 
 	if (InvalidOid != hist_slot.valuetype && hist_slot.valuetype != att_type)
 	{
@@ -2042,7 +2386,8 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 	// to a single bucket structure
 	CDXLBucketArray *dxl_stats_bucket_array_transformed =
 		TransformStatsToDXLBucketArray(
-			mp, att_type, num_distinct, null_freq, mcv_slot.values,
+			mp, md_accessor->RetrieveType(mdid_atttype), num_distinct,
+			null_freq, mcv_slot.values,
 			mcv_slot.numbers, ULONG(mcv_slot.nvalues), hist_slot.values,
 			ULONG(hist_slot.nvalues));
 
@@ -2087,6 +2432,132 @@ CTranslatorRelcacheToDXL::RetrieveColStats(CMemoryPool *mp,
 	return dxl_col_stats;
 }
 
+// Retrieve column statistics from the buckets ANALYZE stored in the given
+// pg_statistic entry. Returns NULL if there are none, or if they were built
+// for a different column type or number of distinct values, e.g. because
+// reltuples changed since, in which case the caller converts the MCVs and
+// histogram as usual.
+CDXLColStats *
+CTranslatorRelcacheToDXL::RetrieveStoredColStats(
+	CMemoryPool *mp, HeapTuple stats_tup, CMDIdColStats *mdid_col_stats,
+	CMDName *md_colname, IMDId *mdid_atttype, CDouble width,
+	CDouble num_distinct)
+{
+	AttStatsSlot buckets_slot;
+
+	if (!gpdb::GetAttrStatsSlot(&buckets_slot, stats_tup,
+								STATISTIC_KIND_ORCA_BUCKETS, InvalidOid,
+								ATTSTATSSLOT_VALUES))
+	{
+		return nullptr;
+	}
+
+	if (BYTEAOID != buckets_slot.valuetype || 1 != buckets_slot.nvalues)
+	{
+		gpdb::FreeAttrStatsSlot(&buckets_slot);
+		return nullptr;
+	}
+
+	bytea *stored = (bytea *) DatumGetPointer(buckets_slot.values[0]);
+	CStoredBucketsReader reader((const BYTE *) VARDATA_ANY(stored),
+								VARSIZE_ANY_EXHDR(stored));
+
+	ULONG version = reader.Read<ULONG>();
+	OID att_type = reader.Read<OID>();
+	CDouble stored_num_distinct(reader.Read<double>());
+	CDouble null_freq(reader.Read<double>());
+	CDouble distinct_remaining(reader.Read<double>());
+	CDouble freq_remaining(reader.Read<double>());
+	ULONG num_buckets = reader.Read<ULONG>();
+
+	if (!reader.IsValid() || stored_buckets_version != version ||
+		CMDIdGPDB::CastMdid(mdid_atttype)->Oid() != att_type ||
+		stored_num_distinct != num_distinct)
+	{
+		gpdb::FreeAttrStatsSlot(&buckets_slot);
+		return nullptr;
+	}
+
+	CDXLBucketArray *dxl_stats_bucket_array = GPOS_NEW(mp) CDXLBucketArray(mp);
+	for (ULONG ul = 0; ul < num_buckets && reader.IsValid(); ul++)
+	{
+		CDouble frequency(reader.Read<double>());
+		CDouble distinct(reader.Read<double>());
+		BOOL is_lower_closed = (0 != reader.Read<BYTE>());
+		BOOL is_upper_closed = (0 != reader.Read<BYTE>());
+		CDXLDatum *dxl_datum_lower =
+			ReadStoredDatum(mp, &reader, mdid_atttype);
+		CDXLDatum *dxl_datum_upper =
+			ReadStoredDatum(mp, &reader, mdid_atttype);
+
+		if (nullptr == dxl_datum_lower || nullptr == dxl_datum_upper)
+		{
+			CRefCount::SafeRelease(dxl_datum_lower);
+			CRefCount::SafeRelease(dxl_datum_upper);
+			break;
+		}
+
+		dxl_stats_bucket_array->Append(GPOS_NEW(mp) CDXLBucket(
+			dxl_datum_lower, dxl_datum_upper, is_lower_closed,
+			is_upper_closed, frequency, distinct));
+	}
+
+	gpdb::FreeAttrStatsSlot(&buckets_slot);
+
+	if (num_buckets != dxl_stats_bucket_array->Size() || !reader.AtEnd())
+	{
+		dxl_stats_bucket_array->Release();
+		return nullptr;
+	}
+
+	mdid_col_stats->AddRef();
+	return GPOS_NEW(mp) CDXLColStats(
+		mp, mdid_col_stats, md_colname, width, null_freq, distinct_remaining,
+		freq_remaining, dxl_stats_bucket_array, false /* is_col_stats_missing */
+	);
+}
+
+// Build the buckets of a column's statistics from its pg_statistic entry,
+// like RetrieveColStats does, and serialize them for ANALYZE to store in a
+// STATISTIC_KIND_ORCA_BUCKETS slot. Returns NULL if the column has no
+// usable statistics.
+BYTE *
+CTranslatorRelcacheToDXL::SerializeColStatsBuckets(CMemoryPool *mp,
+												   CMDAccessor *md_accessor,
+												   IMDId *mdid, ULONG *length)
+{
+	CMDIdColStats *mdid_col_stats = CMDIdColStats::CastMdid(mdid);
+	const IMDRelation *md_rel =
+		md_accessor->RetrieveRel(mdid_col_stats->GetRelMdId());
+	const IMDColumn *md_col = md_rel->GetMdCol(mdid_col_stats->Position());
+	OID att_type = CMDIdGPDB::CastMdid(md_col->MdidType())->Oid();
+
+	CDouble num_distinct(0.0);
+	CDXLColStats *dxl_col_stats =
+		TranslateColStats(mp, md_accessor, mdid,
+						  false /* use_stored_buckets */, &num_distinct);
+
+	*length = 0;
+	if (dxl_col_stats->IsColStatsMissing())
+	{
+		dxl_col_stats->Release();
+		return nullptr;
+	}
+
+	CStoredBucketsWriter size_counter(nullptr);
+	AppendStoredColStats(&size_counter, dxl_col_stats, att_type,
+						 num_distinct);
+
+	BYTE *buffer = GPOS_NEW_ARRAY(mp, BYTE, size_counter.Length());
+	CStoredBucketsWriter writer(buffer);
+	AppendStoredColStats(&writer, dxl_col_stats, att_type, num_distinct);
+	GPOS_ASSERT(writer.Length() == size_counter.Length());
+
+	dxl_col_stats->Release();
+	*length = writer.Length();
+	return buffer;
+}
+
 
 //---------------------------------------------------------------------------
 //	@function:
@@ -2244,13 +2715,11 @@ CTranslatorRelcacheToDXL::RetrieveScCmp(CMemoryPool *mp, IMDId *mdid)
 //---------------------------------------------------------------------------
 CDXLBucketArray *
 CTranslatorRelcacheToDXL::TransformStatsToDXLBucketArray(
-	CMemoryPool *mp, OID att_type, CDouble num_distinct, CDouble null_freq,
-	const Datum *mcv_values, const float4 *mcv_frequencies,
+	CMemoryPool *mp, const IMDType *md_type, CDouble num_distinct,
+	CDouble null_freq, const Datum *mcv_values, const float4 *mcv_frequencies,
 	ULONG num_mcv_values, const Datum *hist_values, ULONG num_hist_values)
 {
-	CMDIdGPDB *mdid_atttype =
-		GPOS_NEW(mp) CMDIdGPDB(IMDId::EmdidGeneral, att_type);
-	IMDType *md_type = RetrieveType(mp, mdid_atttype);
+	IMDId *mdid_atttype = md_type->MDId();
 
 	// translate MCVs to Orca histogram. Create an empty histogram if there are no MCVs.
 	CHistogram *gpdb_mcv_hist = TransformMcvToOrcaHistogram(
@@ -2318,8 +2787,6 @@ CTranslatorRelcacheToDXL::TransformStatsToDXLBucketArray(
 	}
 
 	// cleanup
-	mdid_atttype->Release();
-	md_type->Release();
 	GPOS_DELETE(gpdb_mcv_hist);
 
 	if (nullptr != histogram)
@@ -2392,14 +2859,18 @@ CTranslatorRelcacheToDXL::TransformHistToOrcaHistogram(
 	CDouble freq_per_bucket = hist_freq / CDouble(num_buckets);
 
 	BOOL last_bucket_was_singleton = false;
-	// create buckets
+	// create buckets; adjacent buckets share their common bound, so every
+	// histogram value is translated only once
 	CBucketArray *buckets = GPOS_NEW(mp) CBucketArray(mp);
+	IDatum *next_min_datum = CTranslatorScalarToDXL::CreateIDatumFromGpdbDatum(
+		mp, md_type, false /* is_null */, hist_values[0]);
 	for (ULONG ul = 0; ul < num_buckets; ul++)
 	{
-		IDatum *min_datum = CTranslatorScalarToDXL::CreateIDatumFromGpdbDatum(
-			mp, md_type, false /* is_null */, hist_values[ul]);
+		IDatum *min_datum = next_min_datum;
 		IDatum *max_datum = CTranslatorScalarToDXL::CreateIDatumFromGpdbDatum(
 			mp, md_type, false /* is_null */, hist_values[ul + 1]);
+		max_datum->AddRef();
+		next_min_datum = max_datum;
 		BOOL is_lower_closed, is_upper_closed;
 
 		if (min_datum->StatsAreEqual(max_datum))
@@ -2446,10 +2917,12 @@ CTranslatorRelcacheToDXL::TransformHistToOrcaHistogram(
 			// TODO: 03/01/2014 translate histogram into Orca even if sort
 			// order is different in GPDB, and use const expression eval to compare
 			// datums in Orca (MPP-22780)
+			next_min_datum->Release();
 			buckets->Release();
 			return GPOS_NEW(mp) CHistogram(mp);
 		}
 	}
+	next_min_datum->Release();
 
 	CHistogram *hist = GPOS_NEW(mp) CHistogram(mp, buckets);
 	return hist;
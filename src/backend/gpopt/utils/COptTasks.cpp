@@ -17,6 +17,7 @@
 
 extern "C" {
 #include "cdb/cdbvars.h"
+#include "optimizer/cardfeedback.h"
 #include "optimizer/hints.h"
 #include "optimizer/orca.h"
 #include "utils/fmgroids.h"
@@ -66,6 +67,7 @@ extern "C" {
 #include "naucrates/exception.h"
 #include "naucrates/init.h"
 #include "naucrates/md/CMDIdCast.h"
+#include "naucrates/md/CMDIdColStats.h"
 #include "naucrates/md/CMDIdRelStats.h"
 #include "naucrates/md/CMDIdScCmp.h"
 #include "naucrates/md/CSystemId.h"
@@ -473,7 +475,7 @@ COptTasks::GetCostModel(CMemoryPool *mp, ULONG num_segments)
 //
 //---------------------------------------------------------------------------
 CPlanHint *
-COptTasks::GetPlanHints(CMemoryPool *mp, Query *query)
+COptTasks::GetPlanHints(CMemoryPool *mp, Query *query, List **feedback_list)
 {
 	HintState *hintstate = nullptr;
 	if (plan_hint_hook != nullptr)
@@ -483,9 +485,11 @@ COptTasks::GetPlanHints(CMemoryPool *mp, Query *query)
 		hintstate = (HintState *) plan_hint_hook(query);
 	}
 
+	*feedback_list = gpdb::GetCardinalityFeedback(query, hintstate);
+
 	if (nullptr == hintstate)
 	{
-		return nullptr;
+		return AddCardinalityFeedback(mp, *feedback_list, nullptr);
 	}
 
 	// Following code translates pg_hint_plan hint structures into ORCA hint
@@ -599,30 +603,70 @@ COptTasks::GetPlanHints(CMemoryPool *mp, Query *query)
 			(CRowHint::RowsValueType) row_hint->value_type));
 	}
 
-	return plan_hints;
+	return AddCardinalityFeedback(mp, *feedback_list, plan_hints);
 }
 
 //---------------------------------------------------------------------------
-//	@function:
-//		COptTasks::OptimizeTask
+//      @function:
+//			COptTasks::AddCardinalityFeedback
 //
-//	@doc:
-//		task that does the optimizes query to physical DXL
+//      @doc:
+//			Add a row hint scaling the estimate of every join that has
+//			cardinality feedback. The feedback list leaves out the joins
+//			that have an explicit row hint, and marks them with a ratio
+//			of 0 instead.
 //
 //---------------------------------------------------------------------------
-void *
-COptTasks::OptimizeTask(void *ptr)
+CPlanHint *
+COptTasks::AddCardinalityFeedback(CMemoryPool *mp, List *feedback_list,
+								  CPlanHint *plan_hints)
 {
-	GPOS_ASSERT(nullptr != ptr);
-	SOptContext *opt_ctxt = SOptContext::Cast(ptr);
+	if (NIL == feedback_list)
+	{
+		return plan_hints;
+	}
 
-	GPOS_ASSERT(nullptr != opt_ctxt->m_query);
-	GPOS_ASSERT(nullptr == opt_ctxt->m_plan_dxl);
-	GPOS_ASSERT(nullptr == opt_ctxt->m_plan_stmt);
+	if (nullptr == plan_hints)
+	{
+		plan_hints = GPOS_NEW(mp) CPlanHint(mp);
+	}
 
-	AUTO_MEM_POOL(amp);
-	CMemoryPool *mp = amp.Pmp();
+	ListCell *lc;
+	foreach (lc, feedback_list)
+	{
+		CardinalityFeedback *feedback = (CardinalityFeedback *) lfirst(lc);
+		if (0 >= feedback->ratio)
+		{
+			continue;
+		}
+
+		StringPtrArray *aliases = GPOS_NEW(mp) StringPtrArray(mp);
+		for (int rel_index = 0; rel_index < feedback->nrels; rel_index++)
+		{
+			aliases->Append(GPOS_NEW(mp) CWStringConst(
+				mp, NameStr(feedback->aliases[rel_index])));
+		}
+
+		plan_hints->AddHint(GPOS_NEW(mp) CRowHint(mp, aliases,
+												  CDouble(feedback->ratio),
+												  CRowHint::RVT_MULTI));
+	}
 
+	return plan_hints;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::InitMDCache
+//
+//	@doc:
+//		Initialize the metadata cache, or purge it if the catalog changed
+//		since it was filled, or resize it if requested
+//
+//---------------------------------------------------------------------------
+void
+COptTasks::InitMDCache()
+{
 	// Does the metadatacache need to be reset?
 	//
 	// On the first call, before the cache has been initialized, we
@@ -647,7 +691,30 @@ COptTasks::OptimizeTask(void *ptr)
 	{
 		CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
 	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::OptimizeTask
+//
+//	@doc:
+//		task that does the optimizes query to physical DXL
+//
+//---------------------------------------------------------------------------
+void *
+COptTasks::OptimizeTask(void *ptr)
+{
+	GPOS_ASSERT(nullptr != ptr);
+	SOptContext *opt_ctxt = SOptContext::Cast(ptr);
+
+	GPOS_ASSERT(nullptr != opt_ctxt->m_query);
+	GPOS_ASSERT(nullptr == opt_ctxt->m_plan_dxl);
+	GPOS_ASSERT(nullptr == opt_ctxt->m_plan_stmt);
+
+	AUTO_MEM_POOL(amp);
+	CMemoryPool *mp = amp.Pmp();
 
+	InitMDCache();
 
 	// load search strategy
 	CSearchStageArray *search_strategy_arr =
@@ -690,7 +757,9 @@ COptTasks::OptimizeTask(void *ptr)
 				mp, &mda, (Query *) opt_ctxt->m_query);
 
 			ICostModel *cost_model = GetCostModel(mp, num_segments_for_costing);
-			CPlanHint *plan_hints = GetPlanHints(mp, opt_ctxt->m_query);
+			List *feedback_list = NIL;
+			CPlanHint *plan_hints =
+				GetPlanHints(mp, opt_ctxt->m_query, &feedback_list);
 			COptimizerConfig *optimizer_config =
 				CreateOptimizerConfig(mp, cost_model, plan_hints);
 			CConstExprEvaluatorProxy expr_eval_proxy(mp, &mda);
@@ -746,7 +815,17 @@ COptTasks::OptimizeTask(void *ptr)
 						mp, &mda, opt_ctxt->m_query, plan_dxl,
 						opt_ctxt->m_query->canSetTag,
 						query_to_dxl_translator->GetDistributionHashOpsKind()));
+
+				// remember what the plan's join estimates were corrected
+				// by, for EXPLAIN ANALYZE to learn from
+				if (optimizer_cardinality_feedback)
+				{
+					gpdb::AnnotateCardinalityFeedback(opt_ctxt->m_plan_stmt,
+													  opt_ctxt->m_query,
+													  feedback_list);
+				}
 			}
+			gpdb::ListFreeDeep(feedback_list);
 
 			CStatisticsConfig *stats_conf = optimizer_config->GetStatsConf();
 			col_stats = GPOS_NEW(mp) IMdIdArray(mp);
@@ -799,6 +878,93 @@ COptTasks::OptimizeTask(void *ptr)
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::SerializeColumnBucketsTask
+//
+//	@doc:
+//		task that serializes the optimizer's buckets for columns of a
+//		relation from their pg_statistic entries
+//
+//---------------------------------------------------------------------------
+void *
+COptTasks::SerializeColumnBucketsTask(void *ptr)
+{
+	GPOS_ASSERT(nullptr != ptr);
+	SColumnBucketsContext *buckets_ctxt = (SColumnBucketsContext *) ptr;
+
+	AUTO_MEM_POOL(amp);
+	CMemoryPool *mp = amp.Pmp();
+
+	InitMDCache();
+
+	GPOS_TRY
+	{
+		// set up relcache MD provider
+		CMDProviderRelcache *relcache_provider =
+			GPOS_NEW(mp) CMDProviderRelcache();
+
+		{
+			// scope for MD accessor
+			CMDAccessor mda(mp, CMDCache::Pcache(), default_sysid,
+							relcache_provider);
+
+			// build the buckets with the same configuration as planning
+			ICostModel *cost_model =
+				GetCostModel(mp, gpdb::GetGPSegmentCount());
+			CAutoOptCtxt aoc(mp, &mda, nullptr /* pceeval */,
+							 CreateOptimizerConfig(mp, cost_model,
+												   nullptr /* plan_hints */));
+
+			CMDIdGPDB *mdid_rel = GPOS_NEW(mp)
+				CMDIdGPDB(IMDId::EmdidRel, buckets_ctxt->m_relid);
+			const IMDRelation *md_rel = mda.RetrieveRel(mdid_rel);
+
+			for (int i = 0; i < buckets_ctxt->m_natts; i++)
+			{
+				mdid_rel->AddRef();
+				CMDIdColStats *mdid_col_stats = GPOS_NEW(mp) CMDIdColStats(
+					mdid_rel,
+					md_rel->GetPosFromAttno(buckets_ctxt->m_attnums[i]));
+
+				ULONG length = 0;
+				BYTE *serialized =
+					CTranslatorRelcacheToDXL::SerializeColStatsBuckets(
+						mp, &mda, mdid_col_stats, &length);
+				mdid_col_stats->Release();
+
+				if (nullptr == serialized)
+				{
+					continue;
+				}
+
+				bytea *buckets =
+					(bytea *) gpdb::GPDBAlloc(VARHDRSZ + length);
+				SET_VARSIZE(buckets, VARHDRSZ + length);
+				memcpy(VARDATA(buckets), serialized, length);
+				buckets_ctxt->m_buckets[i] = buckets;
+
+				GPOS_DELETE_ARRAY(serialized);
+			}
+
+			mdid_rel->Release();
+		}
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		CMDCache::Shutdown();
+		GPOS_RETHROW(ex);
+	}
+	GPOS_CATCH_END;
+
+	if (!optimizer_metadata_caching)
+	{
+		CMDCache::Shutdown();
+	}
+
+	return nullptr;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COptTasks::PrintMissingStatsWarning
@@ -917,6 +1083,28 @@ COptTasks::GPOPTOptimizedPlan(Query *query, SOptContext *gpopt_context)
 	return gpopt_context->m_plan_stmt;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::SerializeColumnBuckets
+//
+//	@doc:
+//		serialize the optimizer's buckets for columns of a relation, for
+//		ANALYZE to store in pg_statistic
+//
+//---------------------------------------------------------------------------
+void
+COptTasks::SerializeColumnBuckets(Oid relid, int natts,
+								  const AttrNumber *attnums, bytea **buckets)
+{
+	SColumnBucketsContext buckets_ctxt;
+	buckets_ctxt.m_relid = relid;
+	buckets_ctxt.m_natts = natts;
+	buckets_ctxt.m_attnums = attnums;
+	buckets_ctxt.m_buckets = buckets;
+
+	Execute(&SerializeColumnBucketsTask, &buckets_ctxt);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COptTasks::SetXform
@@ -1359,16 +1359,9 @@ CTranslatorExprToDXL::PdxlnDynamicTableScan(
 
 	if (nullptr != dxl_properties)
 	{
-		CWStringDynamic *rows_out_str = GPOS_NEW(m_mp) CWStringDynamic(
-			m_mp,
-			dxl_properties->GetDXLOperatorCost()->GetRowsOutStr()->GetBuffer());
-		CWStringDynamic *pstrCost = GPOS_NEW(m_mp)
-			CWStringDynamic(m_mp, dxl_properties->GetDXLOperatorCost()
-									  ->GetTotalCostStr()
-									  ->GetBuffer());
-
-		pdxlpropDTS->GetDXLOperatorCost()->SetRows(rows_out_str);
-		pdxlpropDTS->GetDXLOperatorCost()->SetCost(pstrCost);
+		CDXLOperatorCost *cost = dxl_properties->GetDXLOperatorCost();
+		pdxlpropDTS->GetDXLOperatorCost()->SetRows(cost->GetRowsOut());
+		pdxlpropDTS->GetDXLOperatorCost()->SetCost(cost->GetTotalCost());
 		dxl_properties->Release();
 	}
 
@@ -1771,16 +1764,9 @@ CTranslatorExprToDXL::PdxlnDynamicForeignScan(
 
 	if (nullptr != dxl_properties)
 	{
-		CWStringDynamic *rows_out_str = GPOS_NEW(m_mp) CWStringDynamic(
-			m_mp,
-			dxl_properties->GetDXLOperatorCost()->GetRowsOutStr()->GetBuffer());
-		CWStringDynamic *pstrCost = GPOS_NEW(m_mp)
-			CWStringDynamic(m_mp, dxl_properties->GetDXLOperatorCost()
-									  ->GetTotalCostStr()
-									  ->GetBuffer());
-
-		pdxlpropDFS->GetDXLOperatorCost()->SetRows(rows_out_str);
-		pdxlpropDFS->GetDXLOperatorCost()->SetCost(pstrCost);
+		CDXLOperatorCost *cost = dxl_properties->GetDXLOperatorCost();
+		pdxlpropDFS->GetDXLOperatorCost()->SetRows(cost->GetRowsOut());
+		pdxlpropDFS->GetDXLOperatorCost()->SetCost(cost->GetTotalCost());
 		dxl_properties->Release();
 	}
 
@@ -6909,7 +6895,6 @@ CDXLPhysicalProperties *
 CTranslatorExprToDXL::GetProperties(const CExpression *pexpr)
 {
 	// extract out rows from statistics object
-	CWStringDynamic *rows_out_str = GPOS_NEW(m_mp) CWStringDynamic(m_mp);
 	const IStatistics *stats = pexpr->Pstats();
 	CDouble rows = CStatistics::DefaultRelationRows;
 
@@ -6930,35 +6915,23 @@ CTranslatorExprToDXL::GetProperties(const CExpression *pexpr)
 		rows = rows * ulSegments;
 	}
 
-	rows_out_str->AppendFormat(GPOS_WSZ_LIT("%f"), rows.Get());
-
 	// extract our width from statistics object
 	CDouble width = CStatistics::DefaultColumnWidth;
 	CReqdPropPlan *prpp = pexpr->Prpp();
 	CColRefSet *pcrs = prpp->PcrsRequired();
 	ULongPtrArray *colids = GPOS_NEW(m_mp) ULongPtrArray(m_mp);
 	pcrs->ExtractColIds(m_mp, colids);
-	CWStringDynamic *width_str = GPOS_NEW(m_mp) CWStringDynamic(m_mp);
 
 	if (nullptr != stats)
 	{
 		width = stats->Width(colids);
 	}
 	colids->Release();
-	width_str->AppendFormat(GPOS_WSZ_LIT("%lld"), (LINT) width.Get());
-
-	// get the cost from expression node
-	CWStringDynamic str(m_mp);
-	COstreamString oss(&str);
-	oss << pexpr->Cost();
-
-	CWStringDynamic *pstrStartupcost =
-		GPOS_NEW(m_mp) CWStringDynamic(m_mp, GPOS_WSZ_LIT("0"));
-	CWStringDynamic *pstrTotalcost =
-		GPOS_NEW(m_mp) CWStringDynamic(m_mp, str.GetBuffer());
 
-	CDXLOperatorCost *cost = GPOS_NEW(m_mp) CDXLOperatorCost(
-		pstrStartupcost, pstrTotalcost, rows_out_str, width_str);
+	// keep the estimates as numbers, they are only turned into text if the
+	// plan gets serialized
+	CDXLOperatorCost *cost = GPOS_NEW(m_mp)
+		CDXLOperatorCost(m_mp, pexpr->Cost(), rows, (LINT) width.Get());
 	CDXLPhysicalProperties *dxl_properties =
 		GPOS_NEW(m_mp) CDXLPhysicalProperties(cost);
 
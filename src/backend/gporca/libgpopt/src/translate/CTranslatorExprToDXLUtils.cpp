@@ -71,6 +71,14 @@ CTranslatorExprToDXLUtils::PdxlpropCopy(CMemoryPool *mp, CDXLNode *dxlnode)
 	CDXLPhysicalProperties *dxl_properties =
 		CDXLPhysicalProperties::PdxlpropConvert(dxlnode->GetProperties());
 
+	CDXLOperatorCost *cost = dxl_properties->GetDXLOperatorCost();
+	if (cost->HasEstimates())
+	{
+		CDXLOperatorCost *cost_copy = GPOS_NEW(mp) CDXLOperatorCost(
+			mp, cost->GetTotalCost(), cost->GetRowsOut(), cost->GetWidth());
+		return GPOS_NEW(mp) CDXLPhysicalProperties(cost_copy);
+	}
+
 	CWStringDynamic *pstrStartupcost = GPOS_NEW(mp) CWStringDynamic(
 		mp,
 		dxl_properties->GetDXLOperatorCost()->GetStartUpCostStr()->GetBuffer());
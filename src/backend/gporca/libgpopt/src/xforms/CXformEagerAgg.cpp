@@ -7,11 +7,13 @@
 //		CXformEagerAgg.cpp
 //
 //	@doc:
-//		Implementation for eagerly pushing aggregates below join
-//			(with no foreign key restriction on the join condition)
+//		Implementation for eagerly pushing aggregates below an inner or left
+//			outer join (with no foreign key restriction on the join
+//			condition)
 //			The aggregate is pushed down only on the outer child
-//			(since the inner child alternative will be explored through
-//			 commutativity)
+//			(since the inner child alternative of an inner join will be
+//			 explored through commutativity, and the inner child of a left
+//			 outer join is null-extended)
 //---------------------------------------------------------------------------
 #include "gpopt/xforms/CXformEagerAgg.h"
 
@@ -20,8 +22,8 @@
 #include "gpopt/base/CColRefSetIter.h"
 #include "gpopt/base/COptCtxt.h"
 #include "gpopt/operators/CLogicalGbAgg.h"
-#include "gpopt/operators/CLogicalInnerJoin.h"
 #include "gpopt/operators/CPatternLeaf.h"
+#include "gpopt/operators/CPatternNode.h"
 #include "gpopt/operators/CScalarProjectElement.h"
 #include "gpopt/operators/CScalarProjectList.h"
 #include "gpopt/operators/CScalarValuesList.h"
@@ -40,7 +42,9 @@ CXformEagerAgg::CXformEagerAgg(CMemoryPool *mp)
 		  GPOS_NEW(mp) CExpression(
 			  mp, GPOS_NEW(mp) CLogicalGbAgg(mp),
 			  GPOS_NEW(mp) CExpression(
-				  mp, GPOS_NEW(mp) CLogicalInnerJoin(mp),
+				  mp,
+				  GPOS_NEW(mp) CPatternNode(
+					  mp, CPatternNode::EmtMatchInnerOrLeftOuterJoin),
 				  GPOS_NEW(mp) CExpression(
 					  mp, GPOS_NEW(mp) CPatternLeaf(mp)),  // join outer child
 				  GPOS_NEW(mp) CExpression(
@@ -157,16 +161,19 @@ CXformEagerAgg::Transform(CXformContext *pxfctxt, CXformResult *pxfres,
 }
 
 // check if an aggregate can be pushed below a join
-// Only following aggregates are supported:
-// 	min, max, sum, count, avg
+//	Any aggregate with a combine function and at least one argument is
+//	supported: all the outer child rows of a pushed-down group join the same
+//	inner child rows, so combining one partial result per join result row
+//	aggregates the same rows as the original aggregate.
 BOOL
 CXformEagerAgg::CanPushAggBelowJoin(CExpression *scalar_agg_func_expr)
 {
 	CScalarAggFunc *scalar_agg_func =
 		CScalarAggFunc::PopConvert(scalar_agg_func_expr->Pop());
-	if ((*scalar_agg_func_expr)[0]->Arity() != 1)
+
+	// not supporting aggregates without arguments, such as count(*)
+	if (0 == (*scalar_agg_func_expr)[EaggfuncIndexArgs]->Arity())
 	{
-		/* currently only supporting single-input aggregates */
 		return false;
 	}
 
@@ -176,39 +183,25 @@ CXformEagerAgg::CanPushAggBelowJoin(CExpression *scalar_agg_func_expr)
 		return false;
 	}
 
-	COptCtxt *poctxt = COptCtxt::PoctxtFromTLS();
-	CMDAccessor *md_accessor = poctxt->Pmda();
-	IMDId *agg_mdid =
-		scalar_agg_func->MDId();  // oid of the original aggregate function
-	CExpression *agg_child_expr = (*(*scalar_agg_func_expr)[0])[0];
-	IMDId *agg_child_mdid =
-		CScalar::PopConvert(agg_child_expr->Pop())->MdidType();
-	const IMDType *agg_child_type = md_accessor->RetrieveType(agg_child_mdid);
-	// if agg_mdid is not one of the supported aggregates (min, max, sum, count, avg)
-	// then don't push it down
-	if (!(agg_mdid->Equals(
-			  agg_child_type->GetMdidForAggType(IMDType::EaggMin)) ||
-		  agg_mdid->Equals(
-			  agg_child_type->GetMdidForAggType(IMDType::EaggMax)) ||
-		  agg_mdid->Equals(
-			  agg_child_type->GetMdidForAggType(IMDType::EaggSum)) ||
-		  agg_mdid->Equals(
-			  agg_child_type->GetMdidForAggType(IMDType::EaggCount)) ||
-		  agg_mdid->Equals(
-			  agg_child_type->GetMdidForAggType(IMDType::EaggAvg))))
+	// not supporting ordered-set aggregates, or aggregates with an ORDER BY,
+	// since their partial results cannot be combined in order
+	if (EaggfunckindNormal != scalar_agg_func->AggKind() ||
+		0 < (*scalar_agg_func_expr)[EaggfuncIndexOrder]->Arity())
 	{
 		return false;
 	}
-	return true;
+
+	CMDAccessor *md_accessor = COptCtxt::PoctxtFromTLS()->Pmda();
+
+	return md_accessor->RetrieveAgg(scalar_agg_func->MDId())->IsSplittable();
 }
 
 // Check if the transform can be applied
 //	 Eager agg is currently applied only if following is true:
-//		- Inner join of two relations
-//		- Single aggregate (MIN or MAX)
-//		- Aggregate is not a DQA
-//		- Single expression input in the agg
-//		- Input expression only part of outer child
+//		- Inner or left outer join of two relations
+//		- All aggregates have a combine function and at least one argument
+//		- No aggregate is a DQA or an ordered aggregate
+//		- Aggregate inputs only part of outer child
 BOOL
 CXformEagerAgg::CanApplyTransform(CExpression *gb_agg_expr)
 {
@@ -216,6 +209,13 @@ CXformEagerAgg::CanApplyTransform(CExpression *gb_agg_expr)
 	CExpression *agg_proj_list_expr = (*gb_agg_expr)[1];
 	CExpression *join_outer_child_expr = (*join_expr)[0];
 
+	if (CXformUtils::FHasAmbiguousType(agg_proj_list_expr,
+									   COptCtxt::PoctxtFromTLS()->Pmda()))
+	{
+		// the intermediate results must have a known type
+		return false;
+	}
+
 	// currently only supporting aggregate column references from outer child
 	CColRefSet *join_outer_child_cols =
 		join_outer_child_expr->DeriveOutputColumns();
@@ -12,6 +12,7 @@
 #define GPDXL_CDXLOperatorCost_H
 
 #include "gpos/base.h"
+#include "gpos/common/CDouble.h"
 #include "gpos/common/CRefCount.h"
 #include "gpos/string/CWStringDynamic.h"
 
@@ -33,17 +34,30 @@ class CXMLSerializer;
 class CDXLOperatorCost : public CRefCount
 {
 private:
+	// memory pool, used to build the textual form of optimizer estimates
+	CMemoryPool *m_mp;
+
 	// cost expended before fetching any tuples
-	CWStringDynamic *m_startup_cost_str;
+	mutable CWStringDynamic *m_startup_cost_str;
 
 	// total cost (assuming all tuples fetched)
-	CWStringDynamic *m_total_cost_str;
+	mutable CWStringDynamic *m_total_cost_str;
 
 	// number of rows plan is expected to emit
-	CWStringDynamic *m_rows_out_str;
+	mutable CWStringDynamic *m_rows_out_str;
 
 	// average row width in bytes
-	CWStringDynamic *m_width_str;
+	mutable CWStringDynamic *m_width_str;
+
+	// are the costs below set, i.e. was the object built from optimizer
+	// estimates rather than parsed from DXL
+	BOOL m_has_estimates;
+
+	// total cost, number of rows and average width, as estimated by the
+	// optimizer; the strings above are only derived from them on demand
+	CDouble m_total_cost;
+	CDouble m_rows_out;
+	LINT m_width;
 
 public:
 	CDXLOperatorCost(const CDXLOperatorCost &) = delete;
@@ -53,6 +67,11 @@ public:
 					 CWStringDynamic *total_cost_str,
 					 CWStringDynamic *rows_out_str, CWStringDynamic *width_str);
 
+	// ctor for optimizer estimates; the optimizer does not estimate startup
+	// costs, so these are always zero
+	CDXLOperatorCost(CMemoryPool *mp, CDouble total_cost, CDouble rows_out,
+					 LINT width);
+
 	~CDXLOperatorCost() override;
 
 	// serialize operator in DXL format
@@ -64,11 +83,25 @@ public:
 	const CWStringDynamic *GetRowsOutStr() const;
 	const CWStringDynamic *GetWidthStr() const;
 
+	// does the object carry optimizer estimates
+	BOOL
+	HasEstimates() const
+	{
+		return m_has_estimates;
+	}
+
+	// estimates, as they would read back from their textual form
+	CDouble GetTotalCost() const;
+	CDouble GetRowsOut() const;
+	LINT GetWidth() const;
+
 	// set the number of rows
 	void SetRows(CWStringDynamic *str);
+	void SetRows(CDouble rows_out);
 
 	// set the total cost
 	void SetCost(CWStringDynamic *str);
+	void SetCost(CDouble total_cost);
 };
 }  // namespace gpdxl
 
@@ -11,19 +11,54 @@
 
 #include "naucrates/dxl/operators/CDXLOperatorCost.h"
 
+#include "gpos/string/CStringStatic.h"
+
 #include "naucrates/dxl/xml/CXMLSerializer.h"
 
 using namespace gpos;
 using namespace gpdxl;
 
+// an estimate as it reads back from its textual form, so that a plan
+// translated straight from the optimizer and one read back from DXL carry
+// exactly the same estimates; a stack buffer avoids building and converting
+// the wide string
+static DOUBLE
+RoundTripThroughText(DOUBLE value)
+{
+	// large enough for any double printed with "%f"
+	CHAR buffer[512];
+	CStringStatic str(buffer, GPOS_ARRAY_SIZE(buffer));
+	str.AppendFormat("%f", value);
+	return clib::Strtod(str.Buffer());
+}
+
 CDXLOperatorCost::CDXLOperatorCost(CWStringDynamic *startup_cost_str,
 								   CWStringDynamic *total_cost_str,
 								   CWStringDynamic *rows_out_str,
 								   CWStringDynamic *width_str)
-	: m_startup_cost_str(startup_cost_str),
+	: m_mp(nullptr),
+	  m_startup_cost_str(startup_cost_str),
 	  m_total_cost_str(total_cost_str),
 	  m_rows_out_str(rows_out_str),
-	  m_width_str(width_str)
+	  m_width_str(width_str),
+	  m_has_estimates(false),
+	  m_total_cost(0.0),
+	  m_rows_out(0.0),
+	  m_width(0)
+{
+}
+
+CDXLOperatorCost::CDXLOperatorCost(CMemoryPool *mp, CDouble total_cost,
+								   CDouble rows_out, LINT width)
+	: m_mp(mp),
+	  m_startup_cost_str(nullptr),
+	  m_total_cost_str(nullptr),
+	  m_rows_out_str(nullptr),
+	  m_width_str(nullptr),
+	  m_has_estimates(true),
+	  m_total_cost(total_cost),
+	  m_rows_out(rows_out),
+	  m_width(width)
 {
 }
 
@@ -38,27 +73,72 @@ CDXLOperatorCost::~CDXLOperatorCost()
 const CWStringDynamic *
 CDXLOperatorCost::GetStartUpCostStr() const
 {
+	if (nullptr == m_startup_cost_str)
+	{
+		GPOS_ASSERT(m_has_estimates);
+		m_startup_cost_str =
+			GPOS_NEW(m_mp) CWStringDynamic(m_mp, GPOS_WSZ_LIT("0"));
+	}
 	return m_startup_cost_str;
 }
 
 const CWStringDynamic *
 CDXLOperatorCost::GetTotalCostStr() const
 {
+	if (nullptr == m_total_cost_str)
+	{
+		GPOS_ASSERT(m_has_estimates);
+		m_total_cost_str = GPOS_NEW(m_mp) CWStringDynamic(m_mp);
+		m_total_cost_str->AppendFormat(GPOS_WSZ_LIT("%f"), m_total_cost.Get());
+	}
 	return m_total_cost_str;
 }
 
 const CWStringDynamic *
 CDXLOperatorCost::GetRowsOutStr() const
 {
+	if (nullptr == m_rows_out_str)
+	{
+		GPOS_ASSERT(m_has_estimates);
+		m_rows_out_str = GPOS_NEW(m_mp) CWStringDynamic(m_mp);
+		m_rows_out_str->AppendFormat(GPOS_WSZ_LIT("%f"), m_rows_out.Get());
+	}
 	return m_rows_out_str;
 }
 
 const CWStringDynamic *
 CDXLOperatorCost::GetWidthStr() const
 {
+	if (nullptr == m_width_str)
+	{
+		GPOS_ASSERT(m_has_estimates);
+		m_width_str = GPOS_NEW(m_mp) CWStringDynamic(m_mp);
+		m_width_str->AppendFormat(GPOS_WSZ_LIT("%lld"), m_width);
+	}
 	return m_width_str;
 }
 
+CDouble
+CDXLOperatorCost::GetTotalCost() const
+{
+	GPOS_ASSERT(m_has_estimates);
+	return CDouble(RoundTripThroughText(m_total_cost.Get()));
+}
+
+CDouble
+CDXLOperatorCost::GetRowsOut() const
+{
+	GPOS_ASSERT(m_has_estimates);
+	return CDouble(RoundTripThroughText(m_rows_out.Get()));
+}
+
+LINT
+CDXLOperatorCost::GetWidth() const
+{
+	GPOS_ASSERT(m_has_estimates);
+	return m_width;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLOperatorCost::SetRows
@@ -71,10 +151,20 @@ void
 CDXLOperatorCost::SetRows(CWStringDynamic *rows_str)
 {
 	GPOS_ASSERT(nullptr != rows_str);
+	GPOS_ASSERT(!m_has_estimates);
 	GPOS_DELETE(m_rows_out_str);
 	m_rows_out_str = rows_str;
 }
 
+void
+CDXLOperatorCost::SetRows(CDouble rows_out)
+{
+	GPOS_ASSERT(m_has_estimates);
+	GPOS_DELETE(m_rows_out_str);
+	m_rows_out_str = nullptr;
+	m_rows_out = rows_out;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLOperatorCost::SetCost
@@ -87,10 +177,20 @@ void
 CDXLOperatorCost::SetCost(CWStringDynamic *cost_str)
 {
 	GPOS_ASSERT(nullptr != cost_str);
+	GPOS_ASSERT(!m_has_estimates);
 	GPOS_DELETE(m_total_cost_str);
 	m_total_cost_str = cost_str;
 }
 
+void
+CDXLOperatorCost::SetCost(CDouble total_cost)
+{
+	GPOS_ASSERT(m_has_estimates);
+	GPOS_DELETE(m_total_cost_str);
+	m_total_cost_str = nullptr;
+	m_total_cost = total_cost;
+}
+
 void
 CDXLOperatorCost::SerializeToDXL(CXMLSerializer *xml_serializer) const
 {
@@ -99,13 +199,13 @@ CDXLOperatorCost::SerializeToDXL(CXMLSerializer *xml_serializer) const
 		CDXLTokens::GetDXLTokenStr(EdxltokenCost));
 
 	xml_serializer->AddAttribute(
-		CDXLTokens::GetDXLTokenStr(EdxltokenStartupCost), m_startup_cost_str);
+		CDXLTokens::GetDXLTokenStr(EdxltokenStartupCost), GetStartUpCostStr());
 	xml_serializer->AddAttribute(CDXLTokens::GetDXLTokenStr(EdxltokenTotalCost),
-								 m_total_cost_str);
+								 GetTotalCostStr());
 	xml_serializer->AddAttribute(CDXLTokens::GetDXLTokenStr(EdxltokenRows),
-								 m_rows_out_str);
+								 GetRowsOutStr());
 	xml_serializer->AddAttribute(CDXLTokens::GetDXLTokenStr(EdxltokenWidth),
-								 m_width_str);
+								 GetWidthStr());
 
 	xml_serializer->CloseElement(
 		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
@@ -0,0 +1,40 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2026 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CDXLOperatorCostTest.h
+//
+//	@doc:
+//		Tests the optimizer estimates carried by DXL operator costs
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CDXLOperatorCostTest_H
+#define GPOPT_CDXLOperatorCostTest_H
+
+#include "gpos/base.h"
+
+namespace gpdxl
+{
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CDXLOperatorCostTest
+//
+//	@doc:
+//		Static unit tests
+//
+//---------------------------------------------------------------------------
+class CDXLOperatorCostTest
+{
+public:
+	// unittests
+	static GPOS_RESULT EresUnittest();
+	static GPOS_RESULT EresUnittest_EstimatesMatchText();
+
+};	// class CDXLOperatorCostTest
+}  // namespace gpdxl
+
+#endif	// !GPOPT_CDXLOperatorCostTest_H
+
+// EOF
@@ -28,6 +28,7 @@
 
 #include "unittest/base.h"
 #include "unittest/dxl/CDXLMemoryManagerTest.h"
+#include "unittest/dxl/CDXLOperatorCostTest.h"
 #include "unittest/dxl/CDXLUtilsTest.h"
 #include "unittest/dxl/CParseHandlerCostModelTest.h"
 #include "unittest/dxl/CParseHandlerManagerTest.h"
@@ -123,7 +124,8 @@ static gpos::CUnittest rgut[] = {
 
 	// naucrates
 	GPOS_UNITTEST_STD(CCostTest), GPOS_UNITTEST_STD(CDatumTest),
-	GPOS_UNITTEST_STD(CDXLMemoryManagerTest), GPOS_UNITTEST_STD(CDXLUtilsTest),
+	GPOS_UNITTEST_STD(CDXLMemoryManagerTest),
+	GPOS_UNITTEST_STD(CDXLOperatorCostTest), GPOS_UNITTEST_STD(CDXLUtilsTest),
 	GPOS_UNITTEST_STD(CMDAccessorTest), GPOS_UNITTEST_STD(CMDProviderTest),
 	GPOS_UNITTEST_STD(CMiniDumperDXLTest),
 	GPOS_UNITTEST_STD(CExpressionPreprocessorTest),
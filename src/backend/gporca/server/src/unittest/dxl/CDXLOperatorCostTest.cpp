@@ -0,0 +1,97 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2026 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CDXLOperatorCostTest.cpp
+//
+//	@doc:
+//		Tests the optimizer estimates carried by DXL operator costs
+//---------------------------------------------------------------------------
+
+#include "unittest/dxl/CDXLOperatorCostTest.h"
+
+#include "gpos/base.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/string/CStringStatic.h"
+#include "gpos/test/CUnittest.h"
+
+#include "naucrates/dxl/operators/CDXLOperatorCost.h"
+
+using namespace gpos;
+using namespace gpdxl;
+
+// parse an estimate back from its textual form, as the DXL to PlannedStmt
+// translator does for costs read from DXL
+static DOUBLE
+ParseEstimate(const CWStringDynamic *str)
+{
+	CHAR buffer[512];
+	CStringStatic str_static(buffer, GPOS_ARRAY_SIZE(buffer));
+	str_static.AppendConvert(str->GetBuffer());
+	return clib::Strtod(str_static.Buffer());
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLOperatorCostTest::EresUnittest
+//
+//	@doc:
+//		Unittest for DXL operator costs
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CDXLOperatorCostTest::EresUnittest()
+{
+	CUnittest rgut[] = {GPOS_UNITTEST_FUNC(
+		CDXLOperatorCostTest::EresUnittest_EstimatesMatchText)};
+
+	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLOperatorCostTest::EresUnittest_EstimatesMatchText
+//
+//	@doc:
+//		The estimates handed to the plan translator must be exactly the
+//		ones it would parse from the serialized plan, including values
+//		halfway between two six-decimal numbers
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CDXLOperatorCostTest::EresUnittest_EstimatesMatchText()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	const DOUBLE values[] = {0.0,	   1.0,		   0.1018945,	  0.0020675,
+							 5.5804455, 67.0481085, 699486831.0105234,
+							 431.123456789, 1e-9,   1e20};
+
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(values); ul++)
+	{
+		CDXLOperatorCost *cost = GPOS_NEW(mp)
+			CDXLOperatorCost(mp, CDouble(values[ul]),
+							 CDouble(values[GPOS_ARRAY_SIZE(values) - ul - 1]),
+							 (LINT) ul);
+
+		BOOL matches =
+			cost->GetTotalCost().Get() ==
+				ParseEstimate(cost->GetTotalCostStr()) &&
+			cost->GetRowsOut().Get() == ParseEstimate(cost->GetRowsOutStr()) &&
+			cost->GetWidth() == (LINT) ParseEstimate(cost->GetWidthStr()) &&
+			0.0 == ParseEstimate(cost->GetStartUpCostStr());
+
+		cost->Release();
+
+		if (!matches)
+		{
+			return GPOS_FAILED;
+		}
+	}
+
+	return GPOS_OK;
+}
+
+// EOF
@@ -1108,6 +1108,8 @@ CopyJoinFields(const Join *from, Join *newnode)
 	COPY_SCALAR_FIELD(jointype);
 	COPY_SCALAR_FIELD(inner_unique);
 	COPY_NODE_FIELD(joinqual);
+	COPY_SCALAR_FIELD(feedback_qualhash);
+	COPY_SCALAR_FIELD(feedback_ratio);
 }
 
 
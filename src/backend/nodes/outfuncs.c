@@ -524,6 +524,8 @@ _outJoinPlanInfo(StringInfo str, const Join *node)
 	WRITE_ENUM_FIELD(jointype, JoinType);
 	WRITE_BOOL_FIELD(inner_unique);
 	WRITE_NODE_FIELD(joinqual);
+	WRITE_UINT_FIELD(feedback_qualhash);
+	WRITE_FLOAT_FIELD(feedback_ratio, "%.6f");
 }
 
 static void
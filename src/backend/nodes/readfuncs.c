@@ -3120,6 +3120,8 @@ ReadCommonJoin(Join *local_node)
 	READ_ENUM_FIELD(jointype, JoinType);
 	READ_BOOL_FIELD(inner_unique);
 	READ_NODE_FIELD(joinqual);
+	READ_UINT_FIELD(feedback_qualhash);
+	READ_FLOAT_FIELD(feedback_ratio);
 }
 
 /*
@@ -22,6 +22,7 @@
 
 #include "access/sysattr.h"
 #include "access/tsmapi.h"
+#include "catalog/pg_am.h"
 #include "catalog/pg_class.h"
 #include "catalog/pg_operator.h"
 #include "catalog/pg_proc.h"
@@ -61,6 +62,7 @@
 
 // TODO: these planner gucs need to be refactored into PlannerConfig.
 bool		gp_enable_sort_limit = false;
+bool		gp_enable_parallel_ao_scan = false;
 
 /* results of subquery_is_pushdown_safe */
 typedef struct pushdown_safety_info
@@ -800,6 +802,20 @@ set_rel_pathlist(PlannerInfo *root, RelOptInfo *rel,
 		bms_membership(root->all_baserels) != BMS_SINGLETON)
 		generate_gather_paths(root, rel, false);
 
+	/*
+	 * GPDB: the only partial paths are parallel scans of append-optimized
+	 * tables (see set_rel_consider_parallel), and the joins, aggregates and
+	 * motions above them don't know about partial paths. So gather them
+	 * right here, on the segment, even if this is the only baserel, and
+	 * don't let them go any further.
+	 */
+	if (rel->reloptkind == RELOPT_BASEREL && rel->partial_pathlist != NIL)
+	{
+		if (bms_membership(root->all_baserels) == BMS_SINGLETON)
+			generate_gather_paths(root, rel, false);
+		rel->partial_pathlist = NIL;
+	}
+
 	/* Now find the cheapest of the paths for this rel */
 	set_cheapest(rel);
 
@@ -845,6 +861,18 @@ set_rel_consider_parallel(PlannerInfo *root, RelOptInfo *rel,
 	/* This should only be called for baserels and appendrel children. */
 	Assert(IS_SIMPLE_REL(rel));
 
+	/*
+	 * GPDB: parallel workers are only used to scan append-optimized tables,
+	 * whose segment files the workers on each segment divide among
+	 * themselves by row-number ranges. Appendrels and their children are
+	 * left alone.
+	 */
+	if (rte->rtekind != RTE_RELATION || rte->inh ||
+		rel->reloptkind != RELOPT_BASEREL ||
+		(rel->relam != AO_ROW_TABLE_AM_OID &&
+		 rel->relam != AO_COLUMN_TABLE_AM_OID))
+		return;
+
 	/* Assorted checks based on rtekind. */
 	switch (rte->rtekind)
 	{
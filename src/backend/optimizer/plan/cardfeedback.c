@@ -0,0 +1,821 @@
+/*-------------------------------------------------------------------------
+ *
+ * cardfeedback.c
+ *	  Join cardinality feedback for the ORCA query planner
+ *
+ * When optimizer_cardinality_feedback is on, EXPLAIN ANALYZE of an ORCA plan
+ * remembers, for every join, how far the estimated row count was from the
+ * number of rows the join actually produced. The join is identified by the
+ * relations it joins, with the aliases they have in the query, which is also
+ * how ORCA identifies joins in row hints, and by a hash of the quals of the
+ * query that only reference those relations: the join quals, and the quals
+ * pushed down to the scans. Planning a later query that joins the same
+ * relations under the same aliases and with the same quals hands the
+ * corrections to ORCA as multiplicative row hints.
+ *
+ * Once ORCA has produced a plan, every join of it is annotated with its qual
+ * hash and with the correction that was applied to its estimate, if any. The
+ * correction is what the estimate has to be divided by to recover ORCA's own
+ * estimate when the join is recorded; it is 0 when an explicit row hint set
+ * the estimate, in which case there is nothing to learn from it.
+ *
+ * The corrections are kept in a small fixed-size array in shared memory on
+ * the coordinator, so that they outlive the session that observed them. When
+ * the array is full, the least recently updated entry is replaced.
+ *
+ * Copyright (c) 2026-Present VMware, Inc. or its affiliates.
+ *
+ * IDENTIFICATION
+ *	    src/backend/optimizer/plan/cardfeedback.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "cdb/cdbvars.h"
+#include "common/hashfn.h"
+#include "nodes/makefuncs.h"
+#include "nodes/nodeFuncs.h"
+#include "optimizer/cardfeedback.h"
+#include "optimizer/optimizer.h"
+#include "optimizer/walkers.h"
+#include "parser/parsetree.h"
+#include "rewrite/rewriteManip.h"
+#include "storage/lwlock.h"
+#include "storage/shmem.h"
+#include "utils/builtins.h"
+#include "utils/datum.h"
+#include "utils/guc.h"
+
+#define CARDFEEDBACK_NUM_ENTRIES	1024
+
+typedef struct CardFeedbackEntry
+{
+	CardinalityFeedback feedback;	/* nrels is 0 for an unused slot */
+	uint64		lastUpdate;
+} CardFeedbackEntry;
+
+typedef struct CardFeedbackShared
+{
+	uint64		clock;
+	CardFeedbackEntry entries[CARDFEEDBACK_NUM_ENTRIES];
+} CardFeedbackShared;
+
+/* A relation of the query being planned, or of a join being recorded */
+typedef struct FeedbackRel
+{
+	Oid			relid;
+	const char *alias;
+} FeedbackRel;
+
+/* A qual of the query being planned, with the relations it references */
+typedef struct FeedbackQual
+{
+	int			nrels;
+	FeedbackRel rels[CARDFEEDBACK_MAX_RELS];
+	uint32		hash;
+} FeedbackQual;
+
+typedef struct JoinRelsContext
+{
+	plan_tree_base_prefix base;
+	Bitmapset  *rtis;
+} JoinRelsContext;
+
+typedef struct AnnotateContext
+{
+	plan_tree_base_prefix base;
+	PlannedStmt *stmt;
+	List	   *quals;
+	List	   *feedback;
+} AnnotateContext;
+
+typedef struct QualHashContext
+{
+	Query	   *query;
+	FeedbackQual *qual;
+	uint32		hash;
+} QualHashContext;
+
+static CardFeedbackShared *cardFeedback = NULL;
+
+static int	feedback_rel_cmp(const void *a, const void *b);
+static bool feedback_rels_subset(FeedbackRel *sub, int nsub,
+								 FeedbackRel *rels, int nrels);
+static void feedback_get_rels(const CardinalityFeedback *feedback,
+							  FeedbackRel *rels);
+static bool feedback_matches(const CardinalityFeedback *feedback,
+							 FeedbackRel *rels, int nrels, uint32 qualhash);
+static bool row_hint_matches(RowsHint *hint,
+							 const CardinalityFeedback *feedback);
+static int	join_relations(PlannedStmt *stmt, Join *join, FeedbackRel *rels);
+static bool join_relations_walker(Node *node, JoinRelsContext *context);
+static bool annotate_walker(Node *node, AnnotateContext *context);
+static bool collect_relations_walker(Node *node, List **rels);
+static bool collect_quals_walker(Node *node, List **quals);
+static void collect_jointree_quals(Node *jtnode, Query *query, List **quals);
+static FeedbackQual *make_feedback_qual(Node *qual, Query *query);
+static bool qual_hash_walker(Node *node, QualHashContext *context);
+static uint32 feedback_qual_hash(List *quals, FeedbackRel *rels, int nrels);
+
+static bool
+feedback_enabled(void)
+{
+	return Gp_role == GP_ROLE_DISPATCH || Gp_role == GP_ROLE_UTILITY;
+}
+
+Size
+CardFeedbackShmemSize(void)
+{
+	if (!feedback_enabled())
+		return 0;
+
+	return sizeof(CardFeedbackShared);
+}
+
+void
+CardFeedbackShmemInit(void)
+{
+	bool		found;
+
+	if (!feedback_enabled())
+		return;
+
+	cardFeedback = (CardFeedbackShared *)
+		ShmemInitStruct("Cardinality feedback", CardFeedbackShmemSize(), &found);
+
+	if (!found)
+		memset(cardFeedback, 0, CardFeedbackShmemSize());
+}
+
+/*
+ * Remember the rows a join actually produced.
+ *
+ * 'estimated_rows' is the estimate of the join in the plan that was executed.
+ * The correction that planning applied to it, if any, is recorded on the
+ * join; the new correction is computed against the uncorrected estimate, so
+ * that repeated runs converge instead of undoing each other.
+ */
+void
+RecordCardinalityFeedback(PlannedStmt *stmt, Join *join,
+						  double estimated_rows, double actual_rows)
+{
+	FeedbackRel rels[CARDFEEDBACK_MAX_RELS];
+	CardFeedbackEntry *entry = NULL;
+	CardFeedbackEntry *victim = NULL;
+	int			nrels;
+	int			i;
+
+	/* not planned with feedback on, or the estimate came from a row hint */
+	if (cardFeedback == NULL || join->feedback_ratio <= 0)
+		return;
+
+	nrels = join_relations(stmt, join, rels);
+	if (nrels < 2)
+		return;
+
+	LWLockAcquire(CardinalityFeedbackLock, LW_EXCLUSIVE);
+
+	for (i = 0; i < CARDFEEDBACK_NUM_ENTRIES; i++)
+	{
+		CardFeedbackEntry *candidate = &cardFeedback->entries[i];
+
+		if (feedback_matches(&candidate->feedback, rels, nrels,
+							 join->feedback_qualhash))
+		{
+			entry = candidate;
+			break;
+		}
+		if (victim == NULL || candidate->lastUpdate < victim->lastUpdate)
+			victim = candidate;
+	}
+
+	if (entry == NULL)
+	{
+		entry = victim;
+		entry->feedback.nrels = nrels;
+		for (i = 0; i < nrels; i++)
+		{
+			entry->feedback.relids[i] = rels[i].relid;
+			namestrcpy(&entry->feedback.aliases[i], rels[i].alias);
+		}
+		entry->feedback.qualhash = join->feedback_qualhash;
+	}
+
+	/* ORCA never estimates less than one row, don't correct below that */
+	entry->feedback.ratio = Max(actual_rows, 1.0) /
+		Max(estimated_rows / join->feedback_ratio, 1.0);
+	entry->lastUpdate = ++cardFeedback->clock;
+
+	LWLockRelease(CardinalityFeedbackLock);
+}
+
+/*
+ * Return the feedback that applies to the query, as a list of palloc'd
+ * CardinalityFeedback: the entries whose relations all appear in the query
+ * under the recorded aliases, and whose quals are the same as the query's.
+ *
+ * Entries for the same relations as an explicit row hint are left out, the
+ * hint wins. Each such hint is listed instead, with a ratio of 0, so that
+ * AnnotateCardinalityFeedback() knows that its estimate is not ORCA's.
+ */
+List *
+GetCardinalityFeedback(Query *query, HintState *hintstate)
+{
+	List	   *result = NIL;
+	List	   *candidates = NIL;
+	List	   *rtes = NIL;
+	List	   *quals;
+	FeedbackRel *rels;
+	ListCell   *lc;
+	int			nrels;
+	int			i;
+
+	if (cardFeedback == NULL || !optimizer_cardinality_feedback)
+		return NIL;
+
+	(void) collect_relations_walker((Node *) query, &rtes);
+	if (list_length(rtes) < 2)
+		return NIL;
+
+	nrels = list_length(rtes);
+	rels = palloc(nrels * sizeof(FeedbackRel));
+	i = 0;
+	foreach(lc, rtes)
+	{
+		RangeTblEntry *rte = lfirst(lc);
+
+		rels[i].relid = rte->relid;
+		rels[i].alias = rte->eref->aliasname;
+		i++;
+	}
+	qsort(rels, nrels, sizeof(FeedbackRel), feedback_rel_cmp);
+
+	LWLockAcquire(CardinalityFeedbackLock, LW_SHARED);
+
+	for (i = 0; i < CARDFEEDBACK_NUM_ENTRIES; i++)
+	{
+		const CardinalityFeedback *feedback = &cardFeedback->entries[i].feedback;
+		FeedbackRel feedback_rels[CARDFEEDBACK_MAX_RELS];
+
+		if (feedback->nrels == 0)
+			continue;
+
+		feedback_get_rels(feedback, feedback_rels);
+		if (feedback_rels_subset(feedback_rels, feedback->nrels, rels, nrels))
+		{
+			CardinalityFeedback *copy = palloc(sizeof(CardinalityFeedback));
+
+			memcpy(copy, feedback, sizeof(CardinalityFeedback));
+			candidates = lappend(candidates, copy);
+		}
+	}
+
+	LWLockRelease(CardinalityFeedbackLock);
+
+	/* explicit row hints go first, as they do in the ORCA plan hints */
+	if (hintstate != NULL)
+	{
+		for (i = 0; i < hintstate->num_hints[HINT_TYPE_ROWS]; i++)
+		{
+			RowsHint   *hint = hintstate->rows_hints[i];
+			CardinalityFeedback *marker;
+			int			j;
+
+			if (hint->nrels < 2 || hint->nrels > CARDFEEDBACK_MAX_RELS)
+				continue;
+
+			marker = palloc0(sizeof(CardinalityFeedback));
+			marker->nrels = hint->nrels;
+			for (j = 0; j < hint->nrels; j++)
+				namestrcpy(&marker->aliases[j], hint->relnames[j]);
+			result = lappend(result, marker);
+		}
+	}
+
+	quals = NIL;
+	(void) collect_quals_walker((Node *) query, &quals);
+
+	foreach(lc, candidates)
+	{
+		CardinalityFeedback *feedback = lfirst(lc);
+		FeedbackRel feedback_rels[CARDFEEDBACK_MAX_RELS];
+		bool		hinted = false;
+
+		feedback_get_rels(feedback, feedback_rels);
+		if (feedback->qualhash != feedback_qual_hash(quals, feedback_rels,
+													 feedback->nrels))
+		{
+			pfree(feedback);
+			continue;
+		}
+
+		if (hintstate != NULL)
+		{
+			for (i = 0; i < hintstate->num_hints[HINT_TYPE_ROWS]; i++)
+			{
+				if (row_hint_matches(hintstate->rows_hints[i], feedback))
+				{
+					hinted = true;
+					break;
+				}
+			}
+		}
+
+		if (hinted)
+			pfree(feedback);
+		else
+			result = lappend(result, feedback);
+	}
+
+	list_free_deep(quals);
+	list_free(candidates);
+	pfree(rels);
+	list_free(rtes);
+
+	return result;
+}
+
+/*
+ * Record on every join of an ORCA plan the hash of its quals and the
+ * correction that 'feedback', as returned by GetCardinalityFeedback() for
+ * the query, made to its estimate.
+ */
+void
+AnnotateCardinalityFeedback(PlannedStmt *stmt, Query *query, List *feedback)
+{
+	AnnotateContext context;
+	ListCell   *lc;
+
+	exec_init_plan_tree_base(&context.base, stmt);
+	context.stmt = stmt;
+	context.quals = NIL;
+	context.feedback = feedback;
+	(void) collect_quals_walker((Node *) query, &context.quals);
+
+	(void) annotate_walker((Node *) stmt->planTree, &context);
+	foreach(lc, stmt->subplans)
+		(void) annotate_walker((Node *) lfirst(lc), &context);
+
+	list_free_deep(context.quals);
+}
+
+static bool
+annotate_walker(Node *node, AnnotateContext *context)
+{
+	if (node == NULL)
+		return false;
+
+	if (IsA(node, NestLoop) || IsA(node, HashJoin) || IsA(node, MergeJoin))
+	{
+		Join	   *join = (Join *) node;
+		FeedbackRel rels[CARDFEEDBACK_MAX_RELS];
+		int			nrels = join_relations(context->stmt, join, rels);
+
+		if (nrels >= 2)
+		{
+			ListCell   *lc;
+
+			join->feedback_qualhash = feedback_qual_hash(context->quals,
+														 rels, nrels);
+			join->feedback_ratio = 1.0;
+
+			/* ORCA picks the first row hint with the same aliases */
+			foreach(lc, context->feedback)
+			{
+				CardinalityFeedback *feedback = lfirst(lc);
+				int			i;
+
+				if (feedback->nrels != nrels)
+					continue;
+				for (i = 0; i < nrels; i++)
+				{
+					if (strcmp(NameStr(feedback->aliases[i]),
+							   rels[i].alias) != 0)
+						break;
+				}
+				if (i == nrels)
+				{
+					join->feedback_ratio = feedback->ratio;
+					break;
+				}
+			}
+		}
+	}
+
+	return plan_tree_walker(node, annotate_walker, context, false);
+}
+
+static int
+feedback_rel_cmp(const void *a, const void *b)
+{
+	const FeedbackRel *rel_a = (const FeedbackRel *) a;
+	const FeedbackRel *rel_b = (const FeedbackRel *) b;
+	int			cmp = strcmp(rel_a->alias, rel_b->alias);
+
+	if (cmp != 0)
+		return cmp;
+	if (rel_a->relid != rel_b->relid)
+		return rel_a->relid < rel_b->relid ? -1 : 1;
+	return 0;
+}
+
+/* Are all of 'sub' in 'rels'? Both are sorted, so a merge tells. */
+static bool
+feedback_rels_subset(FeedbackRel *sub, int nsub, FeedbackRel *rels, int nrels)
+{
+	int			i = 0;
+	int			k;
+
+	for (k = 0; i < nsub && k < nrels; k++)
+	{
+		if (feedback_rel_cmp(&sub[i], &rels[k]) == 0)
+			i++;
+	}
+	return i == nsub;
+}
+
+static void
+feedback_get_rels(const CardinalityFeedback *feedback, FeedbackRel *rels)
+{
+	int			i;
+
+	for (i = 0; i < feedback->nrels; i++)
+	{
+		rels[i].relid = feedback->relids[i];
+		rels[i].alias = NameStr(feedback->aliases[i]);
+	}
+}
+
+static bool
+feedback_matches(const CardinalityFeedback *feedback, FeedbackRel *rels,
+				 int nrels, uint32 qualhash)
+{
+	int			i;
+
+	if (feedback->nrels != nrels || feedback->qualhash != qualhash)
+		return false;
+
+	for (i = 0; i < nrels; i++)
+	{
+		if (feedback->relids[i] != rels[i].relid ||
+			strcmp(NameStr(feedback->aliases[i]), rels[i].alias) != 0)
+			return false;
+	}
+	return true;
+}
+
+/* Does the row hint name the same aliases as the feedback, in any order? */
+static bool
+row_hint_matches(RowsHint *hint, const CardinalityFeedback *feedback)
+{
+	int			i;
+	int			j;
+
+	if (hint->nrels != feedback->nrels)
+		return false;
+
+	for (i = 0; i < feedback->nrels; i++)
+	{
+		for (j = 0; j < hint->nrels; j++)
+		{
+			if (strcmp(hint->relnames[j], NameStr(feedback->aliases[i])) == 0)
+				break;
+		}
+		if (j == hint->nrels)
+			return false;
+	}
+	return true;
+}
+
+/*
+ * Fill 'rels' with the relations scanned below a join, sorted, and return
+ * their number, or 0 if there are more than CARDFEEDBACK_MAX_RELS. Relations
+ * of subplans are not part of the join.
+ */
+static int
+join_relations(PlannedStmt *stmt, Join *join, FeedbackRel *rels)
+{
+	JoinRelsContext context;
+	int			nrels = 0;
+	int			rti = -1;
+
+	exec_init_plan_tree_base(&context.base, stmt);
+	context.rtis = NULL;
+	(void) join_relations_walker((Node *) join, &context);
+
+	while ((rti = bms_next_member(context.rtis, rti)) >= 0)
+	{
+		RangeTblEntry *rte;
+
+		if (rti == 0)
+			continue;
+
+		rte = rt_fetch(rti, stmt->rtable);
+		if (rte->rtekind != RTE_RELATION)
+			continue;
+
+		/* too large a join to keep feedback for */
+		if (nrels == CARDFEEDBACK_MAX_RELS)
+		{
+			nrels = 0;
+			break;
+		}
+
+		rels[nrels].relid = rte->relid;
+		rels[nrels].alias = rte->eref->aliasname;
+		nrels++;
+	}
+	bms_free(context.rtis);
+
+	qsort(rels, nrels, sizeof(FeedbackRel), feedback_rel_cmp);
+
+	return nrels;
+}
+
+static bool
+join_relations_walker(Node *node, JoinRelsContext *context)
+{
+	if (node == NULL)
+		return false;
+
+	switch (nodeTag(node))
+	{
+		case T_SeqScan:
+		case T_SampleScan:
+		case T_IndexScan:
+		case T_IndexOnlyScan:
+		case T_BitmapHeapScan:
+		case T_DynamicBitmapHeapScan:
+		case T_TidScan:
+		case T_DynamicSeqScan:
+		case T_DynamicIndexScan:
+		case T_DynamicIndexOnlyScan:
+			context->rtis = bms_add_member(context->rtis,
+										   ((Scan *) node)->scanrelid);
+			break;
+		case T_ForeignScan:
+		case T_DynamicForeignScan:
+			context->rtis = bms_add_members(context->rtis,
+											((ForeignScan *) node)->fs_relids);
+			break;
+		default:
+			break;
+	}
+
+	return plan_tree_walker(node, join_relations_walker, context, false);
+}
+
+/*
+ * Collect the plain relations of the query, including those of subqueries,
+ * CTEs and sublinks, since ORCA plans them all together.
+ */
+static bool
+collect_relations_walker(Node *node, List **rels)
+{
+	if (node == NULL)
+		return false;
+
+	if (IsA(node, RangeTblEntry))
+	{
+		RangeTblEntry *rte = (RangeTblEntry *) node;
+
+		if (rte->rtekind == RTE_RELATION)
+			*rels = lappend(*rels, rte);
+		return false;
+	}
+
+	if (IsA(node, Query))
+		return query_tree_walker((Query *) node, collect_relations_walker,
+								 (void *) rels, QTW_EXAMINE_RTES_BEFORE);
+
+	return expression_tree_walker(node, collect_relations_walker,
+								  (void *) rels);
+}
+
+/*
+ * Collect the quals of the query and of its subqueries, CTEs and sublinks, as
+ * a list of FeedbackQual.
+ */
+static bool
+collect_quals_walker(Node *node, List **quals)
+{
+	if (node == NULL)
+		return false;
+
+	if (IsA(node, Query))
+	{
+		Query	   *query = (Query *) node;
+
+		collect_jointree_quals((Node *) query->jointree, query, quals);
+		return query_tree_walker(query, collect_quals_walker,
+								 (void *) quals, 0);
+	}
+
+	return expression_tree_walker(node, collect_quals_walker, (void *) quals);
+}
+
+static void
+collect_jointree_quals(Node *jtnode, Query *query, List **quals)
+{
+	Node	   *jtquals;
+	ListCell   *lc;
+
+	if (jtnode == NULL)
+		return;
+
+	if (IsA(jtnode, FromExpr))
+	{
+		FromExpr   *f = (FromExpr *) jtnode;
+
+		foreach(lc, f->fromlist)
+			collect_jointree_quals(lfirst(lc), query, quals);
+		jtquals = f->quals;
+	}
+	else if (IsA(jtnode, JoinExpr))
+	{
+		JoinExpr   *j = (JoinExpr *) jtnode;
+
+		collect_jointree_quals(j->larg, query, quals);
+		collect_jointree_quals(j->rarg, query, quals);
+		jtquals = j->quals;
+	}
+	else
+		return;
+
+	foreach(lc, make_ands_implicit((Expr *) jtquals))
+	{
+		FeedbackQual *qual = make_feedback_qual(lfirst(lc), query);
+
+		if (qual != NULL)
+			*quals = lappend(*quals, qual);
+	}
+}
+
+/*
+ * Describe one conjunct of the quals of 'query'. Only quals over plain
+ * relations of the same query level, without sublinks, are kept.
+ */
+static FeedbackQual *
+make_feedback_qual(Node *qual, Query *query)
+{
+	FeedbackQual *result;
+	QualHashContext context;
+	Bitmapset  *varnos;
+	int			rti = -1;
+	int			i;
+
+	if (checkExprHasSubLink(qual))
+		return NULL;
+
+	varnos = pull_varnos(qual);
+	if (bms_is_empty(varnos) || bms_num_members(varnos) > CARDFEEDBACK_MAX_RELS)
+		return NULL;
+
+	result = palloc(sizeof(FeedbackQual));
+	result->nrels = 0;
+	while ((rti = bms_next_member(varnos, rti)) >= 0)
+	{
+		RangeTblEntry *rte = rt_fetch(rti, query->rtable);
+
+		if (rte->rtekind != RTE_RELATION)
+		{
+			pfree(result);
+			return NULL;
+		}
+		result->rels[result->nrels].relid = rte->relid;
+		result->rels[result->nrels].alias = rte->eref->aliasname;
+		result->nrels++;
+	}
+	qsort(result->rels, result->nrels, sizeof(FeedbackRel), feedback_rel_cmp);
+
+	/* the hash covers the relations, so the same text on others differs */
+	context.query = query;
+	context.qual = result;
+	context.hash = 0;
+	for (i = 0; i < result->nrels; i++)
+	{
+		context.hash = hash_combine(context.hash,
+									hash_bytes_uint32(result->rels[i].relid));
+		context.hash = hash_combine(context.hash,
+									hash_bytes((const unsigned char *) result->rels[i].alias,
+											   strlen(result->rels[i].alias)));
+	}
+	(void) qual_hash_walker(qual, &context);
+	result->hash = context.hash;
+
+	return result;
+}
+
+/*
+ * Hash the parts of an expression that matter for its selectivity. Vars are
+ * hashed by the position of their relation among the relations of the qual,
+ * not by range table index, which differs from query to query.
+ */
+static bool
+qual_hash_walker(Node *node, QualHashContext *context)
+{
+	uint32		hash;
+
+	if (node == NULL)
+		return false;
+
+	hash = hash_bytes_uint32((uint32) nodeTag(node));
+
+	switch (nodeTag(node))
+	{
+		case T_Var:
+			{
+				Var		   *var = (Var *) node;
+				uint32		relno = var->varno;
+
+				if (var->varlevelsup == 0)
+				{
+					RangeTblEntry *rte = rt_fetch(var->varno,
+												  context->query->rtable);
+					FeedbackRel rel;
+
+					rel.relid = rte->relid;
+					rel.alias = rte->eref->aliasname;
+					for (relno = 0; relno < context->qual->nrels; relno++)
+					{
+						if (feedback_rel_cmp(&rel, &context->qual->rels[relno]) == 0)
+							break;
+					}
+				}
+				hash = hash_combine(hash, hash_bytes_uint32(var->varlevelsup));
+				hash = hash_combine(hash, hash_bytes_uint32(relno));
+				hash = hash_combine(hash, hash_bytes_uint32((uint32) var->varattno));
+			}
+			break;
+		case T_Const:
+			{
+				Const	   *c = (Const *) node;
+
+				hash = hash_combine(hash, hash_bytes_uint32(c->consttype));
+				if (c->constisnull)
+					hash = hash_combine(hash, hash_bytes_uint32(1));
+				else if (c->constbyval)
+					hash = hash_combine(hash,
+										hash_bytes((const unsigned char *) &c->constvalue,
+												   sizeof(Datum)));
+				else
+					hash = hash_combine(hash,
+										hash_bytes((const unsigned char *) DatumGetPointer(c->constvalue),
+												   datumGetSize(c->constvalue, false, c->constlen)));
+			}
+			break;
+		case T_Param:
+			hash = hash_combine(hash, hash_bytes_uint32(((Param *) node)->paramkind));
+			hash = hash_combine(hash, hash_bytes_uint32(((Param *) node)->paramid));
+			break;
+		case T_OpExpr:
+		case T_DistinctExpr:
+		case T_NullIfExpr:
+			hash = hash_combine(hash, hash_bytes_uint32(((OpExpr *) node)->opno));
+			break;
+		case T_ScalarArrayOpExpr:
+			hash = hash_combine(hash, hash_bytes_uint32(((ScalarArrayOpExpr *) node)->opno));
+			hash = hash_combine(hash, hash_bytes_uint32(((ScalarArrayOpExpr *) node)->useOr));
+			break;
+		case T_FuncExpr:
+			hash = hash_combine(hash, hash_bytes_uint32(((FuncExpr *) node)->funcid));
+			break;
+		case T_BoolExpr:
+			hash = hash_combine(hash, hash_bytes_uint32(((BoolExpr *) node)->boolop));
+			break;
+		case T_NullTest:
+			hash = hash_combine(hash, hash_bytes_uint32(((NullTest *) node)->nulltesttype));
+			break;
+		case T_BooleanTest:
+			hash = hash_combine(hash, hash_bytes_uint32(((BooleanTest *) node)->booltesttype));
+			break;
+		default:
+			break;
+	}
+
+	context->hash = hash_combine(context->hash, hash);
+
+	return expression_tree_walker(node, qual_hash_walker, (void *) context);
+}
+
+/*
+ * Hash of the quals of the query that only reference the given relations.
+ * The quals are summed, so that the order they are written in doesn't
+ * matter.
+ */
+static uint32
+feedback_qual_hash(List *quals, FeedbackRel *rels, int nrels)
+{
+	uint32		result = 0;
+	ListCell   *lc;
+
+	foreach(lc, quals)
+	{
+		FeedbackQual *qual = lfirst(lc);
+
+		if (feedback_rels_subset(qual->rels, qual->nrels, rels, nrels))
+			result += qual->hash;
+	}
+	return result;
+}
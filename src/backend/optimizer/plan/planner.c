@@ -479,12 +479,20 @@ standard_planner(Query *parse, int cursorOptions, ParamListInfo boundParams)
 	 * restriction, but for now it seems best not to have parallel workers
 	 * trying to create their own parallel workers.
 	 */
-	/* GPDB_96_MERGE_FIXME: disable parallel workers for now */
-	glob->parallelModeOK = false;
-#if 0
-	if ((cursorOptions & CURSOR_OPT_PARALLEL_OK) != 0 &&
+	/*
+	 * GPDB: parallel workers are only used on the segments, to scan
+	 * append-optimized tables below the motions (see
+	 * set_rel_consider_parallel), and only if gp_enable_parallel_ao_scan is
+	 * on. The QD never runs a Gather itself, so force_parallel_mode, which
+	 * would put one on top of the plan, is not supported.
+	 */
+	if (gp_enable_parallel_ao_scan &&
+		Gp_role == GP_ROLE_DISPATCH &&
+		force_parallel_mode == FORCE_PARALLEL_OFF &&
+		(cursorOptions & CURSOR_OPT_PARALLEL_OK) != 0 &&
 		IsUnderPostmaster &&
 		parse->commandType == CMD_SELECT &&
+		parse->parentStmtType == PARENTSTMTTYPE_NONE &&
 		!parse->hasModifyingCTE &&
 		max_parallel_workers_per_gather > 0 &&
 		!IsParallelWorker())
@@ -499,7 +507,6 @@ standard_planner(Query *parse, int cursorOptions, ParamListInfo boundParams)
 		glob->maxParallelHazard = PROPARALLEL_UNSAFE;
 		glob->parallelModeOK = false;
 	}
-#endif
 
 	/*
 	 * glob->parallelModeNeeded is normally set to false here and changed to
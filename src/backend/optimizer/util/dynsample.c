@@ -0,0 +1,317 @@
+/*-------------------------------------------------------------------------
+ *
+ * dynsample.c
+ *	  Plan-time sampling of tables with missing or stale statistics
+ *
+ * When optimizer_dynamic_sampling is on, ORCA does not fall back to default
+ * selectivities for a table that has never been analyzed, or that has been
+ * modified more since its last ANALYZE than it had rows at the time. Instead,
+ * the table is sampled the way ANALYZE samples it, and the statistics
+ * computed from the sample are used in place of the catalog ones. They are
+ * not stored in the catalogs.
+ *
+ * The samples are kept for the life of the backend, so that planning the
+ * same table again doesn't sample it again. A sample is good as long as the
+ * table's changes_since_analyze counter hasn't moved, and the relation hasn't
+ * been invalidated, by ANALYZE or TRUNCATE for example. DynamicSamplesChanged()
+ * tells ORCA when it must drop what its metadata cache holds for them.
+ *
+ * Copyright (c) 2026-Present VMware, Inc. or its affiliates.
+ *
+ * IDENTIFICATION
+ *	    src/backend/optimizer/util/dynsample.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/relation.h"
+#include "catalog/catalog.h"
+#include "commands/vacuum.h"
+#include "miscadmin.h"
+#include "optimizer/dynsample.h"
+#include "pgstat.h"
+#include "utils/acl.h"
+#include "utils/guc.h"
+#include "utils/hsearch.h"
+#include "utils/inval.h"
+#include "utils/memutils.h"
+#include "utils/rel.h"
+
+typedef struct DynamicSample
+{
+	Oid			relid;			/* hash key */
+	PgStat_Counter changes;		/* changes_since_analyze when sampled */
+	double		reltuples;		/* pg_class.reltuples when sampled */
+	bool		sampled;		/* false if the statistics are good enough */
+	double		totalrows;
+	int			natts;
+	HeapTuple  *attstats;		/* indexed by attnum - 1, may contain NULLs */
+} DynamicSample;
+
+/* Samples taken by this backend */
+static HTAB *dynamicSamples = NULL;
+static MemoryContext DynamicSampleContext = NULL;
+
+/* optimizer_dynamic_sampling as of the last DynamicSamplesChanged() call */
+static bool dynamicSamplingWasOn = false;
+
+static DynamicSample *get_dynamic_sample(Oid relid);
+static bool needs_dynamic_sample(Relation rel, PgStat_Counter *changes);
+static PgStat_Counter changes_since_analyze(Oid relid, bool *analyzed);
+static void free_dynamic_sample(DynamicSample *sample);
+static void dynamic_sample_relcache_callback(Datum arg, Oid relid);
+
+/*
+ * If the relation has been sampled, return the number of rows estimated from
+ * the sample in *totalrows and true. Otherwise, return false; the caller
+ * should use the relation's own statistics.
+ */
+bool
+GetDynamicSampleRelStats(Oid relid, double *totalrows)
+{
+	DynamicSample *sample;
+
+	if (!optimizer_dynamic_sampling)
+		return false;
+
+	sample = get_dynamic_sample(relid);
+	if (!sample->sampled)
+		return false;
+
+	*totalrows = sample->totalrows;
+	return true;
+}
+
+/*
+ * If the relation has been sampled, return a copy of the pg_statistic tuple
+ * computed from the sample for the attribute in *stats_tup, or NULL if there
+ * is none, and true. Otherwise, return false; the caller should look the
+ * statistics up in pg_statistic.
+ */
+bool
+GetDynamicSampleAttStats(Oid relid, AttrNumber attnum, HeapTuple *stats_tup)
+{
+	DynamicSample *sample;
+
+	if (!optimizer_dynamic_sampling)
+		return false;
+
+	sample = get_dynamic_sample(relid);
+	if (!sample->sampled)
+		return false;
+
+	*stats_tup = NULL;
+	if (attnum > 0 && attnum <= sample->natts &&
+		sample->attstats[attnum - 1] != NULL)
+		*stats_tup = heap_copytuple(sample->attstats[attnum - 1]);
+
+	return true;
+}
+
+/*
+ * Has anything ORCA may have cached from the samples changed since the last
+ * call? That is the case when optimizer_dynamic_sampling has been switched,
+ * when a sampled table has been modified since it was sampled, and when a
+ * table that didn't need a sample has since been modified more than it has
+ * rows. The samples that are out of date are dropped.
+ */
+bool
+DynamicSamplesChanged(void)
+{
+	HASH_SEQ_STATUS status;
+	DynamicSample *sample;
+	bool		changed = false;
+
+	if (optimizer_dynamic_sampling != dynamicSamplingWasOn)
+	{
+		dynamicSamplingWasOn = optimizer_dynamic_sampling;
+		changed = true;
+	}
+
+	if (!optimizer_dynamic_sampling || dynamicSamples == NULL)
+		return changed;
+
+	hash_seq_init(&status, dynamicSamples);
+	while ((sample = hash_seq_search(&status)) != NULL)
+	{
+		bool		analyzed;
+		PgStat_Counter changes = changes_since_analyze(sample->relid,
+													   &analyzed);
+
+		if (changes == sample->changes)
+			continue;
+
+		if (sample->sampled || changes > sample->reltuples)
+		{
+			free_dynamic_sample(sample);
+			hash_search(dynamicSamples, &sample->relid, HASH_REMOVE, NULL);
+			changed = true;
+		}
+		else
+			sample->changes = changes;
+	}
+
+	return changed;
+}
+
+static DynamicSample *
+get_dynamic_sample(Oid relid)
+{
+	DynamicSample *sample;
+	Relation	rel;
+	MemoryContext oldcontext;
+	HeapTuple  *attstats = NULL;
+	PgStat_Counter changes;
+	double		totalrows = 0;
+	bool		sampled;
+	bool		found;
+
+	if (dynamicSamples == NULL)
+	{
+		HASHCTL		hash_ctl;
+
+		if (DynamicSampleContext == NULL)
+		{
+			DynamicSampleContext = AllocSetContextCreate(TopMemoryContext,
+														 "Dynamic samples",
+														 ALLOCSET_DEFAULT_SIZES);
+			CacheRegisterRelcacheCallback(dynamic_sample_relcache_callback,
+										  (Datum) 0);
+		}
+
+		MemSet(&hash_ctl, 0, sizeof(hash_ctl));
+		hash_ctl.keysize = sizeof(Oid);
+		hash_ctl.entrysize = sizeof(DynamicSample);
+		hash_ctl.hcxt = DynamicSampleContext;
+		dynamicSamples = hash_create("Dynamic samples", 16, &hash_ctl,
+									 HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	}
+
+	sample = hash_search(dynamicSamples, &relid, HASH_FIND, NULL);
+	if (sample != NULL)
+		return sample;
+
+	rel = relation_open(relid, AccessShareLock);
+
+	sampled = needs_dynamic_sample(rel, &changes);
+	if (sampled)
+	{
+		oldcontext = MemoryContextSwitchTo(DynamicSampleContext);
+		attstats = analyze_sample_attstats(rel,
+										   optimizer_dynamic_sampling_rows,
+										   &totalrows);
+		MemoryContextSwitchTo(oldcontext);
+
+		elog(DEBUG1, "sampled relation \"%s\" for the optimizer, estimated %.0f rows",
+			 RelationGetRelationName(rel), totalrows);
+	}
+
+	/* only enter the sample once it is complete, sampling can fail */
+	sample = hash_search(dynamicSamples, &relid, HASH_ENTER, &found);
+	sample->changes = changes;
+	sample->reltuples = rel->rd_rel->reltuples;
+	sample->sampled = sampled;
+	sample->totalrows = totalrows;
+	sample->natts = RelationGetNumberOfAttributes(rel);
+	sample->attstats = attstats;
+
+	relation_close(rel, AccessShareLock);
+
+	return sample;
+}
+
+static bool
+needs_dynamic_sample(Relation rel, PgStat_Counter *changes)
+{
+	bool		analyzed;
+
+	*changes = changes_since_analyze(RelationGetRelid(rel), &analyzed);
+
+	if (rel->rd_rel->relkind != RELKIND_RELATION &&
+		rel->rd_rel->relkind != RELKIND_MATVIEW)
+		return false;
+
+	if (IsCatalogRelation(rel) || RELATION_IS_OTHER_TEMP(rel))
+		return false;
+
+	/* the segments only sample a relation for its owner */
+	if (!pg_class_ownercheck(RelationGetRelid(rel), GetUserId()))
+		return false;
+
+	/* never analyzed; an analyzed table with no rows was empty */
+	if (rel->rd_rel->reltuples <= 0 && !analyzed)
+		return true;
+
+	/* modified more since the last ANALYZE than it had rows then */
+	return *changes > rel->rd_rel->reltuples;
+}
+
+/*
+ * Return the relation's changes_since_analyze, and whether it has been
+ * analyzed at all in *analyzed, as the stats collector knows them.
+ */
+static PgStat_Counter
+changes_since_analyze(Oid relid, bool *analyzed)
+{
+	PgStat_StatTabEntry *tabentry = pgstat_fetch_stat_tabentry(relid);
+
+	if (tabentry == NULL)
+	{
+		*analyzed = false;
+		return 0;
+	}
+
+	*analyzed = tabentry->analyze_count > 0 ||
+		tabentry->autovac_analyze_count > 0;
+	return tabentry->changes_since_analyze;
+}
+
+static void
+free_dynamic_sample(DynamicSample *sample)
+{
+	int			i;
+
+	if (sample->attstats == NULL)
+		return;
+
+	for (i = 0; i < sample->natts; i++)
+	{
+		if (sample->attstats[i] != NULL)
+			heap_freetuple(sample->attstats[i]);
+	}
+	pfree(sample->attstats);
+	sample->attstats = NULL;
+}
+
+/*
+ * Drop the sample of a relation when its relcache entry is invalidated: its
+ * row count or statistics may have changed, or it may be gone.
+ */
+static void
+dynamic_sample_relcache_callback(Datum arg, Oid relid)
+{
+	HASH_SEQ_STATUS status;
+	DynamicSample *sample;
+
+	if (dynamicSamples == NULL)
+		return;
+
+	if (OidIsValid(relid))
+	{
+		sample = hash_search(dynamicSamples, &relid, HASH_FIND, NULL);
+		if (sample != NULL)
+		{
+			free_dynamic_sample(sample);
+			hash_search(dynamicSamples, &relid, HASH_REMOVE, NULL);
+		}
+		return;
+	}
+
+	hash_seq_init(&status, dynamicSamples);
+	while ((sample = hash_seq_search(&status)) != NULL)
+	{
+		free_dynamic_sample(sample);
+		hash_search(dynamicSamples, &sample->relid, HASH_REMOVE, NULL);
+	}
+}
@@ -5294,6 +5294,17 @@ PostgresMain(int argc, char *argv[],
 		if (Gp_role == GP_ROLE_DISPATCH)
 			GpDropTempTables();
 
+		/*
+		 * (2c) On a new session, connect the writer gang while the client
+		 * gets its first query ready, and let the idle-gang timer cover it.
+		 */
+		if (Gp_role == GP_ROLE_DISPATCH && PrewarmWriterGang() &&
+			IdleSessionGangTimeout > 0 && !idle_gang_timeout_enabled)
+		{
+			idle_gang_timeout_enabled = true;
+			enable_timeout_after(IDLE_GANG_TIMEOUT, IdleSessionGangTimeout);
+		}
+
 		/*
 		 * (3) read a command (loop blocks here)
 		 */
@@ -5412,6 +5423,7 @@ PostgresMain(int argc, char *argv[],
 					int query_string_len = 0;
 					int serializedDtxContextInfolen = 0;
 					int serializedPlantreelen = 0;
+					DispatchPlanId serializedPlantreeId;
 					int serializedQueryDispatchDesclen = 0;
 					int resgroupInfoLen = 0;
 					TimestampTz statementStart;
@@ -5461,6 +5473,11 @@ PostgresMain(int argc, char *argv[],
 
 					query_string_len = pq_getmsgint(&input_message, 4);
 					serializedPlantreelen = pq_getmsgint(&input_message, 4);
+					serializedPlantreeId.size = pq_getmsgint(&input_message, 4);
+					if (serializedPlantreeId.size != 0)
+						pq_copymsgbytes(&input_message,
+										(char *) serializedPlantreeId.digest,
+										sizeof(serializedPlantreeId.digest));
 					serializedQueryDispatchDesclen = pq_getmsgint(&input_message, 4);
 					serializedDtxContextInfolen = pq_getmsgint(&input_message, 4);
 
@@ -5499,6 +5516,41 @@ PostgresMain(int argc, char *argv[],
 					if (serializedPlantreelen > 0)
 						serializedPlantree = pq_getmsgbytes(&input_message,serializedPlantreelen);
 
+					/*
+					 * Keep a plan that the QD may ask for again by its
+					 * identity, or get the one it's asking for.  The QD only
+					 * asks for plans it knows we have, but if we don't, fail
+					 * rather than run anything else.
+					 */
+					if (serializedPlantreeId.size != 0)
+					{
+						if (serializedPlantreelen > 0)
+						{
+							if (serializedPlantreelen != serializedPlantreeId.size)
+								ereport(ERROR,
+										(errcode(ERRCODE_PROTOCOL_VIOLATION),
+										 errmsg("dispatched plan size %d does not match its cached size %d",
+												serializedPlantreelen, serializedPlantreeId.size)));
+							storeDispatchedPlan(&serializedPlantreeId,
+												serializedPlantree);
+						}
+						else
+						{
+							serializedPlantree = lookupDispatchedPlan(&serializedPlantreeId);
+#ifdef FAULT_INJECTOR
+							if (SIMPLE_FAULT_INJECTOR("dispatch_plan_cache_miss") == FaultInjectorTypeSkip)
+								serializedPlantree = NULL;
+#endif
+							if (serializedPlantree == NULL)
+								ereport(ERROR,
+										(errcode(ERRCODE_PROTOCOL_VIOLATION),
+										 errmsg("dispatched plan is not cached in this segment worker")));
+							serializedPlantreelen = serializedPlantreeId.size;
+
+							SIMPLE_FAULT_INJECTOR("dispatch_plan_cache_hit");
+						}
+					}
+
 					if (serializedQueryDispatchDesclen > 0)
 						serializedQueryDispatchDesc = pq_getmsgbytes(&input_message,serializedQueryDispatchDesclen);
 
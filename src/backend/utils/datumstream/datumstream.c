@@ -848,6 +848,10 @@ datumstreamread_open_file(DatumStreamRead * ds, char *fn, int64 eof, int64 eofUn
 
 	AppendOnlyStorageRead_OpenFile(&ds->ao_read, fn, version, ds->eof);
 
+	/* Row numbers start over in each segment file */
+	ds->blockFirstRowNum = 1;
+	ds->blockRowCount = 0;
+
 	ds->need_close_file = true;
 }
 
@@ -1423,6 +1427,58 @@ datumstreamread_find(DatumStreamRead * datumStream,
 	Assert(rowNumInBlock == DatumStreamBlockRead_Nth(&datumStream->blockRead));
 }
 
+/*
+ * Position the datum stream so that the next datumstreamread_advance()
+ * returns the row 'rowNum', or the first row after it if there is no such
+ * row. The blocks that end before it are passed over without decompressing
+ * them. Only seeks forward from the current position.
+ *
+ * Returns -1 at the end of the file, 0 otherwise.
+ */
+int
+datumstreamread_seek_row(DatumStreamRead * acc, int64 rowNum)
+{
+	/*
+	 * Read block headers until we find a block that doesn't end before the
+	 * row, skipping the contents of the others.  A freshly opened file has
+	 * no current block.
+	 */
+	while (acc->blockRowCount == 0 ||
+		   acc->blockFirstRowNum + acc->blockRowCount <= rowNum)
+	{
+		acc->blockFirstRowNum += acc->blockRowCount;
+
+		if (!AppendOnlyStorageRead_GetBlockInfo(&acc->ao_read,
+												&acc->getBlockInfo.contentLen,
+												&acc->getBlockInfo.execBlockKind,
+												&acc->getBlockInfo.firstRow,
+												&acc->getBlockInfo.rowCnt,
+												&acc->getBlockInfo.isLarge,
+												&acc->getBlockInfo.isCompressed))
+			return -1;
+
+		/* See datumstreamread_block() about pre-4.0 blocks */
+		if (acc->getBlockInfo.firstRow >= 0)
+			acc->blockFirstRowNum = acc->getBlockInfo.firstRow;
+		acc->blockFileOffset = acc->ao_read.current.headerOffsetInFile;
+		acc->blockRowCount = acc->getBlockInfo.rowCnt;
+
+		if (acc->blockFirstRowNum + acc->blockRowCount <= rowNum)
+			AppendOnlyStorageRead_SkipCurrentBlock(&acc->ao_read);
+		else
+			datumstreamread_block_content(acc);
+	}
+
+	/*
+	 * The current block holds the row or starts after it.  In the former
+	 * case, stop right before the row.
+	 */
+	if (rowNum > acc->blockFirstRowNum)
+		datumstreamread_find(acc, rowNum - acc->blockFirstRowNum - 1);
+
+	return 0;
+}
+
 /*
  * Find the block that contains the given row.
  */
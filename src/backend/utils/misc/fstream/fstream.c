@@ -181,84 +181,88 @@ fstream_get_error(fstream_t*fs)
  * server. That is because it may be inside a quote. We have to carefully parse
  * the data from the start in order to find the last unquoted newline.
  *
+ * Rather than looking at every byte, we let memchr() (which the C library
+ * vectorizes) jump to the next byte that can change the parser state: a
+ * newline or quote outside of a quoted field, and a quote or escape inside
+ * one. Everything in between is skipped in bulk.
+ *
+ * For CRLF files 'nc' is '\n' and a record only ends where it directly
+ * follows a '\r' within the scanned range.
  */
-
 static char*
-scan_csv_records_crlf(char *p, char* q, int one, fstream_t* fs)
+scan_csv_records_eol(char *p, char *q, int one, fstream_t *fs, int nc, int crlf)
 {
-	int 	in_quote = 0;
-	int 	last_was_esc = 0;
-	int 	qc = fs->options.quote;
-	int 	xc = fs->options.escape;
-	char*	last_record_loc = 0;
-	int 	ch = 0;
-	int 	lastch = 0;
+	char	   *start = p;
+	char	   *last_record_loc = 0;
+	int			qc = fs->options.quote;
+	int			xc = fs->options.escape;
+	char	   *eol = NULL;
+	bool		eol_valid = false;
 
 	while (p < q)
 	{
-		lastch = ch;
-		ch = *p++;
+		char	   *quote;
 
-		if (in_quote)
+		/*
+		 * Remember the next newline across quoted fields, so that lines with
+		 * many quoted fields don't get searched to their end repeatedly.
+		 */
+		if (!eol_valid || (eol && eol < p))
 		{
-			if (!last_was_esc)
-			{
-				if (ch == qc)
-					in_quote = 0;
-				else if (ch == xc)
-					last_was_esc = 1;
-			}
-			else
-				last_was_esc = 0;
+			eol = memchr(p, nc, q - p);
+			eol_valid = true;
 		}
-		else if (ch == '\n' && lastch == '\r')
+
+		quote = memchr(p, qc, (eol ? eol : q) - p);
+		if (quote)
 		{
-			last_record_loc = p;
-			fs->line_number++;
-			if (one)
-				break;
-		}
-		else if (ch == qc)
-			in_quote = 1;
-	}
+			char	   *close = NULL;
+			bool		close_valid = false;
 
-	return last_record_loc;
-}
+			/* skip over the quoted field, honouring escapes within it */
+			p = quote + 1;
+			for (;;)
+			{
+				char	   *esc = NULL;
 
-static char*
-scan_csv_records_cr_or_lf(char *p, char *q, int one, fstream_t *fs, int nc)
-{
-	int 	in_quote = 0;
-	int 	last_was_esc = 0;
-	int 	qc = fs->options.quote;
-	int 	xc = fs->options.escape;
-	char*	last_record_loc = 0;
+				if (!close_valid || (close && close < p))
+				{
+					close = memchr(p, qc, q - p);
+					close_valid = true;
+				}
 
-	while (p < q)
-	{
-		int ch = *p++;
+				/* with escape == quote, a doubled quote just reopens the field */
+				if (xc != qc)
+					esc = memchr(p, xc, (close ? close : q) - p);
 
-		if (in_quote)
-		{
-			if (!last_was_esc)
-			{
-				if (ch == qc)
-					in_quote = 0;
-				else if (ch == xc)
-					last_was_esc = 1;
-			}
-			else
-				last_was_esc = 0;
-		}
-		else if (ch == nc)
-		{
-			last_record_loc = p;
-			fs->line_number++;
-			if (one)
+				if (esc)
+				{
+					p = esc + 2;
+					if (p >= q)
+						return last_record_loc;
+					continue;
+				}
+
+				if (!close)
+					return last_record_loc;
+
+				p = close + 1;
 				break;
+			}
+			continue;
 		}
-		else if (ch == qc)
-			in_quote = 1;
+
+		if (!eol)
+			break;
+
+		p = eol + 1;
+		if (crlf && (eol == start || eol[-1] != '\r'))
+			continue;
+
+		last_record_loc = p;
+		fs->line_number++;
+		if (one)
+			break;
 	}
 
 	return last_record_loc;
@@ -270,12 +274,12 @@ scan_csv_records(char *p, char *q, int one, fstream_t *fs)
 	switch(fs->options.eol_type)
 	{
 		case EOL_CRNL:
-		   return scan_csv_records_crlf(p, q, one, fs);
+		   return scan_csv_records_eol(p, q, one, fs, '\n', 1);
 		case EOL_CR:
-		   return scan_csv_records_cr_or_lf(p, q, one, fs, '\r');
+		   return scan_csv_records_eol(p, q, one, fs, '\r', 0);
 		case EOL_NL:
 		default:
-		   return scan_csv_records_cr_or_lf(p, q, one, fs, '\n');
+		   return scan_csv_records_eol(p, q, one, fs, '\n', 0);
 	}
 }
 /* close the file stream */
@@ -874,7 +878,7 @@ int fstream_read(fstream_t *fs,
 			 */
 			if (fs->options.is_csv)
 			{
-				/* CSV: go slow, scan byte-by-byte for record boundary */
+				/* CSV: track quoting from the start to find the record boundary */
 				p = scan_csv_records(dest, (char*)dest + size, 0, fs);
 			}
 			else
@@ -81,6 +81,7 @@ static bool check_optimizer(bool *newval, void **extra, GucSource source);
 static bool check_verify_gpfdists_cert(bool *newval, void **extra, GucSource source);
 static bool check_dispatch_log_stats(bool *newval, void **extra, GucSource source);
 static bool check_gp_workfile_compression(bool *newval, void **extra, GucSource source);
+static bool check_gp_interconnect_compress_level(int *newval, void **extra, GucSource source);
 
 /* Helper function for guc setter */
 bool gpvars_check_gp_resqueue_priority_default_value(char **newval,
@@ -157,6 +158,7 @@ bool		gp_create_table_random_default_distribution = true;
 bool		gp_allow_non_uniform_partitioning_ddl = true;
 bool		gp_print_create_gang_time = false;
 int			dtx_phase2_retry_second = 0;
+bool		gp_enable_single_writer_one_phase_commit = false;
 
 bool gp_log_suboverflow_statement = false;
 
@@ -261,9 +263,11 @@ bool		gp_enable_multiphase_agg = true;
 bool		gp_enable_preunique = true;
 bool		gp_enable_agg_distinct = true;
 bool		gp_enable_dqa_pruning = true;
+bool		gp_enable_multi_dqa_group_redistribute = false;
 bool		gp_dynamic_partition_pruning = true;
 bool		gp_log_dynamic_partition_pruning = false;
 bool		gp_cte_sharing = false;
+bool		gp_shareinput_xslice_in_memory = false;
 bool		gp_enable_relsize_collection = false;
 bool		gp_recursive_cte = true;
 bool		gp_eager_two_phase_agg = false;
@@ -361,6 +365,9 @@ double		optimizer_damping_factor_join;
 double		optimizer_damping_factor_groupby;
 bool		optimizer_dpe_stats;
 bool		optimizer_enable_derive_stats_all_groups;
+bool		optimizer_cardinality_feedback;
+bool		optimizer_dynamic_sampling;
+int			optimizer_dynamic_sampling_rows;
 
 /* Costing related GUCs used by the Optimizer */
 int			optimizer_segments;
@@ -403,6 +410,9 @@ bool		optimizer_enable_orderedagg;
 /* Analyze related GUCs for Optimizer */
 bool		optimizer_analyze_root_partition;
 bool		optimizer_analyze_midlevel_partition;
+bool		optimizer_analyze_store_buckets = false;
+bool		gp_analyze_hll_fullscan = false;
+bool		gp_analyze_skip_unmodified_ao = false;
 
 /* GUCs for replicated table */
 bool		optimizer_replicated_table_insert;
@@ -440,6 +450,8 @@ bool		gp_external_enable_filter_pushdown = true;
 bool		gp_enable_global_deadlock_detector = false;
 
 bool		gp_log_endpoints = false;
+int			gp_endpoint_tuple_queue_size = 64;
+int			gp_endpoint_batch_size = 16;
 
 /* optional reject to  parse ambigous 5-digits date in YYYMMDD format */
 bool		gp_allow_date_field_width_5digits = false;
@@ -685,6 +697,16 @@ struct config_bool ConfigureNamesBool_gp[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"gp_enable_dispatch_plan_cache", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Let segment workers keep dispatched plans for reuse."),
+			gettext_noop("When the same plan is dispatched again to a segment worker "
+						 "that still has it, only the plan's digest is sent.")
+		},
+		&gp_enable_dispatch_plan_cache,
+		false,
+		NULL, NULL, NULL
+	},
 	{
 		{"gp_enable_predicate_propagation", PGC_USERSET, QUERY_TUNING_OTHER,
 			gettext_noop("When two expressions are equivalent (such as with "
@@ -775,6 +797,16 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_enable_multi_dqa_group_redistribute", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Compute multiple distinct-qualified aggregates with GROUP BY after a single redistribution on the grouping keys."),
+			NULL,
+		},
+		&gp_enable_multi_dqa_group_redistribute,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_enable_explain_allstat", PGC_USERSET, CLIENT_CONN_OTHER,
 			gettext_noop("Experimental feature: dump stats for all segments in EXPLAIN ANALYZE."),
@@ -796,6 +828,41 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_enable_parallel_ao_scan", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enable parallel scans of append-optimized tables on the segments."),
+			gettext_noop("Lets the Postgres planner divide the scan of an append-optimized "
+						 "table among max_parallel_workers_per_gather workers on each segment.")
+		},
+		&gp_enable_parallel_ao_scan,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_enable_radix_sort", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enable radix sorting on integer leading sort keys."),
+			gettext_noop("Large sorts whose first key is a smallint, integer or bigint "
+						 "are sorted by distributing the rows on the key's bytes, "
+						 "instead of by comparisons.")
+		},
+		&gp_enable_radix_sort,
+		true,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_enable_window_agg_combine", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enable sliding window frames with the aggregate's combine function."),
+			gettext_noop("Aggregates without an inverse transition function, such as "
+						 "MIN and MAX, are otherwise recomputed over the whole frame "
+						 "for every row, when the frame start moves.")
+		},
+		&gp_enable_window_agg_combine,
+		true,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_explain_jit", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Enables JIT instrumentation output for EXPLAIN"),
@@ -883,6 +950,18 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_enable_single_writer_one_phase_commit", PGC_USERSET, GP_ARRAY_TUNING,
+			gettext_noop("Use one-phase commit when only one segment changed data."),
+			gettext_noop("A distributed transaction is prepared on the segments only "
+						 "if more than one of them wrote WAL for it."),
+			GUC_NOT_IN_SAMPLE
+		},
+		&gp_enable_single_writer_one_phase_commit,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_enable_slow_writer_testmode", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Slow down writer gangs -- to facilitate race-condition testing."),
@@ -1753,6 +1832,17 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_shareinput_xslice_in_memory", PGC_USERSET, RESOURCES_MEM,
+			gettext_noop("Shares the result of a cross-slice ShareInputScan through shared memory when it fits in the operator memory."),
+			gettext_noop("Otherwise, and when this is off, the result is shared through a temporary file."),
+			GUC_NOT_IN_SAMPLE
+		},
+		&gp_shareinput_xslice_in_memory,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_enable_relsize_collection", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("This guc enables relsize collection when stats are not present. If disabled and stats are not present a default "
@@ -1808,6 +1898,18 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_prewarm_writer_gang", PGC_USERSET, GP_ARRAY_TUNING,
+			gettext_noop("Connect the writer gang as soon as a session starts."),
+			gettext_noop("The segment workers are created while the client is "
+						 "preparing its first query, instead of by that query."),
+			GUC_NOT_IN_SAMPLE
+		},
+		&gp_prewarm_writer_gang,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_recursive_cte_prototype", PGC_USERSET, DEPRECATED_OPTIONS,
 			gettext_noop("Enable RECURSIVE clauses in CTE queries (deprecated option, use \"gp_recursive_cte\" instead)."),
@@ -2068,6 +2170,16 @@ struct config_bool ConfigureNamesBool_gp[] =
 		false,
 		NULL, NULL, NULL
 	},
+	{
+		{"optimizer_cardinality_feedback", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Correct the optimizer's join cardinality estimates with row counts observed by EXPLAIN ANALYZE."),
+			NULL,
+			GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_cardinality_feedback,
+		false,
+		NULL, NULL, NULL
+	},
 	{
 		{"optimizer_dpe_stats", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Enable statistics derivation for partitioned tables with dynamic partition elimination."),
@@ -2078,6 +2190,16 @@ struct config_bool ConfigureNamesBool_gp[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"optimizer_dynamic_sampling", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Sample tables with missing or stale statistics while optimizing a query."),
+			NULL,
+			GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_dynamic_sampling,
+		false,
+		NULL, NULL, NULL
+	},
 	{
 		{"optimizer_enable_nljoin", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Enable nested loops join plans in the optimizer."),
@@ -2592,6 +2714,37 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_analyze_store_buckets", PGC_USERSET, STATS_ANALYZE,
+			gettext_noop("Store the column statistics GPORCA plans with during ANALYZE, so that it does not rebuild them from the MCVs and histogram."),
+			NULL,
+			GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_analyze_store_buckets,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_analyze_hll_fullscan", PGC_USERSET, STATS_ANALYZE,
+			gettext_noop("Estimate the number of distinct values of a column from a HyperLogLog counter over the whole table during ANALYZE, as ANALYZE FULLSCAN does."),
+			NULL
+		},
+		&gp_analyze_hll_fullscan,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_analyze_skip_unmodified_ao", PGC_USERSET, STATS_ANALYZE,
+			gettext_noop("Skip append-optimized tables that have not been modified since they were last analyzed during ANALYZE."),
+			gettext_noop("Partitioned tables only sample their modified leaf partitions again, and merge the statistics of the others.")
+		},
+		&gp_analyze_skip_unmodified_ao,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_enable_constant_expression_evaluation", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Enable constant expression evaluation in the optimizer"),
@@ -2937,8 +3090,8 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 	{
-		{"optimizer_enable_eageragg", PGC_USERSET, DEVELOPER_OPTIONS,
-			gettext_noop("Enable Eager Agg transform for pushing aggregate below an innerjoin."),
+		{"optimizer_enable_eageragg", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enable Eager Agg transform for pushing aggregate below an inner or left outer join."),
 			NULL,
 			GUC_NOT_IN_SAMPLE
 		},
@@ -3454,6 +3607,16 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_interconnect_compress_level", PGC_USERSET, GP_ARRAY_TUNING,
+			gettext_noop("Sets the zstd compression level for data sent by motions through the interconnect."),
+			gettext_noop("0 disables compression.")
+		},
+		&Gp_interconnect_compress_level,
+		0, 0, 19,
+		check_gp_interconnect_compress_level, NULL, NULL
+	},
+
 	{
 		{"gp_interconnect_snd_queue_depth", PGC_USERSET, GP_ARRAY_TUNING,
 			gettext_noop("Sets the maximum size of the send queue for each connection in the UDP interconnect"),
@@ -4208,6 +4371,17 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_dynamic_sampling_rows", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Sets the number of rows sampled from a table by optimizer_dynamic_sampling."),
+			NULL,
+			GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_dynamic_sampling_rows,
+		3000, 100, 1000000,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_mdcache_size", PGC_USERSET, RESOURCES_MEM,
 			gettext_noop("Sets the size of MDCache."),
@@ -4370,6 +4544,29 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_endpoint_tuple_queue_size", PGC_USERSET, RESOURCES_MEM,
+			gettext_noop("Sets the size of the shared memory queue of each PARALLEL RETRIEVE CURSOR endpoint."),
+			gettext_noop("A larger queue lets an endpoint run further ahead of its retrieve session."),
+			GUC_UNIT_KB | GUC_NOT_IN_SAMPLE
+		},
+		&gp_endpoint_tuple_queue_size,
+		64, 64, MAX_KILOBYTES,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"gp_endpoint_batch_size", PGC_USERSET, RESOURCES_MEM,
+			gettext_noop("Sets how much tuple data a PARALLEL RETRIEVE CURSOR endpoint sends in one message."),
+			gettext_noop("Tuples are held back until a batch is full or the query ends. "
+						 "0 sends every tuple on its own."),
+			GUC_UNIT_KB | GUC_NOT_IN_SAMPLE
+		},
+		&gp_endpoint_batch_size,
+		16, 0, MAX_KILOBYTES,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_max_parallel_cursors", PGC_SUSET, RESOURCES,
 			gettext_noop("Parallel cursor concurrency control, -1 means no limit, which is the default"),
@@ -5340,6 +5537,19 @@ check_gp_workfile_compression(bool *newval, void **extra, GucSource source)
 	return true;
 }
 
+static bool
+check_gp_interconnect_compress_level(int *newval, void **extra, GucSource source)
+{
+#ifndef USE_ZSTD
+	if (*newval > 0)
+	{
+		GUC_check_errmsg("interconnect compression is not supported by this build");
+		return false;
+	}
+#endif
+	return true;
+}
+
 void
 DispatchSyncPGVariable(struct config_generic * gconfig)
 {
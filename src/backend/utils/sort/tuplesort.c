@@ -101,6 +101,8 @@
 #include "access/nbtree.h"
 #include "catalog/index.h"
 #include "catalog/pg_am.h"
+#include "catalog/pg_opfamily.h"
+#include "cdb/cdbvars.h"
 #include "commands/tablespace.h"
 #include "executor/executor.h"
 #include "miscadmin.h"
@@ -132,6 +134,13 @@
 #ifdef TRACE_SORT
 bool		trace_sort = false;
 #endif
+bool		gp_enable_radix_sort = true;
+
+/*
+ * Below this many tuples, radix_sort_tuples() leaves a group of tuples to the
+ * comparison sort.
+ */
+#define RADIX_SORT_MIN_TUPLES	1024
 
 #ifdef DEBUG_BOUNDED_SORT
 bool		optimize_bounded_sort = true;
@@ -423,6 +432,12 @@ struct Tuplesortstate
 	 */
 	SortSupport onlyKey;
 
+	/*
+	 * If the leading sort key is a signed integer that datum1 holds as is,
+	 * its width in bytes, to allow radix_sort_tuples().  Otherwise 0.
+	 */
+	int			radixKeyWidth;
+
 	/*
 	 * Additional state for managing "abbreviated key" sortsupport routines
 	 * (which currently may be used by all cases except the hash index case).
@@ -663,6 +678,11 @@ static void worker_freeze_result_tape(Tuplesortstate *state);
 static void worker_nomergeruns(Tuplesortstate *state);
 static void leader_takeover_tapes(Tuplesortstate *state);
 static void free_sort_tuple(Tuplesortstate *state, SortTuple *stup);
+static int	radix_sort_key_width(SortSupport sortKey, Oid sortOperator);
+static void radix_sort_tuples(Tuplesortstate *state, SortTuple *tuples, int n,
+							  int byte);
+static void sort_tuples_by_comparison(Tuplesortstate *state,
+									  SortTuple *tuples, int n);
 
 /*
  * Special versions of qsort just for SortTuple objects.  qsort_tuple() sorts
@@ -970,6 +990,9 @@ tuplesort_begin_heap(TupleDesc tupDesc,
 	if (nkeys == 1 && !state->sortKeys->abbrev_converter)
 		state->onlyKey = state->sortKeys;
 
+	state->radixKeyWidth = radix_sort_key_width(state->sortKeys,
+												sortOperators[0]);
+
 	MemoryContextSwitchTo(oldcontext);
 
 	return state;
@@ -1266,6 +1289,8 @@ tuplesort_begin_datum(Oid datumType, Oid sortOperator, Oid sortCollation,
 	if (!state->sortKeys->abbrev_converter)
 		state->onlyKey = state->sortKeys;
 
+	state->radixKeyWidth = radix_sort_key_width(state->sortKeys, sortOperator);
+
 	MemoryContextSwitchTo(oldcontext);
 
 	return state;
@@ -3528,15 +3553,228 @@ tuplesort_sort_memtuples(Tuplesortstate *state)
 
 	if (state->memtupcount > 1)
 	{
-		/* Can we use the single-key sort function? */
-		if (state->onlyKey != NULL)
-			qsort_ssup(state->memtuples, state->memtupcount,
-					   state->onlyKey);
+		/* Can we radix sort on the leading key? */
+		if (gp_enable_radix_sort && state->radixKeyWidth > 0 &&
+			state->memtupcount >= RADIX_SORT_MIN_TUPLES)
+		{
+			SortTuple  *memtuples = state->memtuples;
+			int			nnull = 0;
+			int			i;
+
+			/*
+			 * Move the tuples with a NULL leading key to the front, and then
+			 * to the back if that's where they belong.
+			 */
+			for (i = 0; i < state->memtupcount; i++)
+			{
+				if (memtuples[i].isnull1)
+				{
+					SortTuple	tmp = memtuples[nnull];
+
+					memtuples[nnull++] = memtuples[i];
+					memtuples[i] = tmp;
+				}
+			}
+			if (nnull > 0 && !state->sortKeys->ssup_nulls_first)
+			{
+				int			nnotnull = state->memtupcount - nnull;
+
+				for (i = 0; i < Min(nnull, nnotnull); i++)
+				{
+					SortTuple	tmp = memtuples[i];
+
+					memtuples[i] = memtuples[state->memtupcount - 1 - i];
+					memtuples[state->memtupcount - 1 - i] = tmp;
+				}
+				memtuples += nnotnull;
+			}
+
+			/* The NULLs may still need sorting on the other keys */
+			if (nnull > 1 && state->onlyKey == NULL)
+				qsort_tuple(memtuples, nnull, state->comparetup, state);
+
+			if (state->sortKeys->ssup_nulls_first)
+				memtuples += nnull;
+			else
+				memtuples = state->memtuples;
+
+			radix_sort_tuples(state, memtuples, state->memtupcount - nnull,
+							  state->radixKeyWidth - 1);
+		}
 		else
-			qsort_tuple(state->memtuples,
-						state->memtupcount,
-						state->comparetup,
-						state);
+			sort_tuples_by_comparison(state, state->memtuples,
+									  state->memtupcount);
+	}
+}
+
+/*
+ * Sort tuples using the comparator.
+ */
+static void
+sort_tuples_by_comparison(Tuplesortstate *state, SortTuple *tuples, int n)
+{
+	/* Can we use the single-key sort function? */
+	if (state->onlyKey != NULL)
+		qsort_ssup(tuples, n, state->onlyKey);
+	else
+		qsort_tuple(tuples, n, state->comparetup, state);
+}
+
+/*
+ * Radix sort
+ *
+ * Sorting on the integer leading key of a large number of tuples is a lot
+ * cheaper by distributing them on its bytes than by comparisons, which call
+ * the comparator through a function pointer and, for MinimalTuples, usually
+ * need tie-breaking on the other keys anyway.
+ *
+ * This is an in-place MSD radix sort ("American flag sort"), so that it needs
+ * no memory beyond the memtuples array, which matters as it's also used to
+ * sort each run before writing it out, when work_mem is exhausted.  Groups
+ * of tuples that get small fall back to the comparison sort, and so do groups
+ * with equal leading keys, when there are more sort keys.
+ */
+
+/*
+ * Return the width of the leading key, if radix_sort_tuples() can be used on
+ * it.  That's the case for the built-in signed integer types, which are
+ * passed by value, don't use abbreviated keys, and are ordered numerically by
+ * their standard btree operator family.
+ */
+static int
+radix_sort_key_width(SortSupport sortKey, Oid sortOperator)
+{
+	Oid			opfamily;
+	Oid			opcintype;
+	int16		strategy;
+	int16		typlen;
+	bool		typbyval;
+
+	if (sortKey->abbrev_converter)
+		return 0;
+
+	if (!get_ordering_op_properties(sortOperator,
+									&opfamily, &opcintype, &strategy))
+		return 0;
+	if (opfamily != INTEGER_BTREE_FAM_OID)
+		return 0;
+
+	get_typlenbyval(opcintype, &typlen, &typbyval);
+	if (!typbyval || (typlen != 2 && typlen != 4 && typlen != 8))
+		return 0;
+
+	return typlen;
+}
+
+/*
+ * Map the leading key of a tuple to an unsigned integer that sorts in the
+ * order of the sort, and return its byte number 'byte'.
+ */
+static inline int
+radix_sort_key_byte(Tuplesortstate *state, SortTuple *stup, int byte)
+{
+	int			width = state->radixKeyWidth;
+	int64		value;
+	uint64		key;
+
+	switch (width)
+	{
+		case 2:
+			value = DatumGetInt16(stup->datum1);
+			break;
+		case 4:
+			value = DatumGetInt32(stup->datum1);
+			break;
+		default:
+			value = DatumGetInt64(stup->datum1);
+			break;
+	}
+
+	/* Shift the value range to start at 0 */
+	key = (uint64) value + (UINT64CONST(1) << (width * BITS_PER_BYTE - 1));
+	if (state->sortKeys->ssup_reverse)
+		key = ~key;
+
+	return (key >> (byte * BITS_PER_BYTE)) & 0xFF;
+}
+
+static void
+radix_sort_tuples(Tuplesortstate *state, SortTuple *tuples, int n, int byte)
+{
+	int			counts[256];
+	int			offsets[256];
+	int			ends[256];
+	int			b;
+	int			i;
+
+	for (;;)
+	{
+		if (n < RADIX_SORT_MIN_TUPLES)
+		{
+			if (n > 1)
+				sort_tuples_by_comparison(state, tuples, n);
+			return;
+		}
+
+		memset(counts, 0, sizeof(counts));
+		for (i = 0; i < n; i++)
+			counts[radix_sort_key_byte(state, &tuples[i], byte)]++;
+
+		/* If all tuples share this byte, go on to the next one */
+		if (counts[radix_sort_key_byte(state, &tuples[0], byte)] < n)
+			break;
+		if (byte == 0)
+		{
+			/* All the leading keys are equal */
+			if (state->onlyKey == NULL)
+				qsort_tuple(tuples, n, state->comparetup, state);
+			return;
+		}
+		byte--;
+	}
+
+	offsets[0] = 0;
+	for (b = 0; b < 256; b++)
+	{
+		if (b > 0)
+			offsets[b] = ends[b - 1];
+		ends[b] = offsets[b] + counts[b];
+	}
+
+	/*
+	 * Move every tuple to its group, following each cycle of displaced tuples
+	 * until it comes back to the group where it started.
+	 */
+	for (b = 0; b < 256; b++)
+	{
+		while (offsets[b] < ends[b])
+		{
+			SortTuple	stup = tuples[offsets[b]];
+			int			sb = radix_sort_key_byte(state, &stup, byte);
+
+			while (sb != b)
+			{
+				SortTuple	tmp = tuples[offsets[sb]];
+
+				tuples[offsets[sb]++] = stup;
+				stup = tmp;
+				sb = radix_sort_key_byte(state, &stup, byte);
+			}
+			tuples[offsets[b]++] = stup;
+		}
+	}
+
+	CHECK_FOR_INTERRUPTS();
+
+	/* Sort each group on the remaining bytes */
+	for (b = 0, i = 0; b < 256; i += counts[b], b++)
+	{
+		if (counts[b] <= 1)
+			continue;
+		if (byte > 0)
+			radix_sort_tuples(state, tuples + i, counts[b], byte - 1);
+		else if (state->onlyKey == NULL)
+			qsort_tuple(tuples + i, counts[b], state->comparetup, state);
 	}
 }
 
@@ -60,6 +60,14 @@
  * as many times as you want, in different processes, until it is destroyed
  * by the original writer process by calling tuplestore_end().
  *
+ * If tuplestore_make_shared_lazy() is used instead of
+ * tuplestore_make_shared(), the tuples are kept in memory until they exceed
+ * the tuplestore's memory limit, and the file is only created then. If they
+ * are still in memory when the writer is done, it may copy them to shared
+ * memory with tuplestore_export_shared_mem() instead of freezing the
+ * tuplestore, and the other processes read them from there with
+ * tuplestore_open_shared_mem(), without going through a file at all.
+ *
  * Note that tuplestore doesn't do any synchronization across processes!
  * It is up to the calling code to do the freezing, opening for reading, and
  * destroying the tuplestore in the right order!
@@ -84,6 +92,7 @@
 #include "executor/executor.h"
 #include "miscadmin.h"
 #include "storage/buffile.h"
+#include "storage/shmem.h"
 #include "utils/memutils.h"
 #include "utils/resowner.h"
 
@@ -150,6 +159,7 @@ struct Tuplestorestate
 
 	TSSharedStatus share_status;
 	bool		frozen;
+	bool		memtuples_borrowed;	/* tuples are in shared memory, not ours */
 	SharedFileSet *fileset;
 	char	   *shared_filename;
 	workfile_set *work_set; /* workfile set to use when using workfile manager */
@@ -294,6 +304,7 @@ static unsigned int getlen(Tuplestorestate *state, bool eofOK);
 static void *copytup_heap(Tuplestorestate *state, void *tup);
 static void writetup_heap(Tuplestorestate *state, void *tup);
 static void *readtup_heap(Tuplestorestate *state, unsigned int len);
+static void tuplestore_create_shared_file(Tuplestorestate *state);
 
 
 char *
@@ -482,7 +493,7 @@ tuplestore_clear(Tuplestorestate *state)
 	if (state->myfile)
 		BufFileClose(state->myfile);
 	state->myfile = NULL;
-	if (state->memtuples)
+	if (state->memtuples && !state->memtuples_borrowed)
 	{
 		for (i = state->memtupdeleted; i < state->memtupcount; i++)
 		{
@@ -511,6 +522,7 @@ tuplestore_clear(Tuplestorestate *state)
 void
 tuplestore_end(Tuplestorestate *state)
 {
+	bool		had_file = (state->myfile != NULL);
 	int			i;
 
 	/*
@@ -539,7 +551,8 @@ tuplestore_end(Tuplestorestate *state)
 
 	if (state->myfile)
 		BufFileClose(state->myfile);
-	if (state->share_status == TSHARE_WRITER)
+	/* a lazily shared tuplestore may never have created its file */
+	if (state->share_status == TSHARE_WRITER && had_file)
 		BufFileDeleteShared(state->fileset, state->shared_filename);
 	if (state->work_set)
 		workfile_mgr_close_set(state->work_set);
@@ -547,8 +560,11 @@ tuplestore_end(Tuplestorestate *state)
 		pfree(state->shared_filename);
 	if (state->memtuples)
 	{
-		for (i = state->memtupdeleted; i < state->memtupcount; i++)
-			pfree(state->memtuples[i]);
+		if (!state->memtuples_borrowed)
+		{
+			for (i = state->memtupdeleted; i < state->memtupcount; i++)
+				pfree(state->memtuples[i]);
+		}
 		pfree(state->memtuples);
 	}
 	pfree(state->readptrs);
@@ -902,8 +918,19 @@ tuplestore_puttuple_common(Tuplestorestate *state, void *tuple)
 				return;
 
 			/*
-			 * Nope; time to switch to tape-based operation.  Make sure that
-			 * the temp file(s) are created in suitable temp tablespaces.
+			 * Nope; time to switch to tape-based operation. A lazily shared
+			 * tuplestore switches to the file it shares.
+			 */
+			if (state->share_status == TSHARE_WRITER)
+			{
+				tuplestore_create_shared_file(state);
+				dumptuples(state);
+				break;
+			}
+
+			/*
+			 * Make sure that the temp file(s) are created in suitable temp
+			 * tablespaces.
 			 */
 			PrepareTempTablespaces();
 
@@ -1692,8 +1719,28 @@ tuplestore_set_instrument(Tuplestorestate *state,
 void
 tuplestore_make_shared(Tuplestorestate *state, SharedFileSet *fileset, const char *filename)
 {
-	ResourceOwner oldowner;
+	tuplestore_make_shared_lazy(state, fileset, filename);
 
+	/*
+	 * Switch to tape-based operation, like in tuplestore_puttuple_common().
+	 * We could delay this until tuplestore_freeze(), but we know we'll have
+	 * to write everything to the file anyway, so let's not waste memory
+	 * buffering the tuples in the meanwhile.
+	 */
+	tuplestore_create_shared_file(state);
+}
+
+/*
+ * tuplestore_make_shared_lazy
+ *
+ * Like tuplestore_make_shared(), but keep the tuples in memory for as long
+ * as they fit in the tuplestore's memory limit, and only create the shared
+ * file when they no longer do.
+ */
+void
+tuplestore_make_shared_lazy(Tuplestorestate *state, SharedFileSet *fileset,
+							const char *filename)
+{
 	state->work_set = workfile_mgr_create_set("SharedTupleStore", filename, true /* hold pin */);
 
 	Assert(state->status == TSS_INMEM);
@@ -1702,20 +1749,27 @@ tuplestore_make_shared(Tuplestorestate *state, SharedFileSet *fileset, const cha
 	state->share_status = TSHARE_WRITER;
 	state->fileset = fileset;
 	state->shared_filename = pstrdup(filename);
+}
+
+/*
+ * Create the file of a shared tuplestore, and switch to writing to it.
+ */
+static void
+tuplestore_create_shared_file(Tuplestorestate *state)
+{
+	ResourceOwner oldowner;
+
+	Assert(state->share_status == TSHARE_WRITER);
+	Assert(state->myfile == NULL);
 
-	/*
-	 * Switch to tape-based operation, like in tuplestore_puttuple_common().
-	 * We could delay this until tuplestore_freeze(), but we know we'll have
-	 * to write everything to the file anyway, so let's not waste memory
-	 * buffering the tuples in the meanwhile.
-	 */
 	PrepareTempTablespaces();
 
 	/* associate the file with the store's resource owner */
 	oldowner = CurrentResourceOwner;
 	CurrentResourceOwner = state->resowner;
 
-	state->myfile = BufFileCreateShared(fileset, filename, state->work_set);
+	state->myfile = BufFileCreateShared(state->fileset, state->shared_filename,
+										state->work_set);
 	CurrentResourceOwner = oldowner;
 
 	/*
@@ -1745,6 +1799,11 @@ tuplestore_freeze(Tuplestorestate *state)
 {
 	Assert(state->share_status == TSHARE_WRITER);
 	Assert(!state->frozen);
+
+	/* a lazily shared tuplestore needs its file now */
+	if (state->status == TSS_INMEM)
+		tuplestore_create_shared_file(state);
+
 	dumptuples(state);
 	BufFileExportShared(state->myfile);
 	state->frozen = true;
@@ -1786,3 +1845,104 @@ tuplestore_open_shared(SharedFileSet *fileset, const char *filename)
 
 	return state;
 }
+
+/*
+ * tuplestore_shared_mem_size
+ *
+ * Return the amount of shared memory that tuplestore_export_shared_mem()
+ * needs for the tuples of a lazily shared tuplestore that is still in
+ * memory.
+ */
+Size
+tuplestore_shared_mem_size(Tuplestorestate *state)
+{
+	Size		size;
+	int			i;
+
+	Assert(state->share_status == TSHARE_WRITER);
+	Assert(state->status == TSS_INMEM);
+
+	size = MAXALIGN(sizeof(int));
+	for (i = state->memtupdeleted; i < state->memtupcount; i++)
+		size = add_size(size, MAXALIGN(((MinimalTuple) state->memtuples[i])->t_len));
+
+	return size;
+}
+
+/*
+ * tuplestore_export_shared_mem
+ *
+ * Copy the tuples of a lazily shared tuplestore that is still in memory to
+ * 'dest', which must be tuplestore_shared_mem_size() bytes of shared memory.
+ * This takes the place of tuplestore_freeze(); no new rows may be added
+ * afterwards.
+ */
+void
+tuplestore_export_shared_mem(Tuplestorestate *state, void *dest)
+{
+	char	   *p = (char *) dest;
+	int			i;
+
+	Assert(state->share_status == TSHARE_WRITER);
+	Assert(state->status == TSS_INMEM);
+	Assert(!state->frozen);
+
+	*(int *) p = state->memtupcount - state->memtupdeleted;
+	p += MAXALIGN(sizeof(int));
+
+	for (i = state->memtupdeleted; i < state->memtupcount; i++)
+	{
+		MinimalTuple tuple = (MinimalTuple) state->memtuples[i];
+
+		memcpy(p, tuple, tuple->t_len);
+		p += MAXALIGN(tuple->t_len);
+	}
+
+	state->frozen = true;
+}
+
+/*
+ * tuplestore_open_shared_mem
+ *
+ * Open for reading the tuples that tuplestore_export_shared_mem() copied to
+ * 'src'. The tuples are read in place, so 'src' must stay mapped until the
+ * tuplestore is ended.
+ */
+Tuplestorestate *
+tuplestore_open_shared_mem(void *src)
+{
+	Tuplestorestate *state;
+	char	   *p = (char *) src;
+	int			ntuples;
+	int			i;
+
+	state = tuplestore_begin_common(EXEC_FLAG_BACKWARD | EXEC_FLAG_REWIND,
+									false /* interXact */,
+									10 /* no need for memory buffers */);
+
+	state->copytup = copytup_heap;
+	state->writetup = writetup_forbidden;
+	state->readtup = readtup_heap;
+
+	ntuples = *(int *) p;
+	p += MAXALIGN(sizeof(int));
+
+	pfree(state->memtuples);
+	state->memtuples = (void **) MemoryContextAllocHuge(state->context,
+														Max(ntuples, 1) * sizeof(void *));
+	state->memtupsize = Max(ntuples, 1);
+	state->growmemtuples = false;
+	for (i = 0; i < ntuples; i++)
+	{
+		state->memtuples[i] = p;
+		p += MAXALIGN(((MinimalTuple) p)->t_len);
+	}
+	state->memtupcount = ntuples;
+	state->memtuples_borrowed = true;
+	state->tuples = ntuples;
+
+	state->share_status = TSHARE_READER;
+	state->frozen = true;
+
+	return state;
+}
@@ -253,6 +253,9 @@ typedef struct SerializedSnapshotData
 	CommandId	curcid;
 	TimestampTz whenTaken;
 	XLogRecPtr	lsn;
+	/* GPDB: the distributed snapshot, if any, follows the XID arrays */
+	bool		haveDistribSnapshot;
+	int32		dscount;
 } SerializedSnapshotData;
 
 Size
@@ -2296,6 +2299,9 @@ EstimateSnapshotSpace(Snapshot snap)
 		(!snap->suboverflowed || snap->takenDuringRecovery))
 		size = add_size(size,
 						mul_size(snap->subxcnt, sizeof(TransactionId)));
+	if (snap->haveDistribSnapshot)
+		size = add_size(size,
+						DistributedSnapshot_SerializeSize(&snap->distribSnapshotWithLocalMapping.ds));
 
 	return size;
 }
@@ -2322,6 +2328,9 @@ SerializeSnapshot(Snapshot snapshot, char *start_address)
 	serialized_snapshot.curcid = snapshot->curcid;
 	serialized_snapshot.whenTaken = snapshot->whenTaken;
 	serialized_snapshot.lsn = snapshot->lsn;
+	serialized_snapshot.haveDistribSnapshot = snapshot->haveDistribSnapshot;
+	serialized_snapshot.dscount = snapshot->haveDistribSnapshot ?
+		snapshot->distribSnapshotWithLocalMapping.ds.count : 0;
 
 	/*
 	 * Ignore the SubXID array if it has overflowed, unless the snapshot was
@@ -2355,6 +2364,19 @@ SerializeSnapshot(Snapshot snapshot, char *start_address)
 		memcpy((TransactionId *) (start_address + subxipoff),
 			   snapshot->subxip, snapshot->subxcnt * sizeof(TransactionId));
 	}
+
+	/*
+	 * GPDB: Copy the distributed snapshot, so that parallel workers on a
+	 * segment judge visibility the same way as the QE that launched them.
+	 */
+	if (serialized_snapshot.haveDistribSnapshot)
+	{
+		Size		dsoff = sizeof(SerializedSnapshotData) +
+		(snapshot->xcnt + serialized_snapshot.subxcnt) * sizeof(TransactionId);
+
+		DistributedSnapshot_Serialize(&snapshot->distribSnapshotWithLocalMapping.ds,
+									  start_address + dsoff);
+	}
 }
 
 /*
@@ -2369,8 +2391,10 @@ RestoreSnapshot(char *start_address)
 {
 	SerializedSnapshotData serialized_snapshot;
 	Size		size;
+	Size		dsoff;
 	Snapshot	snapshot;
 	TransactionId *serialized_xids;
+	DistributedSnapshotWithLocalMapping *dslm;
 
 	memcpy(&serialized_snapshot, start_address,
 		   sizeof(SerializedSnapshotData));
@@ -2378,9 +2402,11 @@ RestoreSnapshot(char *start_address)
 		(start_address + sizeof(SerializedSnapshotData));
 
 	/* We allocate any XID arrays needed in the same palloc block. */
-	size = sizeof(SnapshotData)
+	size = dsoff = sizeof(SnapshotData)
 		+ serialized_snapshot.xcnt * sizeof(TransactionId)
 		+ serialized_snapshot.subxcnt * sizeof(TransactionId);
+	size += serialized_snapshot.dscount *
+		(sizeof(DistributedTransactionId) + sizeof(TransactionId));
 
 	/* Copy all required fields */
 	snapshot = (Snapshot) MemoryContextAlloc(TopTransactionContext, size);
@@ -2414,6 +2440,27 @@ RestoreSnapshot(char *start_address)
 			   serialized_snapshot.subxcnt * sizeof(TransactionId));
 	}
 
+	/*
+	 * GPDB: Restore the distributed snapshot, if present. The cache of
+	 * distributed to local XID mappings starts out empty.
+	 */
+	dslm = &snapshot->distribSnapshotWithLocalMapping;
+	MemSet(dslm, 0, sizeof(DistributedSnapshotWithLocalMapping));
+	snapshot->haveDistribSnapshot = serialized_snapshot.haveDistribSnapshot;
+	if (serialized_snapshot.dscount > 0)
+	{
+		dslm->ds.inProgressXidArray =
+			(DistributedTransactionId *) ((char *) snapshot + dsoff);
+		dslm->inProgressMappedLocalXids = (TransactionId *)
+			((char *) snapshot + dsoff +
+			 serialized_snapshot.dscount * sizeof(DistributedTransactionId));
+	}
+	if (serialized_snapshot.haveDistribSnapshot)
+		DistributedSnapshot_Deserialize((char *) (serialized_xids +
+												  serialized_snapshot.xcnt +
+												  serialized_snapshot.subxcnt),
+										&dslm->ds);
+
 	/* Set the copied flag so that the caller will set refcounts correctly. */
 	snapshot->regd_count = 0;
 	snapshot->active_count = 0;
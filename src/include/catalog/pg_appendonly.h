@@ -31,6 +31,11 @@ CATALOG(pg_appendonly,6105,AppendOnlyRelationId)
     Oid             blkdirrelid;        /* OID of aoblkdir table; 0 if none */
 	Oid             visimaprelid;		/* OID of the aovisimap table */
 	int16			version;			/* AO relation version */
+	int64			analyzemodcount;	/* total modcount of the segfiles when
+										 * last analyzed; -1 if unknown */
+	int32			analyzestatsig;		/* signature of the statistics targets,
+										 * extended statistics and expression
+										 * indexes when last analyzed */
 } FormData_pg_appendonly;
 
 /* GPDB added foreign key definitions for gpcheckcat. */
@@ -41,7 +46,7 @@ FOREIGN_KEY(relid REFERENCES pg_class(oid));
  * (there are no var-length fields currentl.)
 */
 #define APPENDONLY_TUPLE_SIZE \
-	 (offsetof(FormData_pg_appendonly,version) + sizeof(Oid))
+	 (offsetof(FormData_pg_appendonly,analyzestatsig) + sizeof(int32))
 
 /* ----------------
 *		Form_pg_appendonly corresponds to a pointer to a tuple with
@@ -158,6 +163,10 @@ UpdateAppendOnlyEntryAuxOids(Oid relid,
 							 Oid newBlkdirrelid,
 							 Oid newVisimaprelid);
 
+extern void
+UpdateAppendOnlyEntryAnalyzeModCount(Oid relid, int64 analyzemodcount,
+									 int32 analyzestatsig);
+
 extern void
 RemoveAppendonlyEntry(Oid relid);
 
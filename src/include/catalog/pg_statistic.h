@@ -294,6 +294,16 @@ typedef FormData_pg_statistic *Form_pg_statistic;
  */
 #define STATISTIC_KIND_FULLHLL  98
 
+/*
+ * An "ORCA buckets" slot stores the column's MCVs and histogram already
+ * converted into the buckets GPORCA estimates with, so that the optimizer
+ * does not redo that conversion each time it loads the column's statistics.
+ * It is added by ANALYZE when optimizer_analyze_store_buckets is on.
+ * stavalues holds a single bytea whose layout is private to GPORCA, and
+ * stanumbers is null.
+ */
+#define STATISTIC_KIND_ORCA_BUCKETS  97
+
 #endif							/* EXPOSE_TO_CLIENT_CODE */
 
 #endif							/* PG_STATISTIC_H */
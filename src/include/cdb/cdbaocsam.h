@@ -238,6 +238,10 @@ typedef struct AOCSScanDescData
 	int32					 total_seg;
 	int32					 cur_seg;
 
+	/* row number range of the current segfile claimed in a parallel scan */
+	int64					 parallel_startrow;
+	int64					 parallel_endrow;
+
 	/*
 	 * The only relation wide Storage Option, the rest are aquired in a per
 	 * column basis and there is no need to keep track of.
@@ -193,6 +193,10 @@ typedef struct AppendOnlyScanDescData
 	FileSegInfo **aos_segfile_arr;	/* array of all segfiles information */
 	bool		aos_need_new_segfile;
 	bool		aos_done_all_segfiles;
+
+	/* row number range of the current segfile claimed in a parallel scan */
+	int64		aos_parallel_startrow;
+	int64		aos_parallel_endrow;
 	
 	MemoryContext	aoScanInitContext; /* mem context at init time */
 
@@ -287,6 +291,31 @@ typedef struct AppendOnlyScanDescData
 
 typedef AppendOnlyScanDescData *AppendOnlyScanDesc;
 
+/*
+ * Shared state for parallel scans of append-optimized tables, both row and
+ * column oriented.
+ *
+ * Every participant builds the same segfile array (sorted by segno, under the
+ * shared snapshot). The segment files are scanned one after the other, and
+ * the rows of the current one are handed out in ranges of
+ * APPENDONLY_PARALLEL_SCAN_ROWS row numbers. A participant skips the varblocks
+ * outside of its ranges without decompressing them. The number of rows in a
+ * segment file isn't known up front, so whoever reaches its end moves
+ * phs_segidx on to the next one.
+ */
+typedef struct ParallelAppendOnlyScanDescData
+{
+	ParallelTableScanDescData base;
+
+	slock_t		phs_mutex;		/* protects the fields below */
+	int			phs_segidx;		/* segfile array index being handed out */
+	int64		phs_nextrow;	/* first row number of the next range */
+} ParallelAppendOnlyScanDescData;
+
+#define APPENDONLY_PARALLEL_SCAN_ROWS	(64 * 1024)
+
+typedef ParallelAppendOnlyScanDescData *ParallelAppendOnlyScanDesc;
+
 /*
  * Statistics on the latest fetch.
  */
@@ -468,6 +497,17 @@ extern TableScanDesc appendonly_beginscan(Relation relation,
 										  int nkeys, struct ScanKeyData *key,
 										  ParallelTableScanDesc pscan,
 										  uint32 flags);
+extern Size appendonly_parallelscan_estimate(Relation rel);
+extern Size appendonly_parallelscan_initialize(Relation rel,
+											   ParallelTableScanDesc pscan);
+extern void appendonly_parallelscan_reinitialize(Relation rel,
+												 ParallelTableScanDesc pscan);
+extern int appendonly_parallelscan_cursegidx(ParallelTableScanDesc pscan);
+extern bool appendonly_parallelscan_nextrange(ParallelTableScanDesc pscan,
+											  int segidx, int64 minrow,
+											  int64 *startrow);
+extern void appendonly_parallelscan_segdone(ParallelTableScanDesc pscan,
+											int segidx);
 extern void appendonly_rescan(TableScanDesc scan, ScanKey key,
 								bool set_params, bool allow_strat,
 								bool allow_sync, bool allow_pagemode);
@@ -55,6 +55,12 @@ typedef struct SegmentDatabaseDescriptor
 	int						identifier;		/* unique identifier in the cdbcomponent segment pool */
 	double					establishConnTime; /* the time of establish connection to the segment,
 												* -1 means this connection is cached */
+
+	/*
+	 * Identities of the plans the QE is known to have cached, by plan cache
+	 * slot (see cdbsrlz.h); size 0 if none.  Allocated on first use.
+	 */
+	struct DispatchPlanId  *cachedPlans;
 } SegmentDatabaseDescriptor;
 
 SegmentDatabaseDescriptor *
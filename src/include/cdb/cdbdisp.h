@@ -16,6 +16,7 @@
 #ifndef CDBDISP_H
 #define CDBDISP_H
 
+#include "cdb/cdbsrlz.h"
 #include "cdb/cdbtm.h"
 #include "utils/resowner.h"
 
@@ -51,6 +52,14 @@ typedef struct CdbDispatcherState
 	bool isGangDestroying;
 #endif
 	bool destroyIdleReaderGang;
+
+	/*
+	 * For a dispatched plan that QEs may cache, its identity, and the query
+	 * text to send to the QEs that already have it instead of the full one.
+	 */
+	DispatchPlanId planId;
+	char *cachedPlanQueryText;
+	int cachedPlanQueryTextLen;
 } CdbDispatcherState;
 
 typedef struct DispatcherInternalFuncs
@@ -105,6 +105,9 @@ typedef struct CdbDispatchResult
 	/* type of signal sent */
 	DispatchWaitMode sentSignal;
 
+	/* when the command was sent, if log_dispatch_stats is on; or 0 */
+	TimestampTz dispatchTime;
+
 	/*
 	 * true => got any of these errors:
 	 * ERRCODE_GP_OPERATION_CANCELED
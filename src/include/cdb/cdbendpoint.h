@@ -105,6 +105,8 @@ struct EndpointData
 								 * free */
 	dsm_handle	sessionDsmHandle;	/* DSM handle, which contains per-session
 									 * DSM (see session.c). */
+	uint64		tuplesSent;		/* Tuples sent to the message queue */
+	uint64		bytesSent;		/* Bytes sent to the message queue */
 };
 
 typedef struct EndpointData Endpoint;
@@ -79,6 +79,7 @@ extern void DisconnectAndDestroyUnusedQEs(void);
 
 extern void GpDropTempTables(void);
 extern void ResetAllGangs(void);
+extern bool PrewarmWriterGang(void);
 
 extern struct SegmentDatabaseDescriptor *getSegmentDescriptorFromGang(const Gang *gp, int seg);
 
@@ -291,6 +291,16 @@ struct MotionConn
 	uint64 stat_max_resent;
 	uint64 stat_count_dropped;
 
+	/*
+	 * used by the sender, with gp_interconnect_compress_level set.
+	 *
+	 * compressSkip is the number of packets still to be sent uncompressed
+	 * before compression is tried again, compressBackoff the value it was
+	 * last reset to.
+	 */
+	int			compressSkip;
+	int			compressBackoff;
+
 	/*
 	 * used by the sender.
 	 *
@@ -353,6 +363,10 @@ typedef struct ChunkTransportStateEntry
 	uint64 stat_max_resent;
 	uint64 stat_count_dropped;
 
+	/* Bytes of outgoing packets before and after compression */
+	uint64 stat_compress_bytes_in;
+	uint64 stat_compress_bytes_out;
+
 }	ChunkTransportStateEntry;
 
 /* ChunkTransportState array initial size */
@@ -18,9 +18,34 @@
 #ifndef CDBSRLZ_H
 #define CDBSRLZ_H
 
+#include "common/sha2.h"
 #include "nodes/nodes.h"
 
 extern char *serializeNode(Node *node, int *size, int *uncompressed_size);
 extern Node *deserializeNode(const char *strNode, int size);
 
+/*
+ * Serialized plans kept by a QE, so that later dispatches of the same plan
+ * only need to send its identity.  A plan always goes into the slot given by
+ * its digest, which lets the QD keep track of what each QE holds; see
+ * cdbdisp_dispatchX().
+ */
+#define DISPATCH_PLAN_CACHE_SLOTS	8
+
+/* Identity of a serialized plan: its size and SHA-256 digest */
+typedef struct DispatchPlanId
+{
+	int32		size;			/* 0 if none */
+	uint8		digest[PG_SHA256_DIGEST_LENGTH];
+} DispatchPlanId;
+
+#define DispatchPlanCacheSlot(id)	((int) ((id)->digest[0] % DISPATCH_PLAN_CACHE_SLOTS))
+#define DispatchPlanIdEquals(a, b) \
+	((a)->size == (b)->size && \
+	 memcmp((a)->digest, (b)->digest, PG_SHA256_DIGEST_LENGTH) == 0)
+
+extern void computeDispatchPlanId(const char *plan, int size, DispatchPlanId *id);
+extern void storeDispatchedPlan(const DispatchPlanId *id, const char *plan);
+extern const char *lookupDispatchedPlan(const DispatchPlanId *id);
+
 #endif   /* CDBSRLZ_H */
@@ -235,6 +235,9 @@ typedef struct TMGXACTLOCAL
 	Bitmapset					*dtxSegmentsMap;
 	List						*dtxSegments;
 	List						*waitGxids;
+
+	/* segments whose QEs reported writing xlog in this transaction */
+	Bitmapset					*xlogSegmentsMap;
 }	TMGXACTLOCAL;
 
 typedef struct TMGXACTSTATUS
@@ -352,6 +355,7 @@ extern void markCurrentGxactWriterGangLost(void);
 extern bool currentGxactWriterGangLost(void);
 
 extern void addToGxactDtxSegments(struct Gang* gp);
+extern void addToGxactXLogSegments(int segindex);
 extern bool CurrentDtxIsRollingback(void);
 
 extern pid_t DtxRecoveryPID(void);
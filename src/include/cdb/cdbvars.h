@@ -103,6 +103,14 @@ extern int qdPostmasterPort;
 /*How many gangs to keep around from stmt to stmt.*/
 extern int			gp_cached_gang_threshold;
 
+/*
+ * gp_prewarm_writer_gang
+ *
+ * Connect the writer gang as soon as a session is established, while the
+ * client is still composing its first query.
+ */
+extern bool gp_prewarm_writer_gang;
+
 /*
  * gp_reject_percent_threshold
  *
@@ -344,6 +352,15 @@ extern int Gp_interconnect_fc_method;
  */
 extern int	Gp_interconnect_queue_depth;
 
+/*
+ * Parameter Gp_interconnect_compress_level
+ *
+ * The run-time parameter Gp_interconnect_compress_level sets the zstd
+ * compression level used for motion packets; 0 disables compression.
+ *
+ */
+extern int	Gp_interconnect_compress_level;
+
 /*
  * Parameter Gp_interconnect_snd_queue_depth
  *
@@ -595,6 +612,16 @@ extern bool gp_enable_agg_distinct;
  */
 extern bool gp_enable_dqa_pruning;
 
+/*
+ * "gp_enable_multi_dqa_group_redistribute"
+ *
+ * Should Greenplum consider computing multiple DISTINCT-qualified aggregates
+ * with a GROUP BY by redistributing the input once on the grouping keys, and
+ * splitting and deduplicating the rows locally, besides redistributing the
+ * split rows on each DISTINCT argument?  The cheaper plan is used.
+ */
+extern bool gp_enable_multi_dqa_group_redistribute;
+
 /* May Greenplum apply Unique operator (and possibly a Sort) in parallel prior
  * to the collocation motion for a Unique operator?  The idea is to reduce
  * the number of rows moving over the interconnect.
@@ -624,6 +651,24 @@ extern int explain_memory_verbosity;
  */
 extern bool gp_enable_sort_limit;
 
+/*
+ * May the planner use parallel workers on the segments to scan
+ * append-optimized tables?
+ */
+extern bool gp_enable_parallel_ao_scan;
+
+/*
+ * May in-memory sorts, and the sorts of runs before writing them out, use a
+ * radix sort when the leading sort key is an integer?
+ */
+extern bool gp_enable_radix_sort;
+
+/*
+ * May window aggregates without an inverse transition function slide their
+ * frame with the combine function, instead of restarting for every row?
+ */
+extern bool gp_enable_window_agg_combine;
+
 extern bool trace_sort;
 
 /**
@@ -645,6 +690,12 @@ extern int gp_segworker_relative_priority;
 /*  Max size of dispatched plans; 0 if no limit */
 extern int gp_max_plan_size;
 
+/*
+ * Let QEs keep dispatched plans, so that running the same plan again only
+ * sends its digest to the QEs that still have it.
+ */
+extern bool gp_enable_dispatch_plan_cache;
+
 /* Get statistics for partitioned parent from a child */
 extern bool 	gp_statistics_pullup_from_child_partition;
 
@@ -213,6 +213,8 @@ extern void DeregisterReadInterest(ChunkTransportState *transportStates,
 								   const char          *reason);
 
 extern void readPacket(MotionConn *conn, ChunkTransportState *transportStates);
+extern uint8 *expandPacketTCP(MotionConn *conn, int32 *msgSize);
+extern uint8 *expandPacketUDPIFC(MotionConn *conn, int32 *msgSize);
 
 /* 
  * Return a UDP receive buffer to our freelist.
@@ -60,6 +60,9 @@ typedef struct SerTupInfo
 
 	/* true if tupdesc contains record types */
 	bool		has_record_types;
+
+	/* true if every attribute in tupdesc is fixed-width (typlen > 0) */
+	bool		all_fixed_width;
 }	SerTupInfo;
 
 /*
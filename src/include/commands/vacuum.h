@@ -370,6 +370,8 @@ extern void analyze_rel(Oid relid, RangeVar *relation,
 extern int gp_acquire_sample_rows_func(Relation onerel, int elevel,
 									   HeapTuple *rows, int targrows,
 									   double *totalrows, double *totaldeadrows);
+extern HeapTuple *analyze_sample_attstats(Relation onerel, int targrows,
+										 double *totalrows);
 /* in commands/vacuumlazy.c */
 extern void lazy_vacuum_rel_heap(Relation onerel,
 							VacuumParams *params, BufferAccessStrategy bstrategy);
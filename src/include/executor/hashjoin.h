@@ -117,6 +117,13 @@ typedef struct HashSkewBucket
 #define SKEW_WORK_MEM_PERCENT  2
 #define SKEW_MIN_OUTER_FRACTION  0.01
 
+/*
+ * When increasing nbatch leaves a single hash value holding more than this
+ * fraction of the allowed space, further increases are not attempted: they
+ * cannot split that value, and each one rewrites the rest of the batch.
+ */
+#define SKEW_HEAVY_HITTER_FRACTION  0.5
+
 /*
  * To reduce palloc overhead, the HashJoinTuples for the current batch are
  * packed in 32kB buffers instead of pallocing each tuple individually.
@@ -175,6 +182,13 @@ typedef struct HashJoinTableStats
     int                     nonemptybatches;    /* num of nontrivial batches */
     Size                    workmem_max;        /* work_mem high water mark */
     CdbExplain_Agg          chainlength;        /* hash chain length stats */
+
+    /* Growth of nbatch at run time */
+    int                     nbatch_increases;   /* times nbatch was doubled */
+    int                     growth_stopped_batch;   /* batch in which growth
+                                                     * was disabled, or -1 */
+    Size                    heavy_hitter_space; /* work_mem held by the most
+                                                 * common hash value then */
 } HashJoinTableStats;
 
 
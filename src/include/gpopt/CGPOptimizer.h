@@ -36,6 +36,11 @@ public:
 	// serialize planned statement into DXL
 	static char *SerializeDXLPlan(Query *query);
 
+	// serialize the optimizer's buckets for columns of a relation
+	static void GPOPTSerializeColumnBuckets(Oid relid, int natts,
+											const AttrNumber *attnums,
+											bytea **buckets);
+
 	// gpopt initialize and terminate
 	static void InitGPOPT();
 
@@ -47,6 +52,9 @@ extern "C" {
 extern PlannedStmt *GPOPTOptimizedPlan(Query *query,
 									   bool *had_unexpected_failure);
 extern char *SerializeDXLPlan(Query *query);
+extern void GPOPTSerializeColumnBuckets(Oid relid, int natts,
+										const AttrNumber *attnums,
+										bytea **buckets);
 extern void InitGPOPT();
 extern void TerminateGPOPT();
 }
@@ -41,6 +41,7 @@ struct Query;
 using ScanKey = struct ScanKeyData *;
 struct Bitmapset;
 struct Plan;
+struct PlannedStmt;
 struct ListCell;
 struct TargetEntry;
 struct Expr;
@@ -59,6 +60,7 @@ struct Motion;
 struct Var;
 struct Const;
 struct ArrayExpr;
+struct HintState;
 
 #include "gpopt/utils/RelationWrapper.h"
 
@@ -618,6 +620,22 @@ bool MDCacheNeedsReset(void);
 // returns true if a query cancel is requested in GPDB
 bool IsAbortRequested(void);
 
+// join cardinality corrections observed for the relations of the query
+List *GetCardinalityFeedback(Query *query, HintState *hintstate);
+
+// record on the joins of the plan the cardinality feedback applied to them
+void AnnotateCardinalityFeedback(PlannedStmt *stmt, Query *query,
+								 List *feedback);
+
+// number of rows of a relation estimated by optimizer_dynamic_sampling,
+// false if the relation was not sampled
+bool GetDynamicSampleRelStats(Oid relid, double *totalrows);
+
+// statistics of an attribute computed by optimizer_dynamic_sampling,
+// false if the relation was not sampled
+bool GetDynamicSampleAttStats(Oid relid, AttrNumber attnum,
+							  HeapTuple *stats_tup);
+
 // Given the type OID, get the typelem (InvalidOid if not an array type).
 Oid GetElementType(Oid array_type_oid);
 
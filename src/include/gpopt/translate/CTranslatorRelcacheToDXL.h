@@ -23,6 +23,7 @@
 extern "C" {
 #include "postgres.h"
 
+#include "access/htup.h"
 #include "access/tupdesc.h"
 #include "catalog/gp_distribution_policy.h"
 #include "foreign/foreign.h"
@@ -34,6 +35,7 @@ extern "C" {
 #include "naucrates/md/CMDAggregateGPDB.h"
 #include "naucrates/md/CMDCheckConstraintGPDB.h"
 #include "naucrates/md/CMDFunctionGPDB.h"
+#include "naucrates/md/CMDIdColStats.h"
 #include "naucrates/md/CMDRelationGPDB.h"
 #include "naucrates/md/CMDScalarOpGPDB.h"
 #include "naucrates/md/IMDExtStats.h"
@@ -176,6 +178,21 @@ private:
 											CMDAccessor *md_accessor,
 											IMDId *mdid);
 
+	// translate the pg_statistic entry of a column into column stats,
+	// optionally using the buckets ANALYZE stored in it
+	static CDXLColStats *TranslateColStats(CMemoryPool *mp,
+										   CMDAccessor *md_accessor,
+										   IMDId *mdid,
+										   BOOL use_stored_buckets,
+										   CDouble *num_distinct);
+
+	// column stats from the buckets ANALYZE stored in a pg_statistic entry,
+	// or NULL if there are none or they are out of date
+	static CDXLColStats *RetrieveStoredColStats(
+		CMemoryPool *mp, HeapTuple stats_tup, CMDIdColStats *mdid_col_stats,
+		CMDName *md_colname, IMDId *mdid_atttype, CDouble width,
+		CDouble num_distinct);
+
 	// retrieve cast object from the relcache
 	static IMDCacheObject *RetrieveCast(CMemoryPool *mp, IMDId *mdid);
 
@@ -198,7 +215,8 @@ private:
 
 	// transform stats from pg_stats form to optimizer's preferred form
 	static CDXLBucketArray *TransformStatsToDXLBucketArray(
-		CMemoryPool *mp, OID att_type, CDouble num_distinct, CDouble null_freq,
+		CMemoryPool *mp, const IMDType *md_type, CDouble num_distinct,
+		CDouble null_freq,
 		const Datum *mcv_values, const float4 *mcv_frequencies,
 		ULONG num_mcv_values, const Datum *hist_values, ULONG num_hist_values);
 
@@ -277,6 +295,12 @@ private:
 		Relation rel);
 
 public:
+	// serialize the buckets of a column's stats, for ANALYZE to store in
+	// pg_statistic; returns NULL if the column has no usable stats
+	static BYTE *SerializeColStatsBuckets(CMemoryPool *mp,
+										  CMDAccessor *md_accessor,
+										  IMDId *mdid, ULONG *length);
+
 	// retrieve a metadata object from the relcache
 	static IMDCacheObject *RetrieveObject(CMemoryPool *mp,
 										  CMDAccessor *md_accessor, IMDId *mdid,
@@ -110,6 +110,18 @@ struct SOptContext
 
 };	// struct SOptContext
 
+// context of the task that serializes the optimizer's buckets for columns
+struct SColumnBucketsContext
+{
+	// relation and attribute numbers of its columns
+	Oid m_relid;
+	int m_natts;
+	const AttrNumber *m_attnums;
+
+	// output: serialized buckets per column, NULL if it has no usable stats
+	bytea **m_buckets;
+};
+
 class COptTasks
 {
 private:
@@ -124,9 +136,15 @@ private:
 												   ICostModel *cost_model,
 												   CPlanHint *plan_hints);
 
+	// initialize, purge or resize the metadata cache as needed
+	static void InitMDCache();
+
 	// optimize a query to a physical DXL
 	static void *OptimizeTask(void *ptr);
 
+	// serialize the optimizer's buckets for columns of a relation
+	static void *SerializeColumnBucketsTask(void *ptr);
+
 	// translate a DXL tree into a planned statement
 	static PlannedStmt *ConvertToPlanStmtFromDXL(
 		CMemoryPool *mp, CMDAccessor *md_accessor, const Query *orig_query,
@@ -146,7 +164,13 @@ private:
 	static ICostModel *GetCostModel(CMemoryPool *mp, ULONG num_segments);
 
 	// create optimizer plan hints
-	static CPlanHint *GetPlanHints(CMemoryPool *mp, Query *query);
+	static CPlanHint *GetPlanHints(CMemoryPool *mp, Query *query,
+								   List **feedback_list);
+
+	// add row hints for the join cardinality feedback that applies to the query
+	static CPlanHint *AddCardinalityFeedback(CMemoryPool *mp,
+											 List *feedback_list,
+											 CPlanHint *plan_hints);
 
 	// print warning messages for columns with missing statistics
 	static void PrintMissingStatsWarning(CMemoryPool *mp,
@@ -162,6 +186,11 @@ public:
 	static PlannedStmt *GPOPTOptimizedPlan(Query *query,
 										   SOptContext *gpopt_context);
 
+	// serialize the optimizer's buckets for the given columns of a relation
+	static void SerializeColumnBuckets(Oid relid, int natts,
+									   const AttrNumber *attnums,
+									   bytea **buckets);
+
 	// enable/disable a given xforms
 	static bool SetXform(char *xform_str, bool should_disable);
 };
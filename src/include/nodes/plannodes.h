@@ -1083,6 +1083,11 @@ typedef struct Join
 	List	   *joinqual;		/* JOIN quals (in addition to plan.qual) */
 
 	bool		prefetch_inner; /* to avoid deadlock in MPP */
+
+	/* ORCA cardinality feedback, see optimizer/plan/cardfeedback.c */
+	uint32		feedback_qualhash;	/* hash of the quals of the joined rels */
+	double		feedback_ratio; /* correction applied to plan_rows, or 0 if
+									 * the estimate cannot be learned from */
 } Join;
 
 /* ----------------
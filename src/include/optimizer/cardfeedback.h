@@ -0,0 +1,49 @@
+/*-------------------------------------------------------------------------
+ *
+ * cardfeedback.h
+ *	  Join cardinality feedback for the ORCA query planner
+ *
+ * Copyright (c) 2026-Present VMware, Inc. or its affiliates.
+ *
+ * IDENTIFICATION
+ *			src/include/optimizer/cardfeedback.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef CARDFEEDBACK_H
+#define CARDFEEDBACK_H
+
+#include "nodes/parsenodes.h"
+#include "nodes/plannodes.h"
+#include "optimizer/hints.h"
+
+/* Largest join, in number of base relations, that feedback is kept for */
+#define CARDFEEDBACK_MAX_RELS	8
+
+/*
+ * Observed correction of the estimated row count of a join, identified by the
+ * relations it joins and by the quals over them. Aliases and relids are
+ * parallel arrays, sorted by alias.
+ *
+ * A ratio of 0 marks the relations of an explicit row hint: the hint sets the
+ * estimate of that join, so no correction applies to it.
+ */
+typedef struct CardinalityFeedback
+{
+	int			nrels;
+	Oid			relids[CARDFEEDBACK_MAX_RELS];
+	NameData	aliases[CARDFEEDBACK_MAX_RELS];
+	uint32		qualhash;		/* hash of the quals over these relations */
+	double		ratio;			/* actual rows / estimated rows */
+} CardinalityFeedback;
+
+extern Size CardFeedbackShmemSize(void);
+extern void CardFeedbackShmemInit(void);
+
+extern void RecordCardinalityFeedback(PlannedStmt *stmt, Join *join,
+									  double estimated_rows, double actual_rows);
+extern List *GetCardinalityFeedback(Query *query, HintState *hintstate);
+extern void AnnotateCardinalityFeedback(PlannedStmt *stmt, Query *query,
+										List *feedback);
+
+#endif /* CARDFEEDBACK_H */
@@ -0,0 +1,23 @@
+/*-------------------------------------------------------------------------
+ *
+ * dynsample.h
+ *	  Plan-time sampling of tables with missing or stale statistics
+ *
+ * Copyright (c) 2026-Present VMware, Inc. or its affiliates.
+ *
+ * IDENTIFICATION
+ *			src/include/optimizer/dynsample.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef DYNSAMPLE_H
+#define DYNSAMPLE_H
+
+#include "access/htup.h"
+
+extern bool GetDynamicSampleRelStats(Oid relid, double *totalrows);
+extern bool GetDynamicSampleAttStats(Oid relid, AttrNumber attnum,
+									 HeapTuple *stats_tup);
+extern bool DynamicSamplesChanged(void);
+
+#endif /* DYNSAMPLE_H */
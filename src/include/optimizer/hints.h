@@ -13,11 +13,15 @@
 #ifndef OPTIMIZER_HINTS_H
 #define OPTIMIZER_HINTS_H
 
+#ifdef __cplusplus
 extern "C" {
+#endif
 #include "postgres.h"
 #include "nodes/pathnodes.h"
 #include "utils/guc.h"
+#ifdef __cplusplus
 }
+#endif
 
 /* hint keyword of enum type*/
 typedef enum HintKeyword
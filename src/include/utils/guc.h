@@ -313,6 +313,7 @@ extern bool Debug_resource_group;
 extern bool gp_create_table_random_default_distribution;
 extern bool gp_allow_non_uniform_partitioning_ddl;
 extern int  dtx_phase2_retry_second;
+extern bool gp_enable_single_writer_one_phase_commit;
 extern bool gp_log_suboverflow_statement;
 /* WAL replication debug gucs */
 extern bool debug_walrepl_snd;
@@ -330,6 +331,7 @@ extern bool gp_ignore_error_table;
 
 extern bool	Debug_dtm_action_primary;
 extern bool Debug_shareinput_xslice;
+extern bool gp_shareinput_xslice_in_memory;
 
 extern bool gp_log_optimization_time;
 extern bool log_parser_stats;
@@ -536,6 +538,9 @@ extern double optimizer_damping_factor_join;
 extern double optimizer_damping_factor_groupby;
 extern bool optimizer_dpe_stats;
 extern bool optimizer_enable_derive_stats_all_groups;
+extern bool optimizer_cardinality_feedback;
+extern bool optimizer_dynamic_sampling;
+extern int	optimizer_dynamic_sampling_rows;
 
 /* Costing or tuning related GUCs used by the Optimizer */
 extern int optimizer_segments;
@@ -576,6 +581,9 @@ extern bool optimizer_enable_push_join_below_union_all;
 /* Analyze related GUCs for Optimizer */
 extern bool optimizer_analyze_root_partition;
 extern bool optimizer_analyze_midlevel_partition;
+extern bool optimizer_analyze_store_buckets;
+extern bool gp_analyze_hll_fullscan;
+extern bool gp_analyze_skip_unmodified_ao;
 
 extern bool optimizer_use_gpdb_allocators;
 
@@ -616,6 +624,8 @@ extern bool gp_external_enable_filter_pushdown;
 extern bool gp_enable_global_deadlock_detector;
 
 extern bool gp_log_endpoints;
+extern int	gp_endpoint_tuple_queue_size;
+extern int	gp_endpoint_batch_size;
 
 extern bool gp_allow_date_field_width_5digits;
 
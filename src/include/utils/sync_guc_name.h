@@ -48,7 +48,11 @@
 		"gp_disable_tuple_hints",
 		"gp_enable_blkdir_sampling",
 		"gp_enable_interconnect_aggressive_retry",
+		"gp_enable_radix_sort",
 		"gp_enable_segment_copy_checking",
+		"gp_enable_window_agg_combine",
+		"gp_endpoint_batch_size",
+		"gp_endpoint_tuple_queue_size",
 		"gp_external_enable_filter_pushdown",
 		"gp_hashjoin_tuples_per_bucket",
 		"gp_ignore_error_table",
@@ -56,6 +60,7 @@
 		"gp_initial_bad_row_limit",
 		"gp_interconnect_address_type",
 		"gp_interconnect_cache_future_packets",
+		"gp_interconnect_compress_level",
 		"gp_interconnect_cursor_ic_table_size",
 		"gp_interconnect_debug_retry_interval",
 		"gp_interconnect_default_rtt",
@@ -89,6 +94,7 @@
 		"gp_resqueue_print_operator_memory_limits",
 		"gp_select_invisible",
 		"gp_sessionstate_loglevel",
+		"gp_shareinput_xslice_in_memory",
 		"gp_snapshotadd_timeout",
 		"gp_udp_bufsize_k",
 		"gp_udpic_dropacks_percent",
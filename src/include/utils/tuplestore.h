@@ -100,5 +100,10 @@ extern void tuplestore_make_shared(Tuplestorestate *state, SharedFileSet *filese
 								   const char *filename);
 extern void tuplestore_freeze(Tuplestorestate *state);
 extern Tuplestorestate *tuplestore_open_shared(SharedFileSet *fileset, const char *filename);
+extern void tuplestore_make_shared_lazy(Tuplestorestate *state, SharedFileSet *fileset,
+										const char *filename);
+extern Size tuplestore_shared_mem_size(Tuplestorestate *state);
+extern void tuplestore_export_shared_mem(Tuplestorestate *state, void *dest);
+extern Tuplestorestate *tuplestore_open_shared_mem(void *src);
 
 #endif							/* TUPLESTORE_H */
@@ -130,6 +130,8 @@
 		"geqo_threshold",
 		"gp_adjust_selectivity_for_outerjoins",
 		"gp_allow_non_uniform_partitioning_ddl",
+		"gp_analyze_hll_fullscan",
+		"gp_analyze_skip_unmodified_ao",
 		"gp_auth_time_override",
 		"gp_autostats_allow_nonowner",
 		"gp_autostats_lock_wait",
@@ -158,6 +160,7 @@
 		"gp_enable_agg_distinct",
 		"gp_enable_agg_distinct_pruning",
 		"gp_enable_direct_dispatch",
+		"gp_enable_dispatch_plan_cache",
 		"gp_enable_explain_allstat",
 		"gp_enable_fast_sri",
 		"gp_enable_global_deadlock_detector",
@@ -166,11 +169,14 @@
 		"gp_enable_hashjoin_size_heuristic",
 		"gp_enable_minmax_optimization",
 		"gp_enable_motion_deadlock_sanity",
+		"gp_enable_multi_dqa_group_redistribute",
 		"gp_enable_multiphase_agg",
+		"gp_enable_parallel_ao_scan",
 		"gp_enable_predicate_propagation",
 		"gp_enable_preunique",
 		"gp_enable_query_metrics",
 		"gp_enable_relsize_collection",
+		"gp_enable_single_writer_one_phase_commit",
 		"gp_enable_slow_writer_testmode",
 		"gp_enable_sort_limit",
 		"gp_encoding_check_locale_compatibility",
@@ -207,6 +213,7 @@
 		"gp_motion_cost_per_row",
 		"gp_pause_on_restore_point_replay",
 		"gp_postmaster_address_family",
+		"gp_prewarm_writer_gang",
 		"gp_print_create_gang_time",
 		"gp_qd_hostname",
 		"gp_qd_port",
@@ -332,9 +339,11 @@
 		"optimizer",
 		"optimizer_analyze_midlevel_partition",
 		"optimizer_analyze_root_partition",
+		"optimizer_analyze_store_buckets",
 		"optimizer_apply_left_outer_to_union_all_disregarding_stats",
 		"optimizer_array_constraints",
 		"optimizer_array_expansion_threshold",
+		"optimizer_cardinality_feedback",
 		"optimizer_control",
 		"optimizer_cost_model",
 		"optimizer_cost_threshold",
@@ -345,6 +354,8 @@
 		"optimizer_damping_factor_join",
 		"optimizer_discard_redistribute_hashjoin",
 		"optimizer_dpe_stats",
+		"optimizer_dynamic_sampling",
+		"optimizer_dynamic_sampling_rows",
 		"optimizer_enable_assert_maxonerow",
 		"optimizer_enable_associativity",
 		"optimizer_enable_bitmapscan",
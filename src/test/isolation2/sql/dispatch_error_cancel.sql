@@ -0,0 +1,44 @@
+-- Test that the dispatcher handles an error from one QE, and a cancel
+-- request, while the other QEs of a multi-gang query are still busy. The
+-- dispatcher services only the connections that are ready, so the QEs that
+-- are still running must be cancelled and waited for, and the session must
+-- be usable afterwards.
+
+create extension if not exists gp_inject_fault;
+
+create table dispatch_error_cancel (a int, b int) distributed by (a);
+insert into dispatch_error_cancel select i, i from generate_series(1, 1000) i;
+
+-- The join redistributes t2, so each segment runs two QEs.
+1: select count(*) from dispatch_error_cancel t1 join dispatch_error_cancel t2 on t1.a = t2.b;
+
+--
+-- One QE errors out while the QEs on the other segments are busy.
+--
+select gp_inject_fault_infinite('exec_mpp_query_start', 'suspend', dbid) from gp_segment_configuration where role = 'p' and content in (1, 2);
+select gp_inject_fault('exec_mpp_query_start', 'error', dbid) from gp_segment_configuration where role = 'p' and content = 0;
+1&: select count(*) from dispatch_error_cancel t1 join dispatch_error_cancel t2 on t1.a = t2.b;
+select gp_wait_until_triggered_fault('exec_mpp_query_start', 1, dbid) from gp_segment_configuration where role = 'p' and content in (0, 1, 2) order by content;
+-- The error has arrived, but the query can't finish until the busy QEs
+-- have been cancelled.
+select gp_inject_fault_infinite('exec_mpp_query_start', 'resume', dbid) from gp_segment_configuration where role = 'p' and content in (1, 2);
+1<:
+select gp_inject_fault('exec_mpp_query_start', 'reset', dbid) from gp_segment_configuration where role = 'p' and content in (0, 1, 2);
+
+1: select count(*) from dispatch_error_cancel t1 join dispatch_error_cancel t2 on t1.a = t2.b;
+
+--
+-- The query is cancelled while all of its QEs are busy.
+--
+select gp_inject_fault_infinite('exec_mpp_query_start', 'suspend', dbid) from gp_segment_configuration where role = 'p' and content in (0, 1, 2);
+1&: select count(*) from dispatch_error_cancel t1 join dispatch_error_cancel t2 on t1.a = t2.b;
+select gp_wait_until_triggered_fault('exec_mpp_query_start', 1, dbid) from gp_segment_configuration where role = 'p' and content in (0, 1, 2) order by content;
+select pg_cancel_backend(pid) from pg_stat_activity where query = 'select count(*) from dispatch_error_cancel t1 join dispatch_error_cancel t2 on t1.a = t2.b;';
+select gp_inject_fault_infinite('exec_mpp_query_start', 'resume', dbid) from gp_segment_configuration where role = 'p' and content in (0, 1, 2);
+1<:
+select gp_inject_fault('exec_mpp_query_start', 'reset', dbid) from gp_segment_configuration where role = 'p' and content in (0, 1, 2);
+
+1: select count(*) from dispatch_error_cancel t1 join dispatch_error_cancel t2 on t1.a = t2.b;
+1q:
+
+drop table dispatch_error_cancel;
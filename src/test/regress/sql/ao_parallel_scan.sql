@@ -0,0 +1,45 @@
+--
+-- Parallel scans of append-optimized tables. The workers on each segment
+-- divide the segment files among themselves by row-number ranges.
+--
+set optimizer = off;
+set gp_enable_parallel_ao_scan = on;
+set max_parallel_workers_per_gather = 2;
+set parallel_setup_cost = 0;
+set parallel_tuple_cost = 0;
+set min_parallel_table_scan_size = 0;
+create table ao_par (a int, b int, c text) with (appendonly=true) distributed by (a);
+insert into ao_par select i, i % 1000, 'row ' || i from generate_series(1, 600000) i;
+analyze ao_par;
+explain (costs off) select count(*), sum(a) from ao_par;
+select count(*), sum(a) from ao_par;
+explain (costs off) select count(c), sum(a) from ao_par where b < 10;
+select count(c), sum(a) from ao_par where b < 10;
+-- deleted rows must stay invisible to the workers
+delete from ao_par where a % 7 = 0;
+select count(*), sum(a) from ao_par;
+select count(c), sum(a) from ao_par where b < 10;
+create table aocs_par (a int, b int, c text) with (appendonly=true, orientation=column, compresstype=zlib) distributed by (a);
+insert into aocs_par select i, i % 1000, 'row ' || i from generate_series(1, 600000) i;
+analyze aocs_par;
+explain (costs off) select count(*), sum(a) from aocs_par;
+select count(*), sum(a) from aocs_par;
+explain (costs off) select count(c), sum(a) from aocs_par where b < 10;
+select count(c), sum(a) from aocs_par where b < 10;
+-- deleted rows must stay invisible to the workers
+delete from aocs_par where a % 7 = 0;
+select count(*), sum(a) from aocs_par;
+select count(c), sum(a) from aocs_par where b < 10;
+-- the same results without parallel workers
+set gp_enable_parallel_ao_scan = off;
+explain (costs off) select count(*), sum(a) from ao_par;
+select count(*), sum(a) from ao_par;
+select count(*), sum(a) from aocs_par;
+reset min_parallel_table_scan_size;
+reset parallel_tuple_cost;
+reset parallel_setup_cost;
+reset max_parallel_workers_per_gather;
+reset gp_enable_parallel_ao_scan;
+reset optimizer;
+drop table ao_par;
+drop table aocs_par;
@@ -0,0 +1,60 @@
+--
+-- Test optimizer_cardinality_feedback: EXPLAIN ANALYZE of an ORCA plan
+-- corrects the join estimates of later plans of the same query. The
+-- Postgres planner doesn't use the feedback, so its estimates don't change.
+--
+create schema cardinality_feedback;
+set search_path to cardinality_feedback;
+
+-- b is equal to a, so the second join qual removes no rows, but the
+-- estimate treats the two quals as independent
+create table cf_a (a int, b int) distributed by (a);
+create table cf_b (a int, b int) distributed by (a);
+insert into cf_a select i, i from generate_series(1, 10000) i;
+insert into cf_b select i, i from generate_series(1, 10000) i;
+analyze cf_a;
+analyze cf_b;
+
+-- estimated rows of the first join of the plan of a query
+create function join_rows(query text) returns int as $$
+declare
+  ln text;
+begin
+  for ln in execute 'explain ' || query loop
+    if ln ~ 'Join' then
+      return substring(ln from 'rows=(\d+)')::int;
+    end if;
+  end loop;
+  return null;
+end;
+$$ language plpgsql;
+
+create function explain_analyze(query text) returns void as $$
+begin
+  execute 'explain analyze ' || query;
+end;
+$$ language plpgsql;
+
+set optimizer_cardinality_feedback = on;
+
+select join_rows('select * from cf_a a join cf_b b on a.a = b.a and a.b = b.b') as before_rows \gset
+select explain_analyze('select * from cf_a a join cf_b b on a.a = b.a and a.b = b.b');
+select join_rows('select * from cf_a a join cf_b b on a.a = b.a and a.b = b.b') > :before_rows as corrected;
+
+-- learning from the corrected plan keeps the same correction
+select join_rows('select * from cf_a a join cf_b b on a.a = b.a and a.b = b.b') as after_rows \gset
+select explain_analyze('select * from cf_a a join cf_b b on a.a = b.a and a.b = b.b');
+select join_rows('select * from cf_a a join cf_b b on a.a = b.a and a.b = b.b') = :after_rows as converged;
+
+-- the quals, including those pushed down to the scans, are part of what
+-- identifies the join
+select join_rows('select * from cf_a a join cf_b b on a.a = b.a and a.b = b.b where a.b > 0') < :after_rows as other_quals_uncorrected;
+
+-- nothing is applied with the feature off
+set optimizer_cardinality_feedback = off;
+select join_rows('select * from cf_a a join cf_b b on a.a = b.a and a.b = b.b') = :before_rows as uncorrected;
+
+reset optimizer_cardinality_feedback;
+set client_min_messages = warning;
+drop schema cardinality_feedback cascade;
+reset client_min_messages;
@@ -0,0 +1,75 @@
+--
+-- Test caching of dispatched plans in QEs (gp_enable_dispatch_plan_cache).
+--
+-- A plan is only cached if its serialized form is at least 4 kB, so the
+-- queries below carry a long IN list. The 'dispatch_plan_cache_hit' fault
+-- counts how often seg0 ran a plan from its cache.
+--
+CREATE EXTENSION IF NOT EXISTS gp_inject_fault;
+
+SET gp_enable_dispatch_plan_cache = on;
+
+CREATE TABLE dispatch_plan_cache (a int, b text) DISTRIBUTED BY (a);
+INSERT INTO dispatch_plan_cache SELECT i, md5(i::text) FROM generate_series(1, 1000) i;
+
+CREATE FUNCTION dispatch_plan_cache_count(n int) RETURNS bigint AS $$
+DECLARE
+  result bigint;
+BEGIN
+  EXECUTE 'SELECT count(*) FROM dispatch_plan_cache WHERE a <= ' || n ||
+    ' AND b IN (' ||
+    (SELECT string_agg(quote_literal(md5(i::text)), ',') FROM generate_series(1, 500) i) ||
+    ')' INTO result;
+  RETURN result;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE FUNCTION dispatch_plan_cache_hits() RETURNS text AS $$
+  SELECT substring(gp_inject_fault('dispatch_plan_cache_hit', 'status', dbid)
+                   FROM 'num times hit:''(\d+)''')
+  FROM gp_segment_configuration WHERE content = 0 AND role = 'p';
+$$ LANGUAGE sql;
+
+SELECT gp_inject_fault_infinite('dispatch_plan_cache_hit', 'skip', dbid)
+  FROM gp_segment_configuration WHERE content = 0 AND role = 'p';
+
+-- The first dispatch sends the full plan, the following ones only its digest.
+SELECT dispatch_plan_cache_count(1000);
+SELECT dispatch_plan_cache_count(1000);
+SELECT dispatch_plan_cache_count(1000);
+SELECT dispatch_plan_cache_hits();
+
+-- A different plan is sent in full, then cached as well.
+SELECT dispatch_plan_cache_count(100);
+SELECT dispatch_plan_cache_count(100);
+SELECT dispatch_plan_cache_hits();
+
+-- Dispatching a utility statement destroys the idle reader gangs. The new
+-- QEs have an empty cache and get the full plan again.
+CREATE TABLE dispatch_plan_cache_reset (a int);
+DROP TABLE dispatch_plan_cache_reset;
+SELECT dispatch_plan_cache_count(100);
+SELECT dispatch_plan_cache_hits();
+SELECT dispatch_plan_cache_count(100);
+SELECT dispatch_plan_cache_hits();
+
+-- A QE that cannot find the plan the QD believes it has cached must fail
+-- the query rather than run something else. The next dispatch after the
+-- failure sends the full plan.
+SELECT gp_inject_fault('dispatch_plan_cache_miss', 'skip', dbid)
+  FROM gp_segment_configuration WHERE content = 0 AND role = 'p';
+SELECT dispatch_plan_cache_count(100);
+SELECT dispatch_plan_cache_count(100);
+SELECT dispatch_plan_cache_hits();
+SELECT dispatch_plan_cache_count(100);
+SELECT dispatch_plan_cache_hits();
+
+SELECT gp_inject_fault('dispatch_plan_cache_miss', 'reset', dbid)
+  FROM gp_segment_configuration WHERE content = 0 AND role = 'p';
+SELECT gp_inject_fault('dispatch_plan_cache_hit', 'reset', dbid)
+  FROM gp_segment_configuration WHERE content = 0 AND role = 'p';
+
+DROP FUNCTION dispatch_plan_cache_hits();
+DROP FUNCTION dispatch_plan_cache_count(int);
+DROP TABLE dispatch_plan_cache;
+RESET gp_enable_dispatch_plan_cache;
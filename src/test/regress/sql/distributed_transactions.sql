@@ -603,6 +603,17 @@ reset test_print_direct_dispatch_info;
 reset optimizer;
 select count(gp_segment_id) from distxact1_4 group by gp_segment_id; -- sanity check: tuples should be in > 1 segments
 
+-- A transaction that runs on all segments but changes data on only one of
+-- them needs no prepare with gp_enable_single_writer_one_phase_commit.
+set optimizer = off;
+set gp_enable_single_writer_one_phase_commit = on;
+set test_print_direct_dispatch_info = true;
+delete from distxact1_4 where a + 0 = 1;
+reset test_print_direct_dispatch_info;
+reset gp_enable_single_writer_one_phase_commit;
+reset optimizer;
+select * from distxact1_4;
+
 -- Tests for AND CHAIN
 CREATE TABLE abc (a int);
 
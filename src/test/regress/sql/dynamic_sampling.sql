@@ -0,0 +1,44 @@
+--
+-- Test optimizer_dynamic_sampling: ORCA samples a table that has never been
+-- analyzed instead of using default estimates for it. The Postgres planner
+-- doesn't sample.
+--
+create schema dynamic_sampling;
+set search_path to dynamic_sampling;
+set gp_autostats_mode = none;
+
+create table ds_t (a int, b int) distributed by (a);
+insert into ds_t select i, i % 10 from generate_series(1, 10000) i;
+
+-- estimated rows of the first scan of the plan of a query
+create function scan_rows(query text) returns int as $$
+declare
+  ln text;
+begin
+  for ln in execute 'explain ' || query loop
+    if ln ~ 'Scan' then
+      return substring(ln from 'rows=(\d+)')::int;
+    end if;
+  end loop;
+  return null;
+end;
+$$ language plpgsql;
+
+select scan_rows('select * from ds_t where b = 1') as unsampled_rows \gset
+
+-- switching sampling on doesn't reuse what was estimated without it
+set optimizer_dynamic_sampling = on;
+select scan_rows('select * from ds_t where b = 1') as sampled_rows \gset
+select :sampled_rows <> :unsampled_rows as sampled;
+
+-- the sample is kept for the next query, as long as the table is unchanged
+select scan_rows('select * from ds_t where b = 1') = :sampled_rows as cached;
+
+set optimizer_dynamic_sampling = off;
+select scan_rows('select * from ds_t where b = 1') = :unsampled_rows as unsampled;
+
+reset optimizer_dynamic_sampling;
+reset gp_autostats_mode;
+set client_min_messages = warning;
+drop schema dynamic_sampling cascade;
+reset client_min_messages;
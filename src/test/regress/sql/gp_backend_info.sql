@@ -82,3 +82,11 @@ SELECT COUNT(*) = 1 FROM gp_backend_info() WHERE type = 'Q' and content = -1;
 -- IDs and PIDs should still be distinct.
 SELECT COUNT(DISTINCT id) = (:num_primaries * 2 + 2) FROM gp_backend_info();
 SELECT COUNT(DISTINCT pid) = (:num_primaries * 2 + 2) FROM gp_backend_info();
+
+--
+-- With gp_prewarm_writer_gang, a new session connects its writer gang before
+-- running any query.
+--
+\c -reuse-previous=on "options=-cgp_prewarm_writer_gang=on"
+SELECT COUNT(*) = :num_primaries +1 FROM gp_backend_info();
+SELECT COUNT(*) = :num_primaries FROM gp_backend_info() WHERE type = 'w';
@@ -54,6 +54,13 @@ explain (costs off) select count(distinct d), count(distinct dt) from dqa_t1 gro
 select count(distinct d), count(distinct dt) from dqa_t1 group by d;
 explain (costs off) select count(distinct d), count(distinct dt) from dqa_t1 group by d;
 
+-- Redistribute only once, on the GROUP BY keys, and split the tuples locally
+set gp_enable_multi_dqa_group_redistribute = on;
+select count(distinct d), count(distinct dt) from dqa_t1 group by c;
+explain (costs off) select count(distinct d), count(distinct dt) from dqa_t1 group by c;
+explain (costs off) select count(distinct d), count(distinct dt) from dqa_t1 group by d;
+reset gp_enable_multi_dqa_group_redistribute;
+
 select count(distinct dqa_t1.d) from dqa_t1, dqa_t2 where dqa_t1.d = dqa_t2.d;
 explain (costs off) select count(distinct dqa_t1.d) from dqa_t1, dqa_t2 where dqa_t1.d = dqa_t2.d;
 select count(distinct dqa_t1.d) from dqa_t1, dqa_t2 where dqa_t1.d = dqa_t2.d group by dqa_t2.dt;
@@ -12,3 +12,31 @@ insert into uuid_tbl values
 (0, 'ffffffffffffffffffffffffffffffff'),
 (0, '11111111111111111111111111111111');
 select * from uuid_tbl order by uid;
+
+-- Radix sort on integer leading keys must give the same order as the
+-- comparison sort, including NULLs, descending order and ties broken on
+-- further keys.
+create temp table radix_sort_input as
+  select case when i % 97 = 0 then null else hashint4(i) % 100000 end as a,
+         hashint8(i)::int8 * 65536 as b,
+         (hashint4(i) % 30000)::int2 as c
+  from generate_series(1, 20000) i
+  distributed randomly;
+set gp_enable_radix_sort = off;
+create temp table radix_sort_expected as
+  select array_agg(a order by a) as a_asc,
+         array_agg(a order by a desc nulls last) as a_desc,
+         array_agg(b order by b desc) as b_desc,
+         array_agg(b order by c nulls first, b) as c_b
+  from radix_sort_input
+  distributed randomly;
+set gp_enable_radix_sort = on;
+select e.a_asc = r.a_asc as a_asc, e.a_desc = r.a_desc as a_desc,
+       e.b_desc = r.b_desc as b_desc, e.c_b = r.c_b as c_b
+from radix_sort_expected e,
+  (select array_agg(a order by a) as a_asc,
+          array_agg(a order by a desc nulls last) as a_desc,
+          array_agg(b order by b desc) as b_desc,
+          array_agg(b order by c nulls first, b) as c_b
+   from radix_sort_input) r;
+reset gp_enable_radix_sort;
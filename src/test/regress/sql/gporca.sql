@@ -3654,6 +3654,7 @@ analyze foo;
 analyze bar;
 
 explain (costs off) select max(s1) from foo inner join bar on j1 = j2 group by g1;
+select g1, count(s1), sum(s1), max(s1) from foo left join bar on j1 = j2 group by g1 order by g1;
 drop table foo;
 drop table bar;
 reset optimizer_enable_eageragg;
@@ -0,0 +1,63 @@
+--
+-- GPORCA must plan and estimate the same with the buckets ANALYZE stores
+-- when optimizer_analyze_store_buckets is on as with the buckets it builds
+-- from the MCVs and histogram itself.
+--
+create schema gporca_stored_buckets;
+set search_path to gporca_stored_buckets;
+
+-- small enough to be sampled whole, so that both ANALYZEs see the same rows
+create table sb (a int, b text, c numeric, d date, e bool) distributed by (a);
+insert into sb
+  select i, 'v' || (i % 37), (i % 113) / 7.0, date '2020-01-01' + (i % 400), i % 3 = 0
+  from generate_series(1, 20000) i;
+
+create function explain_queries() returns text language plpgsql as $$
+declare
+  q text;
+  line text;
+  plans text := '';
+begin
+  foreach q in array array[
+    'select * from sb where a < 500',
+    'select * from sb where b = ''v3''',
+    'select * from sb where b in (''v1'', ''v2'', ''nosuchvalue'')',
+    'select * from sb where c between 2 and 5',
+    'select * from sb where d > date ''2020-06-01''',
+    'select * from sb where e',
+    'select b, count(*) from sb group by b',
+    'select * from sb s1 join sb s2 on s1.c = s2.c where s1.a < 100']
+  loop
+    for line in execute 'explain ' || q loop
+      plans := plans || line || E'\n';
+    end loop;
+  end loop;
+  return plans;
+end;
+$$;
+
+create function stored_bucket_columns() returns bigint language sql as $$
+  select count(*) from pg_statistic
+  where starelid = 'sb'::regclass
+    and 97 in (stakind1, stakind2, stakind3, stakind4, stakind5);
+$$;
+
+set optimizer_analyze_store_buckets = off;
+analyze sb;
+select stored_bucket_columns();
+create table converted_plans as select explain_queries() as plans distributed randomly;
+
+set optimizer_analyze_store_buckets = on;
+analyze sb;
+select stored_bucket_columns();
+select explain_queries() = plans as same_plans from converted_plans;
+
+-- once reltuples changes, the buckets stored for columns whose number of
+-- distinct values scales with it are ignored
+insert into sb select i, 'v0', 0, date '2020-01-01', false from generate_series(1, 20000) i;
+vacuum sb;
+select stored_bucket_columns();
+select count(*) > 0 as planned from (select explain_queries()) p;
+
+reset optimizer_analyze_store_buckets;
+drop schema gporca_stored_buckets cascade;
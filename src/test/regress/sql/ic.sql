@@ -169,6 +169,44 @@ INSERT INTO a (SELECT i, i * i FROM generate_series(1, 10) as i);
 SELECT a.* FROM a WHERE a.j NOT IN (SELECT j FROM a a2 WHERE a2.j = a.j AND a2.i = 1) AND a.i = 1;
 SELECT a.* FROM a INNER JOIN a b ON a.i = b.i WHERE a.j NOT IN (SELECT j FROM a a2 WHERE a2.j = b.j) AND a.i = 1;
 
+-- Compressed interconnect packets
+SET gp_interconnect_compress_level TO 1;
+SELECT SUM(length(long_tval)) AS sum_len_tval
+  FROM (SELECT jkey, repeat(tval, 10000) AS long_tval
+          FROM small_table ORDER BY dkey LIMIT 20) foo
+            JOIN (SELECT * FROM small_table ORDER BY dkey LIMIT 100) bar USING(jkey);
+-- EXPLAIN ANALYZE reports how much each sending motion compressed
+CREATE FUNCTION ic_compression_report(query text) RETURNS SETOF text
+LANGUAGE plpgsql AS $$
+DECLARE
+  ln text;
+  m text[];
+BEGIN
+  FOR ln IN EXECUTE 'EXPLAIN (ANALYZE, COSTS OFF, TIMING OFF, SUMMARY OFF) ' || query LOOP
+    m := regexp_match(ln, 'Interconnect compression: (\d+) bytes compressed to (\d+) bytes');
+    IF m IS NOT NULL THEN
+      RETURN NEXT CASE WHEN m[2]::bigint < m[1]::bigint
+                       THEN 'compressed' ELSE 'not compressed' END;
+    END IF;
+  END LOOP;
+END;
+$$;
+SELECT ic_compression_report('SELECT repeat(tval, 100) FROM small_table');
+-- Packets of hash values don't compress, and are sent raw
+CREATE TABLE ic_incompressible AS
+  SELECT i, (SELECT string_agg(sha256((i * 1000 + j)::text::bytea), ''::bytea ORDER BY j)
+             FROM generate_series(1, 200) j) AS b
+  FROM generate_series(1, 50) i DISTRIBUTED BY (i);
+CREATE TABLE ic_incompressible_redist AS
+  SELECT * FROM ic_incompressible DISTRIBUTED BY (b);
+SELECT count(*), sum(length(b)), md5(string_agg(b, ''::bytea ORDER BY i))
+  FROM ic_incompressible_redist;
+SELECT ic_compression_report('SELECT * FROM ic_incompressible');
+DROP TABLE ic_incompressible;
+DROP TABLE ic_incompressible_redist;
+SET gp_interconnect_compress_level TO 20; -- ERROR
+RESET gp_interconnect_compress_level;
+
 -- Paramter range
 SET gp_interconnect_snd_queue_depth TO -1; -- ERROR
 SET gp_interconnect_snd_queue_depth TO 0; -- ERROR
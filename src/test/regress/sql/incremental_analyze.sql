@@ -618,6 +618,21 @@ INSERT INTO foo SELECT i, i%3+3, 'text_'||i%200 FROM generate_series(1,1000)i;
 SET default_statistics_target to 3;
 ANALYZE FULLSCAN foo;
 SELECT tablename, n_distinct FROM pg_stats WHERE tablename like 'foo%' ORDER BY attname,tablename;
+-- Test full scan HLL on a table that is not partitioned. The table is much
+-- larger than the 300-row sample, and half of its rows share one value, so
+-- the sample-based estimate of the 10001 distinct values of c is far too low.
+DROP TABLE IF EXISTS foo;
+CREATE TABLE foo (a int, c int) DISTRIBUTED BY (a);
+INSERT INTO foo SELECT i, CASE WHEN i % 2 = 0 THEN 0 ELSE i END FROM generate_series(1,20000)i;
+SELECT count(DISTINCT c) FROM foo;
+SET default_statistics_target = 1;
+ANALYZE foo;
+SELECT n_distinct > 0 AND n_distinct < 1000 AS sample_underestimates FROM pg_stats WHERE tablename = 'foo' AND attname = 'c';
+SET gp_analyze_hll_fullscan = on;
+ANALYZE foo;
+RESET gp_analyze_hll_fullscan;
+SELECT n_distinct BETWEEN -0.55 AND -0.45 AS hll_estimates FROM pg_stats WHERE tablename = 'foo' AND attname = 'c';
+SET default_statistics_target to 3;
 -- Test ANALYZE auto merge behavior
 -- Do not merge stats from only one partition while other partitions have not been analyzed yet
 DROP TABLE IF EXISTS foo;
@@ -961,3 +976,42 @@ alter table hll_part_def set (analyze_hll_non_part_table=true);
 select reloptions from pg_class where relname='hll_part_def';
 select reloptions from pg_class where relname='hll_part_def_1_prt_2';
 
+-- Test skipping append-optimized tables that have not been modified since
+-- they were last analyzed. Only the modified leaves are sampled again, the
+-- root statistics are merged from those of the leaves.
+set gp_autostats_mode = none;
+set gp_analyze_skip_unmodified_ao = on;
+create table ao_skip (a int, b int) with (appendonly=true) distributed by (a)
+partition by range(b) (start(0) end(2) every(1));
+insert into ao_skip select i, i%2 from generate_series(1,100)i;
+analyze ao_skip;
+insert into ao_skip values (1, 1);
+analyze verbose ao_skip;
+analyze verbose ao_skip_1_prt_1;
+-- a list of columns is always analyzed
+analyze verbose ao_skip_1_prt_1(a);
+-- TRUNCATE forgets the modcount recorded by the last ANALYZE
+truncate ao_skip_1_prt_1;
+insert into ao_skip select i, 0 from generate_series(1,100)i;
+analyze verbose ao_skip_1_prt_1;
+-- a changed statistics target, new extended statistics or a new expression
+-- index are analyzed again
+alter table ao_skip_1_prt_1 alter column a set statistics 50;
+analyze verbose ao_skip_1_prt_1;
+analyze verbose ao_skip_1_prt_1;
+create statistics ao_skip_stats (ndistinct) on a, b from ao_skip_1_prt_1;
+analyze ao_skip_1_prt_1;
+select d.stxdndistinct is not null as built from pg_statistic_ext s
+join pg_statistic_ext_data d on s.oid = d.stxoid where s.stxname = 'ao_skip_stats';
+create index ao_skip_expr_idx on ao_skip_1_prt_1 ((a + 1));
+analyze ao_skip_1_prt_1;
+select count(*) from pg_statistic where starelid = 'ao_skip_expr_idx'::regclass;
+-- the inheritance tree of a skipped parent is still analyzed
+create table ao_skip_inh (a int, b int) with (appendonly=true) distributed by (a);
+create table ao_skip_inh_child () inherits (ao_skip_inh);
+insert into ao_skip_inh select i, i from generate_series(1,10)i;
+analyze ao_skip_inh;
+insert into ao_skip_inh_child select i, i from generate_series(1,10)i;
+analyze verbose ao_skip_inh;
+reset gp_analyze_skip_unmodified_ao;
+reset gp_autostats_mode;
@@ -98,3 +98,24 @@ $$) order by id;
 CREATE TABLE motion_noatts ();
 INSERT INTO motion_noatts SELECT;
 SELECT * FROM motion_noatts;
+
+-- Virtual tuples of fixed-width attributes are formed directly in the
+-- interconnect buffer, preceded by alignment padding. Mix in NULLs, so that
+-- the tuples have different widths and start at different alignments.
+CREATE TABLE motion_fixed (a int4, b int2, c int8, d float8, e bool, f "char") DISTRIBUTED BY (a);
+INSERT INTO motion_fixed
+  SELECT i,
+         CASE WHEN i % 3 = 0 THEN NULL ELSE i % 100 END,
+         CASE WHEN i % 5 = 0 THEN NULL ELSE i * 1000000000::int8 END,
+         CASE WHEN i % 7 = 0 THEN NULL ELSE i / 4.0::float8 END,
+         CASE WHEN i % 2 = 0 THEN NULL ELSE i % 4 = 1 END,
+         CASE WHEN i % 11 = 0 THEN NULL ELSE chr(65 + i % 26)::"char" END
+  FROM generate_series(1, 1000) i;
+-- Gather Motion of projected, virtual tuples
+SELECT a + 0 AS a, b, c, d, e, f FROM motion_fixed WHERE a <= 15 ORDER BY a;
+-- Redistribute Motion of projected, virtual tuples
+CREATE TABLE motion_fixed_redist AS
+  SELECT a + 0 AS a, b, c, d, e, f FROM motion_fixed DISTRIBUTED BY (b);
+SELECT count(*) FROM motion_fixed_redist;
+SELECT * FROM motion_fixed EXCEPT ALL SELECT * FROM motion_fixed_redist;
+SELECT * FROM motion_fixed_redist EXCEPT ALL SELECT * FROM motion_fixed;
@@ -1388,6 +1388,63 @@ SELECT i, b, bool_and(b) OVER w, bool_or(b) OVER w
   FROM (VALUES (1,true), (2,true), (3,false), (4,false), (5,true)) v(i,b)
   WINDOW w AS (ORDER BY i ROWS BETWEEN CURRENT ROW AND 1 FOLLOWING);
 
+-- MIN and MAX have no inverse transition function, so when the frame head
+-- moves, they slide the frame with their combine function instead
+SELECT i, v, min(v) OVER w, max(v) OVER w, max(t) OVER w
+  FROM (VALUES (1,3,'c'), (2,1,'a'), (3,4,'d'), (4,1,'a'), (5,5,'e'), (6,null,null), (7,2,'b')) x(i,v,t)
+  WINDOW w AS (ORDER BY i ROWS BETWEEN 1 PRECEDING AND 2 FOLLOWING);
+
+-- RANGE and GROUPS frames with offsets move the frame head by more than one
+-- row at a time
+SELECT k, v,
+       min(v) OVER (ORDER BY k RANGE BETWEEN 2 PRECEDING AND 1 FOLLOWING) AS range_min,
+       max(v) OVER (ORDER BY k GROUPS BETWEEN 1 PRECEDING AND 1 FOLLOWING) AS groups_max
+  FROM (VALUES (1,3), (2,1), (2,4), (4,1), (5,5), (5,null), (7,2), (8,6), (10,0)) x(k,v)
+  ORDER BY k, v;
+
+-- a restarting aggregate sharing the aggcontext, and one using an inverse
+-- transition function, alongside ones using the combine function
+SELECT i, v, min(v) OVER w, avg(v::float8) OVER w, count(v) OVER w, max(t) OVER w
+  FROM (VALUES (1,3,'c'), (2,1,'a'), (3,5,'e'), (4,null,null), (5,4,'d'), (6,2,'b'), (7,6,'f'), (8,7,'g')) x(i,v,t)
+  WINDOW w AS (ORDER BY i ROWS BETWEEN 1 PRECEDING AND 1 FOLLOWING)
+  ORDER BY i;
+
+-- a by-ref transition value, over several rebuilds of the front and two
+-- partitions
+SELECT g, i, t, max(t) OVER w, min(t) OVER w
+  FROM (VALUES (1,1,'pear'), (2,1,'apple'), (3,1,'zebra'), (4,1,'kiwi'), (5,1,'mango'), (6,1,'fig'),
+               (7,1,'banana'), (8,2,'cherry'), (9,1,'date'), (10,2,'lime'), (11,1,'grape'), (12,2,'olive')) x(i,g,t)
+  WINDOW w AS (PARTITION BY g ORDER BY i ROWS BETWEEN 2 PRECEDING AND 1 FOLLOWING)
+  ORDER BY g, i;
+
+-- combine functions of bitwise aggregates
+SELECT i, v, bit_and(v) OVER w, bit_or(v) OVER w
+  FROM (VALUES (1,7), (2,14), (3,6), (4,12), (5,null), (6,5), (7,13), (8,15)) x(i,v)
+  WINDOW w AS (ORDER BY i ROWS BETWEEN 2 PRECEDING AND CURRENT ROW)
+  ORDER BY i;
+
+-- the same without the combine function
+SET gp_enable_window_agg_combine = off;
+SELECT k, v,
+       min(v) OVER (ORDER BY k RANGE BETWEEN 2 PRECEDING AND 1 FOLLOWING) AS range_min,
+       max(v) OVER (ORDER BY k GROUPS BETWEEN 1 PRECEDING AND 1 FOLLOWING) AS groups_max
+  FROM (VALUES (1,3), (2,1), (2,4), (4,1), (5,5), (5,null), (7,2), (8,6), (10,0)) x(k,v)
+  ORDER BY k, v;
+SELECT i, v, min(v) OVER w, avg(v::float8) OVER w, count(v) OVER w, max(t) OVER w
+  FROM (VALUES (1,3,'c'), (2,1,'a'), (3,5,'e'), (4,null,null), (5,4,'d'), (6,2,'b'), (7,6,'f'), (8,7,'g')) x(i,v,t)
+  WINDOW w AS (ORDER BY i ROWS BETWEEN 1 PRECEDING AND 1 FOLLOWING)
+  ORDER BY i;
+SELECT g, i, t, max(t) OVER w, min(t) OVER w
+  FROM (VALUES (1,1,'pear'), (2,1,'apple'), (3,1,'zebra'), (4,1,'kiwi'), (5,1,'mango'), (6,1,'fig'),
+               (7,1,'banana'), (8,2,'cherry'), (9,1,'date'), (10,2,'lime'), (11,1,'grape'), (12,2,'olive')) x(i,g,t)
+  WINDOW w AS (PARTITION BY g ORDER BY i ROWS BETWEEN 2 PRECEDING AND 1 FOLLOWING)
+  ORDER BY g, i;
+SELECT i, v, bit_and(v) OVER w, bit_or(v) OVER w
+  FROM (VALUES (1,7), (2,14), (3,6), (4,12), (5,null), (6,5), (7,13), (8,15)) x(i,v)
+  WINDOW w AS (ORDER BY i ROWS BETWEEN 2 PRECEDING AND CURRENT ROW)
+  ORDER BY i;
+RESET gp_enable_window_agg_combine;
+
 -- Tests for problems with failure to walk or mutate expressions
 -- within window frame clauses.
 
@@ -60,4 +60,31 @@ select count(1) from generate_series(1, 1000000) t1 left join generate_series(1,
 set gp_workfile_compression = off;
 select count(1) from generate_series(1, 1000000) t1 left join generate_series(1, 50000) t2 on t1 = t2;
 
+-- Test a build side where a single key holds most of the rows. Increasing the
+-- number of batches cannot split that key, so it should stop, and EXPLAIN
+-- ANALYZE should say so.
+create or replace function hashjoin_spill.batch_growth_stopped(explain_query text)
+returns setof bool as
+$$
+rv = plpy.execute(explain_query)
+search_text = 'Further increases disabled in batch'
+result = False
+for i in range(len(rv)):
+    cur_line = rv[i]['QUERY PLAN']
+    if search_text.lower() in cur_line.lower():
+        result = True
+return [result]
+$$
+language plpython3u;
+
+CREATE TABLE test_hj_skew (i1 int, t text) distributed randomly;
+insert into test_hj_skew select case when i % 100 = 0 then i else 1 end, repeat('x', 40)
+	from generate_series(1, 60000) i;
+CREATE TABLE test_hj_skew_probe (i1 int) distributed randomly;
+insert into test_hj_skew_probe select i from generate_series(1, 400000) i;
+analyze test_hj_skew;
+analyze test_hj_skew_probe;
+select count(*) from test_hj_skew_probe p join test_hj_skew s on p.i1 = s.i1;
+select * from hashjoin_spill.batch_growth_stopped('explain (analyze) select count(*) from test_hj_skew_probe p join test_hj_skew s on p.i1 = s.i1');
+
 drop schema hashjoin_spill cascade;